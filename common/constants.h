@@ -5,8 +5,14 @@
 #ifndef FLUTTER_COMMON_CONSTANTS_H_
 #define FLUTTER_COMMON_CONSTANTS_H_
 
+#include <cstdint>
+
 namespace flutter {
 constexpr double kMegaByteSizeInBytes = (1 << 20);
+
+// The ID of the view that the platform provides without it being added, if
+// any.
+constexpr int64_t kFlutterImplicitViewId = 0ll;
 }  // namespace flutter
 
 #endif  // FLUTTER_COMMON_CONSTANTS_H_
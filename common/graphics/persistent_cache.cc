@@ -85,8 +85,12 @@ bool PersistentCache::Purge() {
   FML_CHECK(GetWorkerTaskRunner());
 
   std::promise<bool> removed;
-  GetWorkerTaskRunner()->PostTask([&removed,
-                                   cache_directory = cache_directory_]() {
+  GetWorkerTaskRunner()->PostTask([&removed, cache_directory = cache_directory_,
+                                   cache_pack = cache_pack_,
+                                   sksl_cache_pack = sksl_cache_pack_]() {
+    // The packs are opened again when they are next used.
+    cache_pack->Close();
+    sksl_cache_pack->Close();
     if (cache_directory->is_valid()) {
       // Only remove files but not directories.
       FML_LOG(INFO) << "Purge persistent cache.";
@@ -218,14 +222,53 @@ size_t PersistentCache::PrecompileKnownSkSLs(GrDirectContext* context) const {
   return precompiled_count;
 }
 
+static void PostToWorker(const fml::RefPtr<fml::TaskRunner>& worker,
+                         const fml::closure& task) {
+  if (!worker) {
+    FML_LOG(WARNING)
+        << "The persistent cache has no available workers. Performing the task "
+           "on the current thread. This slow operation is going to occur on a "
+           "frame workload.";
+    task();
+  } else {
+    worker->PostTask(task);
+  }
+}
+
+// Moves an object stored in its own file into the pack and deletes the file.
+static void PersistentCacheMigrate(
+    const fml::RefPtr<fml::TaskRunner>& worker,
+    const std::shared_ptr<PersistentCachePack>& pack,
+    const std::shared_ptr<fml::UniqueFD>& directory,
+    std::string file_name,
+    sk_sp<SkData> key,
+    sk_sp<SkData> value) {
+  auto task = [pack, directory, file_name = std::move(file_name),
+               key = std::move(key), value = std::move(value)]() {
+    TRACE_EVENT0("flutter", "PersistentCacheMigrate");
+    if (!pack->Append(*key, *value)) {
+      FML_LOG(WARNING) << "Could not move cache contents into the pack.";
+      return;
+    }
+    fml::UnlinkFile(*directory, file_name.c_str());
+  };
+  PostToWorker(worker, task);
+}
+
 std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   TRACE_EVENT0("flutter", "PersistentCache::LoadSkSLs");
   std::vector<PersistentCache::SkSLCache> result;
-  fml::FileVisitor visitor = [&result](const fml::UniqueFD& directory,
-                                       const std::string& filename) {
+  std::vector<std::pair<std::string, SkSLCache>> files;
+  fml::FileVisitor visitor = [&files](const fml::UniqueFD& directory,
+                                      const std::string& filename) {
+    // The pack, and the temporary file it is compacted into, are loaded
+    // separately.
+    if (filename.rfind(PersistentCachePack::kFileName, 0) == 0) {
+      return true;
+    }
     SkSLCache cache = LoadFile(directory, filename, true);
     if (cache.key != nullptr && cache.value != nullptr) {
-      result.push_back(cache);
+      files.emplace_back(filename, cache);
     } else {
       FML_LOG(ERROR) << "Failed to load: " << filename;
     }
@@ -236,6 +279,10 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
   // However, we'd like to continue visit the asset dir even if this persistent
   // cache is invalid.
   if (IsValid()) {
+    for (auto& entry : sksl_cache_pack_->GetEntries()) {
+      result.push_back({std::move(entry.key), std::move(entry.value)});
+    }
+
     // In case `rewinddir` doesn't work reliably, load SkSLs from a freshly
     // opened directory (https://github.com/flutter/flutter/issues/65258).
     fml::UniqueFD fresh_dir =
@@ -243,6 +290,16 @@ std::vector<PersistentCache::SkSLCache> PersistentCache::LoadSkSLs() const {
     if (fresh_dir.is_valid()) {
       fml::VisitFiles(fresh_dir, visitor);
     }
+
+    // SkSLs stored one per file by previous versions are moved into the pack.
+    for (auto& [filename, cache] : files) {
+      if (!is_read_only_) {
+        PersistentCacheMigrate(GetWorkerTaskRunner(), sksl_cache_pack_,
+                               sksl_cache_directory_, filename, cache.key,
+                               cache.value);
+      }
+      result.push_back(std::move(cache));
+    }
   }
 
   std::unique_ptr<fml::Mapping> mapping = nullptr;
@@ -279,7 +336,12 @@ PersistentCache::PersistentCache(bool read_only)
     : is_read_only_(read_only),
       cache_directory_(MakeCacheDirectory(cache_base_path_, read_only, false)),
       sksl_cache_directory_(
-          MakeCacheDirectory(cache_base_path_, read_only, true)) {
+          MakeCacheDirectory(cache_base_path_, read_only, true)),
+      cache_pack_(
+          std::make_shared<PersistentCachePack>(cache_directory_, read_only)),
+      sksl_cache_pack_(
+          std::make_shared<PersistentCachePack>(sksl_cache_directory_,
+                                                read_only)) {
   if (!IsValid()) {
     FML_LOG(WARNING) << "Could not acquire the persistent cache directory. "
                         "Caching of GPU resources on disk is disabled.";
@@ -332,12 +394,23 @@ sk_sp<SkData> PersistentCache::load(const SkData& key) {
   if (!IsValid()) {
     return nullptr;
   }
-  auto file_name = SkKeyToFilePath(key);
-  if (file_name.empty()) {
-    return nullptr;
+  auto result = cache_pack_->Find(key);
+  // Caches prepared ahead of time, or written by previous versions, may hold
+  // one object per file. Writable caches move those into the pack.
+  if (result == nullptr) {
+    auto file_name = SkKeyToFilePath(key);
+    if (file_name.empty()) {
+      return nullptr;
+    }
+    result =
+        PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
+    if (result != nullptr && !is_read_only_) {
+      PersistentCacheMigrate(GetWorkerTaskRunner(), cache_pack_,
+                             cache_directory_, std::move(file_name),
+                             SkData::MakeWithCopy(key.data(), key.size()),
+                             result);
+    }
   }
-  auto result =
-      PersistentCache::LoadFile(*cache_directory_, file_name, false).value;
   if (result != nullptr) {
     TRACE_EVENT0("flutter", "PersistentCacheLoadHit");
   }
@@ -363,16 +436,26 @@ static void PersistentCacheStore(
       FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
     }
   });
+  PostToWorker(worker, task);
+}
 
-  if (!worker) {
-    FML_LOG(WARNING)
-        << "The persistent cache has no available workers. Performing the task "
-           "on the current thread. This slow operation is going to occur on a "
-           "frame workload.";
-    task();
-  } else {
-    worker->PostTask(std::move(task));
-  }
+static void PersistentCachePackStore(
+    const fml::RefPtr<fml::TaskRunner>& worker,
+    const std::shared_ptr<PersistentCachePack>& pack,
+    sk_sp<SkData> key,
+    sk_sp<SkData> value) {
+  auto task = [pack, key = std::move(key), value = std::move(value)]() {
+    TRACE_EVENT0("flutter", "PersistentCacheStore");
+    if (!pack->Append(*key, *value)) {
+      FML_LOG(WARNING) << "Could not write cache contents to persistent store.";
+      return;
+    }
+    // Compacting on the worker keeps the rewrite off the frame workload.
+    if (pack->NeedsCompaction()) {
+      pack->Compact();
+    }
+  };
+  PostToWorker(worker, task);
 }
 
 std::unique_ptr<fml::MallocMapping> PersistentCache::BuildCacheObject(
@@ -407,20 +490,14 @@ void PersistentCache::store(const SkData& key, const SkData& data) {
     return;
   }
 
-  auto file_name = SkKeyToFilePath(key);
-
-  if (file_name.empty()) {
+  if (key.size() == 0) {
     return;
   }
 
-  std::unique_ptr<fml::MallocMapping> mapping = BuildCacheObject(key, data);
-  if (!mapping) {
-    return;
-  }
-
-  PersistentCacheStore(GetWorkerTaskRunner(),
-                       cache_sksl_ ? sksl_cache_directory_ : cache_directory_,
-                       std::move(file_name), std::move(mapping));
+  PersistentCachePackStore(GetWorkerTaskRunner(),
+                           cache_sksl_ ? sksl_cache_pack_ : cache_pack_,
+                           SkData::MakeWithCopy(key.data(), key.size()),
+                           SkData::MakeWithCopy(data.data(), data.size()));
 }
 
 void PersistentCache::DumpSkp(const SkData& data) {
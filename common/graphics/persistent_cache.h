@@ -10,6 +10,7 @@
 #include <set>
 
 #include "flutter/assets/asset_manager.h"
+#include "flutter/common/graphics/persistent_cache_pack.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/unique_fd.h"
@@ -27,6 +28,12 @@ class ShellTest;
 ///
 /// This is mainly used for Shaders but is also written to by Dart.  It is
 /// thread-safe for reading and writing from multiple threads.
+///
+/// Cached objects are stored in a single |PersistentCachePack| per cache
+/// directory. Objects stored one per file, as done by previous versions or
+/// when a read-only cache is prepared ahead of time, can still be loaded.
+/// Writable caches move such objects into the pack when they are loaded and
+/// delete their files.
 class PersistentCache : public GrContextOptions::PersistentCache {
  public:
   // Mutable static switch that can be set before GetCacheForProcess. If true,
@@ -49,13 +56,13 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   // json keys.
   static std::string SkKeyToFilePath(const SkData& key);
 
-  // Allocate a MallocMapping containing the given key and value in the file
-  // format used by the cache.
+  // Allocate a MallocMapping containing the given key and value in the format
+  // of the files that hold a single cache object.
   static std::unique_ptr<fml::MallocMapping> BuildCacheObject(
       const SkData& key,
       const SkData& data);
 
-  // Header written into the files used to store cached Skia objects.
+  // Header written into the files that hold a single cached Skia object.
   struct CacheObjectHeader {
     // A prefix used to identify the cache object file format.
     static const uint32_t kSignature = 0xA869593F;
@@ -153,6 +160,8 @@ class PersistentCache : public GrContextOptions::PersistentCache {
   const bool is_read_only_;
   const std::shared_ptr<fml::UniqueFD> cache_directory_;
   const std::shared_ptr<fml::UniqueFD> sksl_cache_directory_;
+  const std::shared_ptr<PersistentCachePack> cache_pack_;
+  const std::shared_ptr<PersistentCachePack> sksl_cache_pack_;
   mutable std::mutex worker_task_runners_mutex_;
   std::multiset<fml::RefPtr<fml::TaskRunner>> worker_task_runners_;
 
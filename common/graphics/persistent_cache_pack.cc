@@ -0,0 +1,382 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/common/graphics/persistent_cache_pack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "flutter/fml/build_config.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+namespace {
+
+// The pack file grows at least by this much so that consecutive appends don't
+// each need to resize and remap it.
+constexpr size_t kMinCapacity = 64 * 1024;
+
+// Compacting a pack with fewer dead bytes than this isn't worth the rewrite.
+constexpr size_t kMinCompactionBytes = 256 * 1024;
+
+// 32-bit FNV-1a of the key followed by the value.
+uint32_t Checksum(const uint8_t* key,
+                  size_t key_size,
+                  const uint8_t* value,
+                  size_t value_size) {
+  uint32_t hash = 2166136261u;
+  const auto add = [&hash](const uint8_t* bytes, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= 16777619u;
+    }
+  };
+  add(key, key_size);
+  add(value, value_size);
+  return hash;
+}
+
+}  // namespace
+
+PersistentCachePack::PersistentCachePack(
+    std::shared_ptr<fml::UniqueFD> directory,
+    bool read_only)
+    : directory_(std::move(directory)), read_only_(read_only) {}
+
+PersistentCachePack::~PersistentCachePack() = default;
+
+sk_sp<SkData> PersistentCachePack::Find(const SkData& key) {
+  std::scoped_lock lock(mutex_);
+  if (key.size() == 0 || !OpenLocked()) {
+    return nullptr;
+  }
+  auto found = index_.find(
+      std::string(static_cast<const char*>(key.data()), key.size()));
+  if (found == index_.end()) {
+    return nullptr;
+  }
+  const size_t value_offset = sizeof(RecordHeader) + key.size();
+  return SkData::MakeWithCopy(
+      mapping_->GetMapping() + found->second.offset + value_offset,
+      found->second.size - value_offset);
+}
+
+std::vector<PersistentCachePack::Entry> PersistentCachePack::GetEntries() {
+  std::scoped_lock lock(mutex_);
+  std::vector<Entry> entries;
+  if (!OpenLocked()) {
+    return entries;
+  }
+  entries.reserve(index_.size());
+  for (const auto& [key, record] : index_) {
+    const size_t value_offset = sizeof(RecordHeader) + key.size();
+    entries.push_back({
+        SkData::MakeWithCopy(key.data(), key.size()),
+        SkData::MakeWithCopy(
+            mapping_->GetMapping() + record.offset + value_offset,
+            record.size - value_offset),
+    });
+  }
+  return entries;
+}
+
+bool PersistentCachePack::Append(const SkData& key, const SkData& value) {
+  if (read_only_ || key.size() == 0 ||
+      key.size() > std::numeric_limits<uint32_t>::max() ||
+      value.size() > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (!OpenLocked()) {
+    return false;
+  }
+  return AppendLocked(key.bytes(), key.size(), value.bytes(), value.size());
+}
+
+bool PersistentCachePack::NeedsCompaction() {
+  std::scoped_lock lock(mutex_);
+  return dead_bytes_ >= kMinCompactionBytes && dead_bytes_ * 2 >= end_;
+}
+
+bool PersistentCachePack::Compact() {
+  if (read_only_) {
+    return false;
+  }
+  TRACE_EVENT0("flutter", "PersistentCachePack::Compact");
+
+#if FML_OS_WIN
+  // The file is rewritten in place here, which can't be done while it is
+  // mapped or while records are appended to it.
+  std::scoped_lock lock(mutex_);
+  if (!OpenLocked()) {
+    return false;
+  }
+  auto data = GetLiveRecordsLocked();
+  CloseLocked();
+  const bool compacted = fml::WriteAtomically(
+      *directory_, kFileName, fml::DataMapping(std::move(data)));
+  if (!compacted) {
+    FML_LOG(ERROR) << "Could not compact the persistent cache pack.";
+  }
+  // Whether or not the pack was compacted, it is still usable.
+  OpenLocked();
+  return compacted;
+#else
+  std::vector<uint8_t> data;
+  size_t compacted_end = 0;
+  uint64_t generation = 0;
+  {
+    std::scoped_lock lock(mutex_);
+    if (!OpenLocked()) {
+      return false;
+    }
+    data = GetLiveRecordsLocked();
+    compacted_end = end_;
+    generation = generation_;
+  }
+
+  // The compacted file replaces the pack by being renamed over it. Lookups
+  // and appends carry on using the old file in the meantime.
+  if (!fml::WriteAtomically(*directory_, kFileName,
+                            fml::DataMapping(std::move(data)))) {
+    FML_LOG(ERROR) << "Could not compact the persistent cache pack.";
+    return false;
+  }
+
+  std::scoped_lock lock(mutex_);
+  if (generation_ != generation) {
+    // The pack was closed in the meantime. It reads the compacted file when
+    // it is next opened.
+    return true;
+  }
+  // Switch to the compacted file and carry over the records that were
+  // appended to the old one while the compacted file was written.
+  const auto old_mapping = std::move(mapping_);
+  const size_t old_end = end_;
+  CloseLocked();
+  if (!OpenLocked()) {
+    return false;
+  }
+  const uint8_t* base = old_mapping->GetMapping();
+  for (size_t offset = compacted_end; offset < old_end;) {
+    RecordHeader record;
+    memcpy(&record, base + offset, sizeof(RecordHeader));
+    const uint8_t* key = base + offset + sizeof(RecordHeader);
+    if (!AppendLocked(key, record.key_size, key + record.key_size,
+                      record.value_size)) {
+      break;
+    }
+    offset += sizeof(RecordHeader) + record.key_size + record.value_size;
+  }
+  return true;
+#endif  // FML_OS_WIN
+}
+
+void PersistentCachePack::Close() {
+  std::scoped_lock lock(mutex_);
+  CloseLocked();
+}
+
+size_t PersistentCachePack::GetDeadBytes() {
+  std::scoped_lock lock(mutex_);
+  return dead_bytes_;
+}
+
+bool PersistentCachePack::OpenLocked() {
+  if (is_open_) {
+    return mapping_ != nullptr;
+  }
+  // Don't try again on every use if the pack can't be opened.
+  is_open_ = true;
+
+  if (!directory_ || !directory_->is_valid()) {
+    return false;
+  }
+  file_ = read_only_ ? fml::OpenFileReadOnly(*directory_, kFileName)
+                     : fml::OpenFile(*directory_, kFileName, true,
+                                     fml::FilePermission::kReadWrite);
+  if (!file_.is_valid() || !MapLocked()) {
+    CloseLocked();
+    is_open_ = true;
+    return false;
+  }
+
+  TRACE_EVENT0("flutter", "PersistentCachePack::Open");
+  const uint8_t* base = mapping_->GetMapping();
+  const size_t size = mapping_->GetSize();
+
+  FileHeader header;
+  if (size >= sizeof(FileHeader)) {
+    memcpy(&header, base, sizeof(FileHeader));
+  }
+  if (size < sizeof(FileHeader) || header.signature != FileHeader::kSignature ||
+      header.version != FileHeader::kVersion1) {
+    if (size > 0) {
+      FML_LOG(INFO) << "Persistent cache pack header is corrupt.";
+    }
+    if (read_only_ || !ResetLocked()) {
+      CloseLocked();
+      is_open_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  size_t offset = sizeof(FileHeader);
+  while (size - offset >= sizeof(RecordHeader)) {
+    RecordHeader record;
+    memcpy(&record, base + offset, sizeof(RecordHeader));
+    if (record.signature != RecordHeader::kSignature ||
+        uint64_t{record.key_size} + record.value_size >
+            size - offset - sizeof(RecordHeader)) {
+      break;
+    }
+    const uint8_t* key = base + offset + sizeof(RecordHeader);
+    const uint8_t* value = key + record.key_size;
+    if (record.key_size == 0 ||
+        Checksum(key, record.key_size, value, record.value_size) !=
+            record.checksum) {
+      break;
+    }
+    const size_t record_size =
+        sizeof(RecordHeader) + record.key_size + record.value_size;
+    IndexRecordLocked(key, record.key_size, {offset, record_size});
+    offset += record_size;
+  }
+  end_ = offset;
+
+  // Clear what an interrupted append left behind so that it can't be mistaken
+  // for records once the next appends partially overwrite it.
+  if (!read_only_) {
+    uint8_t* tail = mapping_->GetMutableMapping();
+    if (std::any_of(tail + end_, tail + size,
+                    [](uint8_t byte) { return byte != 0u; })) {
+      FML_LOG(WARNING) << "Discarding an incomplete persistent cache record.";
+      memset(tail + end_, 0, size - end_);
+    }
+  }
+  return true;
+}
+
+bool PersistentCachePack::MapLocked() {
+  if (read_only_) {
+    mapping_ = std::make_unique<fml::FileMapping>(file_);
+  } else {
+    mapping_ = std::make_unique<fml::FileMapping>(
+        file_, std::initializer_list<fml::FileMapping::Protection>{
+                   fml::FileMapping::Protection::kRead,
+                   fml::FileMapping::Protection::kWrite});
+  }
+  if (!mapping_->IsValid()) {
+    mapping_.reset();
+    return false;
+  }
+  return true;
+}
+
+bool PersistentCachePack::ResizeLocked(size_t size) {
+  mapping_.reset();
+  return fml::TruncateFile(file_, size) && MapLocked();
+}
+
+bool PersistentCachePack::ResetLocked() {
+  index_.clear();
+  end_ = 0;
+  dead_bytes_ = 0;
+  // Truncating to zero first drops the previous contents.
+  if (!ResizeLocked(0) || !ResizeLocked(kMinCapacity)) {
+    return false;
+  }
+  FileHeader header;
+  memcpy(mapping_->GetMutableMapping(), &header, sizeof(FileHeader));
+  end_ = sizeof(FileHeader);
+  return true;
+}
+
+void PersistentCachePack::IndexRecordLocked(const uint8_t* key,
+                                            size_t key_size,
+                                            Record record) {
+  auto [found, inserted] = index_.try_emplace(
+      std::string(reinterpret_cast<const char*>(key), key_size), record);
+  if (!inserted) {
+    dead_bytes_ += found->second.size;
+    found->second = record;
+  }
+}
+
+bool PersistentCachePack::AppendLocked(const uint8_t* key,
+                                       size_t key_size,
+                                       const uint8_t* value,
+                                       size_t value_size) {
+  const size_t record_size = sizeof(RecordHeader) + key_size + value_size;
+  if (mapping_->GetSize() - end_ < record_size) {
+    if (!ResizeLocked(std::max(
+            {mapping_->GetSize() * 2, end_ + record_size, kMinCapacity}))) {
+      FML_LOG(ERROR) << "Could not grow the persistent cache pack.";
+      return false;
+    }
+  }
+
+  RecordHeader header;
+  header.key_size = key_size;
+  header.value_size = value_size;
+  header.checksum = Checksum(key, key_size, value, value_size);
+
+  // The header is written last so that it never describes contents that
+  // aren't in place yet.
+  uint8_t* record = mapping_->GetMutableMapping() + end_;
+  memcpy(record + sizeof(RecordHeader), key, key_size);
+  if (value_size > 0) {
+    memcpy(record + sizeof(RecordHeader) + key_size, value, value_size);
+  }
+  memcpy(record, &header, sizeof(RecordHeader));
+
+  IndexRecordLocked(record + sizeof(RecordHeader), key_size,
+                    {end_, record_size});
+  end_ += record_size;
+  return true;
+}
+
+std::vector<uint8_t> PersistentCachePack::GetLiveRecordsLocked() const {
+  // Keep the live records in the order they were appended in.
+  std::vector<Record> records;
+  records.reserve(index_.size());
+  size_t live_size = sizeof(FileHeader);
+  for (const auto& [key, record] : index_) {
+    records.push_back(record);
+    live_size += record.size;
+  }
+  std::sort(records.begin(), records.end(),
+            [](const Record& a, const Record& b) {
+              return a.offset < b.offset;
+            });
+
+  std::vector<uint8_t> data(std::max(live_size, kMinCapacity), 0u);
+  FileHeader header;
+  memcpy(data.data(), &header, sizeof(FileHeader));
+  size_t offset = sizeof(FileHeader);
+  for (const auto& record : records) {
+    memcpy(data.data() + offset, mapping_->GetMapping() + record.offset,
+           record.size);
+    offset += record.size;
+  }
+  return data;
+}
+
+void PersistentCachePack::CloseLocked() {
+  mapping_.reset();
+  file_.reset();
+  index_.clear();
+  end_ = 0;
+  dead_bytes_ = 0;
+  is_open_ = false;
+  generation_++;
+}
+
+}  // namespace flutter
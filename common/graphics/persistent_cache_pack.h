@@ -0,0 +1,140 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+#define FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "third_party/skia/include/core/SkData.h"
+
+namespace flutter {
+
+/// A single file in a cache directory that holds the cached objects of
+/// |PersistentCache| as records appended one after the other.
+///
+/// The file is memory mapped when it is first used and a hash index from keys
+/// to records is built by walking the record headers, so that looking up an
+/// object doesn't need any syscalls.
+///
+/// Records are never modified once written. Storing an object again under the
+/// same key appends a new record and leaves the old one behind as dead bytes,
+/// which are dropped by |Compact|. Every record carries a checksum of its key
+/// and value. A record whose checksum doesn't match, as left behind by a crash
+/// partway through an append, ends the pack and is overwritten by the next
+/// append.
+///
+/// All methods are thread-safe.
+class PersistentCachePack {
+ public:
+  static constexpr char kFileName[] = "io.flutter.persistent_cache.pack";
+
+  struct FileHeader {
+    static const uint32_t kSignature = 0x4B504346;
+    static const uint32_t kVersion1 = 1;
+
+    uint32_t signature = kSignature;
+    uint32_t version = kVersion1;
+  };
+
+  // Written in front of the key and value of each record.
+  struct RecordHeader {
+    static const uint32_t kSignature = 0x52504346;
+
+    uint32_t signature = kSignature;
+    uint32_t key_size = 0;
+    uint32_t value_size = 0;
+    uint32_t checksum = 0;
+  };
+
+  struct Entry {
+    sk_sp<SkData> key;
+    sk_sp<SkData> value;
+  };
+
+  PersistentCachePack(std::shared_ptr<fml::UniqueFD> directory,
+                      bool read_only);
+
+  ~PersistentCachePack();
+
+  sk_sp<SkData> Find(const SkData& key);
+
+  std::vector<Entry> GetEntries();
+
+  bool Append(const SkData& key, const SkData& value);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether enough of the pack is taken up by records that were
+  ///             replaced for a |Compact| to be worthwhile.
+  ///
+  bool NeedsCompaction();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Atomically replace the pack file with one that only contains
+  ///             the live records. The compacted file is written without
+  ///             holding up lookups and appends on other threads.
+  ///
+  bool Compact();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Unmap and close the pack file, for example before it is
+  ///             deleted. It is opened again when the pack is next used.
+  ///
+  void Close();
+
+  size_t GetDeadBytes();
+
+ private:
+  struct Record {
+    size_t offset = 0;
+    size_t size = 0;
+  };
+
+  const std::shared_ptr<fml::UniqueFD> directory_;
+  const bool read_only_;
+  std::mutex mutex_;
+  // Whether opening the file was attempted since the pack was last closed.
+  bool is_open_ = false;
+  fml::UniqueFD file_;
+  std::unique_ptr<fml::FileMapping> mapping_;
+  // The end of the last valid record. Anything past it is either zeroes or the
+  // remains of an interrupted append.
+  size_t end_ = 0;
+  size_t dead_bytes_ = 0;
+  // Incremented every time the pack is closed.
+  uint64_t generation_ = 0;
+  std::unordered_map<std::string, Record> index_;
+
+  bool OpenLocked();
+
+  bool MapLocked();
+
+  bool ResizeLocked(size_t size);
+
+  bool ResetLocked();
+
+  bool AppendLocked(const uint8_t* key,
+                    size_t key_size,
+                    const uint8_t* value,
+                    size_t value_size);
+
+  std::vector<uint8_t> GetLiveRecordsLocked() const;
+
+  void IndexRecordLocked(const uint8_t* key, size_t key_size, Record record);
+
+  void CloseLocked();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PersistentCachePack);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_COMMON_GRAPHICS_PERSISTENT_CACHE_PACK_H_
@@ -206,6 +206,31 @@ struct Settings {
   // manager before creating the engine.
   bool prefetched_default_font_manager = false;
 
+  // Start building frames as late as the recent build and raster times allow,
+  // and only pipeline frames when they don't fit in a frame interval.
+  bool enable_predictive_frame_scheduling = false;
+
+  // When the rasterizer falls behind, replace the frame that is waiting to be
+  // rasterized with the newer one instead of skipping the newer one.
+  bool enable_latest_frame_wins = false;
+
+  // Adjust the limits of the resource cache and of the raster cache to how
+  // well they are used and to the memory pressure on the process.
+  bool enable_adaptive_resource_cache = false;
+
+  // The resident set size in megabytes above which the adaptive resource cache
+  // considers the process to be under memory pressure, or 0 to derive it from
+  // the physical memory of the device.
+  size_t resident_memory_budget_mb = 0;
+
+  // Hold pointer data until the next vsync and coalesce the moves of each
+  // pointer in between. See |BatchingPointerDataDispatcher|.
+  bool enable_pointer_batching = false;
+
+  // Resample the positions of batched pointer moves to the vsync time. Implies
+  // |enable_pointer_batching|.
+  bool enable_pointer_resampling = false;
+
   // Enable the rendering of colors outside of the sRGB gamut.
   bool enable_wide_gamut = false;
 
@@ -205,6 +205,8 @@ class CompositorContext {
 
   const Stopwatch& raster_time() const { return raster_time_; }
 
+  Stopwatch& raster_time() { return raster_time_; }
+
   Stopwatch& ui_time() { return ui_time_; }
 
   LayerSnapshotStore& snapshot_store() { return layer_snapshot_store_; }
@@ -4,6 +4,7 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -124,10 +125,15 @@ bool RasterCache::UpdateCacheEntry(
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
   if (!entry.image) {
+    if (cached_bytes_ >= max_bytes_) {
+      budget_miss_count_++;
+      return false;
+    }
     void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
     if (entry.image != nullptr) {
+      cached_bytes_ += entry.image->image_bytes();
       switch (id.type()) {
         case RasterCacheKeyType::kDisplayList: {
           display_list_cached_this_frame_++;
@@ -187,13 +193,15 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
 
   if (entry.image) {
     entry.image->draw(canvas, paint, preserve_rtree);
+    hit_count_++;
     return true;
   }
 
   return false;
 }
 
-void RasterCache::BeginFrame() {
+void RasterCache::BeginFrame(size_t view_count) {
+  defers_eviction_ = view_count > 1;
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
@@ -213,6 +221,13 @@ void RasterCache::UpdateMetrics() {
 }
 
 void RasterCache::EvictUnusedCacheEntries() {
+  if (defers_eviction_) {
+    // The views that are yet to be painted in this frame haven't been
+    // prerolled, so the entries they use haven't been encountered yet. The
+    // entries are evicted by |EndFrame| instead, whichever views were painted.
+    return;
+  }
+
   std::vector<RasterCacheKey::Map<Entry>::iterator> dead;
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
@@ -227,18 +242,52 @@ void RasterCache::EvictUnusedCacheEntries() {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
       metrics.eviction_count++;
       metrics.eviction_bytes += it->second.image->image_bytes();
+      cached_bytes_ -= it->second.image->image_bytes();
     }
     cache_.erase(it);
   }
+
+  EvictOverBudgetImages();
+}
+
+void RasterCache::EvictOverBudgetImages() {
+  if (cached_bytes_ <= max_bytes_) {
+    return;
+  }
+
+  std::vector<Entry*> cached;
+  for (auto& [key, entry] : cache_) {
+    if (entry.image) {
+      cached.push_back(&entry);
+    }
+  }
+  std::sort(cached.begin(), cached.end(), [](const Entry* a, const Entry* b) {
+    return a->accesses_since_visible < b->accesses_since_visible;
+  });
+
+  // The entries stay in the cache so that their images are rasterized again
+  // once there is room for them.
+  for (Entry* entry : cached) {
+    if (cached_bytes_ <= max_bytes_) {
+      break;
+    }
+    cached_bytes_ -= entry->image->image_bytes();
+    entry->image.reset();
+  }
 }
 
 void RasterCache::EndFrame() {
+  if (defers_eviction_) {
+    defers_eviction_ = false;
+    EvictUnusedCacheEntries();
+  }
   UpdateMetrics();
   TraceStatsToTimeline();
 }
 
 void RasterCache::Clear() {
   cache_.clear();
+  cached_bytes_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <limits>
 #include <memory>
 #include <unordered_map>
 
@@ -106,14 +107,17 @@ struct RasterCacheMetrics {
  *         encountered by the current frame.
  * - Paint stage
  *   - RasterCache::EvictUnusedCacheEntries
- *       Evict cached images that are no longer used.
+ *       Evict cached images that are no longer used. When the layer trees of
+ *       several views are painted in a frame, this is deferred to
+ *       `RasterCache::EndFrame`, once all of them have been prerolled.
  *   - LayerTree::TryToPrepareRasterCache
  *       Create cache image for each cache entry if it does not exist.
  *   - LayerTree::Paint - for each layer in the tree:
  *       If layers or display lists are cached as cached images, the method
  *       `RasterCache::Draw` will be used to draw those cache images.
  *   - RasterCache::EndFrame:
- *       Computes used counts and memory then reports cache metrics.
+ *       Evicts deferred unused entries, computes used counts and memory then
+ *       reports cache metrics.
  */
 class RasterCache {
  public:
@@ -160,7 +164,8 @@ class RasterCache {
 
   bool HasEntry(const RasterCacheKeyID& id, const SkMatrix&) const;
 
-  void BeginFrame();
+  // Starts a frame in which the layer trees of |view_count| views are painted.
+  void BeginFrame(size_t view_count = 1);
 
   void EvictUnusedCacheEntries();
 
@@ -219,6 +224,32 @@ class RasterCache {
    */
   size_t access_threshold() const { return access_threshold_; }
 
+  /**
+   * @brief Limit the bytes of the images held by the cache. Once the cache
+   * holds this many bytes, no new images are rasterized and the images that
+   * were drawn the least are dropped from the cache when it evicts entries.
+   */
+  void SetMaxBytes(size_t max_bytes) { max_bytes_ = max_bytes; }
+
+  size_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief The bytes of the images currently held by the cache.
+   */
+  size_t cached_bytes() const { return cached_bytes_; }
+
+  /**
+   * @brief The number of times a cached image was drawn since the cache was
+   * created.
+   */
+  size_t hit_count() const { return hit_count_; }
+
+  /**
+   * @brief The number of images that weren't rasterized since the cache was
+   * created because the cache held |max_bytes| of images.
+   */
+  size_t budget_miss_count() const { return budget_miss_count_; }
+
   bool GenerateNewCacheInThisFrame() const {
     // Disabling caching when access_threshold is zero is historic behavior.
     return access_threshold_ != 0 && display_list_cached_this_frame_ <
@@ -260,11 +291,22 @@ class RasterCache {
 
   void UpdateMetrics();
 
+  // Drops the images of the entries that were drawn the least until the cache
+  // holds no more than |max_bytes_|.
+  void EvictOverBudgetImages();
+
   RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
   mutable size_t display_list_cached_this_frame_ = 0;
+  size_t max_bytes_ = std::numeric_limits<size_t>::max();
+  mutable size_t cached_bytes_ = 0;
+  mutable size_t hit_count_ = 0;
+  mutable size_t budget_miss_count_ = 0;
+  // Whether several views are painted in the frame, so that unused entries
+  // are only evicted when it ends.
+  bool defers_eviction_ = false;
   RasterCacheMetrics layer_metrics_;
   RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
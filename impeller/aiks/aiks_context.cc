@@ -5,6 +5,7 @@
 #include "impeller/aiks/aiks_context.h"
 
 #include "impeller/aiks/picture.h"
+#include "impeller/entity/pipeline_usage_profile.h"
 
 namespace impeller {
 
@@ -41,11 +42,51 @@ bool AiksContext::Render(const Picture& picture, RenderTarget& render_target) {
     return false;
   }
 
-  if (picture.pass) {
-    return picture.pass->Render(*content_context_, render_target);
+  if (!picture.pass) {
+    return true;
   }
 
-  return true;
+  const auto& filter_result_cache = content_context_->GetFilterResultCache();
+  filter_result_cache->Start();
+  auto result = picture.pass->Render(*content_context_, render_target);
+  filter_result_cache->End();
+
+  if (usage_profile_directory_ &&
+      ++frames_rendered_ % kFramesBetweenUsageProfileUpdates == 0u) {
+    UpdatePipelineUsageProfile();
+  }
+  return result;
+}
+
+void AiksContext::EnablePipelineUsageProfile(fml::UniqueFD directory) {
+  if (!IsValid() || !directory.is_valid()) {
+    return;
+  }
+  // Replaying the profile must not delay the first frame.
+  content_context_->SetAsyncPipelineCompilation(true);
+  content_context_->WarmUpPipelines(PipelineUsageProfile::Load(directory));
+  usage_profile_size_ = content_context_->GetPipelineUsage().size();
+  usage_profile_directory_ =
+      std::make_shared<fml::UniqueFD>(std::move(directory));
+}
+
+void AiksContext::UpdatePipelineUsageProfile() {
+  const auto& usage = content_context_->GetPipelineUsage();
+  if (usage.size() == usage_profile_size_) {
+    return;
+  }
+  usage_profile_size_ = usage.size();
+  auto save = [directory = usage_profile_directory_, usage]() {
+    PipelineUsageProfile::Save(*directory, usage);
+  };
+  // Not every backend has worker threads, the OpenGL ES one for instance. The
+  // profile is small and rarely updated, so save it right away there.
+  auto worker_task_runner = context_->GetConcurrentWorkerTaskRunner();
+  if (!worker_task_runner) {
+    save();
+    return;
+  }
+  worker_task_runner->PostTask(std::move(save));
 }
 
 }  // namespace impeller
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "flutter/fml/macros.h"
+#include "flutter/fml/unique_fd.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/renderer/context.h"
 #include "impeller/renderer/render_target.h"
@@ -30,11 +31,30 @@ class AiksContext {
 
   bool Render(const Picture& picture, RenderTarget& render_target);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Warm up the pipeline variants recorded in the usage profile
+  ///             in the given directory, and periodically record the variants
+  ///             used by this run to it.
+  ///
+  ///             The variants are built on the worker threads. Does nothing if
+  ///             the directory is invalid.
+  ///
+  void EnablePipelineUsageProfile(fml::UniqueFD directory);
+
  private:
+  /// How many frames to render between checks for new pipeline variants
+  /// that should be recorded in the usage profile.
+  static constexpr size_t kFramesBetweenUsageProfileUpdates = 50u;
+
   std::shared_ptr<Context> context_;
   std::unique_ptr<ContentContext> content_context_;
+  std::shared_ptr<fml::UniqueFD> usage_profile_directory_;
+  size_t frames_rendered_ = 0u;
+  size_t usage_profile_size_ = 0u;
   bool is_valid_ = false;
 
+  void UpdatePipelineUsageProfile();
+
   FML_DISALLOW_COPY_AND_ASSIGN(AiksContext);
 };
 
@@ -60,7 +60,8 @@ void Canvas::Save() {
 
 void Canvas::Save(bool create_subpass,
                   BlendMode blend_mode,
-                  EntityPass::BackdropFilterProc backdrop_filter) {
+                  EntityPass::BackdropFilterProc backdrop_filter,
+                  std::optional<uint64_t> backdrop_content_key) {
   auto entry = CanvasStackEntry{};
   entry.xformation = xformation_stack_.back().xformation;
   entry.cull_rect = xformation_stack_.back().cull_rect;
@@ -70,7 +71,8 @@ void Canvas::Save(bool create_subpass,
     auto subpass = std::make_unique<EntityPass>();
     subpass->SetEnableOffscreenCheckerboard(
         debug_options.offscreen_texture_checkerboard);
-    subpass->SetBackdropFilter(std::move(backdrop_filter));
+    subpass->SetBackdropFilter(std::move(backdrop_filter),
+                               backdrop_content_key);
     subpass->SetBlendMode(blend_mode);
     current_pass_ = GetCurrentPass().AddSubpass(std::move(subpass));
     current_pass_->SetTransformation(xformation_stack_.back().xformation);
@@ -489,8 +491,9 @@ size_t Canvas::GetStencilDepth() const {
 
 void Canvas::SaveLayer(const Paint& paint,
                        std::optional<Rect> bounds,
-                       const Paint::ImageFilterProc& backdrop_filter) {
-  Save(true, paint.blend_mode, backdrop_filter);
+                       const Paint::ImageFilterProc& backdrop_filter,
+                       std::optional<uint64_t> backdrop_content_key) {
+  Save(true, paint.blend_mode, backdrop_filter, backdrop_content_key);
 
   auto& new_layer_pass = GetCurrentPass();
 
@@ -66,9 +66,14 @@ class Canvas {
 
   void Save();
 
+  /// @param backdrop_content_key  Identifies the content read by the
+  ///                              backdrop filter. Layers with equal keys may
+  ///                              reuse each other's filtered backdrop, see
+  ///                              `EntityPass::SetBackdropFilter`.
   void SaveLayer(const Paint& paint,
                  std::optional<Rect> bounds = std::nullopt,
-                 const Paint::ImageFilterProc& backdrop_filter = nullptr);
+                 const Paint::ImageFilterProc& backdrop_filter = nullptr,
+                 std::optional<uint64_t> backdrop_content_key = std::nullopt);
 
   bool Restore();
 
@@ -181,7 +186,8 @@ class Canvas {
 
   void Save(bool create_subpass,
             BlendMode = BlendMode::kSourceOver,
-            EntityPass::BackdropFilterProc backdrop_filter = nullptr);
+            EntityPass::BackdropFilterProc backdrop_filter = nullptr,
+            std::optional<uint64_t> backdrop_content_key = std::nullopt);
 
   void RestoreClip();
 
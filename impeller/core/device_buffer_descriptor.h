@@ -13,6 +13,10 @@ namespace impeller {
 struct DeviceBufferDescriptor {
   StorageMode storage_mode = StorageMode::kDeviceTransient;
   size_t size = 0u;
+  /// Whether the buffer is only used by the frame it was created for, like
+  /// the contents of the transients buffer of a pass. Backends may place such
+  /// buffers in memory that is recycled from frame to frame.
+  bool is_per_frame = false;
 };
 
 }  // namespace impeller
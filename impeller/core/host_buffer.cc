@@ -77,8 +77,13 @@ std::shared_ptr<const DeviceBuffer> HostBuffer::GetDeviceBuffer(
   if (generation_ == device_buffer_generation_) {
     return device_buffer_;
   }
-  auto new_buffer = allocator.CreateBufferWithCopy(GetBuffer(), GetLength());
-  if (!new_buffer) {
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = GetLength();
+  desc.is_per_frame = true;
+  auto new_buffer = allocator.CreateBuffer(desc);
+  if (!new_buffer ||
+      !new_buffer->CopyHostBuffer(GetBuffer(), Range{0, GetLength()})) {
     return nullptr;
   }
   new_buffer->SetLabel(label_);
@@ -0,0 +1,625 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/display_list/dl_backdrop_key_collector.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "third_party/skia/include/core/SkPath.h"
+#include "third_party/skia/include/core/SkRRect.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace impeller {
+
+namespace {
+
+enum class OpType {
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+  kSaveLayer,
+  kBackdrop,
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawDisplayList,
+  kDrawTextBlob,
+  kDrawShadow,
+};
+
+/// Keys are 64 bits wide on every platform. `std::hash` and
+/// `fml::HashCombine` are only as wide as `size_t`, which is 32 bits on some
+/// targets and makes collisions between cached backdrops likely.
+template <class Type>
+uint64_t ToBits(Type value) {
+  if constexpr (std::is_floating_point_v<Type>) {
+    static_assert(sizeof(Type) <= sizeof(uint64_t));
+    uint64_t bits = 0u;
+    std::memcpy(&bits, &value, sizeof(Type));
+    return bits;
+  } else if constexpr (std::is_enum_v<Type>) {
+    return static_cast<uint64_t>(
+        static_cast<std::underlying_type_t<Type>>(value));
+  } else {
+    return static_cast<uint64_t>(value);
+  }
+}
+
+template <class Type>
+void HashCombineSeed(uint64_t& seed, Type arg) {
+  // The finalizer of SplitMix64 spreads every input bit over the whole word.
+  uint64_t bits = ToBits(arg);
+  bits = (bits ^ (bits >> 30)) * 0xbf58476d1ce4e5b9ull;
+  bits = (bits ^ (bits >> 27)) * 0x94d049bb133111ebull;
+  bits ^= bits >> 31;
+  seed ^= bits + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+}
+
+template <class Type, class... Rest>
+void HashCombineSeed(uint64_t& seed, Type arg, Rest... other_args) {
+  HashCombineSeed(seed, arg);
+  HashCombineSeed(seed, other_args...);
+}
+
+template <class... Type>
+uint64_t HashCombine(Type... args) {
+  uint64_t seed = 0xdabbad00u;
+  if constexpr (sizeof...(args) > 0) {
+    HashCombineSeed(seed, args...);
+  }
+  return seed;
+}
+
+uint64_t HashRect(const SkRect& rect) {
+  return HashCombine(rect.fLeft, rect.fTop, rect.fRight, rect.fBottom);
+}
+
+uint64_t HashRRect(const SkRRect& rrect) {
+  uint64_t hash = HashRect(rrect.rect());
+  for (auto corner : {SkRRect::kUpperLeft_Corner, SkRRect::kUpperRight_Corner,
+                      SkRRect::kLowerRight_Corner,
+                      SkRRect::kLowerLeft_Corner}) {
+    auto radii = rrect.radii(corner);
+    HashCombineSeed(hash, radii.fX, radii.fY);
+  }
+  return hash;
+}
+
+/// Paths are only identified by their generation id, which changes whenever a
+/// path is rebuilt, even with the same contents.
+uint64_t HashPath(const SkPath& path) {
+  return HashCombine(path.getGenerationID(), path.getFillType());
+}
+
+}  // namespace
+
+std::vector<DlBackdropKeyCollector::Key> DlBackdropKeyCollector::Collect(
+    const flutter::DisplayList& display_list,
+    const SkRect& cull_rect) {
+  DlBackdropKeyCollector collector(cull_rect);
+  display_list.Dispatch(collector, cull_rect);
+  return collector.GetKeys();
+}
+
+DlBackdropKeyCollector::DlBackdropKeyCollector(const SkRect& cull_rect)
+    : tracker_(cull_rect, SkMatrix::I()) {
+  save_stack_.emplace_back();
+}
+
+DlBackdropKeyCollector::~DlBackdropKeyCollector() = default;
+
+const std::vector<DlBackdropKeyCollector::Key>&
+DlBackdropKeyCollector::GetKeys() const {
+  return keys_;
+}
+
+uint64_t DlBackdropKeyCollector::HashPaint() const {
+  return HashCombine(paint_.anti_alias, paint_.dither, paint_.style,
+                     paint_.color, paint_.stroke_width, paint_.stroke_miter,
+                     paint_.stroke_cap, paint_.stroke_join,
+                     paint_.invert_colors, paint_.blend_mode);
+}
+
+uint64_t DlBackdropKeyCollector::HashMatrix() const {
+  SkScalar values[16];
+  tracker_.matrix_4x4().getColMajor(values);
+  uint64_t hash = HashCombine();
+  for (auto value : values) {
+    HashCombineSeed(hash, value);
+  }
+  return hash;
+}
+
+bool DlBackdropKeyCollector::PaintIsIdentifiable() const {
+  return !paint_.has_color_source && !paint_.has_color_filter &&
+         !paint_.has_path_effect && !paint_.has_mask_filter &&
+         !paint_.has_image_filter;
+}
+
+void DlBackdropKeyCollector::CombineClip(uint64_t clip_hash) {
+  auto& state = save_stack_.back();
+  HashCombineSeed(state.clip_hash, clip_hash, HashMatrix());
+}
+
+void DlBackdropKeyCollector::AddRecord(SkRect local_bounds,
+                                       std::optional<uint64_t> hash,
+                                       bool uses_paint) {
+  if (uses_paint && paint_.style != flutter::DlDrawStyle::kFill) {
+    // Conservatively account for miters and hairlines.
+    auto outset = std::max(paint_.stroke_width, 1.0f) *
+                  std::max(paint_.stroke_miter, 1.0f);
+    local_bounds.outset(outset, outset);
+  }
+  SkRect device_bounds = local_bounds;
+  tracker_.mapRect(&device_bounds);
+  // Account for anti-aliasing fringes.
+  device_bounds.outset(1.0f, 1.0f);
+  if (!device_bounds.intersect(tracker_.device_cull_rect())) {
+    return;
+  }
+
+  const auto& state = save_stack_.back();
+  if (hash.has_value() && state.layer_is_identifiable &&
+      (!uses_paint || PaintIsIdentifiable())) {
+    HashCombineSeed(hash.value(), HashMatrix(), state.clip_hash,
+                    state.layer_hash);
+    if (uses_paint) {
+      HashCombineSeed(hash.value(), HashPaint());
+    }
+  } else {
+    hash = std::nullopt;
+  }
+  records_.push_back({device_bounds, hash});
+}
+
+void DlBackdropKeyCollector::AddUnboundedRecord(std::optional<uint64_t> hash,
+                                                bool uses_paint) {
+  const auto& state = save_stack_.back();
+  if (hash.has_value() && state.layer_is_identifiable &&
+      (!uses_paint || PaintIsIdentifiable())) {
+    HashCombineSeed(hash.value(), HashMatrix(), state.clip_hash,
+                    state.layer_hash);
+    if (uses_paint) {
+      HashCombineSeed(hash.value(), HashPaint());
+    }
+  } else {
+    hash = std::nullopt;
+  }
+  auto device_bounds = tracker_.device_cull_rect();
+  if (device_bounds.isEmpty()) {
+    return;
+  }
+  records_.push_back({device_bounds, hash});
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setAntiAlias(bool aa) {
+  paint_.anti_alias = aa;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setDither(bool dither) {
+  paint_.dither = dither;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setDrawStyle(flutter::DlDrawStyle style) {
+  paint_.style = style;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setColor(flutter::DlColor color) {
+  paint_.color = color.argb;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setStrokeWidth(SkScalar width) {
+  paint_.stroke_width = width;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setStrokeMiter(SkScalar limit) {
+  paint_.stroke_miter = limit;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setStrokeCap(flutter::DlStrokeCap cap) {
+  paint_.stroke_cap = cap;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setStrokeJoin(flutter::DlStrokeJoin join) {
+  paint_.stroke_join = join;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setColorSource(
+    const flutter::DlColorSource* source) {
+  paint_.has_color_source = source != nullptr;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setColorFilter(
+    const flutter::DlColorFilter* filter) {
+  paint_.has_color_filter = filter != nullptr;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setInvertColors(bool invert) {
+  paint_.invert_colors = invert;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setBlendMode(flutter::DlBlendMode mode) {
+  paint_.blend_mode = mode;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setPathEffect(
+    const flutter::DlPathEffect* effect) {
+  paint_.has_path_effect = effect != nullptr;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setMaskFilter(
+    const flutter::DlMaskFilter* filter) {
+  paint_.has_mask_filter = filter != nullptr;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::setImageFilter(
+    const flutter::DlImageFilter* filter) {
+  paint_.has_image_filter = filter != nullptr;
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::save() {
+  tracker_.save();
+  save_stack_.push_back(save_stack_.back());
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::saveLayer(const SkRect* bounds,
+                                       const flutter::SaveLayerOptions options,
+                                       const flutter::DlImageFilter* backdrop) {
+  auto state = save_stack_.back();
+  const bool uses_paint = options.renders_with_attributes();
+
+  if (uses_paint && paint_.has_image_filter) {
+    // The layer filter may move its contents anywhere within the clip.
+    AddUnboundedRecord(std::nullopt, false);
+  }
+
+  HashCombineSeed(state.layer_hash, OpType::kSaveLayer, HashMatrix(),
+                  state.clip_hash, bounds ? HashRect(*bounds) : 0u);
+  if (uses_paint) {
+    HashCombineSeed(state.layer_hash, HashPaint());
+    state.layer_is_identifiable &= PaintIsIdentifiable();
+  }
+
+  if (backdrop) {
+    Key key;
+    const auto* blur = backdrop->asBlur();
+    if (blur && state.layer_is_identifiable) {
+      // The region of the parent pass the filter reads from.
+      auto roi = tracker_.device_cull_rect().roundOut();
+      SkIRect input_bounds;
+      SkRect read_bounds = tracker_.base_device_cull_rect();
+      if (backdrop->get_input_device_bounds(roi, tracker_.matrix_3x3(),
+                                            input_bounds)) {
+        read_bounds = SkRect::Make(input_bounds);
+      }
+
+      uint64_t hash = HashCombine(OpType::kBackdrop, blur->sigma_x(),
+                                  blur->sigma_y(), blur->tile_mode(),
+                                  HashMatrix(), state.clip_hash,
+                                  state.layer_hash, HashRect(read_bounds));
+      bool identifiable = true;
+      for (const auto& record : records_) {
+        if (!record.bounds.intersects(read_bounds)) {
+          continue;
+        }
+        if (!record.hash.has_value()) {
+          identifiable = false;
+          break;
+        }
+        HashCombineSeed(hash, record.hash.value());
+      }
+      if (identifiable) {
+        key = hash;
+      }
+    }
+    keys_.push_back(key);
+
+    // The filtered backdrop replaces the content under the clip and is itself
+    // read by any backdrop filter that follows.
+    AddUnboundedRecord(key, false);
+    if (key.has_value()) {
+      HashCombineSeed(state.layer_hash, key.value());
+    } else {
+      state.layer_is_identifiable = false;
+    }
+  }
+
+  tracker_.save();
+  save_stack_.push_back(state);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::restore() {
+  if (save_stack_.size() <= 1u) {
+    return;
+  }
+  tracker_.restore();
+  save_stack_.pop_back();
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::translate(SkScalar tx, SkScalar ty) {
+  tracker_.translate(tx, ty);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::scale(SkScalar sx, SkScalar sy) {
+  tracker_.scale(sx, sy);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::rotate(SkScalar degrees) {
+  tracker_.rotate(degrees);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::skew(SkScalar sx, SkScalar sy) {
+  tracker_.skew(sx, sy);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::transform2DAffine(SkScalar mxx,
+                                               SkScalar mxy,
+                                               SkScalar mxt,
+                                               SkScalar myx,
+                                               SkScalar myy,
+                                               SkScalar myt) {
+  tracker_.transform2DAffine(mxx, mxy, mxt, myx, myy, myt);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::transformFullPerspective(SkScalar mxx,
+                                                      SkScalar mxy,
+                                                      SkScalar mxz,
+                                                      SkScalar mxt,
+                                                      SkScalar myx,
+                                                      SkScalar myy,
+                                                      SkScalar myz,
+                                                      SkScalar myt,
+                                                      SkScalar mzx,
+                                                      SkScalar mzy,
+                                                      SkScalar mzz,
+                                                      SkScalar mzt,
+                                                      SkScalar mwx,
+                                                      SkScalar mwy,
+                                                      SkScalar mwz,
+                                                      SkScalar mwt) {
+  tracker_.transformFullPerspective(mxx, mxy, mxz, mxt,  //
+                                    myx, myy, myz, myt,  //
+                                    mzx, mzy, mzz, mzt,  //
+                                    mwx, mwy, mwz, mwt);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::transformReset() {
+  tracker_.setIdentity();
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::clipRect(const SkRect& rect,
+                                      ClipOp clip_op,
+                                      bool is_aa) {
+  tracker_.clipRect(rect, clip_op, is_aa);
+  CombineClip(HashCombine(OpType::kClipRect, HashRect(rect), clip_op, is_aa));
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::clipRRect(const SkRRect& rrect,
+                                       ClipOp clip_op,
+                                       bool is_aa) {
+  tracker_.clipRRect(rrect, clip_op, is_aa);
+  CombineClip(
+      HashCombine(OpType::kClipRRect, HashRRect(rrect), clip_op, is_aa));
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::clipPath(const SkPath& path,
+                                      ClipOp clip_op,
+                                      bool is_aa) {
+  tracker_.clipPath(path, clip_op, is_aa);
+  CombineClip(HashCombine(OpType::kClipPath, HashPath(path), clip_op, is_aa));
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawColor(flutter::DlColor color,
+                                       flutter::DlBlendMode mode) {
+  AddUnboundedRecord(HashCombine(OpType::kDrawColor, color.argb, mode), false);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawPaint() {
+  AddUnboundedRecord(HashCombine(OpType::kDrawPaint), true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawLine(const SkPoint& p0, const SkPoint& p1) {
+  auto bounds = SkRect::MakeLTRB(p0.fX, p0.fY, p1.fX, p1.fY).makeSorted();
+  AddRecord(bounds, HashCombine(OpType::kDrawLine, p0.fX, p0.fY, p1.fX, p1.fY),
+            true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawRect(const SkRect& rect) {
+  AddRecord(rect.makeSorted(), HashCombine(OpType::kDrawRect, HashRect(rect)),
+            true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawOval(const SkRect& bounds) {
+  AddRecord(bounds.makeSorted(),
+            HashCombine(OpType::kDrawOval, HashRect(bounds)), true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawCircle(const SkPoint& center,
+                                        SkScalar radius) {
+  auto bounds = SkRect::MakeLTRB(center.fX - radius, center.fY - radius,
+                                 center.fX + radius, center.fY + radius);
+  AddRecord(bounds,
+            HashCombine(OpType::kDrawCircle, center.fX, center.fY, radius),
+            true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawRRect(const SkRRect& rrect) {
+  AddRecord(rrect.getBounds(),
+            HashCombine(OpType::kDrawRRect, HashRRect(rrect)), true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawDRRect(const SkRRect& outer,
+                                        const SkRRect& inner) {
+  AddRecord(outer.getBounds(),
+            HashCombine(OpType::kDrawDRRect, HashRRect(outer), HashRRect(inner)),
+            true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawPath(const SkPath& path) {
+  auto hash = HashCombine(OpType::kDrawPath, HashPath(path));
+  if (path.isInverseFillType()) {
+    AddUnboundedRecord(hash, true);
+    return;
+  }
+  AddRecord(path.getBounds(), hash, true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawArc(const SkRect& oval_bounds,
+                                     SkScalar start_degrees,
+                                     SkScalar sweep_degrees,
+                                     bool use_center) {
+  AddRecord(oval_bounds.makeSorted(),
+            HashCombine(OpType::kDrawArc, HashRect(oval_bounds),
+                        start_degrees, sweep_degrees, use_center),
+            true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawPoints(PointMode mode,
+                                        uint32_t count,
+                                        const SkPoint points[]) {
+  if (count == 0u) {
+    return;
+  }
+  SkRect bounds;
+  bounds.setBounds(points, count);
+  uint64_t hash = HashCombine(OpType::kDrawPoints, mode, count);
+  for (uint32_t i = 0; i < count; i++) {
+    HashCombineSeed(hash, points[i].fX, points[i].fY);
+  }
+  AddRecord(bounds, hash, true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawVertices(const flutter::DlVertices* vertices,
+                                          flutter::DlBlendMode dl_mode) {
+  AddRecord(vertices->bounds(), std::nullopt, true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawImage(const sk_sp<flutter::DlImage> image,
+                                       const SkPoint point,
+                                       flutter::DlImageSampling sampling,
+                                       bool render_with_attributes) {
+  auto bounds = SkRect::Make(image->bounds()).makeOffset(point.fX, point.fY);
+  AddRecord(bounds, std::nullopt, render_with_attributes);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawImageRect(
+    const sk_sp<flutter::DlImage> image,
+    const SkRect& src,
+    const SkRect& dst,
+    flutter::DlImageSampling sampling,
+    bool render_with_attributes,
+    SrcRectConstraint constraint) {
+  AddRecord(dst.makeSorted(), std::nullopt, render_with_attributes);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawImageNine(const sk_sp<flutter::DlImage> image,
+                                           const SkIRect& center,
+                                           const SkRect& dst,
+                                           flutter::DlFilterMode filter,
+                                           bool render_with_attributes) {
+  AddRecord(dst.makeSorted(), std::nullopt, render_with_attributes);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawAtlas(const sk_sp<flutter::DlImage> atlas,
+                                       const SkRSXform xform[],
+                                       const SkRect tex[],
+                                       const flutter::DlColor colors[],
+                                       int count,
+                                       flutter::DlBlendMode mode,
+                                       flutter::DlImageSampling sampling,
+                                       const SkRect* cull_rect,
+                                       bool render_with_attributes) {
+  if (cull_rect) {
+    AddRecord(*cull_rect, std::nullopt, render_with_attributes);
+    return;
+  }
+  AddUnboundedRecord(std::nullopt, render_with_attributes);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawDisplayList(
+    const sk_sp<flutter::DisplayList> display_list,
+    SkScalar opacity) {
+  AddRecord(display_list->bounds(),
+            HashCombine(OpType::kDrawDisplayList, display_list->unique_id(),
+                        opacity),
+            false);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawTextBlob(const sk_sp<SkTextBlob> blob,
+                                          SkScalar x,
+                                          SkScalar y) {
+  AddRecord(blob->bounds().makeOffset(x, y),
+            HashCombine(OpType::kDrawTextBlob, blob->uniqueID(), x, y),
+            true);
+}
+
+// |flutter::DlOpReceiver|
+void DlBackdropKeyCollector::drawShadow(const SkPath& path,
+                                        const flutter::DlColor color,
+                                        const SkScalar elevation,
+                                        bool transparent_occluder,
+                                        SkScalar dpr) {
+  AddUnboundedRecord(
+      HashCombine(OpType::kDrawShadow, HashPath(path), color.argb, elevation,
+                  transparent_occluder, dpr),
+      false);
+}
+
+}  // namespace impeller
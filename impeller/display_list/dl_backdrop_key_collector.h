@@ -0,0 +1,312 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/display_list/utils/dl_matrix_clip_tracker.h"
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Computes a key for every backdrop filter save layer of a
+///             display list that identifies both the filter and the content
+///             the filter reads.
+///
+///             Two frames that produce the same key for a backdrop filter
+///             render identical backdrops, so the filtered result of the
+///             earlier frame can be reused by the later one.
+///
+///             Only draws whose device space bounds intersect the region read
+///             by the filter contribute to its key, so changes elsewhere in
+///             the frame leave the key intact. Nested display lists are
+///             identified by their unique id and are not traversed; backdrop
+///             filters inside of them are not keyed.
+///
+///             A backdrop filter gets no key when its content can't be
+///             identified across frames: images, vertices, draws with shader,
+///             filter or path effect attributes, layers with such attributes,
+///             and filters other than blurs.
+///
+class DlBackdropKeyCollector final : public flutter::DlOpReceiver {
+ public:
+  using Key = std::optional<uint64_t>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collect the keys of the backdrop filter save layers of the
+  ///             display list, in the order they are dispatched.
+  ///
+  static std::vector<Key> Collect(const flutter::DisplayList& display_list,
+                                  const SkRect& cull_rect);
+
+  explicit DlBackdropKeyCollector(const SkRect& cull_rect);
+
+  ~DlBackdropKeyCollector();
+
+  const std::vector<Key>& GetKeys() const;
+
+  // |flutter::DlOpReceiver|
+  void setAntiAlias(bool aa) override;
+
+  // |flutter::DlOpReceiver|
+  void setDither(bool dither) override;
+
+  // |flutter::DlOpReceiver|
+  void setDrawStyle(flutter::DlDrawStyle style) override;
+
+  // |flutter::DlOpReceiver|
+  void setColor(flutter::DlColor color) override;
+
+  // |flutter::DlOpReceiver|
+  void setStrokeWidth(SkScalar width) override;
+
+  // |flutter::DlOpReceiver|
+  void setStrokeMiter(SkScalar limit) override;
+
+  // |flutter::DlOpReceiver|
+  void setStrokeCap(flutter::DlStrokeCap cap) override;
+
+  // |flutter::DlOpReceiver|
+  void setStrokeJoin(flutter::DlStrokeJoin join) override;
+
+  // |flutter::DlOpReceiver|
+  void setColorSource(const flutter::DlColorSource* source) override;
+
+  // |flutter::DlOpReceiver|
+  void setColorFilter(const flutter::DlColorFilter* filter) override;
+
+  // |flutter::DlOpReceiver|
+  void setInvertColors(bool invert) override;
+
+  // |flutter::DlOpReceiver|
+  void setBlendMode(flutter::DlBlendMode mode) override;
+
+  // |flutter::DlOpReceiver|
+  void setPathEffect(const flutter::DlPathEffect* effect) override;
+
+  // |flutter::DlOpReceiver|
+  void setMaskFilter(const flutter::DlMaskFilter* filter) override;
+
+  // |flutter::DlOpReceiver|
+  void setImageFilter(const flutter::DlImageFilter* filter) override;
+
+  // |flutter::DlOpReceiver|
+  void save() override;
+
+  // |flutter::DlOpReceiver|
+  void saveLayer(const SkRect* bounds,
+                 const flutter::SaveLayerOptions options,
+                 const flutter::DlImageFilter* backdrop) override;
+
+  // |flutter::DlOpReceiver|
+  void restore() override;
+
+  // |flutter::DlOpReceiver|
+  void translate(SkScalar tx, SkScalar ty) override;
+
+  // |flutter::DlOpReceiver|
+  void scale(SkScalar sx, SkScalar sy) override;
+
+  // |flutter::DlOpReceiver|
+  void rotate(SkScalar degrees) override;
+
+  // |flutter::DlOpReceiver|
+  void skew(SkScalar sx, SkScalar sy) override;
+
+  // |flutter::DlOpReceiver|
+  void transform2DAffine(SkScalar mxx,
+                         SkScalar mxy,
+                         SkScalar mxt,
+                         SkScalar myx,
+                         SkScalar myy,
+                         SkScalar myt) override;
+
+  // |flutter::DlOpReceiver|
+  void transformFullPerspective(SkScalar mxx,
+                                SkScalar mxy,
+                                SkScalar mxz,
+                                SkScalar mxt,
+                                SkScalar myx,
+                                SkScalar myy,
+                                SkScalar myz,
+                                SkScalar myt,
+                                SkScalar mzx,
+                                SkScalar mzy,
+                                SkScalar mzz,
+                                SkScalar mzt,
+                                SkScalar mwx,
+                                SkScalar mwy,
+                                SkScalar mwz,
+                                SkScalar mwt) override;
+
+  // |flutter::DlOpReceiver|
+  void transformReset() override;
+
+  // |flutter::DlOpReceiver|
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override;
+
+  // |flutter::DlOpReceiver|
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override;
+
+  // |flutter::DlOpReceiver|
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override;
+
+  // |flutter::DlOpReceiver|
+  void drawColor(flutter::DlColor color, flutter::DlBlendMode mode) override;
+
+  // |flutter::DlOpReceiver|
+  void drawPaint() override;
+
+  // |flutter::DlOpReceiver|
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override;
+
+  // |flutter::DlOpReceiver|
+  void drawRect(const SkRect& rect) override;
+
+  // |flutter::DlOpReceiver|
+  void drawOval(const SkRect& bounds) override;
+
+  // |flutter::DlOpReceiver|
+  void drawCircle(const SkPoint& center, SkScalar radius) override;
+
+  // |flutter::DlOpReceiver|
+  void drawRRect(const SkRRect& rrect) override;
+
+  // |flutter::DlOpReceiver|
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override;
+
+  // |flutter::DlOpReceiver|
+  void drawPath(const SkPath& path) override;
+
+  // |flutter::DlOpReceiver|
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override;
+
+  // |flutter::DlOpReceiver|
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override;
+
+  // |flutter::DlOpReceiver|
+  void drawVertices(const flutter::DlVertices* vertices,
+                    flutter::DlBlendMode dl_mode) override;
+
+  // |flutter::DlOpReceiver|
+  void drawImage(const sk_sp<flutter::DlImage> image,
+                 const SkPoint point,
+                 flutter::DlImageSampling sampling,
+                 bool render_with_attributes) override;
+
+  // |flutter::DlOpReceiver|
+  void drawImageRect(const sk_sp<flutter::DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     flutter::DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override;
+
+  // |flutter::DlOpReceiver|
+  void drawImageNine(const sk_sp<flutter::DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     flutter::DlFilterMode filter,
+                     bool render_with_attributes) override;
+
+  // |flutter::DlOpReceiver|
+  void drawAtlas(const sk_sp<flutter::DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const flutter::DlColor colors[],
+                 int count,
+                 flutter::DlBlendMode mode,
+                 flutter::DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override;
+
+  // |flutter::DlOpReceiver|
+  void drawDisplayList(const sk_sp<flutter::DisplayList> display_list,
+                       SkScalar opacity) override;
+
+  // |flutter::DlOpReceiver|
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override;
+
+  // |flutter::DlOpReceiver|
+  void drawShadow(const SkPath& path,
+                  const flutter::DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override;
+
+ private:
+  /// Something drawn into the frame, in device space.
+  struct Record {
+    SkRect bounds;
+    /// Identifies what was drawn. Absent if it can't be identified across
+    /// frames.
+    std::optional<uint64_t> hash;
+  };
+
+  /// The state shared by everything drawn between a save and its restore.
+  struct SaveState {
+    uint64_t clip_hash = 0u;
+    uint64_t layer_hash = 0u;
+    bool layer_is_identifiable = true;
+  };
+
+  /// The paint attributes that can be identified by value.
+  struct PaintState {
+    bool anti_alias = false;
+    bool dither = false;
+    flutter::DlDrawStyle style = flutter::DlDrawStyle::kFill;
+    uint32_t color = 0xFF000000;
+    SkScalar stroke_width = 0.0;
+    SkScalar stroke_miter = 4.0;
+    flutter::DlStrokeCap stroke_cap = flutter::DlStrokeCap::kButt;
+    flutter::DlStrokeJoin stroke_join = flutter::DlStrokeJoin::kMiter;
+    bool invert_colors = false;
+    flutter::DlBlendMode blend_mode = flutter::DlBlendMode::kSrcOver;
+    bool has_color_source = false;
+    bool has_color_filter = false;
+    bool has_path_effect = false;
+    bool has_mask_filter = false;
+    bool has_image_filter = false;
+  };
+
+  flutter::DisplayListMatrixClipTracker tracker_;
+  std::vector<SaveState> save_stack_;
+  PaintState paint_;
+  std::vector<Record> records_;
+  std::vector<Key> keys_;
+
+  uint64_t HashPaint() const;
+
+  uint64_t HashMatrix() const;
+
+  bool PaintIsIdentifiable() const;
+
+  void CombineClip(uint64_t clip_hash);
+
+  /// Record a draw of the given local bounds. Pass no hash for draws that
+  /// can't be identified across frames.
+  void AddRecord(SkRect local_bounds,
+                 std::optional<uint64_t> hash,
+                 bool uses_paint);
+
+  /// Record a draw that may touch any pixel within the current clip.
+  void AddUnboundedRecord(std::optional<uint64_t> hash, bool uses_paint);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DlBackdropKeyCollector);
+};
+
+}  // namespace impeller
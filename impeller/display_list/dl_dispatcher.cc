@@ -710,8 +710,15 @@ void DlDispatcher::saveLayer(const SkRect* bounds,
                              const flutter::SaveLayerOptions options,
                              const flutter::DlImageFilter* backdrop) {
   auto paint = options.renders_with_attributes() ? paint_ : Paint{};
+  std::optional<uint64_t> backdrop_content_key;
+  if (backdrop && display_list_depth_ == 0u) {
+    if (backdrop_count_ < backdrop_content_keys_.size()) {
+      backdrop_content_key = backdrop_content_keys_[backdrop_count_];
+    }
+    backdrop_count_++;
+  }
   canvas_.SaveLayer(paint, skia_conversions::ToRect(bounds),
-                    ToImageFilterProc(backdrop));
+                    ToImageFilterProc(backdrop), backdrop_content_key);
 }
 
 // |flutter::DlOpReceiver|
@@ -1062,6 +1069,7 @@ void DlDispatcher::drawDisplayList(
   // values are reset to defaults.
   initial_matrix_ = canvas_.GetCurrentTransformation();
   paint_ = Paint();
+  display_list_depth_++;
 
   // Handle passed opacity in the most brute-force way by using
   // a SaveLayer. If the display_list is able to inherit the
@@ -1098,6 +1106,7 @@ void DlDispatcher::drawDisplayList(
   canvas_.RestoreToCount(restore_count);
   initial_matrix_ = saved_initial_matrix;
   paint_ = saved_paint;
+  display_list_depth_--;
 }
 
 // |flutter::DlOpReceiver|
@@ -1183,6 +1192,12 @@ void DlDispatcher::drawShadow(const SkPath& path,
   canvas_.Restore();
 }
 
+void DlDispatcher::SetBackdropContentKeys(
+    std::vector<std::optional<uint64_t>> keys) {
+  backdrop_content_keys_ = std::move(keys);
+  backdrop_count_ = 0u;
+}
+
 Picture DlDispatcher::EndRecordingAsPicture() {
   TRACE_EVENT0("impeller", "DisplayListDispatcher::EndRecordingAsPicture");
   return canvas_.EndRecordingAsPicture();
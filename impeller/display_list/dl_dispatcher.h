@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 #include "flutter/display_list/dl_op_receiver.h"
 #include "flutter/fml/macros.h"
 #include "impeller/aiks/canvas.h"
@@ -23,6 +27,14 @@ class DlDispatcher final : public flutter::DlOpReceiver {
 
   Picture EndRecordingAsPicture();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set the content keys of the backdrop filter save layers of
+  ///             the display list about to be dispatched, as computed by
+  ///             `DlBackdropKeyCollector` with the same cull rect. Keyed
+  ///             backdrop filters may reuse their results across frames.
+  ///
+  void SetBackdropContentKeys(std::vector<std::optional<uint64_t>> keys);
+
   // |flutter::DlOpReceiver|
   void setAntiAlias(bool aa) override;
 
@@ -223,6 +235,11 @@ class DlDispatcher final : public flutter::DlOpReceiver {
   Paint paint_;
   Canvas canvas_;
   Matrix initial_matrix_;
+  std::vector<std::optional<uint64_t>> backdrop_content_keys_;
+  size_t backdrop_count_ = 0u;
+  /// The number of nested display lists being dispatched. Keys only apply to
+  /// the outermost display list.
+  size_t display_list_depth_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(DlDispatcher);
 };
@@ -18,6 +18,7 @@
 #include "flutter/display_list/effects/dl_mask_filter.h"
 #include "flutter/testing/testing.h"
 #include "gtest/gtest.h"
+#include "impeller/display_list/dl_backdrop_key_collector.h"
 #include "impeller/display_list/dl_dispatcher.h"
 #include "impeller/display_list/dl_image_impeller.h"
 #include "impeller/display_list/dl_playground.h"
@@ -1587,5 +1588,87 @@ TEST_P(DisplayListTest, SceneColorSource) {
 }
 #endif
 
+static sk_sp<flutter::DisplayList> MakeBackdropScene(
+    const sk_sp<flutter::DisplayList>& under_blur,
+    const sk_sp<flutter::DisplayList>& beside_blur) {
+  flutter::DisplayListBuilder builder;
+  builder.DrawDisplayList(under_blur);
+  builder.Save();
+  builder.Translate(500, 0);
+  builder.DrawDisplayList(beside_blur);
+  builder.Restore();
+
+  auto filter = flutter::DlBlurImageFilter(5, 5, flutter::DlTileMode::kClamp);
+  builder.Save();
+  builder.ClipRect(SkRect::MakeLTRB(0, 0, 100, 100));
+  builder.SaveLayer(nullptr, nullptr, &filter);
+  builder.Restore();
+  builder.Restore();
+  return builder.Build();
+}
+
+static sk_sp<flutter::DisplayList> MakeSquare(flutter::DlColor color) {
+  flutter::DisplayListBuilder builder;
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 100, 100),
+                   flutter::DlPaint().setColor(color));
+  return builder.Build();
+}
+
+TEST(DisplayListBackdropKeyTest, KeysOnlyChangeWithContentUnderTheFilter) {
+  const auto cull_rect = SkRect::MakeWH(1000, 1000);
+  auto under = MakeSquare(flutter::DlColor::kRed());
+  auto beside = MakeSquare(flutter::DlColor::kGreen());
+
+  auto keys = DlBackdropKeyCollector::Collect(*MakeBackdropScene(under, beside),
+                                              cull_rect);
+  ASSERT_EQ(keys.size(), 1u);
+  ASSERT_TRUE(keys[0].has_value());
+
+  // Rebuilding the frame from the same content yields the same key.
+  auto same_keys = DlBackdropKeyCollector::Collect(
+      *MakeBackdropScene(under, beside), cull_rect);
+  ASSERT_EQ(same_keys.size(), 1u);
+  EXPECT_EQ(same_keys[0], keys[0]);
+
+  // Content far from the blurred region doesn't affect it.
+  auto moved_keys = DlBackdropKeyCollector::Collect(
+      *MakeBackdropScene(under, MakeSquare(flutter::DlColor::kBlue())),
+      cull_rect);
+  ASSERT_EQ(moved_keys.size(), 1u);
+  EXPECT_EQ(moved_keys[0], keys[0]);
+
+  // Content under the blurred region does.
+  auto changed_keys = DlBackdropKeyCollector::Collect(
+      *MakeBackdropScene(MakeSquare(flutter::DlColor::kBlue()), beside),
+      cull_rect);
+  ASSERT_EQ(changed_keys.size(), 1u);
+  ASSERT_TRUE(changed_keys[0].has_value());
+  EXPECT_NE(changed_keys[0], keys[0]);
+}
+
+TEST(DisplayListBackdropKeyTest, UnidentifiableContentIsNotKeyed) {
+  flutter::DisplayListBuilder builder;
+  auto color_filter = flutter::DlBlendColorFilter(
+      flutter::DlColor::kBlue(), flutter::DlBlendMode::kModulate);
+  builder.DrawRect(SkRect::MakeLTRB(0, 0, 100, 100),
+                   flutter::DlPaint().setColorFilter(&color_filter));
+  auto blur = flutter::DlBlurImageFilter(5, 5, flutter::DlTileMode::kClamp);
+  builder.SaveLayer(nullptr, nullptr, &blur);
+  builder.Restore();
+  auto matrix = flutter::DlMatrixImageFilter(SkMatrix::Translate(10, 10),
+                                             flutter::DlImageSampling::kLinear);
+  builder.DrawRect(SkRect::MakeLTRB(800, 800, 900, 900), flutter::DlPaint());
+  builder.SaveLayer(nullptr, nullptr, &matrix);
+  builder.Restore();
+
+  auto keys = DlBackdropKeyCollector::Collect(*builder.Build(),
+                                              SkRect::MakeWH(1000, 1000));
+  ASSERT_EQ(keys.size(), 2u);
+  // The color filtered draw can't be identified across frames.
+  EXPECT_FALSE(keys[0].has_value());
+  // Only blurs are keyed.
+  EXPECT_FALSE(keys[1].has_value());
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -51,6 +51,12 @@ void ColorSourceContents::SetInheritedOpacity(Scalar opacity) {
   inherited_opacity_ = opacity;
 }
 
+bool ColorSourceContents::OccludesArea(const Entity& entity,
+                                       const Rect& rect) const {
+  return geometry_ != nullptr && IsOpaque() &&
+         geometry_->CoversArea(entity.GetTransformation(), rect);
+}
+
 bool ColorSourceContents::ShouldRender(
     const Entity& entity,
     const std::optional<Rect>& stencil_coverage) const {
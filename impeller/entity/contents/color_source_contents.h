@@ -39,6 +39,9 @@ class ColorSourceContents : public Contents {
   // |Contents|
   void SetInheritedOpacity(Scalar opacity) override;
 
+  // |Contents|
+  bool OccludesArea(const Entity& entity, const Rect& rect) const override;
+
   Scalar GetOpacity() const;
 
   const std::shared_ptr<Geometry>& GetGeometry() const;
@@ -163,7 +163,11 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
       tessellator_(std::make_shared<Tessellator>()),
       alpha_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
       color_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
-      scene_context_(std::make_shared<scene::SceneContext>(context_)) {
+      sdf_glyph_atlas_context_(std::make_shared<GlyphAtlasContext>()),
+      scene_context_(std::make_shared<scene::SceneContext>(context_)),
+      render_target_cache_(std::make_shared<RenderTargetCache>(
+          context_ ? context_->GetResourceAllocator() : nullptr)),
+      filter_result_cache_(std::make_shared<FilterResultCache>()) {
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -296,6 +300,8 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
       CreateDefaultPipeline<GlyphAtlasPipeline>(*context_);
   glyph_atlas_color_pipelines_[default_options_] =
       CreateDefaultPipeline<GlyphAtlasColorPipeline>(*context_);
+  glyph_atlas_sdf_pipelines_[default_options_] =
+      CreateDefaultPipeline<GlyphAtlasSdfPipeline>(*context_);
   geometry_color_pipelines_[default_options_] =
       CreateDefaultPipeline<GeometryColorPipeline>(*context_);
   yuv_to_rgb_filter_pipelines_[default_options_] =
@@ -335,9 +341,80 @@ ContentContext::ContentContext(std::shared_ptr<Context> context)
     return;
   }
 
+  RegisterAllVariants();
   is_valid_ = true;
 }
 
+void ContentContext::RegisterAllVariants() {
+// Variants are recorded under the name of their container since pipelines
+// like PositionUV and TiledTexture share a label.
+#define REGISTER_VARIANTS(pipelines) RegisterVariants(#pipelines, pipelines)
+#ifdef IMPELLER_DEBUG
+  REGISTER_VARIANTS(checkerboard_pipelines_);
+#endif  // IMPELLER_DEBUG
+  REGISTER_VARIANTS(solid_fill_pipelines_);
+  REGISTER_VARIANTS(linear_gradient_fill_pipelines_);
+  REGISTER_VARIANTS(radial_gradient_fill_pipelines_);
+  REGISTER_VARIANTS(conical_gradient_fill_pipelines_);
+  REGISTER_VARIANTS(sweep_gradient_fill_pipelines_);
+  REGISTER_VARIANTS(linear_gradient_ssbo_fill_pipelines_);
+  REGISTER_VARIANTS(radial_gradient_ssbo_fill_pipelines_);
+  REGISTER_VARIANTS(conical_gradient_ssbo_fill_pipelines_);
+  REGISTER_VARIANTS(sweep_gradient_ssbo_fill_pipelines_);
+  REGISTER_VARIANTS(rrect_blur_pipelines_);
+  REGISTER_VARIANTS(texture_blend_pipelines_);
+  REGISTER_VARIANTS(texture_pipelines_);
+  REGISTER_VARIANTS(position_uv_pipelines_);
+  REGISTER_VARIANTS(tiled_texture_pipelines_);
+  REGISTER_VARIANTS(gaussian_blur_alpha_decal_pipelines_);
+  REGISTER_VARIANTS(gaussian_blur_alpha_nodecal_pipelines_);
+  REGISTER_VARIANTS(gaussian_blur_noalpha_decal_pipelines_);
+  REGISTER_VARIANTS(gaussian_blur_noalpha_nodecal_pipelines_);
+  REGISTER_VARIANTS(border_mask_blur_pipelines_);
+  REGISTER_VARIANTS(morphology_filter_pipelines_);
+  REGISTER_VARIANTS(color_matrix_color_filter_pipelines_);
+  REGISTER_VARIANTS(linear_to_srgb_filter_pipelines_);
+  REGISTER_VARIANTS(srgb_to_linear_filter_pipelines_);
+  REGISTER_VARIANTS(clip_pipelines_);
+  REGISTER_VARIANTS(glyph_atlas_pipelines_);
+  REGISTER_VARIANTS(glyph_atlas_color_pipelines_);
+  REGISTER_VARIANTS(glyph_atlas_sdf_pipelines_);
+  REGISTER_VARIANTS(geometry_color_pipelines_);
+  REGISTER_VARIANTS(yuv_to_rgb_filter_pipelines_);
+  REGISTER_VARIANTS(porter_duff_blend_pipelines_);
+  REGISTER_VARIANTS(blend_color_pipelines_);
+  REGISTER_VARIANTS(blend_colorburn_pipelines_);
+  REGISTER_VARIANTS(blend_colordodge_pipelines_);
+  REGISTER_VARIANTS(blend_darken_pipelines_);
+  REGISTER_VARIANTS(blend_difference_pipelines_);
+  REGISTER_VARIANTS(blend_exclusion_pipelines_);
+  REGISTER_VARIANTS(blend_hardlight_pipelines_);
+  REGISTER_VARIANTS(blend_hue_pipelines_);
+  REGISTER_VARIANTS(blend_lighten_pipelines_);
+  REGISTER_VARIANTS(blend_luminosity_pipelines_);
+  REGISTER_VARIANTS(blend_multiply_pipelines_);
+  REGISTER_VARIANTS(blend_overlay_pipelines_);
+  REGISTER_VARIANTS(blend_saturation_pipelines_);
+  REGISTER_VARIANTS(blend_screen_pipelines_);
+  REGISTER_VARIANTS(blend_softlight_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_color_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_colorburn_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_colordodge_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_darken_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_difference_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_exclusion_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_hardlight_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_hue_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_lighten_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_luminosity_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_multiply_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_overlay_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_saturation_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_screen_pipelines_);
+  REGISTER_VARIANTS(framebuffer_blend_softlight_pipelines_);
+#undef REGISTER_VARIANTS
+}
+
 ContentContext::~ContentContext() = default;
 
 bool ContentContext::IsValid() const {
@@ -354,7 +431,8 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
   RenderTarget subpass_target;
   if (context->GetCapabilities()->SupportsOffscreenMSAA() && msaa_enabled) {
     subpass_target = RenderTarget::CreateOffscreenMSAA(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *render_target_cache_, texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfigMSAA  //
 #ifndef FML_OS_ANDROID  // Reduce PSO variants for Vulkan.
         ,
@@ -363,7 +441,8 @@ std::shared_ptr<Texture> ContentContext::MakeSubpass(
     );
   } else {
     subpass_target = RenderTarget::CreateOffscreen(
-        *context, texture_size, SPrintF("%s Offscreen", label.c_str()),
+        *context, *render_target_cache_, texture_size,
+        SPrintF("%s Offscreen", label.c_str()),
         RenderTarget::kDefaultColorAttachmentConfig  //
 #ifndef FML_OS_ANDROID  // Reduce PSO variants for Vulkan.
         ,
@@ -409,8 +488,15 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
 
 std::shared_ptr<GlyphAtlasContext> ContentContext::GetGlyphAtlasContext(
     GlyphAtlas::Type type) const {
-  return type == GlyphAtlas::Type::kAlphaBitmap ? alpha_glyph_atlas_context_
-                                                : color_glyph_atlas_context_;
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      return alpha_glyph_atlas_context_;
+    case GlyphAtlas::Type::kColorBitmap:
+      return color_glyph_atlas_context_;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return sdf_glyph_atlas_context_;
+  }
+  FML_UNREACHABLE();
 }
 
 std::shared_ptr<Context> ContentContext::GetContext() const {
@@ -425,4 +511,54 @@ void ContentContext::SetWireframe(bool wireframe) {
   wireframe_ = wireframe;
 }
 
+void ContentContext::SetAsyncPipelineCompilation(bool async) {
+  async_pipeline_compilation_ = async;
+}
+
+const std::vector<ContentContext::PipelineUsage>&
+ContentContext::GetPipelineUsage() const {
+  return pipeline_usage_;
+}
+
+size_t ContentContext::GetOnDemandVariantCount() const {
+  return on_demand_variant_count_;
+}
+
+void ContentContext::WarmUpPipelines(
+    const std::vector<PipelineUsage>& usage) const {
+  if (!IsValid()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "ContentContext::WarmUpPipelines");
+  for (const auto& [label, opts] : usage) {
+    auto found = variant_builders_.find(label);
+    if (found != variant_builders_.end()) {
+      found->second(opts);
+    }
+  }
+}
+
+const DrawBatcher::Stats& ContentContext::GetDrawBatchingStats() const {
+  return draw_batching_stats_;
+}
+
+void ContentContext::RecordDrawBatchingStats(const DrawBatcher::Stats& stats) {
+  draw_batching_stats_.draws_before_batching += stats.draws_before_batching;
+  draw_batching_stats_.draws_after_batching += stats.draws_after_batching;
+}
+
+void ContentContext::ResetDrawBatchingStats() {
+  draw_batching_stats_ = {};
+}
+
+const std::shared_ptr<RenderTargetCache>&
+ContentContext::GetRenderTargetCache() const {
+  return render_target_cache_;
+}
+
+const std::shared_ptr<FilterResultCache>&
+ContentContext::GetFilterResultCache() const {
+  return filter_result_cache_;
+}
+
 }  // namespace impeller
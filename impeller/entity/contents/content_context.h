@@ -4,18 +4,27 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/core/formats.h"
+#include "impeller/entity/contents/filters/filter_result_cache.h"
+#include "impeller/entity/draw_batcher.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/renderer/capabilities.h"
 #include "impeller/renderer/pipeline.h"
+#include "impeller/renderer/pipeline_library.h"
 #include "impeller/scene/scene_context.h"
 
 #ifdef IMPELLER_DEBUG
@@ -33,6 +42,7 @@
 #include "impeller/entity/glyph_atlas.frag.h"
 #include "impeller/entity/glyph_atlas.vert.h"
 #include "impeller/entity/glyph_atlas_color.frag.h"
+#include "impeller/entity/glyph_atlas_sdf.frag.h"
 #include "impeller/entity/gradient_fill.vert.h"
 #include "impeller/entity/linear_gradient_fill.frag.h"
 #include "impeller/entity/linear_to_srgb_filter.frag.h"
@@ -175,6 +185,8 @@ using GlyphAtlasPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasFragmentShader>;
 using GlyphAtlasColorPipeline =
     RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasColorFragmentShader>;
+using GlyphAtlasSdfPipeline =
+    RenderPipelineT<GlyphAtlasVertexShader, GlyphAtlasSdfFragmentShader>;
 using PorterDuffBlendPipeline =
     RenderPipelineT<BlendVertexShader, PorterDuffBlendFragmentShader>;
 // Instead of requiring new shaders for clips, the solid fill stages are used
@@ -482,6 +494,11 @@ class ContentContext {
     return GetPipeline(glyph_atlas_color_pipelines_, opts);
   }
 
+  std::shared_ptr<Pipeline<PipelineDescriptor>> GetGlyphAtlasSdfPipeline(
+      ContentContextOptions opts) const {
+    return GetPipeline(glyph_atlas_sdf_pipelines_, opts);
+  }
+
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetGeometryColorPipeline(
       ContentContextOptions opts) const {
     return GetPipeline(geometry_color_pipelines_, opts);
@@ -686,6 +703,56 @@ class ContentContext {
 
   void SetWireframe(bool wireframe);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether `WarmUpPipelines` returns as soon as the variants
+  ///             started building on the worker threads instead of waiting
+  ///             for them to be built.
+  ///
+  ///             Draws always use the exact variant they need. A draw that
+  ///             needs a variant which is still being built waits for it.
+  ///
+  void SetAsyncPipelineCompilation(bool async);
+
+  /// A pipeline variant, identified by the name its pipeline is registered
+  /// under and its options.
+  using PipelineUsage = std::pair<std::string, ContentContextOptions>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The pipeline variants created so far, in creation order.
+  ///
+  const std::vector<PipelineUsage>& GetPipelineUsage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start building the given pipeline variants ahead of their
+  ///             first use, typically from a usage profile recorded by an
+  ///             earlier run. Variants of unknown pipelines are ignored.
+  ///
+  ///             Unless async pipeline compilation is enabled, this waits for
+  ///             the variants to be built.
+  ///
+  void WarmUpPipelines(const std::vector<PipelineUsage>& usage) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of pipeline variants that were first requested
+  ///             while rendering rather than created by a warm-up.
+  ///
+  size_t GetOnDemandVariantCount() const;
+
+  /// @brief  The draws issued by entity passes before and after merging
+  ///         compatible entities, accumulated since the last reset.
+  const DrawBatcher::Stats& GetDrawBatchingStats() const;
+
+  void RecordDrawBatchingStats(const DrawBatcher::Stats& stats);
+
+  void ResetDrawBatchingStats();
+
+  /// @brief  The allocator that recycles the textures of offscreen render
+  ///         targets created while rendering entity passes.
+  const std::shared_ptr<RenderTargetCache>& GetRenderTargetCache() const;
+
+  /// @brief  Filter results that can be reused by later frames.
+  const std::shared_ptr<FilterResultCache>& GetFilterResultCache() const;
+
   using SubpassCallback =
       std::function<bool(const ContentContext&, RenderPass&)>;
 
@@ -749,6 +816,7 @@ class ContentContext {
   mutable Variants<ClipPipeline> clip_pipelines_;
   mutable Variants<GlyphAtlasPipeline> glyph_atlas_pipelines_;
   mutable Variants<GlyphAtlasColorPipeline> glyph_atlas_color_pipelines_;
+  mutable Variants<GlyphAtlasSdfPipeline> glyph_atlas_sdf_pipelines_;
   mutable Variants<GeometryColorPipeline> geometry_color_pipelines_;
   mutable Variants<YUVToRGBFilterPipeline> yuv_to_rgb_filter_pipelines_;
   mutable Variants<PorterDuffBlendPipeline> porter_duff_blend_pipelines_;
@@ -822,38 +890,95 @@ class ContentContext {
       opts.wireframe = true;
     }
 
-    if (auto found = container.find(opts); found != container.end()) {
-      return found->second->WaitAndGet();
+    auto found = container.find(opts);
+    if (found == container.end()) {
+      on_demand_variant_count_++;
+      found = CreateVariant(container, opts);
+      if (found == container.end()) {
+        return nullptr;
+      }
     }
 
+    // Draws wait for the exact variant they need if it is still being built.
+    // Variants that differ in any option, including the blend mode, draw
+    // something else, and contents have no way to skip a draw and schedule
+    // another frame. Warming up the variants recorded in a usage profile
+    // keeps these waits out of the first frames.
+    return found->second->WaitAndGet();
+  }
+
+  template <class TypedPipeline>
+  typename Variants<TypedPipeline>::iterator CreateVariant(
+      Variants<TypedPipeline>& container,
+      ContentContextOptions opts) const {
     auto prototype = container.find(default_options_);
 
     // The prototype must always be initialized in the constructor.
     FML_CHECK(prototype != container.end());
 
-    auto pipeline = prototype->second->WaitAndGet();
-    if (!pipeline) {
-      return nullptr;
+    // Variants are created from the prototype's descriptor rather than from
+    // the prototype pipeline so that creating them never waits for the
+    // prototype to be built.
+    auto desc = prototype->second->GetDescriptor();
+    if (!desc.has_value()) {
+      return container.end();
     }
 
-    auto variant_future = pipeline->CreateVariant(
-        [&opts, variants_count = container.size()](PipelineDescriptor& desc) {
-          opts.ApplyToPipelineDescriptor(desc);
-          desc.SetLabel(
-              SPrintF("%s V#%zu", desc.GetLabel().c_str(), variants_count));
-        });
-    auto variant = std::make_unique<TypedPipeline>(std::move(variant_future));
-    auto variant_pipeline = variant->WaitAndGet();
-    container[opts] = std::move(variant);
-    return variant_pipeline;
-  }
+    auto name = variant_names_.find(&container);
+    pipeline_usage_.emplace_back(
+        name != variant_names_.end() ? name->second : desc->GetLabel(), opts);
+    opts.ApplyToPipelineDescriptor(desc.value());
+    desc->SetLabel(
+        SPrintF("%s V#%zu", desc->GetLabel().c_str(), container.size()));
+    auto variant_future =
+        context_->GetPipelineLibrary()->GetPipeline(desc.value());
+    return container
+        .emplace(opts,
+                 std::make_unique<TypedPipeline>(std::move(variant_future)))
+        .first;
+  }
+
+  /// Makes the variants of the given pipeline available to
+  /// `WarmUpPipelines` under a name that is unique to the container.
+  template <class TypedPipeline>
+  void RegisterVariants(const std::string& name,
+                        Variants<TypedPipeline>& container) {
+    if (container.find(default_options_) == container.end()) {
+      return;
+    }
+    FML_DCHECK(variant_builders_.find(name) == variant_builders_.end());
+    variant_names_[&container] = name;
+    variant_builders_[name] =
+        [this, &container](const ContentContextOptions& opts) {
+          auto found = container.find(opts);
+          if (found == container.end()) {
+            found = CreateVariant(container, opts);
+          }
+          if (!async_pipeline_compilation_ && found != container.end()) {
+            found->second->WaitAndGet();
+          }
+        };
+  }
+
+  void RegisterAllVariants();
 
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
   std::shared_ptr<GlyphAtlasContext> alpha_glyph_atlas_context_;
   std::shared_ptr<GlyphAtlasContext> color_glyph_atlas_context_;
+  std::shared_ptr<GlyphAtlasContext> sdf_glyph_atlas_context_;
   std::shared_ptr<scene::SceneContext> scene_context_;
+  std::shared_ptr<RenderTargetCache> render_target_cache_;
+  std::shared_ptr<FilterResultCache> filter_result_cache_;
   bool wireframe_ = false;
+  bool async_pipeline_compilation_ = false;
+  mutable std::vector<PipelineUsage> pipeline_usage_;
+  mutable size_t on_demand_variant_count_ = 0u;
+  std::unordered_map<std::string,
+                     std::function<void(const ContentContextOptions&)>>
+      variant_builders_;
+  std::unordered_map<const void*, std::string> variant_names_;
+  DrawBatcher::Stats draw_batching_stats_;
 
   FML_DISALLOW_COPY_AND_ASSIGN(ContentContext);
 };
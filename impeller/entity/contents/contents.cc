@@ -123,6 +123,15 @@ std::optional<Color> Contents::AsBackgroundColor(const Entity& entity,
   return {};
 }
 
+std::optional<Contents::BatchableQuad> Contents::AsBatchableQuad(
+    const Entity& entity) const {
+  return std::nullopt;
+}
+
+bool Contents::OccludesArea(const Entity& entity, const Rect& rect) const {
+  return false;
+}
+
 bool Contents::ShouldRender(const Entity& entity,
                             const std::optional<Rect>& stencil_coverage) const {
   if (!stencil_coverage.has_value()) {
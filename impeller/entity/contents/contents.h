@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -37,6 +38,25 @@ class Contents {
     std::optional<Rect> coverage = std::nullopt;
   };
 
+  /// @brief A single quad filled with either a solid color or a texture.
+  ///        Entities whose contents can be drawn as such a quad may be merged
+  ///        with their neighbours into a single draw by `DrawBatcher`.
+  struct BatchableQuad {
+    /// The corners of the quad in the local space of the entity in the order
+    /// left-top, right-top, left-bottom, right-bottom.
+    std::array<Point, 4> corners;
+    /// The premultiplied color of the quad. Unused if there is a texture.
+    Color color;
+    /// The texture sampled by the quad, if any.
+    std::shared_ptr<Texture> texture;
+    /// The texture coordinates of the corners of the quad.
+    std::array<Point, 4> texture_coords;
+    SamplerDescriptor sampler_descriptor;
+    /// The opacity the sampled texture is multiplied by.
+    Scalar opacity = 1.0f;
+    bool stencil_enabled = true;
+  };
+
   using RenderProc = std::function<bool(const ContentContext& renderer,
                                         const Entity& entity,
                                         RenderPass& pass)>;
@@ -126,6 +146,23 @@ class Contents {
   virtual std::optional<Color> AsBackgroundColor(const Entity& entity,
                                                  ISize target_size) const;
 
+  /// @brief Returns a quad if this Contents draws nothing but a single quad
+  ///        and renders exactly the same when drawn as part of a batch with
+  ///        other quads.
+  ///
+  ///        By default all contents return std::nullopt. It is always safe
+  ///        to do so.
+  virtual std::optional<BatchableQuad> AsBatchableQuad(
+      const Entity& entity) const;
+
+  /// @brief Whether rendering this Contents with the given entity writes an
+  ///        opaque color to every pixel in `rect`. This does not account for
+  ///        the blend mode or clips of the entity.
+  ///
+  ///        This is used to skip entities that are hidden behind others. By
+  ///        default all contents return false. It is always safe to do so.
+  virtual bool OccludesArea(const Entity& entity, const Rect& rect) const;
+
  private:
   std::optional<Rect> coverage_hint_;
   std::optional<Size> color_source_size_;
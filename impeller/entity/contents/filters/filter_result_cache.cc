@@ -0,0 +1,152 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/contents/filters/filter_result_cache.h"
+
+#include <algorithm>
+
+namespace impeller {
+
+static bool InputsMatch(const std::vector<std::weak_ptr<Texture>>& cached,
+                        const std::vector<const Texture*>& cached_keys,
+                        const FilterResultCache::Inputs& inputs) {
+  if (cached_keys.size() != inputs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    // A texture allocated at the address of a released input is not a match.
+    if (cached_keys[i] != inputs[i].get() || cached[i].expired()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+FilterResultCache::FilterResultCache() = default;
+
+FilterResultCache::~FilterResultCache() = default;
+
+bool FilterResultCache::IsCacheable(
+    const std::shared_ptr<Texture>& texture) const {
+  if (!texture) {
+    return false;
+  }
+  if (!(texture->GetTextureDescriptor().usage &
+        static_cast<TextureUsageMask>(TextureUsage::kRenderTarget))) {
+    return true;
+  }
+  return std::any_of(entries_.begin(), entries_.end(),
+                     [&texture](const Entry& entry) {
+                       return entry.result.texture == texture;
+                     });
+}
+
+bool FilterResultCache::HasValidInputs(const Entry& entry) const {
+  return std::all_of(
+      entry.inputs.begin(), entry.inputs.end(),
+      [this](const std::weak_ptr<Texture>& input) {
+        return IsCacheable(input.lock());
+      });
+}
+
+std::optional<Snapshot> FilterResultCache::Get(const Inputs& inputs,
+                                               const Parameters& parameters) {
+  for (auto& entry : entries_) {
+    if (!entry.content_key.has_value() && entry.parameters == parameters &&
+        InputsMatch(entry.inputs, entry.input_keys, inputs)) {
+      entry.used_this_frame = true;
+      return entry.result;
+    }
+  }
+  return std::nullopt;
+}
+
+void FilterResultCache::Set(const Inputs& inputs,
+                            Parameters parameters,
+                            const Snapshot& result) {
+  Entry entry;
+  for (const auto& input : inputs) {
+    entry.inputs.push_back(input);
+    entry.input_keys.push_back(input.get());
+  }
+  entry.parameters = std::move(parameters);
+  entry.result = result;
+  Insert(std::move(entry));
+}
+
+std::optional<Snapshot> FilterResultCache::Get(uint64_t content_key,
+                                               const Parameters& parameters) {
+  for (auto& entry : entries_) {
+    if (entry.content_key == content_key && entry.parameters == parameters) {
+      entry.used_this_frame = true;
+      return entry.result;
+    }
+  }
+  return std::nullopt;
+}
+
+void FilterResultCache::Set(uint64_t content_key,
+                            Parameters parameters,
+                            const Snapshot& result) {
+  Entry entry;
+  entry.content_key = content_key;
+  entry.parameters = std::move(parameters);
+  entry.result = result;
+  Insert(std::move(entry));
+}
+
+void FilterResultCache::Insert(Entry entry) {
+  if (entries_.size() >= kMaxEntries) {
+    // Prefer dropping an entry that the current frame hasn't touched.
+    auto victim = std::find_if(
+        entries_.begin(), entries_.end(),
+        [](const Entry& entry) { return !entry.used_this_frame; });
+    entries_.erase(victim == entries_.end() ? entries_.begin() : victim);
+  }
+  entry.used_this_frame = true;
+  entries_.push_back(std::move(entry));
+  EraseEntriesWithInvalidInputs();
+}
+
+void FilterResultCache::EraseEntriesWithInvalidInputs() {
+  // Once an entry is gone, the render target holding its result may be
+  // reused for something else, so the entries computed from it are stale.
+  // Erasing those may in turn invalidate the entries computed from theirs.
+  while (true) {
+    auto invalid = std::find_if(
+        entries_.begin(), entries_.end(),
+        [this](const Entry& entry) { return !HasValidInputs(entry); });
+    if (invalid == entries_.end()) {
+      return;
+    }
+    entries_.erase(invalid);
+  }
+}
+
+void FilterResultCache::Start() {
+  if (frame_depth_++ > 0u) {
+    return;
+  }
+  for (auto& entry : entries_) {
+    entry.used_this_frame = false;
+  }
+}
+
+void FilterResultCache::End() {
+  if (frame_depth_ == 0u || --frame_depth_ > 0u) {
+    return;
+  }
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [](const Entry& entry) {
+                                  return !entry.used_this_frame;
+                                }),
+                 entries_.end());
+  EraseEntriesWithInvalidInputs();
+}
+
+size_t FilterResultCache::GetEntryCount() const {
+  return entries_.size();
+}
+
+}  // namespace impeller
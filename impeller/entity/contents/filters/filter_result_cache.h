@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/texture.h"
+#include "impeller/geometry/scalar.h"
+#include "impeller/renderer/snapshot.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Holds on to the results of expensive filters so that they can
+///             be reused by later frames that apply the same filter to the
+///             same input.
+///
+///             Results are keyed by the identity of the input textures and a
+///             list of parameters that fully describe the filter. Only inputs
+///             whose contents cannot change behind the cache's back are
+///             eligible: textures that can't be rendered to, and textures
+///             produced by this cache (which stay immutable while the cache
+///             holds them, so that chained filters can be cached too).
+///
+///             Results can alternatively be keyed by a content key supplied
+///             by the caller, for inputs such as backdrops whose textures are
+///             recreated every frame but whose contents can be identified by
+///             other means.
+///
+///             Entries that were not used during a frame are released in
+///             `End`. Nested `Start` and `End` calls are folded into the
+///             outermost frame. Releasing an entry also releases the entries
+///             computed from its result.
+///
+///             `AiksContext::Render` treats every render as a frame. Callers
+///             that render several targets per frame with one context, such
+///             as the layers of a frame with platform views, bracket the whole
+///             frame so that the targets don't evict each other's entries.
+///
+///             Content keys are 64 bits wide on every platform and are
+///             compared in full along with the parameters.
+///
+class FilterResultCache {
+ public:
+  using Inputs = std::vector<std::shared_ptr<Texture>>;
+  using Parameters = std::vector<Scalar>;
+
+  static constexpr size_t kMaxEntries = 16u;
+
+  FilterResultCache();
+
+  ~FilterResultCache();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether results computed from the given texture can be
+  ///             cached.
+  ///
+  bool IsCacheable(const std::shared_ptr<Texture>& texture) const;
+
+  std::optional<Snapshot> Get(const Inputs& inputs,
+                              const Parameters& parameters);
+
+  void Set(const Inputs& inputs,
+           Parameters parameters,
+           const Snapshot& result);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a result keyed by the caller supplied identity of the
+  ///             input contents rather than by the input textures.
+  ///
+  std::optional<Snapshot> Get(uint64_t content_key,
+                              const Parameters& parameters);
+
+  void Set(uint64_t content_key, Parameters parameters, const Snapshot& result);
+
+  /// @brief  Mark the beginning of a frame workload.
+  void Start();
+
+  /// @brief  Mark the end of a frame workload and release the entries that
+  ///         were not used by it.
+  void End();
+
+  size_t GetEntryCount() const;
+
+ private:
+  struct Entry {
+    std::vector<std::weak_ptr<Texture>> inputs;
+    std::vector<const Texture*> input_keys;
+    std::optional<uint64_t> content_key;
+    Parameters parameters;
+    Snapshot result;
+    bool used_this_frame = false;
+  };
+
+  std::vector<Entry> entries_;
+  size_t frame_depth_ = 0u;
+
+  void Insert(Entry entry);
+
+  bool HasValidInputs(const Entry& entry) const;
+
+  void EraseEntriesWithInvalidInputs();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FilterResultCache);
+};
+
+}  // namespace impeller
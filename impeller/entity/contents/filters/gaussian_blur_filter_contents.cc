@@ -4,6 +4,7 @@
 
 #include "impeller/entity/contents/filters/gaussian_blur_filter_contents.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 #include <valarray>
@@ -14,12 +15,14 @@
 #include "impeller/core/sampler_descriptor.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/filter_result_cache.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/geometry/scalar.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/render_target.h"
 #include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
 
 namespace impeller {
 
@@ -81,6 +84,111 @@ void DirectionalGaussianBlurFilterContents::SetSourceOverride(
   source_override_ = std::move(source_override);
 }
 
+/// Blurs with a larger sigma than this (in texels) run on a downsampled copy
+/// of the input instead. Keeping the downsampled sigma between half of this
+/// and this value keeps the extra variance of the box filter used to
+/// downsample negligible.
+static constexpr Scalar kMaxDownsampledSigma = 4.0;
+
+static constexpr int kMaxDownsampleFactor = 16;
+
+/// Pick the power of two by which the input can be downsampled along the blur
+/// direction before blurring with a sigma of `sigma` texels.
+static int ComputeDownsampleFactor(Scalar sigma, int texture_extent) {
+  int factor = 1;
+  while (sigma / factor > kMaxDownsampledSigma &&
+         factor < kMaxDownsampleFactor && texture_extent / (factor * 2) > 0) {
+    factor *= 2;
+  }
+  return factor;
+}
+
+/// Shrink the snapshot texture by `factor` along one axis by repeatedly
+/// averaging pairs of texels. The returned snapshot covers the same area as
+/// the given one.
+static std::optional<Snapshot> DownsampleSnapshot(
+    const ContentContext& renderer,
+    Snapshot snapshot,
+    bool horizontal,
+    int factor) {
+  using VS = TexturePipeline::VertexShader;
+  using FS = TexturePipeline::FragmentShader;
+
+  for (; factor > 1; factor /= 2) {
+    auto texture = snapshot.texture;
+    auto size = texture->GetSize();
+    auto half_size = horizontal
+                         ? ISize((size.width + 1) / 2, size.height)
+                         : ISize(size.width, (size.height + 1) / 2);
+    // For odd sizes, the last texel averages the edge texel with the clamped
+    // texel just beyond it.
+    auto uv_extent =
+        horizontal
+            ? Point(half_size.width * 2.0f / size.width, 1.0f)
+            : Point(1.0f, half_size.height * 2.0f / size.height);
+
+    ContentContext::SubpassCallback subpass_callback =
+        [&](const ContentContext& renderer, RenderPass& pass) {
+          auto& host_buffer = pass.GetTransientsBuffer();
+
+          VertexBufferBuilder<VS::PerVertexData> vtx_builder;
+          vtx_builder.AddVertices({
+              {Point(0, 0), Point(0, 0)},
+              {Point(1, 0), Point(uv_extent.x, 0)},
+              {Point(1, 1), uv_extent},
+              {Point(0, 0), Point(0, 0)},
+              {Point(1, 1), uv_extent},
+              {Point(0, 1), Point(0, uv_extent.y)},
+          });
+
+          VS::FrameInfo frame_info;
+          frame_info.mvp = Matrix::MakeOrthographic(ISize(1, 1));
+          frame_info.texture_sampler_y_coord_scale = texture->GetYCoordScale();
+
+          FS::FragInfo frag_info;
+          frag_info.alpha = 1.0;
+
+          Command cmd;
+          cmd.label = "Gaussian Blur Downsample";
+          cmd.BindVertices(vtx_builder.CreateVertexBuffer(host_buffer));
+
+          auto options = OptionsFromPass(pass);
+          options.blend_mode = BlendMode::kSource;
+          cmd.pipeline = renderer.GetTexturePipeline(options);
+
+          SamplerDescriptor sampler_desc;
+          sampler_desc.min_filter = MinMagFilter::kLinear;
+          sampler_desc.mag_filter = MinMagFilter::kLinear;
+
+          VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+          FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+          FS::BindTextureSampler(
+              cmd, texture,
+              renderer.GetContext()->GetSamplerLibrary()->GetSampler(
+                  sampler_desc));
+
+          return pass.AddCommand(std::move(cmd));
+        };
+
+    auto out_texture = renderer.MakeSubpass("Gaussian Blur Downsample",
+                                            half_size, subpass_callback);
+    if (!out_texture) {
+      return std::nullopt;
+    }
+    snapshot.texture = out_texture;
+    snapshot.transform =
+        snapshot.transform * Matrix::MakeScale(horizontal ? Vector3(2, 1, 1)
+                                                          : Vector3(1, 2, 1));
+  }
+  return snapshot;
+}
+
+static void AppendMatrix(FilterResultCache::Parameters& parameters,
+                         const Matrix& matrix) {
+  parameters.insert(parameters.end(), std::begin(matrix.m),
+                    std::end(matrix.m));
+}
+
 std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     const FilterInput::Vector& inputs,
     const ContentContext& renderer,
@@ -177,6 +285,80 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     return std::nullopt;
   }
 
+  // Results computed from inputs that can't change between frames are reused.
+
+  bool has_alpha_mask = blur_style_ != BlurStyle::kNormal;
+  const auto& result_cache = renderer.GetFilterResultCache();
+  FilterResultCache::Inputs cache_inputs = {input_snapshot->texture};
+  if (has_alpha_mask) {
+    cache_inputs.push_back(source_snapshot->texture);
+  }
+  bool is_cacheable =
+      std::all_of(cache_inputs.begin(), cache_inputs.end(),
+                  [&result_cache](const std::shared_ptr<Texture>& texture) {
+                    return result_cache->IsCacheable(texture);
+                  });
+  FilterResultCache::Parameters cache_parameters;
+  if (is_cacheable) {
+    cache_parameters = {
+        blur_sigma_.sigma,
+        secondary_blur_sigma_.sigma,
+        blur_direction_.x,
+        blur_direction_.y,
+        static_cast<Scalar>(blur_style_),
+        static_cast<Scalar>(tile_mode_),
+        input_snapshot->opacity,
+    };
+    AppendMatrix(cache_parameters, transform);
+    AppendMatrix(cache_parameters, input_snapshot->transform);
+    if (has_alpha_mask) {
+      AppendMatrix(cache_parameters, source_snapshot->transform);
+    }
+    if (expanded_coverage_hint.has_value()) {
+      cache_parameters.insert(
+          cache_parameters.end(),
+          {expanded_coverage_hint->origin.x, expanded_coverage_hint->origin.y,
+           expanded_coverage_hint->size.width,
+           expanded_coverage_hint->size.height});
+    }
+    auto cached = result_cache->Get(cache_inputs, cache_parameters);
+    if (cached.has_value()) {
+      return Entity::FromSnapshot(cached.value(), entity.GetBlendMode(),
+                                  entity.GetStencilDepth());
+    }
+  }
+
+  // Large blurs sample a downsampled copy of the input with a proportionally
+  // smaller kernel. This is only done when the blur runs along one of the
+  // texture axes so that the other axis keeps its full resolution.
+
+  int downsample_factor = 1;
+  Scalar blur_step = 1.0;
+  {
+    auto texture_blur_vector = input_snapshot->transform.Invert()
+                                   .TransformDirection(transformed_blur_radius)
+                                   .Abs();
+    auto texture_blur_radius = texture_blur_vector.GetLength();
+    bool horizontal = texture_blur_vector.y <= texture_blur_vector.x * 1e-3f;
+    bool vertical = texture_blur_vector.x <= texture_blur_vector.y * 1e-3f;
+    if ((horizontal || vertical) && texture_blur_radius > 0) {
+      auto size = input_snapshot->texture->GetSize();
+      downsample_factor =
+          ComputeDownsampleFactor(Sigma{Radius{texture_blur_radius}}.sigma,
+                                  horizontal ? size.width : size.height);
+      if (downsample_factor > 1) {
+        auto downsampled = DownsampleSnapshot(renderer, input_snapshot.value(),
+                                              horizontal, downsample_factor);
+        if (!downsampled.has_value()) {
+          return std::nullopt;
+        }
+        input_snapshot = downsampled;
+        blur_step = downsample_factor * transformed_blur_radius_length /
+                    texture_blur_radius;
+      }
+    }
+  }
+
   // UV mapping.
 
   auto pass_uv_project = [&texture_rotate,
@@ -221,11 +403,24 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     auto r = Radius{transformed_blur_radius_length};
     frag_info.blur_sigma = Sigma{r}.sigma;
     frag_info.blur_radius = std::round(r.radius);
+    if (downsample_factor > 1) {
+      // Each tap now spans `blur_step` pixels. Remove the variance that the
+      // box filter of the downsample already contributed.
+      auto texel_size = blur_step / downsample_factor;
+      auto sigma = frag_info.blur_sigma;
+      auto box_variance =
+          (blur_step * blur_step - texel_size * texel_size) / 12;
+      auto variance = sigma * sigma - box_variance;
+      frag_info.blur_sigma =
+          std::sqrt(std::max(variance, sigma * sigma / 4)) / blur_step;
+      auto radius = Radius{Sigma{frag_info.blur_sigma}}.radius;
+      frag_info.blur_radius = std::max(1.0f, std::round(radius));
+    }
 
     // The blur direction is in input UV space.
     frag_info.blur_uv_offset =
         pass_transform.Invert().TransformDirection(Vector2(1, 0)).Normalize() /
-        Point(input_snapshot->GetCoverage().value().size);
+        Point(input_snapshot->GetCoverage().value().size) * blur_step;
 
     Command cmd;
     cmd.label = SPrintF("Gaussian Blur Filter (Radius=%.2f)",
@@ -268,7 +463,6 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
     input_descriptor.mag_filter = MinMagFilter::kLinear;
     input_descriptor.min_filter = MinMagFilter::kLinear;
 
-    bool has_alpha_mask = blur_style_ != BlurStyle::kNormal;
     bool has_decal_specialization =
         tile_mode_ == Entity::TileMode::kDecal &&
         !renderer.GetDeviceCapabilities().SupportsDecalTileMode();
@@ -336,15 +530,20 @@ std::optional<Entity> DirectionalGaussianBlurFilterContents::RenderFilter(
   sampler_desc.min_filter = MinMagFilter::kLinear;
   sampler_desc.mag_filter = MinMagFilter::kLinear;
 
-  return Entity::FromSnapshot(
-      Snapshot{.texture = out_texture,
-               .transform = texture_rotate.Invert() *
-                            Matrix::MakeTranslation(pass_texture_rect.origin) *
-                            Matrix::MakeScale((1 / scale) *
-                                              (scaled_size / floored_size)),
-               .sampler_descriptor = sampler_desc,
-               .opacity = input_snapshot->opacity},
-      entity.GetBlendMode(), entity.GetStencilDepth());
+  Snapshot result{
+      .texture = out_texture,
+      .transform =
+          texture_rotate.Invert() *
+          Matrix::MakeTranslation(pass_texture_rect.origin) *
+          Matrix::MakeScale((1 / scale) * (scaled_size / floored_size)),
+      .sampler_descriptor = sampler_desc,
+      .opacity = input_snapshot->opacity};
+  if (is_cacheable) {
+    result_cache->Set(cache_inputs, std::move(cache_parameters), result);
+  }
+
+  return Entity::FromSnapshot(result, entity.GetBlendMode(),
+                              entity.GetStencilDepth());
 }
 
 std::optional<Rect> DirectionalGaussianBlurFilterContents::GetFilterCoverage(
@@ -110,4 +110,20 @@ std::optional<Color> SolidColorContents::AsBackgroundColor(
              : std::optional<Color>();
 }
 
+std::optional<Contents::BatchableQuad> SolidColorContents::AsBatchableQuad(
+    const Entity& entity) const {
+  auto geometry = GetGeometry();
+  if (geometry == nullptr || !geometry->IsAxisAlignedRect()) {
+    return std::nullopt;
+  }
+  auto rect = geometry->GetCoverage(Matrix());
+  if (!rect.has_value()) {
+    return std::nullopt;
+  }
+  BatchableQuad quad;
+  quad.corners = rect->GetPoints();
+  quad.color = GetColor().Premultiply();
+  return quad;
+}
+
 }  // namespace impeller
@@ -52,6 +52,10 @@ class SolidColorContents final : public ColorSourceContents {
   std::optional<Color> AsBackgroundColor(const Entity& entity,
                                          ISize target_size) const override;
 
+  // |Contents|
+  std::optional<BatchableQuad> AsBatchableQuad(
+      const Entity& entity) const override;
+
  private:
   Color color_;
 
@@ -4,6 +4,8 @@
 
 #include "impeller/entity/contents/text_contents.h"
 
+#include <algorithm>
+#include <limits>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -92,18 +94,16 @@ static bool CommonRender(const ContentContext& renderer,
   // Common vertex uniforms for all glyphs.
   VS::FrameInfo frame_info;
   frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
-  frame_info.atlas_size =
-      Vector2{static_cast<Scalar>(atlas->GetTexture()->GetSize().width),
-              static_cast<Scalar>(atlas->GetTexture()->GetSize().height)};
   frame_info.offset = offset;
   frame_info.is_translation_scale =
       entity.GetTransformation().IsTranslationScaleOnly();
   frame_info.entity_transform = entity.GetTransformation();
 
-  VS::BindFrameInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frame_info));
+  const bool is_sdf =
+      atlas->GetType() == GlyphAtlas::Type::kSignedDistanceField;
 
   SamplerDescriptor sampler_desc;
-  if (frame_info.is_translation_scale) {
+  if (frame_info.is_translation_scale && !is_sdf) {
     sampler_desc.min_filter = MinMagFilter::kNearest;
     sampler_desc.mag_filter = MinMagFilter::kNearest;
   } else {
@@ -112,21 +112,42 @@ static bool CommonRender(const ContentContext& renderer,
     // on linear sampling to prevent crunchiness caused by the pixel grid not
     // being perfectly aligned.
     // The downside is that this slightly over-blurs rotated/skewed text.
+    // Signed distance fields are always sampled linearly since they are
+    // rarely drawn at the size they were rasterized at.
     sampler_desc.min_filter = MinMagFilter::kLinear;
     sampler_desc.mag_filter = MinMagFilter::kLinear;
   }
   sampler_desc.mip_filter = MipFilter::kNearest;
-
-  FS::FragInfo frag_info;
-  frag_info.text_color = ToVector(color.Premultiply());
-  FS::BindFragInfo(cmd, pass.GetTransientsBuffer().EmplaceUniform(frag_info));
-
-  FS::BindGlyphAtlasSampler(
-      cmd,                  // command
-      atlas->GetTexture(),  // texture
-      renderer.GetContext()->GetSamplerLibrary()->GetSampler(
-          sampler_desc)  // sampler
-  );
+  auto sampler =
+      renderer.GetContext()->GetSamplerLibrary()->GetSampler(sampler_desc);
+
+  if (is_sdf) {
+    using SdfFS = GlyphAtlasSdfPipeline::FragmentShader;
+
+    // The anti-aliased edge spans one pixel on screen. Work out how many
+    // distance field units that is for the smallest text in the frame.
+    const Scalar scale = entity.GetTransformation().GetMaxBasisLength();
+    Scalar min_text_size = std::numeric_limits<Scalar>::max();
+    for (const auto& run : frame.GetRuns()) {
+      min_text_size = std::min(
+          min_text_size, run.GetFont().GetMetrics().point_size * scale);
+    }
+    const Scalar atlas_pixels_per_pixel =
+        GlyphAtlas::kSignedDistanceFieldPixelSize /
+        std::max(min_text_size, kEhCloseEnough);
+
+    SdfFS::FragInfo frag_info;
+    frag_info.text_color = ToVector(color.Premultiply());
+    frag_info.edge_width = atlas_pixels_per_pixel /
+                           (4.0f * GlyphAtlas::kSignedDistanceFieldSpread);
+    SdfFS::BindFragInfo(cmd,
+                        pass.GetTransientsBuffer().EmplaceUniform(frag_info));
+  } else {
+    FS::FragInfo frag_info;
+    frag_info.text_color = ToVector(color.Premultiply());
+    FS::BindFragInfo(cmd,
+                     pass.GetTransientsBuffer().EmplaceUniform(frag_info));
+  }
 
   // Common vertex information for all glyphs.
   // All glyphs are given the same vertex information in the form of a
@@ -139,56 +160,101 @@ static bool CommonRender(const ContentContext& renderer,
                                                 Point{0, 1}, Point{1, 0},
                                                 Point{0, 1}, Point{1, 1}};
 
-  auto& host_buffer = pass.GetTransientsBuffer();
-  size_t vertex_count = 0;
+  // Glyphs may be spread over several pages of the atlas. Each page is drawn
+  // with its own command since it is backed by its own texture.
+  std::vector<std::optional<GlyphAtlas::GlyphLocation>> glyph_locations;
+  std::vector<size_t> page_glyph_counts(atlas->GetPageCount(), 0u);
   for (const auto& run : frame.GetRuns()) {
-    vertex_count += run.GetGlyphPositions().size();
+    const Font font = GlyphAtlas::GetAtlasFont(atlas->GetType(), run.GetFont());
+    for (const auto& glyph_position : run.GetGlyphPositions()) {
+      FontGlyphPair font_glyph_pair{font, glyph_position.glyph};
+      auto location = atlas->FindFontGlyphLocation(font_glyph_pair);
+      if (!location.has_value()) {
+        VALIDATION_LOG << "Could not find glyph position in the atlas.";
+      } else {
+        page_glyph_counts[location->page]++;
+      }
+      glyph_locations.emplace_back(location);
+    }
   }
-  vertex_count *= 6;
-
-  auto buffer_view = host_buffer.Emplace(
-      vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
-      [&](uint8_t* contents) {
-        VS::PerVertexData vtx;
-        size_t vertex_offset = 0;
-        for (const auto& run : frame.GetRuns()) {
-          const Font& font = run.GetFont();
-          for (const auto& glyph_position : run.GetGlyphPositions()) {
-            FontGlyphPair font_glyph_pair{font, glyph_position.glyph};
-            auto maybe_atlas_glyph_bounds =
-                atlas->FindFontGlyphBounds(font_glyph_pair);
-            if (!maybe_atlas_glyph_bounds.has_value()) {
-              VALIDATION_LOG << "Could not find glyph position in the atlas.";
-              continue;
+
+  auto& host_buffer = pass.GetTransientsBuffer();
+  for (size_t page = 0; page < page_glyph_counts.size(); page++) {
+    if (page_glyph_counts[page] == 0u) {
+      continue;
+    }
+    const auto& texture = atlas->GetPageTexture(page);
+    frame_info.atlas_size =
+        Vector2{static_cast<Scalar>(texture->GetSize().width),
+                static_cast<Scalar>(texture->GetSize().height)};
+    VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+    FS::BindGlyphAtlasSampler(cmd,      // command
+                              texture,  // texture
+                              sampler   // sampler
+    );
+
+    size_t vertex_count = page_glyph_counts[page] * 6;
+    auto buffer_view = host_buffer.Emplace(
+        vertex_count * sizeof(VS::PerVertexData), alignof(VS::PerVertexData),
+        [&](uint8_t* contents) {
+          VS::PerVertexData vtx;
+          size_t vertex_offset = 0;
+          size_t glyph_index = 0;
+          for (const auto& run : frame.GetRuns()) {
+            // The distance field extends past the outline of the glyph, so
+            // its quad covers the spread around the outline too. The atlas
+            // leaves that much room around every glyph.
+            Scalar atlas_spread = 0.0f;
+            Scalar glyph_spread = 0.0f;
+            if (is_sdf) {
+              atlas_spread = GlyphAtlas::kSignedDistanceFieldSpread;
+              glyph_spread =
+                  atlas_spread /
+                  GlyphAtlas::GetAtlasFont(atlas->GetType(), run.GetFont())
+                      .GetMetrics()
+                      .scale;
             }
-            auto atlas_glyph_bounds = maybe_atlas_glyph_bounds.value();
-            vtx.atlas_glyph_bounds = Vector4(
-                atlas_glyph_bounds.origin.x, atlas_glyph_bounds.origin.y,
-                atlas_glyph_bounds.size.width, atlas_glyph_bounds.size.height);
-            vtx.glyph_bounds = Vector4(glyph_position.glyph.bounds.origin.x,
-                                       glyph_position.glyph.bounds.origin.y,
-                                       glyph_position.glyph.bounds.size.width,
-                                       glyph_position.glyph.bounds.size.height);
-            vtx.glyph_position = glyph_position.position;
-
-            for (const auto& point : unit_points) {
-              vtx.unit_position = point;
-              ::memcpy(contents + vertex_offset, &vtx,
-                       sizeof(VS::PerVertexData));
-              vertex_offset += sizeof(VS::PerVertexData);
+            for (const auto& glyph_position : run.GetGlyphPositions()) {
+              const auto& location = glyph_locations[glyph_index++];
+              if (!location.has_value() || location->page != page) {
+                continue;
+              }
+              const auto atlas_glyph_bounds =
+                  location->bounds.Expand(atlas_spread);
+              vtx.atlas_glyph_bounds = Vector4(
+                  atlas_glyph_bounds.origin.x, atlas_glyph_bounds.origin.y,
+                  atlas_glyph_bounds.size.width,
+                  atlas_glyph_bounds.size.height);
+              const auto glyph_bounds =
+                  glyph_position.glyph.bounds.Expand(glyph_spread);
+              vtx.glyph_bounds =
+                  Vector4(glyph_bounds.origin.x, glyph_bounds.origin.y,
+                          glyph_bounds.size.width, glyph_bounds.size.height);
+              vtx.glyph_position = glyph_position.position;
+
+              for (const auto& point : unit_points) {
+                vtx.unit_position = point;
+                ::memcpy(contents + vertex_offset, &vtx,
+                         sizeof(VS::PerVertexData));
+                vertex_offset += sizeof(VS::PerVertexData);
+              }
             }
           }
-        }
-      });
-
-  cmd.BindVertices({
-      .vertex_buffer = buffer_view,
-      .index_buffer = {},
-      .vertex_count = vertex_count,
-      .index_type = IndexType::kNone,
-  });
+        });
+
+    cmd.BindVertices({
+        .vertex_buffer = buffer_view,
+        .index_buffer = {},
+        .vertex_count = vertex_count,
+        .index_type = IndexType::kNone,
+    });
+
+    if (!pass.AddCommand(cmd)) {
+      return false;
+    }
+  }
 
-  return pass.AddCommand(cmd);
+  return true;
 }
 
 bool TextContents::Render(const ContentContext& renderer,
@@ -213,10 +279,16 @@ bool TextContents::Render(const ContentContext& renderer,
   cmd.label = "TextFrame";
   auto opts = OptionsFromPassAndEntity(pass, entity);
   opts.primitive_type = PrimitiveType::kTriangle;
-  if (type == GlyphAtlas::Type::kAlphaBitmap) {
-    cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
-  } else {
-    cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      cmd.pipeline = renderer.GetGlyphAtlasColorPipeline(opts);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      cmd.pipeline = renderer.GetGlyphAtlasSdfPipeline(opts);
+      break;
   }
   cmd.stencil_reference = entity.GetStencilDepth();
 
@@ -164,6 +164,41 @@ bool TextureContents::Render(const ContentContext& renderer,
   return true;
 }
 
+std::optional<Contents::BatchableQuad> TextureContents::AsBatchableQuad(
+    const Entity& entity) const {
+  if (destination_rect_.size.IsEmpty() || source_rect_.IsEmpty() ||
+      texture_ == nullptr || texture_->GetSize().IsEmpty()) {
+    return std::nullopt;
+  }
+
+  BatchableQuad quad;
+  quad.corners = destination_rect_.GetPoints();
+  quad.texture = texture_;
+  // Matches the half texel expansion in `Render`.
+  quad.texture_coords = Rect::MakeSize(texture_->GetSize())
+                            .Project(source_rect_.Expand(0.5))
+                            .GetPoints();
+  quad.sampler_descriptor = sampler_descriptor_;
+  quad.opacity = GetOpacity();
+  quad.stencil_enabled = stencil_enabled_;
+  return quad;
+}
+
+bool TextureContents::OccludesArea(const Entity& entity,
+                                   const Rect& rect) const {
+  if (texture_ == nullptr || !texture_->IsOpaque() || GetOpacity() < 1 ||
+      !entity.GetTransformation().IsTranslationScaleOnly()) {
+    return false;
+  }
+  // The source rect must lie within the texture so that every destination
+  // pixel samples opaque texels.
+  if (!Rect::MakeSize(texture_->GetSize()).Contains(source_rect_)) {
+    return false;
+  }
+  return destination_rect_.TransformBounds(entity.GetTransformation())
+      .Contains(rect);
+}
+
 void TextureContents::SetSourceRect(const Rect& source_rect) {
   source_rect_ = source_rect;
 }
@@ -73,6 +73,13 @@ class TextureContents final : public Contents {
   // |Contents|
   void SetInheritedOpacity(Scalar opacity) override;
 
+  // |Contents|
+  std::optional<BatchableQuad> AsBatchableQuad(
+      const Entity& entity) const override;
+
+  // |Contents|
+  bool OccludesArea(const Entity& entity, const Rect& rect) const override;
+
   void SetDeferApplyingOpacity(bool defer_applying_opacity);
 
  private:
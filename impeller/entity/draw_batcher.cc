@@ -0,0 +1,198 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/draw_batcher.h"
+
+#include <array>
+#include <utility>
+
+#include "impeller/entity/contents/content_context.h"
+#include "impeller/entity/texture_fill.frag.h"
+#include "impeller/entity/texture_fill.vert.h"
+#include "impeller/renderer/sampler_library.h"
+#include "impeller/renderer/vertex_buffer_builder.h"
+
+namespace impeller {
+
+// Each quad is drawn as two triangles.
+static constexpr std::array<size_t, 6> kQuadIndices = {0, 1, 2, 1, 2, 3};
+
+static std::optional<Contents::BatchableQuad> GetBatchableQuad(
+    const Entity& entity) {
+  const auto& contents = entity.GetContents();
+  if (!contents) {
+    return std::nullopt;
+  }
+  // Advanced blends read from the destination and cannot be merged. Vertices
+  // are transformed on the CPU, which is only exact without perspective.
+  if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode ||
+      !entity.GetTransformation().IsAffine()) {
+    return std::nullopt;
+  }
+  return contents->AsBatchableQuad(entity);
+}
+
+DrawBatcher::DrawBatcher(const ContentContext& renderer)
+    : renderer_(renderer) {}
+
+DrawBatcher::~DrawBatcher() = default;
+
+const DrawBatcher::Stats& DrawBatcher::GetStats() const {
+  return stats_;
+}
+
+bool DrawBatcher::Render(const Entity& entity, RenderPass& pass) {
+  auto quad = GetBatchableQuad(entity);
+  if (quad.has_value()) {
+    if (!batch_.empty() && !CanAppend(entity, quad.value(), pass)) {
+      if (!Flush()) {
+        return false;
+      }
+    }
+    pass_ = &pass;
+    batch_.push_back({entity, std::move(quad.value())});
+    return true;
+  }
+
+  if (!Flush()) {
+    return false;
+  }
+  const auto command_count = pass.GetCommands().size();
+  if (!entity.Render(renderer_, pass)) {
+    return false;
+  }
+  const auto draw_count = pass.GetCommands().size() - command_count;
+  stats_.draws_before_batching += draw_count;
+  stats_.draws_after_batching += draw_count;
+  return true;
+}
+
+bool DrawBatcher::Flush() {
+  if (batch_.empty()) {
+    return true;
+  }
+  auto batch = std::move(batch_);
+  batch_.clear();
+  RenderPass& pass = *pass_;
+  pass_ = nullptr;
+
+  stats_.draws_before_batching += batch.size();
+  stats_.draws_after_batching += 1u;
+
+  if (batch.size() == 1u) {
+    return batch.front().entity.Render(renderer_, pass);
+  }
+  if (batch.front().quad.texture) {
+    return EncodeTextureBatch(batch, pass);
+  }
+  return EncodeColorBatch(batch, pass);
+}
+
+bool DrawBatcher::CanAppend(const Entity& entity,
+                            const Contents::BatchableQuad& quad,
+                            const RenderPass& pass) const {
+  const auto& first = batch_.front();
+  if (pass_ != &pass ||
+      entity.GetBlendMode() != first.entity.GetBlendMode() ||
+      entity.GetStencilDepth() != first.entity.GetStencilDepth() ||
+      quad.texture != first.quad.texture) {
+    return false;
+  }
+  if (!quad.texture) {
+    // Colors are per vertex so any solid color quads can be merged.
+    return true;
+  }
+  return quad.opacity == first.quad.opacity &&
+         quad.stencil_enabled == first.quad.stencil_enabled &&
+         quad.sampler_descriptor.IsEqual(first.quad.sampler_descriptor);
+}
+
+bool DrawBatcher::EncodeColorBatch(const std::vector<BatchedEntity>& batch,
+                                   RenderPass& pass) const {
+  using VS = GeometryColorPipeline::VertexShader;
+  using FS = GeometryColorPipeline::FragmentShader;
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.Reserve(batch.size() * kQuadIndices.size());
+  for (const auto& batched : batch) {
+    const auto& transform = batched.entity.GetTransformation();
+    for (auto index : kQuadIndices) {
+      VS::PerVertexData data;
+      data.position = transform * batched.quad.corners[index];
+      data.color = batched.quad.color;
+      vertex_builder.AppendVertex(data);
+    }
+  }
+
+  const auto& first = batch.front();
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  Command cmd;
+  cmd.label = "Batched Solid Fill";
+  auto options = OptionsFromPassAndEntity(pass, first.entity);
+  options.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer_.GetGeometryColorPipeline(options);
+  cmd.stencil_reference = first.entity.GetStencilDepth();
+  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = 1.0;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+bool DrawBatcher::EncodeTextureBatch(const std::vector<BatchedEntity>& batch,
+                                     RenderPass& pass) const {
+  using VS = TextureFillVertexShader;
+  using FS = TextureFillFragmentShader;
+
+  VertexBufferBuilder<VS::PerVertexData> vertex_builder;
+  vertex_builder.Reserve(batch.size() * kQuadIndices.size());
+  for (const auto& batched : batch) {
+    const auto& transform = batched.entity.GetTransformation();
+    for (auto index : kQuadIndices) {
+      vertex_builder.AppendVertex({
+          .position = transform * batched.quad.corners[index],
+          .texture_coords = batched.quad.texture_coords[index],
+      });
+    }
+  }
+
+  const auto& first = batch.front();
+  auto& host_buffer = pass.GetTransientsBuffer();
+
+  Command cmd;
+  cmd.label = "Batched Texture Fill";
+  auto options = OptionsFromPassAndEntity(pass, first.entity);
+  if (!first.quad.stencil_enabled) {
+    options.stencil_compare = CompareFunction::kAlways;
+  }
+  options.primitive_type = PrimitiveType::kTriangle;
+  cmd.pipeline = renderer_.GetTexturePipeline(options);
+  cmd.stencil_reference = first.entity.GetStencilDepth();
+  cmd.BindVertices(vertex_builder.CreateVertexBuffer(host_buffer));
+
+  VS::FrameInfo frame_info;
+  frame_info.mvp = Matrix::MakeOrthographic(pass.GetRenderTargetSize());
+  frame_info.texture_sampler_y_coord_scale =
+      first.quad.texture->GetYCoordScale();
+  VS::BindFrameInfo(cmd, host_buffer.EmplaceUniform(frame_info));
+
+  FS::FragInfo frag_info;
+  frag_info.alpha = first.quad.opacity;
+  FS::BindFragInfo(cmd, host_buffer.EmplaceUniform(frag_info));
+  FS::BindTextureSampler(
+      cmd, first.quad.texture,
+      renderer_.GetContext()->GetSamplerLibrary()->GetSampler(
+          first.quad.sampler_descriptor));
+
+  return pass.AddCommand(std::move(cmd));
+}
+
+}  // namespace impeller
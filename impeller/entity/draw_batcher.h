@@ -0,0 +1,87 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/entity/contents/contents.h"
+#include "impeller/entity/entity.h"
+#include "impeller/renderer/render_pass.h"
+
+namespace impeller {
+
+class ContentContext;
+
+//------------------------------------------------------------------------------
+/// @brief      Renders entities into render passes while merging consecutive
+///             entities that draw a single solid color or texture quad into
+///             one draw.
+///
+///             Only consecutive entities targeting the same render pass with
+///             the same blend mode and stencil depth are merged. Quads of a
+///             merged draw are emitted in the order their entities were
+///             rendered so the result is identical to drawing them one by one.
+///
+///             Entities that cannot be merged are rendered immediately after
+///             the pending batch is flushed. The pending batch must be
+///             flushed before the render pass it targets ends.
+///
+class DrawBatcher {
+ public:
+  struct Stats {
+    /// The number of draws the rendered entities would have issued without
+    /// batching.
+    size_t draws_before_batching = 0u;
+    /// The number of draws actually issued.
+    size_t draws_after_batching = 0u;
+  };
+
+  explicit DrawBatcher(const ContentContext& renderer);
+
+  ~DrawBatcher();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Render the entity into the pass or defer it to be merged with
+  ///             the entities that follow.
+  ///
+  /// @return     If the entity or the pending batch failed to render.
+  ///
+  bool Render(const Entity& entity, RenderPass& pass);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Encode the pending batch into the render pass it targets.
+  ///
+  bool Flush();
+
+  const Stats& GetStats() const;
+
+ private:
+  struct BatchedEntity {
+    Entity entity;
+    Contents::BatchableQuad quad;
+  };
+
+  const ContentContext& renderer_;
+  RenderPass* pass_ = nullptr;
+  std::vector<BatchedEntity> batch_;
+  Stats stats_;
+
+  bool CanAppend(const Entity& entity,
+                 const Contents::BatchableQuad& quad,
+                 const RenderPass& pass) const;
+
+  bool EncodeColorBatch(const std::vector<BatchedEntity>& batch,
+                        RenderPass& pass) const;
+
+  bool EncodeTextureBatch(const std::vector<BatchedEntity>& batch,
+                          RenderPass& pass) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DrawBatcher);
+};
+
+}  // namespace impeller
@@ -8,6 +8,7 @@
 #include <utility>
 #include <variant>
 
+#include "flutter/fml/closure.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/trace_event.h"
@@ -22,6 +23,7 @@
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/contents/texture_contents.h"
+#include "impeller/entity/draw_batcher.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/inline_pass_context.h"
 #include "impeller/geometry/color.h"
@@ -36,6 +38,10 @@
 
 namespace impeller {
 
+/// The maximum number of opaque entities each element of a pass is tested
+/// against when looking for elements hidden behind them.
+static constexpr size_t kMaxOccluders = 8u;
+
 namespace {
 std::tuple<std::optional<Color>, BlendMode> ElementAsBackgroundColor(
     const EntityPass::Element& element,
@@ -206,9 +212,10 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
   RenderTarget target;
   if (context->GetCapabilities()->SupportsOffscreenMSAA()) {
     target = RenderTarget::CreateOffscreenMSAA(
-        *context,      // context
-        size,          // size
-        "EntityPass",  // label
+        *context,                          // context
+        *renderer.GetRenderTargetCache(),  // allocator
+        size,                              // size
+        "EntityPass",                      // label
         RenderTarget::AttachmentConfigMSAA{
             .storage_mode = StorageMode::kDeviceTransient,
             .resolve_storage_mode = StorageMode::kDevicePrivate,
@@ -219,9 +226,10 @@ static EntityPassTarget CreateRenderTarget(ContentContext& renderer,
     );
   } else {
     target = RenderTarget::CreateOffscreen(
-        *context,      // context
-        size,          // size
-        "EntityPass",  // label
+        *context,                          // context
+        *renderer.GetRenderTargetCache(),  // allocator
+        size,                              // size
+        "EntityPass",                      // label
         RenderTarget::AttachmentConfig{
             .storage_mode = StorageMode::kDevicePrivate,
             .load_action = LoadAction::kDontCare,
@@ -245,6 +253,13 @@ uint32_t EntityPass::GetTotalPassReads(ContentContext& renderer) const {
 
 bool EntityPass::Render(ContentContext& renderer,
                         const RenderTarget& render_target) const {
+  // Every root pass is a frame for the offscreen render targets recycled by
+  // the cache. Passes rendered from within another frame fold into it.
+  const auto& render_target_cache = renderer.GetRenderTargetCache();
+  render_target_cache->Start();
+  fml::ScopedCleanupClosure end_frame(
+      [&render_target_cache]() { render_target_cache->End(); });
+
   auto root_render_target = render_target;
 
   if (root_render_target.GetColorAttachments().empty()) {
@@ -390,6 +405,91 @@ bool EntityPass::Render(ContentContext& renderer,
       stencil_coverage_stack);                   // stencil_coverage_stack
 }
 
+std::shared_ptr<Contents> EntityPass::GetBackdropFilterContents(
+    ContentContext& renderer,
+    InlinePassContext& pass_context,
+    const EntityPass& subpass,
+    Point global_pass_position,
+    Rect subpass_coverage) const {
+  const auto& proc = subpass.backdrop_filter_proc_;
+  const auto& content_key = subpass.backdrop_content_key_;
+  auto& cache = *renderer.GetFilterResultCache();
+
+  // Besides the content of the parent pass, the filtered backdrop depends on
+  // where the parent pass is, the region it is read from, and the transform
+  // applied to the filter.
+  FilterResultCache::Parameters parameters;
+  std::optional<Snapshot> backdrop;
+  if (content_key.has_value()) {
+    auto target_size =
+        pass_context.GetPassTarget().GetRenderTarget().GetRenderTargetSize();
+    parameters = {static_cast<Scalar>(target_size.width),
+                  static_cast<Scalar>(target_size.height),
+                  global_pass_position.x,
+                  global_pass_position.y,
+                  subpass_coverage.origin.x,
+                  subpass_coverage.origin.y,
+                  subpass_coverage.size.width,
+                  subpass_coverage.size.height};
+    parameters.insert(parameters.end(), std::begin(subpass.xformation_.m),
+                      std::end(subpass.xformation_.m));
+    backdrop = cache.Get(content_key.value(), parameters);
+  }
+
+  if (!backdrop.has_value()) {
+    auto texture = pass_context.GetTexture();
+    // Render the backdrop texture before any of the pass elements.
+    auto filter = proc(FilterInput::Make(texture), subpass.xformation_,
+                       /*is_subpass*/ true);
+
+    // The subpass will need to read from the current pass texture when
+    // rendering the backdrop, so if there's an active pass, end it prior to
+    // rendering the subpass.
+    pass_context.EndPass();
+
+    if (!content_key.has_value() || !filter) {
+      return filter;
+    }
+
+    // Filter into a texture that outlives the parent pass texture so that the
+    // result can be reused. The coverage hint is the subpass coverage in the
+    // local space of the parent pass.
+    backdrop = filter->RenderToSnapshot(
+        renderer, Entity{},
+        Rect(subpass_coverage.origin - global_pass_position,
+             subpass_coverage.size));
+    if (!backdrop.has_value()) {
+      return nullptr;
+    }
+    if (backdrop->texture != texture) {
+      cache.Set(content_key.value(), std::move(parameters), backdrop.value());
+    }
+  }
+
+  // The snapshot is in the local space of the parent pass, which the subpass
+  // maps to its own space through the entity transform.
+  auto snapshot = backdrop.value();
+  return Contents::MakeAnonymous(
+      [snapshot](const ContentContext& renderer, const Entity& entity,
+                 RenderPass& pass) -> bool {
+        auto snapshot_entity = Entity::FromSnapshot(
+            snapshot, entity.GetBlendMode(), entity.GetStencilDepth());
+        if (!snapshot_entity.has_value()) {
+          return false;
+        }
+        snapshot_entity->SetTransformation(entity.GetTransformation() *
+                                           snapshot.transform);
+        return snapshot_entity->Render(renderer, pass);
+      },
+      [snapshot](const Entity& entity) -> std::optional<Rect> {
+        auto coverage = snapshot.GetCoverage();
+        if (!coverage.has_value()) {
+          return std::nullopt;
+        }
+        return coverage->TransformBounds(entity.GetTransformation());
+      });
+}
+
 EntityPass::EntityResult EntityPass::GetEntityForElement(
     const EntityPass::Element& element,
     ContentContext& renderer,
@@ -451,21 +551,6 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       return EntityPass::EntityResult::Skip();
     }
 
-    std::shared_ptr<Contents> backdrop_filter_contents = nullptr;
-    if (subpass->backdrop_filter_proc_) {
-      auto texture = pass_context.GetTexture();
-      // Render the backdrop texture before any of the pass elements.
-      const auto& proc = subpass->backdrop_filter_proc_;
-      backdrop_filter_contents =
-          proc(FilterInput::Make(std::move(texture)), subpass->xformation_,
-               /*is_subpass*/ true);
-
-      // The subpass will need to read from the current pass texture when
-      // rendering the backdrop, so if there's an active pass, end it prior to
-      // rendering the subpass.
-      pass_context.EndPass();
-    }
-
     if (stencil_coverage_stack.empty()) {
       // The current clip is empty. This means the pass texture won't be
       // visible, so skip it.
@@ -493,13 +578,21 @@ EntityPass::EntityResult EntityPass::GetEntityForElement(
       return EntityPass::EntityResult::Skip();
     }
 
-    auto subpass_coverage = (subpass->flood_clip_ || backdrop_filter_contents)
-                                ? coverage_limit
-                                : GetSubpassCoverage(*subpass, coverage_limit);
+    auto subpass_coverage =
+        (subpass->flood_clip_ || subpass->backdrop_filter_proc_)
+            ? coverage_limit
+            : GetSubpassCoverage(*subpass, coverage_limit);
     if (!subpass_coverage.has_value()) {
       return EntityPass::EntityResult::Skip();
     }
 
+    std::shared_ptr<Contents> backdrop_filter_contents = nullptr;
+    if (subpass->backdrop_filter_proc_) {
+      backdrop_filter_contents = GetBackdropFilterContents(
+          renderer, pass_context, *subpass, global_pass_position,
+          subpass_coverage.value());
+    }
+
     auto subpass_size = ISize(subpass_coverage->size);
     if (subpass_size.IsEmpty()) {
       return EntityPass::EntityResult::Skip();
@@ -599,9 +692,15 @@ bool EntityPass::OnRender(
     pass_context.GetRenderPass(pass_depth);
   }
 
+  // Consecutive entities drawing simple quads are merged into single draws.
+  // The batcher must be flushed before anything else renders into or ends
+  // the current pass.
+  DrawBatcher batcher(renderer);
+
   auto render_element = [&stencil_depth_floor, &pass_context, &pass_depth,
                          &renderer, &stencil_coverage_stack,
-                         &global_pass_position](Entity& element_entity) {
+                         &global_pass_position,
+                         &batcher](Entity& element_entity) {
     auto result = pass_context.GetRenderPass(pass_depth);
 
     if (!result.pass) {
@@ -709,7 +808,7 @@ bool EntityPass::OnRender(
 
     element_entity.SetStencilDepth(element_entity.GetStencilDepth() -
                                    stencil_depth_floor);
-    if (!element_entity.Render(renderer, *result.pass)) {
+    if (!batcher.Render(element_entity, *result.pass)) {
       VALIDATION_LOG << "Failed to render entity.";
       return false;
     }
@@ -735,8 +834,12 @@ bool EntityPass::OnRender(
     render_element(backdrop_entity);
   }
 
+  const auto occluded_elements = ComputeOccludedElements();
+
   bool is_collapsing_clear_colors = true;
-  for (const auto& element : elements_) {
+  for (size_t element_index = 0; element_index < elements_.size();
+       element_index++) {
+    const auto& element = elements_[element_index];
     // Skip elements that are incorporated into the clear color.
     if (is_collapsing_clear_colors) {
       auto [entity_color, _] =
@@ -747,6 +850,19 @@ bool EntityPass::OnRender(
       is_collapsing_clear_colors = false;
     }
 
+    // Skip elements that are hidden behind opaque entities.
+    if (occluded_elements[element_index]) {
+      continue;
+    }
+
+    // Subpasses either render into the current pass when collapsed or may end
+    // it to read from its texture.
+    if (std::holds_alternative<std::unique_ptr<EntityPass>>(element) &&
+        !batcher.Flush()) {
+      VALIDATION_LOG << "Failed to render batched entities.";
+      return false;
+    }
+
     EntityResult result =
         GetEntityForElement(element,                 // element
                             renderer,                // renderer
@@ -791,6 +907,10 @@ bool EntityPass::OnRender(
         // for blending (otherwise the blend pass will end up executing before
         // all the previous commands in the active pass).
 
+        if (!batcher.Flush()) {
+          VALIDATION_LOG << "Failed to render batched entities.";
+          return false;
+        }
         if (!pass_context.EndPass()) {
           VALIDATION_LOG
               << "Failed to end the current render pass in order to read from "
@@ -829,6 +949,12 @@ bool EntityPass::OnRender(
     }
   }
 
+  if (!batcher.Flush()) {
+    VALIDATION_LOG << "Failed to render batched entities.";
+    return false;
+  }
+  renderer.RecordDrawBatchingStats(batcher.GetStats());
+
 #ifdef IMPELLER_DEBUG
   //--------------------------------------------------------------------------
   /// Draw debug checkerboard over offscreen textures.
@@ -934,6 +1060,73 @@ void EntityPass::SetBlendMode(BlendMode blend_mode) {
   flood_clip_ = Entity::IsBlendModeDestructive(blend_mode);
 }
 
+std::vector<bool> EntityPass::ComputeOccludedElements() const {
+  TRACE_EVENT0("impeller", "EntityPass::ComputeOccludedElements");
+  std::vector<bool> occluded(elements_.size(), false);
+
+  // Opaque entities drawn after the element being visited. Only the ones
+  // closest to the top are kept to bound the cost of the search.
+  std::vector<const Entity*> occluders;
+
+  for (size_t i = elements_.size(); i > 0; i--) {
+    const auto& element = elements_[i - 1];
+
+    if (const auto* subpass =
+            std::get_if<std::unique_ptr<EntityPass>>(&element)) {
+      // Subpasses that read from the backdrop see everything drawn before
+      // them, even where later entities cover it.
+      if ((*subpass)->backdrop_filter_proc_ ||
+          (*subpass)->blend_mode_ > Entity::kLastPipelineBlendMode) {
+        occluders.clear();
+      }
+      continue;
+    }
+
+    const auto& entity = std::get<Entity>(element);
+    const auto& contents = entity.GetContents();
+    if (!contents) {
+      continue;
+    }
+    // Clips and restores change the stencil for everything after them.
+    if (contents->GetStencilCoverage(entity, std::nullopt).type !=
+        Contents::StencilCoverage::Type::kNoChange) {
+      continue;
+    }
+
+    auto coverage = entity.GetCoverage();
+    if (coverage.has_value()) {
+      for (const auto* occluder : occluders) {
+        if (occluder->GetContents()->OccludesArea(*occluder,
+                                                  coverage.value())) {
+          occluded[i - 1] = true;
+          break;
+        }
+      }
+    }
+    if (occluded[i - 1]) {
+      continue;
+    }
+
+    if (entity.GetBlendMode() > Entity::kLastPipelineBlendMode) {
+      // Advanced blends read from the backdrop.
+      occluders.clear();
+      continue;
+    }
+
+    // Only opaque entities that fill their whole coverage are useful
+    // occluders. Entities clipped within this pass may not fill it.
+    if (occluders.size() < kMaxOccluders && coverage.has_value() &&
+        entity.GetStencilDepth() == stencil_depth_ &&
+        (entity.GetBlendMode() == BlendMode::kSourceOver ||
+         entity.GetBlendMode() == BlendMode::kSource) &&
+        contents->OccludesArea(entity, coverage.value())) {
+      occluders.push_back(&entity);
+    }
+  }
+
+  return occluded;
+}
+
 Color EntityPass::GetClearColor(ISize target_size) const {
   Color result = Color::BlackTransparent();
   for (const Element& element : elements_) {
@@ -947,13 +1140,15 @@ Color EntityPass::GetClearColor(ISize target_size) const {
   return result.Premultiply();
 }
 
-void EntityPass::SetBackdropFilter(BackdropFilterProc proc) {
+void EntityPass::SetBackdropFilter(BackdropFilterProc proc,
+                                   std::optional<uint64_t> content_key) {
   if (superpass_) {
     VALIDATION_LOG << "Backdrop filters cannot be set on EntityPasses that "
                       "have already been appended to another pass.";
   }
 
   backdrop_filter_proc_ = std::move(proc);
+  backdrop_content_key_ = backdrop_filter_proc_ ? content_key : std::nullopt;
 }
 
 void EntityPass::SetEnableOffscreenCheckerboard(bool enabled) {
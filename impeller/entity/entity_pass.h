@@ -96,7 +96,31 @@ class EntityPass {
 
   Color GetClearColor(ISize size = ISize::Infinite()) const;
 
-  void SetBackdropFilter(BackdropFilterProc proc);
+  /// @brief  Find the elements of this pass that are completely hidden behind
+  ///         opaque entities drawn after them.
+  ///
+  ///         Only entities that are not clipped within this pass are
+  ///         considered as occluders. Clips, restores and subpasses are never
+  ///         culled, and nothing drawn before an element that reads from the
+  ///         backdrop is culled by anything drawn after it.
+  ///
+  /// @return A flag for each element that is set if rendering the element
+  ///         can be skipped.
+  std::vector<bool> ComputeOccludedElements() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief  Set the filter applied to the backdrop of this pass.
+  ///
+  /// @param  content_key  Identifies the parent pass content read by the
+  ///                      filter. When set, the filtered backdrop is cached
+  ///                      and a later pass with the same key, filter placement
+  ///                      and parent size reuses it instead of reading back
+  ///                      and filtering the parent pass again. Callers must
+  ///                      only supply keys that change whenever the content
+  ///                      under the filtered region changes.
+  ///
+  void SetBackdropFilter(BackdropFilterProc proc,
+                         std::optional<uint64_t> content_key = std::nullopt);
 
   void SetEnableOffscreenCheckerboard(bool enabled);
 
@@ -140,6 +164,18 @@ class EntityPass {
                                    StencilCoverageStack& stencil_coverage_stack,
                                    size_t stencil_depth_floor) const;
 
+  /// @brief  Read back and filter the parent pass content under a subpass
+  ///         with a backdrop filter, or reuse the filtered backdrop of an
+  ///         earlier frame if the subpass has a content key that matches it.
+  ///
+  ///         The parent pass is ended if its texture had to be read.
+  std::shared_ptr<Contents> GetBackdropFilterContents(
+      ContentContext& renderer,
+      InlinePassContext& pass_context,
+      const EntityPass& subpass,
+      Point global_pass_position,
+      Rect subpass_coverage) const;
+
   /// @brief     OnRender is the internal command recording routine for
   ///            `EntityPass`. Its job is to walk through each `Element` which
   ///            was appended to the scene (either an `Entity` via `AddEntity()`
@@ -232,6 +268,7 @@ class EntityPass {
   uint32_t GetTotalPassReads(ContentContext& renderer) const;
 
   BackdropFilterProc backdrop_filter_proc_ = nullptr;
+  std::optional<uint64_t> backdrop_content_key_;
 
   std::unique_ptr<EntityPassDelegate> delegate_ =
       EntityPassDelegate::MakeDefault();
@@ -3,12 +3,14 @@
 // found in the LICENSE file.
 
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <optional>
 #include <unordered_map>
 #include <vector>
 
+#include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/testing/testing.h"
 #include "fml/logging.h"
 #include "fml/time/time_point.h"
@@ -20,6 +22,7 @@
 #include "impeller/entity/contents/filters/blend_filter_contents.h"
 #include "impeller/entity/contents/filters/color_filter_contents.h"
 #include "impeller/entity/contents/filters/filter_contents.h"
+#include "impeller/entity/contents/filters/filter_result_cache.h"
 #include "impeller/entity/contents/filters/inputs/filter_input.h"
 #include "impeller/entity/contents/linear_gradient_contents.h"
 #include "impeller/entity/contents/radial_gradient_contents.h"
@@ -31,6 +34,7 @@
 #include "impeller/entity/contents/texture_contents.h"
 #include "impeller/entity/contents/tiled_texture_contents.h"
 #include "impeller/entity/contents/vertices_contents.h"
+#include "impeller/entity/draw_batcher.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass.h"
 #include "impeller/entity/entity_pass_delegate.h"
@@ -38,6 +42,8 @@
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/entity/geometry/point_field_geometry.h"
 #include "impeller/entity/geometry/stroke_path_geometry.h"
+#include "impeller/entity/pipeline_usage_profile.h"
+#include "impeller/entity/render_target_cache.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/geometry_asserts.h"
 #include "impeller/geometry/path_builder.h"
@@ -160,6 +166,73 @@ TEST_P(EntityTest, EntityPassCanMergeSubpassIntoParent) {
   ASSERT_TRUE(OpenPlaygroundHere(pass));
 }
 
+static Entity MakeRectEntity(Rect rect, Color color) {
+  Entity entity;
+  auto contents = std::make_unique<SolidColorContents>();
+  contents->SetGeometry(Geometry::MakeRect(rect));
+  contents->SetColor(color);
+  entity.SetContents(std::move(contents));
+  return entity;
+}
+
+TEST_P(EntityTest, EntityPassCullsEntitiesHiddenBehindOpaqueEntities) {
+  EntityPass pass;
+  pass.AddEntity(MakeRectEntity(Rect::MakeXYWH(10, 10, 50, 50), Color::Red()));
+  pass.AddEntity(MakeRectEntity(Rect::MakeXYWH(100, 10, 50, 50),
+                                Color::Red().WithAlpha(0.5)));
+  // Covers the first rect but only half of the second.
+  pass.AddEntity(MakeRectEntity(Rect::MakeXYWH(0, 0, 125, 100), Color::Blue()));
+  // Translucent, so it hides nothing.
+  pass.AddEntity(MakeRectEntity(Rect::MakeXYWH(0, 0, 200, 200),
+                                Color::Green().WithAlpha(0.5)));
+
+  auto occluded = pass.ComputeOccludedElements();
+  ASSERT_EQ(occluded.size(), 4u);
+  EXPECT_TRUE(occluded[0]);
+  EXPECT_FALSE(occluded[1]);
+  EXPECT_FALSE(occluded[2]);
+  EXPECT_FALSE(occluded[3]);
+}
+
+TEST_P(EntityTest, EntityPassDoesNotCullBehindClippedOrBackdropReads) {
+  EntityPass pass;
+  pass.AddEntity(MakeRectEntity(Rect::MakeXYWH(10, 10, 50, 50), Color::Red()));
+
+  // An opaque rect that is clipped doesn't necessarily hide the first rect.
+  auto clipped = MakeRectEntity(Rect::MakeXYWH(0, 0, 100, 100), Color::Blue());
+  clipped.SetStencilDepth(1);
+  pass.AddEntity(clipped);
+
+  // Nothing before an advanced blend is hidden by what comes after it.
+  pass.AddEntity(MakeRectEntity(Rect::MakeXYWH(10, 10, 50, 50), Color::Red()));
+  auto blend = MakeRectEntity(Rect::MakeXYWH(0, 0, 10, 10), Color::Red());
+  blend.SetBlendMode(BlendMode::kScreen);
+  pass.AddEntity(blend);
+  pass.AddEntity(MakeRectEntity(Rect::MakeXYWH(0, 0, 100, 100), Color::Blue()));
+
+  auto occluded = pass.ComputeOccludedElements();
+  ASSERT_EQ(occluded.size(), 5u);
+  for (auto is_occluded : occluded) {
+    EXPECT_FALSE(is_occluded);
+  }
+}
+
+TEST_P(EntityTest, EntityPassRendersWithOccludedEntities) {
+  EntityPass pass;
+  for (auto i = 0; i < 10; i++) {
+    pass.AddEntity(MakeRectEntity(Rect::MakeXYWH(100 + i * 10, 100, 50, 50),
+                                  Color::Red()));
+  }
+  // Only the blue rect and the top red rect should be visible.
+  pass.AddEntity(
+      MakeRectEntity(Rect::MakeXYWH(50, 50, 300, 200), Color::Blue()));
+  pass.AddEntity(
+      MakeRectEntity(Rect::MakeXYWH(150, 150, 50, 50), Color::Red()));
+  auto occluded = pass.ComputeOccludedElements();
+  ASSERT_EQ(std::count(occluded.begin(), occluded.end(), true), 10);
+  ASSERT_TRUE(OpenPlaygroundHere(pass));
+}
+
 TEST_P(EntityTest, EntityPassCoverageRespectsCoverageLimit) {
   // Rect is drawn entirely in negative area.
   auto pass = CreatePassWithRectPath(Rect::MakeLTRB(-200, -200, -100, -100),
@@ -2435,6 +2508,552 @@ TEST_P(EntityTest, ColorFilterContentsWithLargeGeometry) {
   ASSERT_TRUE(OpenPlaygroundHere(entity));
 }
 
+TEST_P(EntityTest, DrawBatcherMergesConsecutiveSolidColorRects) {
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    DrawBatcher batcher(context);
+    const auto command_count = pass.GetCommands().size();
+    for (auto i = 0; i < 10; i++) {
+      Entity entity;
+      entity.SetTransformation(Matrix::MakeScale(GetContentScale()));
+      // Switching the blend mode halfway through starts a new batch.
+      entity.SetBlendMode(i < 5 ? BlendMode::kSourceOver : BlendMode::kPlus);
+      auto contents = std::make_shared<SolidColorContents>();
+      contents->SetGeometry(
+          Geometry::MakeRect(Rect::MakeXYWH(100 + i * 40, 100, 30, 30)));
+      contents->SetColor(i % 2 == 0 ? Color::Red() : Color::Blue());
+      entity.SetContents(std::move(contents));
+      if (!batcher.Render(entity, pass)) {
+        return false;
+      }
+    }
+    if (!batcher.Flush()) {
+      return false;
+    }
+    EXPECT_EQ(pass.GetCommands().size() - command_count, 2u);
+    EXPECT_EQ(batcher.GetStats().draws_before_batching, 10u);
+    EXPECT_EQ(batcher.GetStats().draws_after_batching, 2u);
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, DrawBatcherDoesNotMergeAcrossOtherDraws) {
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    DrawBatcher batcher(context);
+    const auto command_count = pass.GetCommands().size();
+    auto make_rect = [&](Rect rect, Color color) {
+      Entity entity;
+      entity.SetTransformation(Matrix::MakeScale(GetContentScale()));
+      auto contents = std::make_shared<SolidColorContents>();
+      contents->SetGeometry(Geometry::MakeRect(rect));
+      contents->SetColor(color);
+      entity.SetContents(std::move(contents));
+      return entity;
+    };
+    Entity circle;
+    circle.SetTransformation(Matrix::MakeScale(GetContentScale()));
+    circle.SetContents(SolidColorContents::Make(
+        PathBuilder{}.AddCircle({150, 150}, 40).TakePath(), Color::Green()));
+
+    // The circle is not a quad and has to be drawn between the two rects.
+    if (!batcher.Render(make_rect(Rect::MakeXYWH(100, 100, 100, 100),
+                                  Color::Red()),
+                        pass) ||
+        !batcher.Render(circle, pass) ||
+        !batcher.Render(make_rect(Rect::MakeXYWH(130, 130, 40, 40),
+                                  Color::Blue()),
+                        pass) ||
+        !batcher.Flush()) {
+      return false;
+    }
+    EXPECT_EQ(pass.GetCommands().size() - command_count, 3u);
+    EXPECT_EQ(batcher.GetStats().draws_before_batching,
+              batcher.GetStats().draws_after_batching);
+    return true;
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+static TextureDescriptor MakeRenderTargetCacheTestDescriptor(ISize size) {
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kDevicePrivate;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = size;
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget) |
+               static_cast<TextureUsageMask>(TextureUsage::kShaderRead);
+  return desc;
+}
+
+TEST_P(EntityTest, RenderTargetCacheReusesTexturesAcrossFrames) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator());
+  auto desc = MakeRenderTargetCacheTestDescriptor({100, 100});
+
+  cache.Start();
+  auto texture = cache.CreateTexture(desc);
+  ASSERT_TRUE(texture);
+  Texture* first = texture.get();
+  texture.reset();
+  // Released textures are not handed back out within the same frame.
+  auto other = cache.CreateTexture(desc);
+  ASSERT_TRUE(other);
+  EXPECT_NE(other.get(), first);
+  other.reset();
+  cache.End();
+
+  cache.Start();
+  texture = cache.CreateTexture(desc);
+  EXPECT_EQ(texture.get(), first);
+  // Textures of a different size come from a different bucket.
+  auto larger = cache.CreateTexture(
+      MakeRenderTargetCacheTestDescriptor({200, 100}));
+  ASSERT_TRUE(larger);
+  EXPECT_NE(larger->GetSize(), texture->GetSize());
+  cache.End();
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.misses, 3u);
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.cached_texture_count, 3u);
+  EXPECT_EQ(stats.cached_bytes, (100u * 100u * 2u + 200u * 100u) * 4u);
+}
+
+TEST_P(EntityTest, RenderTargetCacheDoesNotReuseTexturesInUse) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator());
+  auto desc = MakeRenderTargetCacheTestDescriptor({100, 100});
+
+  cache.Start();
+  auto held = cache.CreateTexture(desc);
+  ASSERT_TRUE(held);
+  cache.End();
+
+  cache.Start();
+  auto texture = cache.CreateTexture(desc);
+  ASSERT_TRUE(texture);
+  EXPECT_NE(texture.get(), held.get());
+  cache.End();
+
+  EXPECT_EQ(cache.GetStats().hits, 0u);
+  EXPECT_EQ(cache.GetStats().misses, 2u);
+}
+
+TEST_P(EntityTest, RenderTargetCacheEvictsIdleTextures) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator(),
+                          /*max_idle_frames=*/2u);
+  auto desc = MakeRenderTargetCacheTestDescriptor({100, 100});
+
+  cache.Start();
+  ASSERT_TRUE(cache.CreateTexture(desc));
+  cache.End();
+
+  for (auto i = 0; i < 2; i++) {
+    cache.Start();
+    cache.End();
+  }
+  EXPECT_EQ(cache.GetStats().cached_texture_count, 1u);
+
+  cache.Start();
+  cache.End();
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.cached_texture_count, 0u);
+  EXPECT_EQ(stats.cached_bytes, 0u);
+  EXPECT_EQ(stats.evictions, 1u);
+}
+
+TEST_P(EntityTest, RenderTargetCacheFoldsNestedFrames) {
+  RenderTargetCache cache(GetContext()->GetResourceAllocator());
+  auto desc = MakeRenderTargetCacheTestDescriptor({100, 100});
+
+  cache.Start();
+  auto texture = cache.CreateTexture(desc);
+  ASSERT_TRUE(texture);
+  Texture* first = texture.get();
+  texture.reset();
+
+  cache.Start();
+  auto nested = cache.CreateTexture(desc);
+  ASSERT_TRUE(nested);
+  EXPECT_NE(nested.get(), first);
+  cache.End();
+  cache.End();
+
+  EXPECT_EQ(cache.GetStats().hits, 0u);
+}
+
+TEST_P(EntityTest, FilterResultCacheOnlyReusesUnchangedInputs) {
+  FilterResultCache cache;
+  auto allocator = GetContext()->GetResourceAllocator();
+
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 100};
+  auto image = allocator->CreateTexture(desc);
+  ASSERT_TRUE(image);
+  desc.usage |= static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  auto render_target = allocator->CreateTexture(desc);
+  ASSERT_TRUE(render_target);
+
+  // Render targets may be drawn into again, so results computed from them
+  // can't be reused. Results of the cache itself can.
+  EXPECT_TRUE(cache.IsCacheable(image));
+  EXPECT_FALSE(cache.IsCacheable(render_target));
+
+  cache.Start();
+  cache.Set({image}, {1.0f}, Snapshot{.texture = render_target});
+  EXPECT_TRUE(cache.IsCacheable(render_target));
+  cache.End();
+
+  cache.Start();
+  auto result = cache.Get({image}, {1.0f});
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->texture, render_target);
+  EXPECT_FALSE(cache.Get({image}, {2.0f}).has_value());
+  EXPECT_FALSE(cache.Get({render_target}, {1.0f}).has_value());
+  cache.End();
+
+  // Entries that a frame didn't use are released.
+  cache.Start();
+  cache.End();
+  EXPECT_EQ(cache.GetEntryCount(), 0u);
+}
+
+TEST_P(EntityTest, FilterResultCacheReusesResultsByContentKey) {
+  FilterResultCache cache;
+  auto allocator = GetContext()->GetResourceAllocator();
+
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 100};
+  desc.usage = static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  auto result = allocator->CreateTexture(desc);
+  ASSERT_TRUE(result);
+
+  cache.Start();
+  cache.Set(42u, {1.0f}, Snapshot{.texture = result});
+  cache.End();
+
+  cache.Start();
+  auto cached = cache.Get(42u, {1.0f});
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached->texture, result);
+  EXPECT_FALSE(cache.Get(43u, {1.0f}).has_value());
+  EXPECT_FALSE(cache.Get(42u, {2.0f}).has_value());
+  // Keyed entries are never matched by input textures.
+  EXPECT_FALSE(cache.Get(FilterResultCache::Inputs{}, {1.0f}).has_value());
+  cache.End();
+}
+
+TEST_P(EntityTest, GaussianBlurReusesResultsForUnchangedInputs) {
+  auto boston = CreateTextureForFixture("boston.jpg");
+  ASSERT_TRUE(boston);
+  auto blur = FilterContents::MakeGaussianBlur(FilterInput::Make(boston),
+                                               Sigma{40}, Sigma{40});
+
+  auto callback = [&](ContentContext& context, RenderPass& pass) -> bool {
+    const auto& cache = context.GetFilterResultCache();
+    Entity entity;
+    entity.SetTransformation(Matrix::MakeScale(GetContentScale()));
+
+    cache->Start();
+    auto first = blur->GetEntity(context, entity, std::nullopt);
+    cache->End();
+    cache->Start();
+    auto second = blur->GetEntity(context, entity, std::nullopt);
+    cache->End();
+
+    if (!first.has_value() || !second.has_value()) {
+      return false;
+    }
+    auto first_texture =
+        std::static_pointer_cast<TextureContents>(first->GetContents())
+            ->GetTexture();
+    auto second_texture =
+        std::static_pointer_cast<TextureContents>(second->GetContents())
+            ->GetTexture();
+    EXPECT_EQ(first_texture, second_texture);
+    // One entry for each of the two directional passes.
+    EXPECT_EQ(cache->GetEntryCount(), 2u);
+
+    return second->Render(context, pass);
+  };
+  ASSERT_TRUE(OpenPlaygroundHere(callback));
+}
+
+TEST_P(EntityTest, FilterResultCacheDropsEntriesComputedFromEvictedResults) {
+  FilterResultCache cache;
+  auto allocator = GetContext()->GetResourceAllocator();
+
+  TextureDescriptor desc;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {100, 100};
+  auto image = allocator->CreateTexture(desc);
+  ASSERT_TRUE(image);
+  desc.usage |= static_cast<TextureUsageMask>(TextureUsage::kRenderTarget);
+  auto first_pass = allocator->CreateTexture(desc);
+  auto second_pass = allocator->CreateTexture(desc);
+  ASSERT_TRUE(first_pass && second_pass);
+
+  cache.Start();
+  cache.Set({image}, {0.0f}, Snapshot{.texture = first_pass});
+  cache.Set({first_pass}, {0.0f}, Snapshot{.texture = second_pass});
+  // Fill the cache so that the first pass entry is evicted.
+  for (size_t i = 2; i <= FilterResultCache::kMaxEntries; i++) {
+    cache.Set({image}, {static_cast<Scalar>(i)},
+              Snapshot{.texture = allocator->CreateTexture(desc)});
+  }
+  EXPECT_FALSE(cache.Get({image}, {0.0f}).has_value());
+
+  // The render target of the first pass may be reused for another result, so
+  // the second pass entry computed from it is gone too.
+  EXPECT_FALSE(cache.IsCacheable(first_pass));
+  cache.Set({image}, {100.0f}, Snapshot{.texture = first_pass});
+  EXPECT_TRUE(cache.IsCacheable(first_pass));
+  EXPECT_FALSE(cache.Get({first_pass}, {0.0f}).has_value());
+  cache.End();
+}
+
+// Copies the contents of |texture| to host memory.
+static std::optional<std::vector<uint8_t>> ReadTexture(
+    const std::shared_ptr<Context>& context,
+    const std::shared_ptr<Texture>& texture) {
+  DeviceBufferDescriptor buffer_desc;
+  buffer_desc.storage_mode = StorageMode::kHostVisible;
+  buffer_desc.size =
+      texture->GetTextureDescriptor().GetByteSizeOfBaseMipLevel();
+  auto buffer = context->GetResourceAllocator()->CreateBuffer(buffer_desc);
+  auto command_buffer = context->CreateCommandBuffer();
+  if (!buffer || !command_buffer) {
+    return std::nullopt;
+  }
+  auto pass = command_buffer->CreateBlitPass();
+  if (!pass || !pass->AddCopy(texture, buffer) ||
+      !pass->EncodeCommands(context->GetResourceAllocator())) {
+    return std::nullopt;
+  }
+  fml::AutoResetWaitableEvent latch;
+  if (!command_buffer->SubmitCommands(
+          [&latch](CommandBuffer::Status) { latch.Signal(); })) {
+    return std::nullopt;
+  }
+  latch.Wait();
+  const uint8_t* contents = buffer->AsBufferView().contents;
+  return std::vector<uint8_t>(contents, contents + buffer_desc.size);
+}
+
+TEST_P(EntityTest, GaussianBlurStaysWithinToleranceOfExactBlur) {
+  // A white stripe on a transparent background, blurred across the stripe
+  // with a sigma that is large enough for the input to be downsampled.
+  constexpr int kWidth = 256;
+  constexpr int kHeight = 8;
+  constexpr int kStripeStart = 112;
+  constexpr int kStripeEnd = 144;
+  constexpr Scalar kSigma = 16;
+  std::vector<uint8_t> pixels(kWidth * kHeight * 4, 0);
+  for (int y = 0; y < kHeight; y++) {
+    std::fill(pixels.begin() + (y * kWidth + kStripeStart) * 4,
+              pixels.begin() + (y * kWidth + kStripeEnd) * 4, 255);
+  }
+  TextureDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.format = PixelFormat::kR8G8B8A8UNormInt;
+  desc.size = {kWidth, kHeight};
+  auto input = GetContext()->GetResourceAllocator()->CreateTexture(desc);
+  ASSERT_TRUE(input);
+  ASSERT_TRUE(input->SetContents(pixels.data(), pixels.size()));
+
+  ContentContext context(GetContext());
+  ASSERT_TRUE(context.IsValid());
+  auto blur = FilterContents::MakeDirectionalGaussianBlur(
+      FilterInput::Make(input), Sigma{kSigma}, Vector2(1, 0));
+  const auto& cache = context.GetFilterResultCache();
+  auto render_blur = [&]() {
+    cache->Start();
+    auto result = blur->GetEntity(context, Entity{}, std::nullopt);
+    cache->End();
+    return result;
+  };
+  auto get_texture = [](const Entity& entity) {
+    return std::static_pointer_cast<TextureContents>(entity.GetContents())
+        ->GetTexture();
+  };
+  auto uncached = render_blur();
+  ASSERT_TRUE(uncached.has_value());
+  auto cached = render_blur();
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(get_texture(cached.value()), get_texture(uncached.value()));
+
+  // The output may be smaller than the area it covers, which it is scaled to.
+  auto coverage = uncached->GetCoverage();
+  ASSERT_TRUE(coverage.has_value());
+  auto output_texture = get_texture(uncached.value());
+  auto output = ReadTexture(GetContext(), output_texture);
+  ASSERT_TRUE(output.has_value());
+
+  // Compare a row of the output with the stripe convolved with the Gaussian.
+  const auto output_size = output_texture->GetSize();
+  const size_t row = output_size.height / 2;
+  for (int x = 0; x < output_size.width; x++) {
+    const Scalar local_x =
+        coverage->origin.x +
+        (x + 0.5f) * coverage->size.width / output_size.width;
+    const Scalar expected =
+        0.5f * (std::erf((kStripeEnd - local_x) / (kSigma * kSqrt2)) -
+                std::erf((kStripeStart - local_x) / (kSigma * kSqrt2)));
+    const Scalar alpha =
+        output.value()[(row * output_size.width + x) * 4 + 3] / 255.0f;
+    EXPECT_NEAR(alpha, expected, 0.06f) << "at x = " << local_x;
+  }
+}
+
+TEST_P(EntityTest, ContentContextWarmsUpRecordedPipelineVariants) {
+  ContentContext recorded(GetContext());
+  ASSERT_TRUE(recorded.IsValid());
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kSource,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat()};
+  ASSERT_TRUE(recorded.GetSolidFillPipeline(opts));
+  auto usage = recorded.GetPipelineUsage();
+  ASSERT_EQ(usage.size(), 1u);
+
+  ContentContext warmed(GetContext());
+  warmed.SetAsyncPipelineCompilation(true);
+  warmed.WarmUpPipelines(usage);
+  ASSERT_EQ(warmed.GetPipelineUsage().size(), 1u);
+
+  // The warmed up variant is used instead of creating another one.
+  auto pipeline = warmed.GetSolidFillPipeline(opts);
+  ASSERT_TRUE(pipeline);
+  EXPECT_EQ(warmed.GetPipelineUsage().size(), 1u);
+
+  // Unknown pipelines are ignored.
+  warmed.WarmUpPipelines({{"Not A Pipeline", opts}});
+  EXPECT_EQ(warmed.GetPipelineUsage().size(), 1u);
+}
+
+TEST_P(EntityTest, WarmsUpVariantsOfPipelinesSharingALabel) {
+  ContentContext recorded(GetContext());
+  ASSERT_TRUE(recorded.IsValid());
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kSource,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat()};
+  ASSERT_TRUE(recorded.GetPositionUVPipeline(opts));
+  ASSERT_TRUE(recorded.GetTiledTexturePipeline(opts));
+  auto usage = recorded.GetPipelineUsage();
+  ASSERT_EQ(usage.size(), 2u);
+  EXPECT_NE(usage[0].first, usage[1].first);
+
+  ContentContext warmed(GetContext());
+  ASSERT_TRUE(warmed.IsValid());
+  warmed.WarmUpPipelines(usage);
+  ASSERT_TRUE(warmed.GetPositionUVPipeline(opts));
+  ASSERT_TRUE(warmed.GetTiledTexturePipeline(opts));
+  EXPECT_EQ(warmed.GetOnDemandVariantCount(), 0u);
+}
+
+TEST_P(EntityTest, AsyncPipelineCompilationUsesExactVariant) {
+  ContentContextOptions opts{
+      .sample_count = SampleCount::kCount4,
+      .blend_mode = BlendMode::kSourceOver,
+      .color_attachment_pixel_format =
+          GetContext()->GetCapabilities()->GetDefaultColorFormat()};
+  auto get_blend = [&opts](const ContentContext& context) {
+    auto pipeline = context.GetSolidFillPipeline(opts);
+    FML_CHECK(pipeline);
+    return *pipeline->GetDescriptor().GetColorAttachmentDescriptor(0u);
+  };
+
+  ContentContext async(GetContext());
+  ASSERT_TRUE(async.IsValid());
+  async.SetAsyncPipelineCompilation(true);
+  auto source_over = get_blend(async);
+
+  // A variant that only differs in its blend mode is built by now, but the
+  // draw must not use it while the requested variant is still being built.
+  opts.blend_mode = BlendMode::kSource;
+  auto source = get_blend(async);
+  ContentContext sync(GetContext());
+  ASSERT_TRUE(sync.IsValid());
+  EXPECT_EQ(source, get_blend(sync));
+  EXPECT_FALSE(source == source_over);
+}
+
+TEST(PipelineUsageProfileTest, RoundTripsPipelineUsage) {
+  PipelineUsageProfile::Usage usage = {
+      {"SolidFill Pipeline", ContentContextOptions{}},
+      {"Texture Pipeline",
+       ContentContextOptions{
+           .sample_count = SampleCount::kCount4,
+           .blend_mode = BlendMode::kMultiply,
+           .stencil_compare = CompareFunction::kAlways,
+           .stencil_operation = StencilOperation::kIncrementClamp,
+           .primitive_type = PrimitiveType::kTriangleStrip,
+           .color_attachment_pixel_format = PixelFormat::kB8G8R8A8UNormInt,
+           .has_stencil_attachment = false,
+           .wireframe = true}},
+  };
+  auto encoded = PipelineUsageProfile::Encode(usage);
+  ASSERT_TRUE(encoded);
+
+  auto decoded = PipelineUsageProfile::Decode(*encoded);
+  ASSERT_TRUE(decoded.has_value());
+  ASSERT_EQ(decoded->size(), usage.size());
+  for (size_t i = 0; i < usage.size(); i++) {
+    EXPECT_EQ(decoded->at(i).first, usage[i].first);
+    EXPECT_TRUE(ContentContextOptions::Equal{}(decoded->at(i).second,
+                                               usage[i].second));
+  }
+
+  // Truncated and corrupted profiles are rejected.
+  fml::NonOwnedMapping truncated(encoded->GetMapping(),
+                                 encoded->GetSize() - 1u);
+  EXPECT_FALSE(PipelineUsageProfile::Decode(truncated).has_value());
+  std::vector<uint8_t> corrupted(encoded->GetMapping(),
+                                 encoded->GetMapping() + encoded->GetSize());
+  corrupted.back() = 0xff;
+  EXPECT_FALSE(PipelineUsageProfile::Decode(fml::DataMapping(corrupted))
+                   .has_value());
+}
+
+TEST_P(EntityTest, NoPipelinesAreCreatedOnDemandAfterWarmUp) {
+  auto render = [](const ContentContext& renderer) {
+    return renderer.MakeSubpass(
+        "Warm Up", ISize(100, 100),
+        [](const ContentContext& renderer, RenderPass& pass) {
+          auto path =
+              PathBuilder{}.AddRect(Rect::MakeXYWH(10, 10, 50, 50)).TakePath();
+          for (auto blend_mode :
+               {BlendMode::kSource, BlendMode::kSourceOver, BlendMode::kPlus,
+                BlendMode::kDestinationOut}) {
+            Entity entity;
+            entity.SetBlendMode(blend_mode);
+            entity.SetContents(
+                SolidColorContents::Make(path, Color::Red().WithAlpha(0.5)));
+            if (!entity.Render(renderer, pass)) {
+              return false;
+            }
+          }
+          return true;
+        });
+  };
+
+  ContentContext recorded(GetContext());
+  ASSERT_TRUE(recorded.IsValid());
+  ASSERT_TRUE(render(recorded));
+  EXPECT_GT(recorded.GetOnDemandVariantCount(), 0u);
+  auto profile = PipelineUsageProfile::Encode(recorded.GetPipelineUsage());
+  auto usage = PipelineUsageProfile::Decode(*profile);
+  ASSERT_TRUE(usage.has_value());
+
+  ContentContext warmed(GetContext());
+  ASSERT_TRUE(warmed.IsValid());
+  warmed.WarmUpPipelines(usage.value());
+  ASSERT_TRUE(render(warmed));
+  EXPECT_EQ(warmed.GetOnDemandVariantCount(), 0u);
+}
+
 }  // namespace testing
 }  // namespace impeller
 
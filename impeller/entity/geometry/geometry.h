@@ -91,6 +91,10 @@ class Geometry {
   /// @return `true` if this geometry will completely cover all fragments in
   /// `rect` when the `transform` is applied to it.
   virtual bool CoversArea(const Matrix& transform, const Rect& rect) const;
+
+  /// @return `true` if this geometry is exactly the rectangle returned by
+  /// `GetCoverage` for an identity transform.
+  virtual bool IsAxisAlignedRect() const;
 };
 
 }  // namespace impeller
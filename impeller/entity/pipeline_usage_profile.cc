@@ -0,0 +1,178 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/pipeline_usage_profile.h"
+
+#include <cstring>
+#include <limits>
+
+#include "flutter/fml/file.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/entity.h"
+
+namespace impeller {
+
+static constexpr uint32_t kProfileMagic = 0x50555049;  // "IPUP"
+static constexpr uint32_t kProfileVersion = 2u;
+static constexpr size_t kPackedOptionsSize = 8u;
+
+namespace {
+struct ProfileHeader {
+  uint32_t magic = kProfileMagic;
+  uint32_t version = kProfileVersion;
+  uint32_t count = 0u;
+};
+
+class Reader {
+ public:
+  explicit Reader(const fml::Mapping& mapping)
+      : data_(mapping.GetMapping()), size_(mapping.GetSize()) {}
+
+  bool Read(void* dest, size_t size) {
+    if (size > size_ - offset_) {
+      return false;
+    }
+    ::memcpy(dest, data_ + offset_, size);
+    offset_ += size;
+    return true;
+  }
+
+  bool IsAtEnd() const { return offset_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  const size_t size_;
+  size_t offset_ = 0u;
+};
+}  // namespace
+
+static void Append(std::vector<uint8_t>& data, const void* src, size_t size) {
+  auto bytes = static_cast<const uint8_t*>(src);
+  data.insert(data.end(), bytes, bytes + size);
+}
+
+static void PackOptions(const ContentContextOptions& opts,
+                        uint8_t packed[kPackedOptionsSize]) {
+  packed[0] = static_cast<uint8_t>(opts.sample_count);
+  packed[1] = static_cast<uint8_t>(opts.blend_mode);
+  packed[2] = static_cast<uint8_t>(opts.stencil_compare);
+  packed[3] = static_cast<uint8_t>(opts.stencil_operation);
+  packed[4] = static_cast<uint8_t>(opts.primitive_type);
+  packed[5] = static_cast<uint8_t>(opts.color_attachment_pixel_format);
+  packed[6] = opts.has_stencil_attachment ? 1u : 0u;
+  packed[7] = opts.wireframe ? 1u : 0u;
+}
+
+static std::optional<ContentContextOptions> UnpackOptions(
+    const uint8_t packed[kPackedOptionsSize]) {
+  auto sample_count = static_cast<SampleCount>(packed[0]);
+  if (sample_count != SampleCount::kCount1 &&
+      sample_count != SampleCount::kCount4) {
+    return std::nullopt;
+  }
+  if (packed[1] > static_cast<uint8_t>(Entity::kLastAdvancedBlendMode) ||
+      packed[2] > static_cast<uint8_t>(CompareFunction::kGreaterEqual) ||
+      packed[3] > static_cast<uint8_t>(StencilOperation::kDecrementWrap) ||
+      packed[4] > static_cast<uint8_t>(PrimitiveType::kPoint) ||
+      packed[5] > static_cast<uint8_t>(PixelFormat::kD32FloatS8UInt) ||
+      packed[6] > 1u || packed[7] > 1u) {
+    return std::nullopt;
+  }
+  return ContentContextOptions{
+      .sample_count = sample_count,
+      .blend_mode = static_cast<BlendMode>(packed[1]),
+      .stencil_compare = static_cast<CompareFunction>(packed[2]),
+      .stencil_operation = static_cast<StencilOperation>(packed[3]),
+      .primitive_type = static_cast<PrimitiveType>(packed[4]),
+      .color_attachment_pixel_format = static_cast<PixelFormat>(packed[5]),
+      .has_stencil_attachment = packed[6] == 1u,
+      .wireframe = packed[7] == 1u,
+  };
+}
+
+std::unique_ptr<fml::Mapping> PipelineUsageProfile::Encode(
+    const Usage& usage) {
+  std::vector<uint8_t> data;
+  ProfileHeader header;
+  for (const auto& [label, opts] : usage) {
+    if (label.size() > std::numeric_limits<uint16_t>::max()) {
+      continue;
+    }
+    auto label_size = static_cast<uint16_t>(label.size());
+    uint8_t packed[kPackedOptionsSize];
+    PackOptions(opts, packed);
+    Append(data, &label_size, sizeof(label_size));
+    Append(data, label.data(), label.size());
+    Append(data, packed, sizeof(packed));
+    header.count++;
+  }
+  data.insert(data.begin(), reinterpret_cast<const uint8_t*>(&header),
+              reinterpret_cast<const uint8_t*>(&header) + sizeof(header));
+  return std::make_unique<fml::DataMapping>(std::move(data));
+}
+
+std::optional<PipelineUsageProfile::Usage> PipelineUsageProfile::Decode(
+    const fml::Mapping& mapping) {
+  if (mapping.GetMapping() == nullptr) {
+    return std::nullopt;
+  }
+  Reader reader(mapping);
+  ProfileHeader header;
+  if (!reader.Read(&header, sizeof(header)) ||
+      header.magic != kProfileMagic || header.version != kProfileVersion) {
+    return std::nullopt;
+  }
+  Usage usage;
+  for (uint32_t i = 0; i < header.count; i++) {
+    uint16_t label_size = 0u;
+    if (!reader.Read(&label_size, sizeof(label_size))) {
+      return std::nullopt;
+    }
+    std::string label(label_size, '\0');
+    uint8_t packed[kPackedOptionsSize];
+    if (!reader.Read(label.data(), label_size) ||
+        !reader.Read(packed, sizeof(packed))) {
+      return std::nullopt;
+    }
+    auto opts = UnpackOptions(packed);
+    if (!opts.has_value()) {
+      return std::nullopt;
+    }
+    usage.emplace_back(std::move(label), opts.value());
+  }
+  if (!reader.IsAtEnd()) {
+    return std::nullopt;
+  }
+  return usage;
+}
+
+PipelineUsageProfile::Usage PipelineUsageProfile::Load(
+    const fml::UniqueFD& directory) {
+  if (!directory.is_valid()) {
+    return {};
+  }
+  TRACE_EVENT0("impeller", "PipelineUsageProfile::Load");
+  auto mapping = fml::FileMapping::CreateReadOnly(directory, kFileName);
+  if (!mapping) {
+    return {};
+  }
+  auto usage = Decode(*mapping);
+  if (!usage.has_value()) {
+    FML_LOG(ERROR) << "Ignoring invalid pipeline usage profile.";
+    return {};
+  }
+  return std::move(usage.value());
+}
+
+bool PipelineUsageProfile::Save(const fml::UniqueFD& directory,
+                                const Usage& usage) {
+  if (!directory.is_valid()) {
+    return false;
+  }
+  TRACE_EVENT0("impeller", "PipelineUsageProfile::Save");
+  auto mapping = Encode(usage);
+  return fml::WriteAtomically(directory, kFileName, *mapping);
+}
+
+}  // namespace impeller
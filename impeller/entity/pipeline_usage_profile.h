@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/mapping.h"
+#include "flutter/fml/unique_fd.h"
+#include "impeller/entity/contents/content_context.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Reads and writes the pipeline variants used by a run of the
+///             app, so that the next run can build them ahead of their first
+///             use.
+///
+///             Each variant is stored as the label of the pipeline it was
+///             created from followed by its packed `ContentContextOptions`.
+///             Profiles written by a different version of the format are
+///             ignored.
+///
+class PipelineUsageProfile {
+ public:
+  using Usage = std::vector<ContentContext::PipelineUsage>;
+
+  static constexpr const char* kFileName = "flutter.impeller.pipeline_usage";
+
+  static std::unique_ptr<fml::Mapping> Encode(const Usage& usage);
+
+  static std::optional<Usage> Decode(const fml::Mapping& mapping);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Read the profile in the given directory. Returns an empty
+  ///             profile if there is none or it can't be decoded.
+  ///
+  static Usage Load(const fml::UniqueFD& directory);
+
+  static bool Save(const fml::UniqueFD& directory, const Usage& usage);
+
+ private:
+  FML_DISALLOW_IMPLICIT_CONSTRUCTORS(PipelineUsageProfile);
+};
+
+}  // namespace impeller
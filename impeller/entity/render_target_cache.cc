@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/render_target_cache.h"
+
+#include <algorithm>
+
+#include "impeller/core/texture.h"
+
+namespace impeller {
+
+static bool IsSameDescriptor(const TextureDescriptor& a,
+                             const TextureDescriptor& b) {
+  return a.storage_mode == b.storage_mode &&  //
+         a.type == b.type &&                  //
+         a.format == b.format &&              //
+         a.size == b.size &&                  //
+         a.mip_count == b.mip_count &&        //
+         a.usage == b.usage &&                //
+         a.sample_count == b.sample_count &&  //
+         a.compression_type == b.compression_type;
+}
+
+RenderTargetCache::RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                                     size_t max_idle_frames)
+    : RenderTargetAllocator(std::move(allocator)),
+      max_idle_frames_(max_idle_frames) {}
+
+RenderTargetCache::~RenderTargetCache() = default;
+
+std::shared_ptr<Texture> RenderTargetCache::CreateTexture(
+    const TextureDescriptor& desc) {
+  for (auto& entry : entries_) {
+    if (entry.used_this_frame || entry.texture.use_count() > 1 ||
+        !IsSameDescriptor(entry.descriptor, desc)) {
+      continue;
+    }
+    entry.used_this_frame = true;
+    entry.idle_frames = 0u;
+    hits_++;
+    return entry.texture;
+  }
+
+  auto texture = RenderTargetAllocator::CreateTexture(desc);
+  if (!texture) {
+    return nullptr;
+  }
+  misses_++;
+  entries_.push_back(TextureEntry{
+      .descriptor = desc,
+      .texture = texture,
+      .byte_size = desc.GetByteSizeOfBaseMipLevel() *
+                   static_cast<size_t>(desc.sample_count),
+      .used_this_frame = true,
+      .idle_frames = 0u,
+  });
+  return texture;
+}
+
+void RenderTargetCache::Start() {
+  if (frame_depth_++ > 0u) {
+    return;
+  }
+  for (auto& entry : entries_) {
+    entry.used_this_frame = false;
+  }
+}
+
+void RenderTargetCache::End() {
+  if (frame_depth_ == 0u || --frame_depth_ > 0u) {
+    return;
+  }
+  for (auto& entry : entries_) {
+    if (entry.used_this_frame) {
+      entry.idle_frames = 0u;
+    } else {
+      entry.idle_frames++;
+    }
+  }
+  auto evicted = std::remove_if(
+      entries_.begin(), entries_.end(), [&](const TextureEntry& entry) {
+        return entry.idle_frames > max_idle_frames_;
+      });
+  evictions_ += std::distance(evicted, entries_.end());
+  entries_.erase(evicted, entries_.end());
+}
+
+RenderTargetCache::Stats RenderTargetCache::GetStats() const {
+  Stats stats;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  stats.cached_texture_count = entries_.size();
+  for (const auto& entry : entries_) {
+    stats.cached_bytes += entry.byte_size;
+  }
+  return stats;
+}
+
+void RenderTargetCache::Clear() {
+  entries_.clear();
+}
+
+}  // namespace impeller
@@ -0,0 +1,97 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/core/texture_descriptor.h"
+#include "impeller/renderer/render_target.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A render target allocator that recycles the textures of
+///             offscreen render targets across frames.
+///
+///             Textures are bucketed by their full descriptor (size, format,
+///             type, sample count, storage mode, usage and compression). A
+///             cached texture is handed back out only once nothing outside of
+///             the cache holds a reference to it and it has not already been
+///             handed out during the current frame, so the GPU is never asked
+///             to write to a texture that an earlier pass of the same frame
+///             may still be sampling from.
+///
+///             Textures that have not been used for more than the configured
+///             number of frames are released in `End`. Nested `Start` and
+///             `End` calls are folded into the outermost frame.
+///
+///             `EntityPass::Render` brackets every root pass with `Start` and
+///             `End`. Callers that render contents directly, without a root
+///             pass, must bracket that work themselves or the textures they
+///             allocate are never recycled or released.
+///
+class RenderTargetCache final : public RenderTargetAllocator {
+ public:
+  struct Stats {
+    /// The number of textures that were served from the cache.
+    size_t hits = 0u;
+    /// The number of textures that had to be allocated.
+    size_t misses = 0u;
+    /// The number of textures released because they were idle for too long.
+    size_t evictions = 0u;
+    /// The number of textures currently held by the cache.
+    size_t cached_texture_count = 0u;
+    /// The approximate size in bytes of the textures held by the cache.
+    size_t cached_bytes = 0u;
+  };
+
+  static constexpr size_t kDefaultMaxIdleFrames = 3u;
+
+  explicit RenderTargetCache(std::shared_ptr<Allocator> allocator,
+                             size_t max_idle_frames = kDefaultMaxIdleFrames);
+
+  ~RenderTargetCache() override;
+
+  // |RenderTargetAllocator|
+  std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc) override;
+
+  // |RenderTargetAllocator|
+  void Start() override;
+
+  // |RenderTargetAllocator|
+  void End() override;
+
+  Stats GetStats() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Release all cached textures. Textures that are still in use
+  ///             stay alive until their last user releases them.
+  ///
+  void Clear();
+
+ private:
+  struct TextureEntry {
+    TextureDescriptor descriptor;
+    std::shared_ptr<Texture> texture;
+    size_t byte_size = 0u;
+    bool used_this_frame = false;
+    size_t idle_frames = 0u;
+  };
+
+  const size_t max_idle_frames_;
+  size_t frame_depth_ = 0u;
+  std::vector<TextureEntry> entries_;
+  size_t hits_ = 0u;
+  size_t misses_ = 0u;
+  size_t evictions_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetCache);
+};
+
+}  // namespace impeller
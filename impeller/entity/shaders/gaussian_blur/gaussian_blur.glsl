@@ -4,14 +4,13 @@
 
 // 1D (directional) gaussian blur.
 //
+// Adjacent kernel taps are folded into a single linearly filtered sample
+// placed between the two texels in proportion to their weights, which halves
+// the number of texture reads without changing the result.
+//
 // Paths for future optimization:
 //   * Remove the uv bounds multiplier in SampleColor by adding optional
 //     support for SamplerAddressMode::ClampToBorder in the texture sampler.
-//   * Render both blur passes into a smaller texture than the source image
-//     (~1/radius size).
-//   * If doing the small texture render optimization, cache misses can be
-//     reduced in the first pass by sampling the source textures with a mip
-//     level of log2(min_radius).
 
 #include <impeller/constants.glsl>
 #include <impeller/gaussian.glsl>
@@ -57,25 +56,28 @@ in vec2 v_src_texture_coords;
 out f16vec4 frag_color;
 
 void main() {
-  f16vec4 total_color = f16vec4(0.0hf);
-  float16_t gaussian_integral = 0.0hf;
-
-  for (float16_t i = -blur_info.blur_radius; i <= blur_info.blur_radius;
-       i += 2.0hf) {
-    // Use the 32 bit Gaussian function because the 16 bit variation results in
-    // quality loss/visible banding. Also, 16 bit variation internally breaks
-    // down at a moderately high (but still reasonable) blur sigma of >255 when
-    // computing sigma^2 due to the exponent only having 5 bits.
-    float16_t gaussian = float16_t(IPGaussian(float(i), blur_info.blur_sigma));
-    gaussian_integral += gaussian;
+  // Use the 32 bit Gaussian function because the 16 bit variation results in
+  // quality loss/visible banding. Also, 16 bit variation internally breaks
+  // down at a moderately high (but still reasonable) blur sigma of >255 when
+  // computing sigma^2 due to the exponent only having 5 bits.
+  float gaussian_integral = IPGaussian(0.0, blur_info.blur_sigma);
+  f16vec4 total_color =
+      float16_t(gaussian_integral) * Sample(texture_sampler, v_texture_coords);
+
+  for (float i = 1.0; i <= float(blur_info.blur_radius); i += 2.0) {
+    float near_gaussian = IPGaussian(i, blur_info.blur_sigma);
+    float far_gaussian = IPGaussian(i + 1.0, blur_info.blur_sigma);
+    float gaussian = near_gaussian + far_gaussian;
+    vec2 uv_offset = vec2(blur_info.blur_uv_offset) *
+                     (i + far_gaussian / max(gaussian, kEhCloseEnough));
+    gaussian_integral += 2.0 * gaussian;
     total_color +=
-        gaussian * Sample(texture_sampler,  // sampler
-                          v_texture_coords + blur_info.blur_uv_offset *
-                                                 i  // texture coordinates
-                   );
+        float16_t(gaussian) *
+        (Sample(texture_sampler, v_texture_coords + uv_offset) +
+         Sample(texture_sampler, v_texture_coords - uv_offset));
   }
 
-  frag_color = total_color / gaussian_integral;
+  frag_color = total_color / float16_t(gaussian_integral);
 
 #if ENABLE_ALPHA_MASK
   f16vec4 src_color = Sample(alpha_mask_sampler,   // sampler
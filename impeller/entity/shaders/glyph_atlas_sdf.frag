@@ -0,0 +1,27 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+precision mediump float;
+
+#include <impeller/types.glsl>
+
+uniform f16sampler2D glyph_atlas_sampler;
+
+uniform FragInfo {
+  f16vec4 text_color;
+  // Half the width of the anti-aliased edge in distance field units.
+  float edge_width;
+}
+frag_info;
+
+in highp vec2 v_uv;
+
+out f16vec4 frag_color;
+
+void main() {
+  float distance = float(texture(glyph_atlas_sampler, v_uv).a);
+  float coverage = smoothstep(0.5 - frag_info.edge_width,
+                              0.5 + frag_info.edge_width, distance);
+  frag_color = frag_info.text_color * float16_t(coverage);
+}
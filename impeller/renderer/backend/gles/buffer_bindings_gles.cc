@@ -122,10 +122,21 @@ bool BufferBindingsGLES::ReadUniformsBindings(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
+bool BufferBindingsGLES::BindVertexAttributes(StateCacheGLES& state,
                                               size_t vertex_offset) const {
+  uint32_t enabled_arrays = 0u;
+  for (const auto& array : vertex_attrib_arrays_) {
+    if (array.index >= StateCacheGLES::kMaxVertexAttribArrays) {
+      VALIDATION_LOG << "Vertex attribute index " << array.index
+                     << " is out of range.";
+      return false;
+    }
+    enabled_arrays |= 1u << array.index;
+  }
+  state.SetEnabledVertexAttribArrays(enabled_arrays);
+
+  const auto& gl = state.GetProcTable();
   for (const auto& array : vertex_attrib_arrays_) {
-    gl.EnableVertexAttribArray(array.index);
     gl.VertexAttribPointer(array.index,       // index
                            array.size,        // size (must be 1, 2, 3, or 4)
                            array.type,        // type
@@ -140,10 +151,11 @@ bool BufferBindingsGLES::BindVertexAttributes(const ProcTableGLES& gl,
 }
 
 bool BufferBindingsGLES::BindUniformData(
-    const ProcTableGLES& gl,
+    StateCacheGLES& state,
     Allocator& transients_allocator,
     const Bindings& vertex_bindings,
     const Bindings& fragment_bindings) const {
+  const auto& gl = state.GetProcTable();
   for (const auto& buffer : vertex_bindings.buffers) {
     if (!BindUniformBuffer(gl, transients_allocator, buffer.second)) {
       return false;
@@ -155,24 +167,17 @@ bool BufferBindingsGLES::BindUniformData(
     }
   }
 
-  if (!BindTextures(gl, vertex_bindings, ShaderStage::kVertex)) {
+  if (!BindTextures(state, vertex_bindings, ShaderStage::kVertex)) {
     return false;
   }
 
-  if (!BindTextures(gl, fragment_bindings, ShaderStage::kFragment)) {
+  if (!BindTextures(state, fragment_bindings, ShaderStage::kFragment)) {
     return false;
   }
 
   return true;
 }
 
-bool BufferBindingsGLES::UnbindVertexAttributes(const ProcTableGLES& gl) const {
-  for (const auto& array : vertex_attrib_arrays_) {
-    gl.DisableVertexAttribArray(array.index);
-  }
-  return true;
-}
-
 bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
                                            Allocator& transients_allocator,
                                            const BufferResource& buffer) const {
@@ -301,9 +306,10 @@ bool BufferBindingsGLES::BindUniformBuffer(const ProcTableGLES& gl,
   return true;
 }
 
-bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
+bool BufferBindingsGLES::BindTextures(StateCacheGLES& state,
                                       const Bindings& bindings,
                                       ShaderStage stage) const {
+  const auto& gl = state.GetProcTable();
   size_t active_index = 0;
   for (const auto& texture : bindings.textures) {
     const auto& texture_gles = TextureGLES::Cast(*texture.second.resource);
@@ -320,33 +326,48 @@ bool BufferBindingsGLES::BindTextures(const ProcTableGLES& gl,
       return false;
     }
 
-    //--------------------------------------------------------------------------
-    /// Set the active texture unit.
-    ///
     if (active_index >= gl.GetCapabilities()->GetMaxTextureUnits(stage)) {
       VALIDATION_LOG << "Texture units specified exceed the capabilities for "
                         "this shader stage.";
       return false;
     }
-    gl.ActiveTexture(GL_TEXTURE0 + active_index);
 
-    //--------------------------------------------------------------------------
-    /// Bind the texture.
-    ///
-    if (!texture_gles.Bind()) {
+    auto handle = texture_gles.GetGLHandle();
+    if (!handle.has_value()) {
       return false;
     }
+    auto sampler = bindings.samplers.find(texture.first);
+    const SamplerGLES* sampler_gles =
+        sampler != bindings.samplers.end()
+            ? &SamplerGLES::Cast(*sampler->second.resource)
+            : nullptr;
 
     //--------------------------------------------------------------------------
-    /// If there is a sampler for the texture at the same index, configure the
-    /// bound texture using that sampler.
+    /// Bind the texture to the active index unless an earlier command already
+    /// did so with the same sampler.
     ///
-    auto sampler = bindings.samplers.find(texture.first);
-    if (sampler != bindings.samplers.end()) {
-      const auto& sampler_gles = SamplerGLES::Cast(*sampler->second.resource);
-      if (!sampler_gles.ConfigureBoundTexture(texture_gles, gl)) {
+    if (!state.IsTextureBound(active_index, handle.value(), sampler_gles)) {
+      //------------------------------------------------------------------------
+      /// Set the active texture unit.
+      ///
+      state.ActiveTexture(GL_TEXTURE0 + active_index);
+
+      //------------------------------------------------------------------------
+      /// Bind the texture.
+      ///
+      if (!texture_gles.Bind()) {
+        return false;
+      }
+
+      //------------------------------------------------------------------------
+      /// If there is a sampler for the texture at the same index, configure
+      /// the bound texture using that sampler.
+      ///
+      if (sampler_gles &&
+          !sampler_gles->ConfigureBoundTexture(texture_gles, gl)) {
         return false;
       }
+      state.SetTextureBound(active_index, handle.value(), sampler_gles);
     }
 
     //--------------------------------------------------------------------------
@@ -10,6 +10,7 @@
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/gles/gles.h"
 #include "impeller/renderer/backend/gles/proc_table_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
 #include "impeller/renderer/command.h"
 #include "impeller/renderer/vertex_descriptor.h"
 
@@ -32,16 +33,13 @@ class BufferBindingsGLES {
 
   bool ReadUniformsBindings(const ProcTableGLES& gl, GLuint program);
 
-  bool BindVertexAttributes(const ProcTableGLES& gl,
-                            size_t vertex_offset) const;
+  bool BindVertexAttributes(StateCacheGLES& state, size_t vertex_offset) const;
 
-  bool BindUniformData(const ProcTableGLES& gl,
+  bool BindUniformData(StateCacheGLES& state,
                        Allocator& transients_allocator,
                        const Bindings& vertex_bindings,
                        const Bindings& fragment_bindings) const;
 
-  bool UnbindVertexAttributes(const ProcTableGLES& gl) const;
-
  private:
   //----------------------------------------------------------------------------
   /// @brief      The arguments to glVertexAttribPointer.
@@ -61,7 +59,7 @@ class BufferBindingsGLES {
                          Allocator& transients_allocator,
                          const BufferResource& buffer) const;
 
-  bool BindTextures(const ProcTableGLES& gl,
+  bool BindTextures(StateCacheGLES& state,
                     const Bindings& bindings,
                     ShaderStage stage) const;
 
@@ -67,7 +67,7 @@ std::optional<GLuint> ReactorGLES::GetGLHandle(const HandleGLES& handle) const {
   return std::nullopt;
 }
 
-bool ReactorGLES::AddOperation(Operation operation) {
+bool ReactorGLES::AddOperation(Operation operation, bool defer) {
   if (!operation) {
     return false;
   }
@@ -75,6 +75,9 @@ bool ReactorGLES::AddOperation(Operation operation) {
     Lock ops_lock(ops_mutex_);
     ops_.emplace_back(std::move(operation));
   }
+  if (defer) {
+    return true;
+  }
   // Attempt a reaction if able but it is not an error if this isn't possible.
   [[maybe_unused]] auto result = React();
   return true;
@@ -142,6 +145,9 @@ HandleGLES ReactorGLES::CreateHandle(HandleType type) {
                        ? CreateGLHandle(GetProcTable(), type)
                        : std::nullopt;
   handles_[new_handle] = LiveHandle{gl_handle};
+  if (!gl_handle.has_value()) {
+    handles_need_consolidation_ = true;
+  }
   return new_handle;
 }
 
@@ -149,6 +155,7 @@ void ReactorGLES::CollectHandle(HandleGLES handle) {
   WriterLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
     found->second.pending_collection = true;
+    handles_need_consolidation_ = true;
   }
 }
 
@@ -195,6 +202,12 @@ bool ReactorGLES::ConsolidateHandles() {
   TRACE_EVENT0("impeller", __FUNCTION__);
   const auto& gl = GetProcTable();
   WriterLock handles_lock(handles_mutex_);
+  // Most reactions only perform operations, don't walk all the live handles
+  // in that case.
+  if (!handles_need_consolidation_) {
+    return true;
+  }
+  bool has_pending_debug_labels = false;
   std::vector<HandleGLES> handles_to_delete;
   for (auto& handle : handles_) {
     // Collect dead handles.
@@ -222,12 +235,15 @@ bool ReactorGLES::ConsolidateHandles() {
                            handle.second.name.value(),
                            handle.second.pending_debug_label.value())) {
         handle.second.pending_debug_label = std::nullopt;
+      } else {
+        has_pending_debug_labels = true;
       }
     }
   }
   for (const auto& handle_to_delete : handles_to_delete) {
     handles_.erase(handle_to_delete);
   }
+  handles_need_consolidation_ = has_pending_debug_labels;
   return true;
 }
 
@@ -257,6 +273,7 @@ void ReactorGLES::SetDebugLabel(const HandleGLES& handle, std::string label) {
   WriterLock handles_lock(handles_mutex_);
   if (auto found = handles_.find(handle); found != handles_.end()) {
     found->second.pending_debug_label = std::move(label);
+    handles_need_consolidation_ = true;
   }
 }
 
@@ -51,7 +51,22 @@ class ReactorGLES {
   void SetDebugLabel(const HandleGLES& handle, std::string label);
 
   using Operation = std::function<void(const ReactorGLES& reactor)>;
-  [[nodiscard]] bool AddOperation(Operation operation);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enqueue an operation to be performed on a thread where the
+  ///             reactor can react.
+  ///
+  /// @param[in]  operation  The operation.
+  /// @param[in]  defer      If true, the operation is only performed on the
+  ///                        next reaction instead of attempting one right away.
+  ///                        This allows operations that are always followed by
+  ///                        a reaction (like the encoding of passes followed
+  ///                        by the submission of their command buffer) to be
+  ///                        performed together.
+  ///
+  /// @return     If the operation was enqueued.
+  ///
+  [[nodiscard]] bool AddOperation(Operation operation, bool defer = false);
 
   [[nodiscard]] bool React();
 
@@ -82,6 +97,9 @@ class ReactorGLES {
                                          HandleGLES::Equal>;
   mutable RWMutex handles_mutex_;
   LiveHandles handles_ IPLR_GUARDED_BY(handles_mutex_);
+  // Whether any handle needs to be created, collected, or labelled during the
+  // next reaction.
+  bool handles_need_consolidation_ IPLR_GUARDED_BY(handles_mutex_) = false;
 
   mutable Mutex workers_mutex_;
   mutable std::map<WorkerID, std::weak_ptr<Worker>> workers_
@@ -0,0 +1,212 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+
+namespace impeller {
+
+StateCacheGLES::StateCacheGLES(const ProcTableGLES& gl) : gl_(gl) {}
+
+StateCacheGLES::~StateCacheGLES() = default;
+
+void StateCacheGLES::Enable(GLenum capability) {
+  SetCapability(capability, true);
+}
+
+void StateCacheGLES::Disable(GLenum capability) {
+  SetCapability(capability, false);
+}
+
+void StateCacheGLES::SetCapability(GLenum capability, bool enabled) {
+  std::optional<bool>* current = nullptr;
+  switch (capability) {
+    case GL_BLEND:
+      current = &capabilities_[static_cast<size_t>(Capability::kBlend)];
+      break;
+    case GL_CULL_FACE:
+      current = &capabilities_[static_cast<size_t>(Capability::kCullFace)];
+      break;
+    case GL_DEPTH_TEST:
+      current = &capabilities_[static_cast<size_t>(Capability::kDepthTest)];
+      break;
+    case GL_SCISSOR_TEST:
+      current = &capabilities_[static_cast<size_t>(Capability::kScissorTest)];
+      break;
+    case GL_STENCIL_TEST:
+      current = &capabilities_[static_cast<size_t>(Capability::kStencilTest)];
+      break;
+  }
+  const auto set = [&]() {
+    if (enabled) {
+      gl_.Enable(capability);
+    } else {
+      gl_.Disable(capability);
+    }
+  };
+  if (!current) {
+    set();
+    return;
+  }
+  Set(*current, enabled, set);
+}
+
+void StateCacheGLES::BlendFuncSeparate(GLenum src_color,
+                                       GLenum dst_color,
+                                       GLenum src_alpha,
+                                       GLenum dst_alpha) {
+  Set(blend_func_, std::make_tuple(src_color, dst_color, src_alpha, dst_alpha),
+      [&]() {
+        gl_.BlendFuncSeparate(src_color, dst_color, src_alpha, dst_alpha);
+      });
+}
+
+void StateCacheGLES::BlendEquationSeparate(GLenum mode_color,
+                                           GLenum mode_alpha) {
+  Set(blend_equation_, std::make_tuple(mode_color, mode_alpha),
+      [&]() { gl_.BlendEquationSeparate(mode_color, mode_alpha); });
+}
+
+void StateCacheGLES::ColorMask(GLboolean red,
+                               GLboolean green,
+                               GLboolean blue,
+                               GLboolean alpha) {
+  Set(color_mask_, std::make_tuple(red, green, blue, alpha),
+      [&]() { gl_.ColorMask(red, green, blue, alpha); });
+}
+
+template <class T, class Setter>
+void StateCacheGLES::SetStencil(GLenum face,
+                                std::optional<T> StencilFaceState::*state,
+                                const T& value,
+                                const Setter& setter) {
+  const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+  const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+  if ((!front || front_stencil_.*state == value) &&
+      (!back || back_stencil_.*state == value)) {
+    elided_call_count_++;
+    return;
+  }
+  setter();
+  if (front) {
+    front_stencil_.*state = value;
+  }
+  if (back) {
+    back_stencil_.*state = value;
+  }
+}
+
+void StateCacheGLES::StencilOpSeparate(GLenum face,
+                                       GLenum stencil_fail,
+                                       GLenum depth_fail,
+                                       GLenum depth_stencil_pass) {
+  SetStencil(face, &StencilFaceState::op,
+             std::make_tuple(stencil_fail, depth_fail, depth_stencil_pass),
+             [&]() {
+               gl_.StencilOpSeparate(face, stencil_fail, depth_fail,
+                                     depth_stencil_pass);
+             });
+}
+
+void StateCacheGLES::StencilFuncSeparate(GLenum face,
+                                         GLenum func,
+                                         GLint ref,
+                                         GLuint mask) {
+  SetStencil(face, &StencilFaceState::func, std::make_tuple(func, ref, mask),
+             [&]() { gl_.StencilFuncSeparate(face, func, ref, mask); });
+}
+
+void StateCacheGLES::StencilMaskSeparate(GLenum face, GLuint mask) {
+  SetStencil(face, &StencilFaceState::write_mask, mask,
+             [&]() { gl_.StencilMaskSeparate(face, mask); });
+}
+
+void StateCacheGLES::DepthFunc(GLenum func) {
+  Set(depth_func_, func, [&]() { gl_.DepthFunc(func); });
+}
+
+void StateCacheGLES::DepthMask(GLboolean flag) {
+  Set(depth_mask_, flag, [&]() { gl_.DepthMask(flag); });
+}
+
+void StateCacheGLES::DepthRangef(GLfloat z_near, GLfloat z_far) {
+  Set(depth_range_, std::make_tuple(z_near, z_far),
+      [&]() { gl_.DepthRangef(z_near, z_far); });
+}
+
+void StateCacheGLES::Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  Set(viewport_, std::make_tuple(x, y, width, height),
+      [&]() { gl_.Viewport(x, y, width, height); });
+}
+
+void StateCacheGLES::Scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  Set(scissor_, std::make_tuple(x, y, width, height),
+      [&]() { gl_.Scissor(x, y, width, height); });
+}
+
+void StateCacheGLES::CullFace(GLenum mode) {
+  Set(cull_face_, mode, [&]() { gl_.CullFace(mode); });
+}
+
+void StateCacheGLES::FrontFace(GLenum mode) {
+  Set(front_face_, mode, [&]() { gl_.FrontFace(mode); });
+}
+
+void StateCacheGLES::UseProgram(GLuint program) {
+  Set(program_, program, [&]() { gl_.UseProgram(program); });
+}
+
+void StateCacheGLES::SetEnabledVertexAttribArrays(uint32_t mask) {
+  for (GLuint index = 0u; index < kMaxVertexAttribArrays; index++) {
+    const uint32_t bit = 1u << index;
+    const bool enabled = enabled_vertex_attrib_arrays_ & bit;
+    const bool enable = mask & bit;
+    if (enabled == enable) {
+      if (enable) {
+        elided_call_count_++;
+      }
+      continue;
+    }
+    if (enable) {
+      gl_.EnableVertexAttribArray(index);
+    } else {
+      gl_.DisableVertexAttribArray(index);
+    }
+  }
+  enabled_vertex_attrib_arrays_ = mask;
+}
+
+void StateCacheGLES::ActiveTexture(GLenum unit) {
+  Set(active_texture_, unit, [&]() { gl_.ActiveTexture(unit); });
+}
+
+bool StateCacheGLES::IsTextureBound(GLuint unit,
+                                    GLuint texture,
+                                    const void* sampler) {
+  if (unit >= texture_units_.size() || texture_units_[unit] != texture) {
+    return false;
+  }
+  if (sampler) {
+    auto configured = texture_samplers_.find(texture);
+    if (configured == texture_samplers_.end() ||
+        configured->second != sampler) {
+      return false;
+    }
+  }
+  elided_call_count_++;
+  return true;
+}
+
+void StateCacheGLES::SetTextureBound(GLuint unit,
+                                     GLuint texture,
+                                     const void* sampler) {
+  if (unit >= texture_units_.size()) {
+    texture_units_.resize(unit + 1u);
+  }
+  texture_units_[unit] = texture;
+  if (sampler) {
+    texture_samplers_[texture] = sampler;
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,175 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/gles/gles.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A shadow copy of the GL state set while encoding a render pass.
+///
+///             Calls that would set state to the value it already has are
+///             elided. Nothing is known about the GL state when the cache is
+///             created, except that no vertex attribute arrays are enabled,
+///             so the first call for each piece of state always goes through.
+///
+///             All state changes made while the cache is in use must go
+///             through it.
+///
+class StateCacheGLES {
+ public:
+  /// Vertex attribute arrays at or above this index can't be enabled through
+  /// the cache.
+  static constexpr GLuint kMaxVertexAttribArrays = 32u;
+
+  explicit StateCacheGLES(const ProcTableGLES& gl);
+
+  ~StateCacheGLES();
+
+  const ProcTableGLES& GetProcTable() const { return gl_; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of GL calls that were elided because the state
+  ///             they would have set was already current.
+  ///
+  size_t GetElidedCallCount() const { return elided_call_count_; }
+
+  void Enable(GLenum capability);
+
+  void Disable(GLenum capability);
+
+  void BlendFuncSeparate(GLenum src_color,
+                         GLenum dst_color,
+                         GLenum src_alpha,
+                         GLenum dst_alpha);
+
+  void BlendEquationSeparate(GLenum mode_color, GLenum mode_alpha);
+
+  void ColorMask(GLboolean red,
+                 GLboolean green,
+                 GLboolean blue,
+                 GLboolean alpha);
+
+  void StencilOpSeparate(GLenum face,
+                         GLenum stencil_fail,
+                         GLenum depth_fail,
+                         GLenum depth_stencil_pass);
+
+  void StencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+
+  void StencilMaskSeparate(GLenum face, GLuint mask);
+
+  void DepthFunc(GLenum func);
+
+  void DepthMask(GLboolean flag);
+
+  void DepthRangef(GLfloat z_near, GLfloat z_far);
+
+  void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  void CullFace(GLenum mode);
+
+  void FrontFace(GLenum mode);
+
+  void UseProgram(GLuint program);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Enable exactly the vertex attribute arrays whose bits are set
+  ///             in the mask and disable all others.
+  ///
+  void SetEnabledVertexAttribArrays(uint32_t mask);
+
+  void ActiveTexture(GLenum unit);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the texture is bound to the unit and was last
+  ///             configured with the sampler, if any. If so, the bind is
+  ///             counted as elided.
+  ///
+  ///             Sampler parameters are state of the texture object in GLES2,
+  ///             so configuring the texture for another unit with a different
+  ///             sampler invalidates the configuration of every unit.
+  ///
+  bool IsTextureBound(GLuint unit, GLuint texture, const void* sampler);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record that the texture was bound to the unit and configured
+  ///             with the sampler.
+  ///
+  void SetTextureBound(GLuint unit, GLuint texture, const void* sampler);
+
+ private:
+  enum class Capability {
+    kBlend,
+    kCullFace,
+    kDepthTest,
+    kScissorTest,
+    kStencilTest,
+    kLast,
+  };
+
+  struct StencilFaceState {
+    std::optional<std::tuple<GLenum, GLenum, GLenum>> op;
+    std::optional<std::tuple<GLenum, GLint, GLuint>> func;
+    std::optional<GLuint> write_mask;
+  };
+
+  const ProcTableGLES& gl_;
+  size_t elided_call_count_ = 0u;
+  std::array<std::optional<bool>, static_cast<size_t>(Capability::kLast)>
+      capabilities_;
+  std::optional<std::tuple<GLenum, GLenum, GLenum, GLenum>> blend_func_;
+  std::optional<std::tuple<GLenum, GLenum>> blend_equation_;
+  std::optional<std::tuple<GLboolean, GLboolean, GLboolean, GLboolean>>
+      color_mask_;
+  StencilFaceState front_stencil_;
+  StencilFaceState back_stencil_;
+  std::optional<GLenum> depth_func_;
+  std::optional<GLboolean> depth_mask_;
+  std::optional<std::tuple<GLfloat, GLfloat>> depth_range_;
+  std::optional<std::tuple<GLint, GLint, GLsizei, GLsizei>> viewport_;
+  std::optional<std::tuple<GLint, GLint, GLsizei, GLsizei>> scissor_;
+  std::optional<GLenum> cull_face_;
+  std::optional<GLenum> front_face_;
+  std::optional<GLuint> program_;
+  uint32_t enabled_vertex_attrib_arrays_ = 0u;
+  std::optional<GLenum> active_texture_;
+  std::vector<std::optional<GLuint>> texture_units_;
+  std::unordered_map<GLuint, const void*> texture_samplers_;
+
+  void SetCapability(GLenum capability, bool enabled);
+
+  template <class T, class Setter>
+  void Set(std::optional<T>& current, const T& value, const Setter& setter) {
+    if (current == value) {
+      elided_call_count_++;
+      return;
+    }
+    setter();
+    current = value;
+  }
+
+  template <class T, class Setter>
+  void SetStencil(GLenum face,
+                  std::optional<T> StencilFaceState::*state,
+                  const T& value,
+                  const Setter& setter);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StateCacheGLES);
+};
+
+}  // namespace impeller
@@ -0,0 +1,180 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/gles/reactor_gles.h"
+#include "impeller/renderer/backend/gles/state_cache_gles.h"
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+/// Sets the state of a draw the way |RenderPassGLES| does for every command.
+void SetDrawState(StateCacheGLES& state, GLuint program, GLuint texture) {
+  state.Enable(GL_BLEND);
+  state.BlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                          GL_ONE_MINUS_SRC_ALPHA);
+  state.BlendEquationSeparate(GL_FUNC_ADD, GL_FUNC_ADD);
+  state.ColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  state.Enable(GL_STENCIL_TEST);
+  state.StencilOpSeparate(GL_FRONT_AND_BACK, GL_KEEP, GL_KEEP, GL_KEEP);
+  state.StencilFuncSeparate(GL_FRONT_AND_BACK, GL_EQUAL, 0, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  state.Disable(GL_DEPTH_TEST);
+  state.Viewport(0, 0, 800, 600);
+  state.Disable(GL_SCISSOR_TEST);
+  state.Disable(GL_CULL_FACE);
+  state.FrontFace(GL_CW);
+  state.UseProgram(program);
+  state.SetEnabledVertexAttribArrays(0b11);
+  if (!state.IsTextureBound(0u, texture, nullptr)) {
+    state.ActiveTexture(GL_TEXTURE0);
+    state.GetProcTable().BindTexture(GL_TEXTURE_2D, texture);
+    state.SetTextureBound(0u, texture, nullptr);
+  }
+}
+}  // namespace
+
+TEST(StateCacheGLESTest, ElidesRedundantStateInFrame) {
+  auto mock_gles = MockGLES::Create();
+  constexpr size_t kDrawCount = 100u;
+
+  // What used to be set when every draw got a fresh state cache.
+  for (size_t i = 0; i < kDrawCount; i++) {
+    StateCacheGLES state(mock_gles->GetProcTable());
+    SetDrawState(state, 1u, 2u);
+  }
+  const auto uncached_calls = mock_gles->GetCapturedCalls().size();
+  mock_gles->ResetCapturedCalls();
+
+  StateCacheGLES state(mock_gles->GetProcTable());
+  for (size_t i = 0; i < kDrawCount; i++) {
+    SetDrawState(state, 1u, 2u);
+  }
+  const auto cached_calls = mock_gles->GetCapturedCalls().size();
+
+  // Only the first draw sets any state.
+  EXPECT_EQ(uncached_calls, cached_calls * kDrawCount);
+  // Skipping a texture bind also skips selecting its texture unit.
+  EXPECT_EQ(state.GetElidedCallCount(),
+            (uncached_calls - cached_calls) - (kDrawCount - 1u));
+  EXPECT_EQ(mock_gles->GetCallCount("glUseProgram"), 1u);
+  EXPECT_EQ(mock_gles->GetCallCount("glBindTexture"), 1u);
+  EXPECT_EQ(mock_gles->GetCallCount("glEnableVertexAttribArray"), 2u);
+}
+
+TEST(StateCacheGLESTest, SetsStateThatChanged) {
+  auto mock_gles = MockGLES::Create();
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  SetDrawState(state, 1u, 2u);
+  mock_gles->ResetCapturedCalls();
+  SetDrawState(state, 3u, 4u);
+
+  EXPECT_EQ(mock_gles->GetCallCount("glUseProgram"), 1u);
+  EXPECT_EQ(mock_gles->GetCallCount("glBindTexture"), 1u);
+  EXPECT_EQ(mock_gles->GetCapturedCalls().size(), 2u);
+
+  state.SetEnabledVertexAttribArrays(0b101);
+  EXPECT_EQ(mock_gles->GetCallCount("glDisableVertexAttribArray"), 1u);
+  EXPECT_EQ(mock_gles->GetCallCount("glEnableVertexAttribArray"), 1u);
+}
+
+TEST(StateCacheGLESTest, TracksStencilFacesSeparately) {
+  auto mock_gles = MockGLES::Create();
+  StateCacheGLES state(mock_gles->GetProcTable());
+
+  state.StencilMaskSeparate(GL_FRONT, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT_AND_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_BACK, 0xFF);
+  state.StencilMaskSeparate(GL_FRONT, 0xFF);
+
+  EXPECT_EQ(mock_gles->GetCallCount("glStencilMaskSeparate"), 2u);
+}
+
+TEST(StateCacheGLESTest, ReconfiguresTextureSampledWithAnotherSampler) {
+  auto mock_gles = MockGLES::Create();
+  StateCacheGLES state(mock_gles->GetProcTable());
+  constexpr GLuint kTexture = 2u;
+  int nearest = 0;
+  int linear = 0;
+  // Binds and configures the texture the way |BufferBindingsGLES| does.
+  auto bind = [&](GLuint unit, const void* sampler) {
+    if (!state.IsTextureBound(unit, kTexture, sampler)) {
+      state.ActiveTexture(GL_TEXTURE0 + unit);
+      state.GetProcTable().BindTexture(GL_TEXTURE_2D, kTexture);
+      state.GetProcTable().TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                                         sampler == &nearest ? GL_NEAREST
+                                                             : GL_LINEAR);
+      state.SetTextureBound(unit, kTexture, sampler);
+    }
+  };
+
+  bind(0u, &nearest);
+  bind(0u, &nearest);
+  EXPECT_EQ(mock_gles->GetCallCount("glTexParameteri"), 1u);
+
+  // Configuring the texture for another unit changes it for unit 0 too.
+  bind(1u, &linear);
+  bind(0u, &nearest);
+  EXPECT_EQ(mock_gles->GetCallCount("glTexParameteri"), 3u);
+  EXPECT_EQ(mock_gles->GetCallCount("glBindTexture"), 3u);
+}
+
+namespace {
+class TestWorker : public ReactorGLES::Worker {
+ public:
+  // |ReactorGLES::Worker|
+  bool CanReactorReactOnCurrentThreadNow(
+      const ReactorGLES& reactor) const override {
+    return true;
+  }
+};
+}  // namespace
+
+TEST(ReactorGLESTest, PerformsDeferredOperationsOnNextReaction) {
+  auto mock_gles = MockGLES::Create();
+  auto reactor = std::make_shared<ReactorGLES>(mock_gles->TakeProcTable());
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+
+  std::vector<int> performed;
+  ASSERT_TRUE(reactor->AddOperation(
+      [&performed](const auto& reactor) { performed.push_back(1); },
+      /*defer=*/true));
+  ASSERT_TRUE(reactor->AddOperation(
+      [&performed](const auto& reactor) { performed.push_back(2); },
+      /*defer=*/true));
+  EXPECT_TRUE(performed.empty());
+
+  ASSERT_TRUE(reactor->AddOperation(
+      [&performed](const auto& reactor) { performed.push_back(3); }));
+  EXPECT_EQ(performed, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(ReactorGLESTest, CreatesAndCollectsHandlesOnReaction) {
+  auto mock_gles = MockGLES::Create();
+  auto reactor = std::make_shared<ReactorGLES>(mock_gles->TakeProcTable());
+
+  // Handles created without a worker can't be given a name yet.
+  auto handle = reactor->CreateHandle(HandleType::kTexture);
+  EXPECT_EQ(mock_gles->GetCallCount("glGenTextures"), 0u);
+
+  auto worker = std::make_shared<TestWorker>();
+  reactor->AddWorker(worker);
+  ASSERT_TRUE(reactor->AddOperation([](const auto& reactor) {}));
+  EXPECT_EQ(mock_gles->GetCallCount("glGenTextures"), 1u);
+
+  // Reactions that only perform operations leave the handles alone.
+  ASSERT_TRUE(reactor->AddOperation([](const auto& reactor) {}));
+  EXPECT_EQ(mock_gles->GetCallCount("glGenTextures"), 1u);
+
+  reactor->CollectHandle(handle);
+  ASSERT_TRUE(reactor->AddOperation([](const auto& reactor) {}));
+  EXPECT_EQ(mock_gles->GetCallCount("glDeleteTextures"), 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,136 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/gles/test/mock_gles.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace impeller {
+namespace testing {
+
+static MockGLES* g_mock_gles = nullptr;
+
+void RecordGLCall(const char* name) {
+  if (g_mock_gles) {
+    g_mock_gles->captured_calls_.emplace_back(name);
+  }
+}
+
+namespace {
+
+template <class Name, class Function>
+struct MockProc;
+
+template <class Name, class Result, class... Args>
+struct MockProc<Name, Result(Args...)> {
+  static Result Call(Args...) {
+    RecordGLCall(Name::kName);
+    return Result{};
+  }
+};
+
+template <class Name, class... Args>
+struct MockProc<Name, void(Args...)> {
+  static void Call(Args...) { RecordGLCall(Name::kName); }
+};
+
+#define IMPELLER_PROC(name)                          \
+  struct name##Name {                                \
+    static constexpr const char* kName = "gl" #name; \
+  }
+FOR_EACH_IMPELLER_PROC(IMPELLER_PROC);
+FOR_EACH_IMPELLER_GLES3_PROC(IMPELLER_PROC);
+FOR_EACH_IMPELLER_EXT_PROC(IMPELLER_PROC);
+#undef IMPELLER_PROC
+
+GLenum mockGetError() {
+  return GL_NO_ERROR;
+}
+
+const GLubyte* mockGetString(GLenum name) {
+  RecordGLCall("glGetString");
+  switch (name) {
+    case GL_VERSION:
+      return reinterpret_cast<const GLubyte*>("OpenGL ES 3.0");
+    case GL_SHADING_LANGUAGE_VERSION:
+      return reinterpret_cast<const GLubyte*>("OpenGL ES GLSL ES 1.0");
+    default:
+      return reinterpret_cast<const GLubyte*>("");
+  }
+}
+
+void mockGetIntegerv(GLenum name, GLint* value) {
+  RecordGLCall("glGetIntegerv");
+  switch (name) {
+    case GL_MAX_VIEWPORT_DIMS:
+      value[0] = 4096;
+      value[1] = 4096;
+      break;
+    default:
+      value[0] = 4096;
+      break;
+  }
+}
+
+GLenum mockCheckFramebufferStatus(GLenum target) {
+  RecordGLCall("glCheckFramebufferStatus");
+  return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void* ResolveMockProc(const char* name) {
+  if (strcmp(name, "glGetError") == 0) {
+    return reinterpret_cast<void*>(&mockGetError);
+  }
+  if (strcmp(name, "glGetString") == 0) {
+    return reinterpret_cast<void*>(&mockGetString);
+  }
+  if (strcmp(name, "glGetIntegerv") == 0) {
+    return reinterpret_cast<void*>(&mockGetIntegerv);
+  }
+  if (strcmp(name, "glCheckFramebufferStatus") == 0) {
+    return reinterpret_cast<void*>(&mockCheckFramebufferStatus);
+  }
+#define IMPELLER_PROC(proc)                                \
+  if (strcmp(name, "gl" #proc) == 0) {                     \
+    using Proc = MockProc<proc##Name, decltype(gl##proc)>; \
+    return reinterpret_cast<void*>(&Proc::Call);           \
+  }
+  FOR_EACH_IMPELLER_PROC(IMPELLER_PROC);
+  FOR_EACH_IMPELLER_GLES3_PROC(IMPELLER_PROC);
+  FOR_EACH_IMPELLER_EXT_PROC(IMPELLER_PROC);
+#undef IMPELLER_PROC
+  return nullptr;
+}
+
+}  // namespace
+
+std::unique_ptr<MockGLES> MockGLES::Create() {
+  FML_CHECK(g_mock_gles == nullptr) << "Only one mock may be alive at a time.";
+  return std::unique_ptr<MockGLES>(new MockGLES());
+}
+
+MockGLES::MockGLES()
+    : proc_table_(std::make_unique<ProcTableGLES>(ResolveMockProc)) {
+  g_mock_gles = this;
+}
+
+MockGLES::~MockGLES() {
+  g_mock_gles = nullptr;
+}
+
+std::unique_ptr<ProcTableGLES> MockGLES::TakeProcTable() {
+  return std::move(proc_table_);
+}
+
+size_t MockGLES::GetCallCount(const std::string& name) const {
+  return std::count(captured_calls_.begin(), captured_calls_.end(), name);
+}
+
+void MockGLES::ResetCapturedCalls() {
+  captured_calls_.clear();
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,54 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "impeller/renderer/backend/gles/proc_table_gles.h"
+
+namespace impeller {
+namespace testing {
+
+//------------------------------------------------------------------------------
+/// @brief      A proc table whose functions do nothing but record that they
+///             were called.
+///
+///             Only one mock may be alive at a time since the functions it
+///             resolves to can't tell which mock they belong to.
+///
+class MockGLES {
+ public:
+  static std::unique_ptr<MockGLES> Create();
+
+  ~MockGLES();
+
+  const ProcTableGLES& GetProcTable() const { return *proc_table_; }
+
+  std::unique_ptr<ProcTableGLES> TakeProcTable();
+
+  const std::vector<std::string>& GetCapturedCalls() const {
+    return captured_calls_;
+  }
+
+  size_t GetCallCount(const std::string& name) const;
+
+  void ResetCapturedCalls();
+
+ private:
+  friend void RecordGLCall(const char* name);
+
+  std::unique_ptr<ProcTableGLES> proc_table_;
+  std::vector<std::string> captured_calls_;
+
+  MockGLES();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(MockGLES);
+};
+
+}  // namespace testing
+}  // namespace impeller
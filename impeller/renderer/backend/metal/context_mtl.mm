@@ -315,6 +315,15 @@ std::shared_ptr<CommandBuffer> ContextMTL::CreateCommandBuffer() const {
   return CreateCommandBufferInQueue(command_queue_);
 }
 
+// |Context|
+std::shared_ptr<fml::ConcurrentTaskRunner>
+ContextMTL::GetConcurrentWorkerTaskRunner() const {
+  if (!raster_message_loop_) {
+    return nullptr;
+  }
+  return raster_message_loop_->GetTaskRunner();
+}
+
 // |Context|
 void ContextMTL::Shutdown() {
   raster_message_loop_.reset();
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "flutter/fml/logging.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/core/formats.h"
@@ -16,6 +17,59 @@
 
 namespace impeller {
 
+static VkBufferCreateInfo ToVKBufferCreateInfo(size_t size) {
+  vk::BufferCreateInfo buffer_info;
+  buffer_info.usage = vk::BufferUsageFlagBits::eVertexBuffer |
+                      vk::BufferUsageFlagBits::eIndexBuffer |
+                      vk::BufferUsageFlagBits::eUniformBuffer |
+                      vk::BufferUsageFlagBits::eStorageBuffer |
+                      vk::BufferUsageFlagBits::eTransferSrc |
+                      vk::BufferUsageFlagBits::eTransferDst;
+  buffer_info.size = size;
+  buffer_info.sharingMode = vk::SharingMode::eExclusive;
+  return static_cast<vk::BufferCreateInfo::NativeType>(buffer_info);
+}
+
+static VmaPool CreateTransientBufferPool(VmaAllocator allocator) {
+  TRACE_EVENT0("impeller", "CreateTransientBufferPool");
+  auto buffer_info = ToVKBufferCreateInfo(1u);
+
+  VmaAllocationCreateInfo allocation_info = {};
+  allocation_info.usage = VMA_MEMORY_USAGE_AUTO;
+  allocation_info.preferredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                                   VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+  allocation_info.flags =
+      VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+      VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  uint32_t memory_type_index = 0u;
+  auto result = vk::Result{::vmaFindMemoryTypeIndexForBufferInfo(
+      allocator, &buffer_info, &allocation_info, &memory_type_index)};
+  if (result != vk::Result::eSuccess) {
+    return {};
+  }
+
+  // A single block with the linear algorithm behaves as a ring buffer as
+  // long as allocations are freed in roughly the order they were made.
+  VmaPoolCreateInfo pool_info = {};
+  pool_info.memoryTypeIndex = memory_type_index;
+  pool_info.flags = VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT;
+  pool_info.blockSize = kTransientBufferPoolSize;
+  pool_info.minBlockCount = 1u;
+  pool_info.maxBlockCount = 1u;
+
+  VmaPool pool = {};
+  result = vk::Result{::vmaCreatePool(allocator, &pool_info, &pool)};
+  if (result != vk::Result::eSuccess) {
+    // Not fatal. All buffers will get allocations of their own.
+    FML_LOG(ERROR) << "Could not create the transient buffer pool: "
+                   << vk::to_string(result);
+    return {};
+  }
+  return pool;
+}
+
 AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
                          uint32_t vulkan_api_version,
                          const vk::PhysicalDevice& physical_device,
@@ -94,12 +148,16 @@ AllocatorVK::AllocatorVK(std::weak_ptr<Context> context,
     return;
   }
   allocator_ = allocator;
+  transient_buffer_pool_ = CreateTransientBufferPool(allocator_);
   supports_memoryless_textures_ = capabilities.SupportsMemorylessTextures();
   is_valid_ = true;
 }
 
 AllocatorVK::~AllocatorVK() {
   TRACE_EVENT0("impeller", "DestroyAllocatorVK");
+  if (transient_buffer_pool_) {
+    ::vmaDestroyPool(allocator_, transient_buffer_pool_);
+  }
   if (allocator_) {
     ::vmaDestroyAllocator(allocator_);
   }
@@ -110,6 +168,20 @@ bool AllocatorVK::IsValid() const {
   return is_valid_;
 }
 
+AllocatorVK::Stats AllocatorVK::GetStats() const {
+  Stats stats;
+  if (transient_buffer_pool_) {
+    VmaStatistics pool_stats = {};
+    ::vmaGetPoolStatistics(allocator_, transient_buffer_pool_, &pool_stats);
+    stats.transient_buffer_count = pool_stats.allocationCount;
+    stats.transient_buffer_bytes = pool_stats.allocationBytes;
+    stats.transient_pool_bytes = pool_stats.blockBytes;
+  }
+  stats.transient_pool_overflow_count = transient_pool_overflow_count_;
+  stats.lazily_allocated_texture_count = lazily_allocated_texture_count_;
+  return stats;
+}
+
 // |Allocator|
 ISize AllocatorVK::GetMaxTextureSizeSupported() const {
   return max_texture_size_;
@@ -177,6 +249,11 @@ static constexpr VmaMemoryUsage ToVMAMemoryUsage() {
   return VMA_MEMORY_USAGE_AUTO;
 }
 
+static constexpr bool IsLazilyAllocated(const vk::ImageCreateInfo& info) {
+  return static_cast<bool>(info.usage &
+                           vk::ImageUsageFlagBits::eTransientAttachment);
+}
+
 static constexpr VkMemoryPropertyFlags ToVKTextureMemoryPropertyFlags(
     StorageMode mode,
     bool supports_memoryless_textures) {
@@ -268,7 +345,13 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
 
     VmaAllocationCreateInfo alloc_nfo = {};
 
-    alloc_nfo.usage = ToVMAMemoryUsage();
+    // Transient attachments are never loaded or stored. On tilers, their
+    // contents only ever live in tile memory and lazily allocated memory
+    // doesn't need to be backed by physical pages at all.
+    is_lazily_allocated_ = IsLazilyAllocated(image_info);
+    alloc_nfo.usage = is_lazily_allocated_
+                          ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED
+                          : ToVMAMemoryUsage();
     alloc_nfo.preferredFlags = ToVKTextureMemoryPropertyFlags(
         desc.storage_mode, supports_memoryless_textures);
     alloc_nfo.flags =
@@ -351,6 +434,8 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
 
   bool IsValid() const { return is_valid_; }
 
+  bool IsLazilyAllocated() const { return is_lazily_allocated_; }
+
   vk::Image GetImage() const override { return image_; }
 
   vk::ImageView GetImageView() const override { return image_view_.get(); }
@@ -360,6 +445,7 @@ class AllocatedTextureSourceVK final : public TextureSourceVK {
   VmaAllocator allocator_ = {};
   VmaAllocation allocation_ = {};
   vk::UniqueImageView image_view_;
+  bool is_lazily_allocated_ = false;
   bool is_valid_ = false;
 
   FML_DISALLOW_COPY_AND_ASSIGN(AllocatedTextureSourceVK);
@@ -385,6 +471,9 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
   if (!source->IsValid()) {
     return nullptr;
   }
+  if (source->IsLazilyAllocated()) {
+    lazily_allocated_texture_count_++;
+  }
   return std::make_shared<TextureVK>(context_, std::move(source));
 }
 
@@ -392,17 +481,7 @@ std::shared_ptr<Texture> AllocatorVK::OnCreateTexture(
 std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
     const DeviceBufferDescriptor& desc) {
   TRACE_EVENT0("impeller", "AllocatorVK::OnCreateBuffer");
-  vk::BufferCreateInfo buffer_info;
-  buffer_info.usage = vk::BufferUsageFlagBits::eVertexBuffer |
-                      vk::BufferUsageFlagBits::eIndexBuffer |
-                      vk::BufferUsageFlagBits::eUniformBuffer |
-                      vk::BufferUsageFlagBits::eStorageBuffer |
-                      vk::BufferUsageFlagBits::eTransferSrc |
-                      vk::BufferUsageFlagBits::eTransferDst;
-  buffer_info.size = desc.size;
-  buffer_info.sharingMode = vk::SharingMode::eExclusive;
-  auto buffer_info_native =
-      static_cast<vk::BufferCreateInfo::NativeType>(buffer_info);
+  auto buffer_info_native = ToVKBufferCreateInfo(desc.size);
 
   VmaAllocationCreateInfo allocation_info = {};
   allocation_info.usage = ToVMAMemoryUsage();
@@ -414,13 +493,44 @@ std::shared_ptr<DeviceBuffer> AllocatorVK::OnCreateBuffer(
   VkBuffer buffer = {};
   VmaAllocation buffer_allocation = {};
   VmaAllocationInfo buffer_allocation_info = {};
-  auto result = vk::Result{::vmaCreateBuffer(allocator_,              //
-                                             &buffer_info_native,     //
-                                             &allocation_info,        //
-                                             &buffer,                 //
-                                             &buffer_allocation,      //
-                                             &buffer_allocation_info  //
-                                             )};
+  auto result = vk::Result::eErrorOutOfDeviceMemory;
+
+  // Small host visible buffers that only live for a frame, the uniform and
+  // vertex data of the passes, are suballocated from the transient buffer
+  // pool. Since they are collected in roughly the order they were allocated,
+  // the linear pool is used as a ring buffer and never fragments. Longer
+  // lived buffers would pin the ring, so they never go there.
+  const bool use_transient_pool =
+      transient_buffer_pool_ && desc.is_per_frame &&
+      desc.storage_mode == StorageMode::kHostVisible &&
+      desc.size <= kTransientBufferPoolMaxAllocationSize;
+  if (use_transient_pool) {
+    VmaAllocationCreateInfo pool_allocation_info = allocation_info;
+    pool_allocation_info.pool = transient_buffer_pool_;
+    // Fall back to a regular allocation instead of letting VMA grow the
+    // pool.
+    pool_allocation_info.flags |= VMA_ALLOCATION_CREATE_NEVER_ALLOCATE_BIT;
+    result = vk::Result{::vmaCreateBuffer(allocator_,              //
+                                          &buffer_info_native,     //
+                                          &pool_allocation_info,   //
+                                          &buffer,                 //
+                                          &buffer_allocation,      //
+                                          &buffer_allocation_info  //
+                                          )};
+    if (result != vk::Result::eSuccess) {
+      transient_pool_overflow_count_++;
+    }
+  }
+
+  if (result != vk::Result::eSuccess) {
+    result = vk::Result{::vmaCreateBuffer(allocator_,              //
+                                          &buffer_info_native,     //
+                                          &allocation_info,        //
+                                          &buffer,                 //
+                                          &buffer_allocation,      //
+                                          &buffer_allocation_info  //
+                                          )};
+  }
 
   if (result != vk::Result::eSuccess) {
     VALIDATION_LOG << "Unable to allocate a device buffer: "
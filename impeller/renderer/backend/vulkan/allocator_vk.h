@@ -13,20 +13,46 @@
 #include "impeller/renderer/backend/vulkan/device_holder.h"
 #include "impeller/renderer/backend/vulkan/vk.h"
 
+#include <atomic>
 #include <memory>
 
 namespace impeller {
 
 class AllocatorVK final : public Allocator {
  public:
+  struct Stats {
+    /// The number of live buffers suballocated from the transient buffer
+    /// pool.
+    size_t transient_buffer_count = 0u;
+    /// The bytes used by live buffers in the transient buffer pool.
+    size_t transient_buffer_bytes = 0u;
+    /// The device memory reserved by the transient buffer pool.
+    size_t transient_pool_bytes = 0u;
+    /// The number of eligible buffers that didn't fit in the transient buffer
+    /// pool and got an allocation of their own instead.
+    size_t transient_pool_overflow_count = 0u;
+    /// The number of transient attachments backed by lazily allocated
+    /// memory.
+    size_t lazily_allocated_texture_count = 0u;
+  };
+
   // |Allocator|
   ~AllocatorVK() override;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Statistics about the memory pools of this allocator.
+  ///
+  Stats GetStats() const;
+
  private:
   friend class ContextVK;
 
   fml::RefPtr<vulkan::VulkanProcTable> vk_;
   VmaAllocator allocator_ = {};
+  /// A ring pool for small host visible buffers that only live for a frame.
+  VmaPool transient_buffer_pool_ = {};
+  std::atomic_size_t transient_pool_overflow_count_ = 0u;
+  std::atomic_size_t lazily_allocated_texture_count_ = 0u;
   std::weak_ptr<Context> context_;
   std::weak_ptr<DeviceHolder> device_holder_;
   ISize max_texture_size_;
@@ -0,0 +1,93 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstdlib>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/native_library.h"
+#include "flutter/fml/paths.h"
+#include "impeller/renderer/backend/vulkan/allocator_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/limits_vk.h"
+
+namespace impeller {
+
+namespace {
+/// Creates a context on SwiftShader so that the results don't depend on the
+/// GPU driver of the host.
+std::shared_ptr<ContextVK> CreateSwiftShaderContext() {
+  auto [found, executable_dir] = fml::paths::GetExecutableDirectoryPath();
+  if (!found) {
+    return nullptr;
+  }
+  auto icd_path =
+      fml::paths::JoinPaths({executable_dir, "vk_swiftshader_icd.json"});
+  setenv("VK_ICD_FILENAMES", icd_path.c_str(), 1);
+
+  static auto vulkan_library = fml::NativeLibrary::Create("libvulkan.so.1");
+  if (!vulkan_library) {
+    return nullptr;
+  }
+  auto proc_address =
+      vulkan_library->ResolveFunction<PFN_vkGetInstanceProcAddr>(
+          "vkGetInstanceProcAddr");
+  if (!proc_address.has_value()) {
+    return nullptr;
+  }
+
+  ContextVK::Settings settings;
+  settings.proc_address_callback = proc_address.value();
+  auto context = ContextVK::Create(std::move(settings));
+  if (!context || !context->IsValid()) {
+    return nullptr;
+  }
+  return context;
+}
+}  // namespace
+
+/// Allocates and collects the per frame host visible buffers of one frame
+/// per iteration. Buffers up to the transient pool limit are suballocated from
+/// the ring pool while larger ones get an allocation of their own, which is
+/// what every buffer used to get.
+static void BM_AllocateFrameBuffers(benchmark::State& state) {
+  auto context = CreateSwiftShaderContext();
+  if (!context) {
+    state.SkipWithError("Could not create a SwiftShader context.");
+    return;
+  }
+  auto allocator = context->GetResourceAllocator();
+
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = state.range(0);
+  desc.is_per_frame = true;
+  const size_t buffers_per_frame = state.range(1);
+
+  std::vector<std::shared_ptr<DeviceBuffer>> buffers;
+  buffers.reserve(buffers_per_frame);
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < buffers_per_frame; i++) {
+      buffers.push_back(allocator->CreateBuffer(desc));
+    }
+    benchmark::DoNotOptimize(buffers.data());
+    buffers.clear();
+  }
+
+  auto stats = static_cast<AllocatorVK&>(*allocator).GetStats();
+  state.counters["TransientPoolOverflows"] =
+      static_cast<double>(stats.transient_pool_overflow_count);
+  state.counters["TransientPoolBytes"] =
+      static_cast<double>(stats.transient_pool_bytes);
+  state.SetItemsProcessed(state.iterations() * buffers_per_frame);
+}
+
+BENCHMARK(BM_AllocateFrameBuffers)
+    ->Args({256, 512})
+    ->Args({4 * 1024, 512})
+    ->Args({64 * 1024, 64})
+    ->Args({kTransientBufferPoolMaxAllocationSize + 1, 64})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace impeller
@@ -0,0 +1,109 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "flutter/testing/testing.h"
+#include "impeller/core/device_buffer.h"
+#include "impeller/renderer/backend/vulkan/allocator_vk.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/limits_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+static DeviceBufferDescriptor MakePerFrameBufferDescriptor(size_t size) {
+  DeviceBufferDescriptor desc;
+  desc.storage_mode = StorageMode::kHostVisible;
+  desc.size = size;
+  desc.is_per_frame = true;
+  return desc;
+}
+
+TEST(AllocatorVKTest, TransientBufferPoolWrapsAround) {
+  auto context = CreateMockVulkanContext();
+  auto allocator = context->GetResourceAllocator();
+  auto& allocator_vk = static_cast<AllocatorVK&>(*allocator);
+  ASSERT_EQ(allocator_vk.GetStats().transient_pool_bytes,
+            kTransientBufferPoolSize);
+
+  // Keep a few frames worth of buffers alive at a time while allocating
+  // several times the size of the pool, so the ring has to wrap around.
+  constexpr size_t kBufferSize = kTransientBufferPoolMaxAllocationSize;
+  constexpr size_t kLiveBufferCount = 4u;
+  const size_t buffer_count = 4u * kTransientBufferPoolSize / kBufferSize;
+  std::deque<std::shared_ptr<DeviceBuffer>> buffers;
+  for (size_t i = 0; i < buffer_count; i++) {
+    auto buffer =
+        allocator->CreateBuffer(MakePerFrameBufferDescriptor(kBufferSize));
+    ASSERT_TRUE(buffer);
+    buffers.push_back(std::move(buffer));
+    if (buffers.size() > kLiveBufferCount) {
+      buffers.pop_front();
+    }
+  }
+
+  auto stats = allocator_vk.GetStats();
+  EXPECT_EQ(stats.transient_pool_overflow_count, 0u);
+  EXPECT_EQ(stats.transient_buffer_count, kLiveBufferCount);
+  EXPECT_EQ(stats.transient_pool_bytes, kTransientBufferPoolSize);
+
+  buffers.clear();
+  EXPECT_EQ(allocator_vk.GetStats().transient_buffer_count, 0u);
+}
+
+TEST(AllocatorVKTest, TransientBufferPoolOverflowsToOwnAllocations) {
+  auto context = CreateMockVulkanContext();
+  auto allocator = context->GetResourceAllocator();
+  auto& allocator_vk = static_cast<AllocatorVK&>(*allocator);
+
+  // Keep every buffer alive so that the pool runs out of space.
+  constexpr size_t kBufferSize = kTransientBufferPoolMaxAllocationSize;
+  const size_t buffer_count = kTransientBufferPoolSize / kBufferSize + 2u;
+  std::vector<std::shared_ptr<DeviceBuffer>> buffers;
+  for (size_t i = 0; i < buffer_count; i++) {
+    auto buffer =
+        allocator->CreateBuffer(MakePerFrameBufferDescriptor(kBufferSize));
+    ASSERT_TRUE(buffer);
+    buffers.push_back(std::move(buffer));
+  }
+
+  auto stats = allocator_vk.GetStats();
+  EXPECT_GE(stats.transient_pool_overflow_count, 2u);
+  EXPECT_EQ(stats.transient_buffer_count + stats.transient_pool_overflow_count,
+            buffer_count);
+  EXPECT_LE(stats.transient_buffer_bytes, kTransientBufferPoolSize);
+  // The pool never grows past its single block.
+  EXPECT_EQ(stats.transient_pool_bytes, kTransientBufferPoolSize);
+
+  // Buffers that are too large for the pool don't count as overflows.
+  auto large_buffer = allocator->CreateBuffer(
+      MakePerFrameBufferDescriptor(kTransientBufferPoolMaxAllocationSize + 1));
+  ASSERT_TRUE(large_buffer);
+  EXPECT_EQ(allocator_vk.GetStats().transient_pool_overflow_count,
+            stats.transient_pool_overflow_count);
+}
+
+TEST(AllocatorVKTest, OnlyPerFrameBuffersUseTheTransientBufferPool) {
+  auto context = CreateMockVulkanContext();
+  auto allocator = context->GetResourceAllocator();
+  auto& allocator_vk = static_cast<AllocatorVK&>(*allocator);
+
+  auto desc = MakePerFrameBufferDescriptor(1024u);
+  desc.is_per_frame = false;
+  auto buffer = allocator->CreateBuffer(desc);
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(allocator_vk.GetStats().transient_buffer_count, 0u);
+
+  auto per_frame_buffer =
+      allocator->CreateBuffer(MakePerFrameBufferDescriptor(1024u));
+  ASSERT_TRUE(per_frame_buffer);
+  EXPECT_EQ(allocator_vk.GetStats().transient_buffer_count, 1u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -8,11 +8,13 @@
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
 #include "impeller/base/validation.h"
 #include "impeller/renderer/backend/vulkan/blit_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/compute_pass_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/encoding_scheduler_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/render_pass_vk.h"
 #include "impeller/renderer/command_buffer.h"
@@ -47,7 +49,67 @@ const std::shared_ptr<CommandEncoderVK>& CommandBufferVK::GetEncoder() const {
   return encoder_;
 }
 
+void CommandBufferVK::FlushEncodingScheduler() const {
+  auto context = context_.lock();
+  if (!context) {
+    return;
+  }
+  if (const auto& scheduler =
+          ContextVK::Cast(*context).GetEncodingScheduler()) {
+    scheduler->Flush();
+  }
+}
+
+bool CommandBufferVK::SubmitCommandsAsync(
+    std::shared_ptr<RenderPass> render_pass) {
+  TRACE_EVENT0("impeller", "CommandBufferVK::SubmitCommandsAsync");
+  if (!IsValid() || !render_pass || !render_pass->IsValid()) {
+    return false;
+  }
+  auto context = context_.lock();
+  if (!context) {
+    return false;
+  }
+  const auto& scheduler = ContextVK::Cast(*context).GetEncodingScheduler();
+  if (!scheduler) {
+    return CommandBuffer::SubmitCommandsAsync(std::move(render_pass));
+  }
+
+  EncodingSchedulerVK::Resources reads;
+  EncodingSchedulerVK::Resources writes;
+  static_cast<const RenderPassVK&>(*render_pass)
+      .CollectResources(reads, writes);
+
+  // Command pools may only be used on the thread that created them, so the
+  // pass is encoded into a command buffer from the pool of the worker thread
+  // and the command buffer of this object is never submitted.
+  encoder_ = nullptr;
+  is_valid_ = false;
+
+  scheduler->Schedule(
+      std::move(reads), std::move(writes),
+      [render_pass = std::move(render_pass),
+       weak_context = context_]() -> EncodingSchedulerVK::SubmitProc {
+        auto context = weak_context.lock();
+        if (!context) {
+          return nullptr;
+        }
+        const auto& context_vk = ContextVK::Cast(*context);
+        std::shared_ptr<CommandEncoderVK> encoder =
+            context_vk.CreateGraphicsCommandEncoder();
+        if (!encoder || !static_cast<const RenderPassVK&>(*render_pass)
+                              .EncodeCommands(context_vk, *encoder)) {
+          return nullptr;
+        }
+        return [encoder]() { return encoder->Submit(); };
+      });
+  return true;
+}
+
 bool CommandBufferVK::OnSubmitCommands(CompletionCallback callback) {
+  // Asynchronously encoded command buffers scheduled earlier must be submitted
+  // first.
+  FlushEncodingScheduler();
   if (!callback) {
     return encoder_->Submit();
   }
@@ -79,6 +141,9 @@ std::shared_ptr<BlitPass> CommandBufferVK::OnCreateBlitPass() const {
   if (!IsValid()) {
     return nullptr;
   }
+  // Blit passes are encoded on the calling thread and must observe the image
+  // layouts left behind by the passes being encoded on the workers.
+  FlushEncodingScheduler();
   auto pass = std::shared_ptr<BlitPassVK>(new BlitPassVK(encoder_));
   if (!pass->IsValid()) {
     return nullptr;
@@ -90,6 +155,7 @@ std::shared_ptr<ComputePass> CommandBufferVK::OnCreateComputePass() const {
   if (!IsValid()) {
     return nullptr;
   }
+  FlushEncodingScheduler();
   auto context = context_.lock();
   if (!context) {
     return nullptr;
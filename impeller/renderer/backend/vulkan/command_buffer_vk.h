@@ -38,9 +38,14 @@ class CommandBufferVK final
   // |CommandBuffer|
   bool IsValid() const override;
 
+  // |CommandBuffer|
+  bool SubmitCommandsAsync(std::shared_ptr<RenderPass> render_pass) override;
+
   // |CommandBuffer|
   bool OnSubmitCommands(CompletionCallback callback) override;
 
+  void FlushEncodingScheduler() const;
+
   // |CommandBuffer|
   void OnWaitUntilScheduled() override;
 
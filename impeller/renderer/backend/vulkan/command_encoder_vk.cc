@@ -16,8 +16,9 @@ class TrackedObjectsVK {
  public:
   explicit TrackedObjectsVK(
       const std::weak_ptr<const DeviceHolder>& device_holder,
-      const std::shared_ptr<CommandPoolVK>& pool)
-      : desc_pool_(device_holder) {
+      const std::shared_ptr<CommandPoolVK>& pool,
+      std::weak_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler)
+      : desc_pool_(device_holder, std::move(descriptor_pool_recycler)) {
     if (!pool) {
       return;
     }
@@ -100,10 +101,13 @@ CommandEncoderVK::CommandEncoderVK(
     const std::weak_ptr<const DeviceHolder>& device_holder,
     const std::shared_ptr<QueueVK>& queue,
     const std::shared_ptr<CommandPoolVK>& pool,
-    std::shared_ptr<FenceWaiterVK> fence_waiter)
+    std::shared_ptr<FenceWaiterVK> fence_waiter,
+    std::weak_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler)
     : fence_waiter_(std::move(fence_waiter)),
-      tracked_objects_(
-          std::make_shared<TrackedObjectsVK>(device_holder, pool)) {
+      tracked_objects_(std::make_shared<TrackedObjectsVK>(
+          device_holder,
+          pool,
+          std::move(descriptor_pool_recycler))) {
   if (!fence_waiter_ || !tracked_objects_->IsValid() || !queue) {
     return;
   }
@@ -150,33 +154,23 @@ bool CommandEncoderVK::Submit(SubmitCallback callback) {
   if (command_buffer.end() != vk::Result::eSuccess) {
     return false;
   }
-  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
-  if (!strong_device) {
-    return false;
-  }
-  auto [fence_result, fence] = strong_device->GetDevice().createFenceUnique({});
-  if (fence_result != vk::Result::eSuccess) {
-    return false;
-  }
-
   vk::SubmitInfo submit_info;
   std::vector<vk::CommandBuffer> buffers = {command_buffer};
   submit_info.setCommandBuffers(buffers);
-  if (queue_->Submit(submit_info, *fence) != vk::Result::eSuccess) {
+  if (!fence_waiter_->Submit(
+          *queue_, submit_info,
+          [callback, tracked_objects = std::move(tracked_objects_)] {
+            if (callback) {
+              callback(true);
+            }
+          })) {
     return false;
   }
 
   // Submit will proceed, call callback with true when it is done and do not
   // call when `reset` is collected.
   fail_callback = false;
-
-  return fence_waiter_->AddFence(
-      std::move(fence),
-      [callback, tracked_objects = std::move(tracked_objects_)] {
-        if (callback) {
-          callback(true);
-        }
-      });
+  return true;
 }
 
 vk::CommandBuffer CommandEncoderVK::GetCommandBuffer() const {
@@ -246,12 +240,14 @@ bool CommandEncoderVK::IsTracking(
   return tracked_objects_->IsTracking(source);
 }
 
-std::optional<vk::DescriptorSet> CommandEncoderVK::AllocateDescriptorSet(
-    const vk::DescriptorSetLayout& layout) {
+std::optional<vk::DescriptorSet> CommandEncoderVK::GetDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    std::vector<vk::WriteDescriptorSet>& writes) {
   if (!IsValid()) {
     return std::nullopt;
   }
-  return tracked_objects_->GetDescriptorPool().AllocateDescriptorSet(layout);
+  return tracked_objects_->GetDescriptorPool().GetDescriptorSet(layout,
+                                                                 writes);
 }
 
 void CommandEncoderVK::PushDebugGroup(const char* label) const {
@@ -7,6 +7,7 @@
 #include <functional>
 #include <optional>
 #include <set>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
@@ -34,7 +35,9 @@ class CommandEncoderVK {
   CommandEncoderVK(const std::weak_ptr<const DeviceHolder>& device_holder,
                    const std::shared_ptr<QueueVK>& queue,
                    const std::shared_ptr<CommandPoolVK>& pool,
-                   std::shared_ptr<FenceWaiterVK> fence_waiter);
+                   std::shared_ptr<FenceWaiterVK> fence_waiter,
+                   std::weak_ptr<DescriptorPoolRecyclerVK>
+                       descriptor_pool_recycler = {});
 
   ~CommandEncoderVK();
 
@@ -62,8 +65,9 @@ class CommandEncoderVK {
 
   void InsertDebugMarker(const char* label) const;
 
-  std::optional<vk::DescriptorSet> AllocateDescriptorSet(
-      const vk::DescriptorSetLayout& layout);
+  std::optional<vk::DescriptorSet> GetDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      std::vector<vk::WriteDescriptorSet>& writes);
 
  private:
   friend class ContextVK;
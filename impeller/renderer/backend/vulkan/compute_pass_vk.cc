@@ -69,11 +69,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                                           CommandEncoderVK& encoder,
                                           const ComputePipelineVK& pipeline) {
   auto desc_set = pipeline.GetDescriptor().GetDescriptorSetLayouts();
-  auto vk_desc_set =
-      encoder.AllocateDescriptorSet(pipeline.GetDescriptorSetLayout());
-  if (!vk_desc_set) {
-    return false;
-  }
 
   auto& allocator = *context.GetResourceAllocator();
 
@@ -81,10 +76,9 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
   std::unordered_map<uint32_t, vk::DescriptorImageInfo> images;
   std::vector<vk::WriteDescriptorSet> writes;
 
-  auto bind_images = [&encoder,     //
-                      &images,      //
-                      &writes,      //
-                      &vk_desc_set  //
+  auto bind_images = [&encoder,  //
+                      &images,   //
+                      &writes    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [index, sampler_handle] : bindings.samplers) {
       if (bindings.textures.find(index) == bindings.textures.end()) {
@@ -108,7 +102,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       image_info.imageView = texture_vk.GetImageView();
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = slot.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
@@ -120,12 +113,11 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return true;
   };
 
-  auto bind_buffers = [&allocator,   //
-                       &encoder,     //
-                       &buffers,     //
-                       &writes,      //
-                       &desc_set,    //
-                       &vk_desc_set  //
+  auto bind_buffers = [&allocator,  //
+                       &encoder,    //
+                       &buffers,    //
+                       &writes,     //
+                       &desc_set    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [buffer_index, view] : bindings.buffers) {
       const auto& buffer_view = view.resource.buffer;
@@ -165,7 +157,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       auto layout = *layout_it;
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = uniform.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
@@ -180,7 +171,11 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return false;
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
+  auto vk_desc_set =
+      encoder.GetDescriptorSet(pipeline.GetDescriptorSetLayout(), writes);
+  if (!vk_desc_set) {
+    return false;
+  }
 
   encoder.GetCommandBuffer().bindDescriptorSets(
       vk::PipelineBindPoint::eCompute,    // bind point
@@ -27,6 +27,8 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/command_pool_vk.h"
 #include "impeller/renderer/backend/vulkan/debug_report_vk.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/encoding_scheduler_vk.h"
 #include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
@@ -113,9 +115,15 @@ uint64_t CalculateHash(void* ptr) {
 ContextVK::ContextVK() : hash_(CalculateHash(this)) {}
 
 ContextVK::~ContextVK() {
+  // Pending workloads must be submitted before the device goes idle.
+  encoding_scheduler_.reset();
   if (device_holder_ && device_holder_->device) {
     [[maybe_unused]] auto result = device_holder_->device->waitIdle();
   }
+  // Completion callbacks run on the workers which go away with the context.
+  if (fence_waiter_) {
+    fence_waiter_->Terminate();
+  }
   CommandPoolVK::ClearAllPools(this);
 }
 
@@ -307,6 +315,18 @@ void ContextVK::Setup(Settings settings) {
   device_info.setPEnabledFeatures(&enabled_features.value());
   // Device layers are deprecated and ignored.
 
+  // The feature is required to be supported if the extension is.
+  const bool supports_timeline_semaphores =
+      std::find(enabled_device_extensions->begin(),
+                enabled_device_extensions->end(),
+                VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) !=
+      enabled_device_extensions->end();
+  vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR timeline_semaphore_features;
+  timeline_semaphore_features.timelineSemaphore = VK_TRUE;
+  if (supports_timeline_semaphores) {
+    device_info.setPNext(&timeline_semaphore_features);
+  }
+
   {
     auto device_result =
         device_holder->physical_device.createDeviceUnique(device_info);
@@ -372,8 +392,11 @@ void ContextVK::Setup(Settings settings) {
   //----------------------------------------------------------------------------
   /// Create the fence waiter.
   ///
-  auto fence_waiter =
-      std::shared_ptr<FenceWaiterVK>(new FenceWaiterVK(device_holder));
+  auto fence_waiter = std::shared_ptr<FenceWaiterVK>(
+      new FenceWaiterVK(device_holder,                         //
+                        raster_message_loop_->GetTaskRunner(),  //
+                        supports_timeline_semaphores            //
+                        ));
   if (!fence_waiter->IsValid()) {
     VALIDATION_LOG << "Could not create fence waiter.";
     return;
@@ -408,6 +431,10 @@ void ContextVK::Setup(Settings settings) {
   queues_ = std::move(queues);
   device_capabilities_ = std::move(caps);
   fence_waiter_ = std::move(fence_waiter);
+  encoding_scheduler_ = std::make_shared<EncodingSchedulerVK>(
+      raster_message_loop_->GetTaskRunner());
+  descriptor_pool_recycler_ =
+      std::make_shared<DescriptorPoolRecyclerVK>(device_holder_);
   device_name_ = std::string(physical_device_properties.deviceName);
   is_valid_ = true;
 
@@ -466,12 +493,16 @@ const vk::Device& ContextVK::GetDevice() const {
   return device_holder_->device.get();
 }
 
-const std::shared_ptr<fml::ConcurrentTaskRunner>
+// |Context|
+std::shared_ptr<fml::ConcurrentTaskRunner>
 ContextVK::GetConcurrentWorkerTaskRunner() const {
   return raster_message_loop_->GetTaskRunner();
 }
 
 void ContextVK::Shutdown() {
+  if (encoding_scheduler_) {
+    encoding_scheduler_->Flush();
+  }
   raster_message_loop_->Terminate();
 }
 
@@ -533,6 +564,16 @@ std::shared_ptr<FenceWaiterVK> ContextVK::GetFenceWaiter() const {
   return fence_waiter_;
 }
 
+const std::shared_ptr<EncodingSchedulerVK>& ContextVK::GetEncodingScheduler()
+    const {
+  return encoding_scheduler_;
+}
+
+const std::shared_ptr<DescriptorPoolRecyclerVK>&
+ContextVK::GetDescriptorPoolRecycler() const {
+  return descriptor_pool_recycler_;
+}
+
 std::unique_ptr<CommandEncoderVK> ContextVK::CreateGraphicsCommandEncoder()
     const {
   auto tls_pool = CommandPoolVK::GetThreadLocal(this);
@@ -543,8 +584,8 @@ std::unique_ptr<CommandEncoderVK> ContextVK::CreateGraphicsCommandEncoder()
       device_holder_,          //
       queues_.graphics_queue,  //
       tls_pool,                //
-      fence_waiter_            //
-      ));
+      fence_waiter_,           //
+      descriptor_pool_recycler_));
   if (!encoder->IsValid()) {
     return nullptr;
   }
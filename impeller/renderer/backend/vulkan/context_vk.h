@@ -29,6 +29,8 @@ bool HasValidationLayers();
 
 class CommandEncoderVK;
 class DebugReportVK;
+class DescriptorPoolRecyclerVK;
+class EncodingSchedulerVK;
 class FenceWaiterVK;
 
 class ContextVK final : public Context,
@@ -119,8 +121,9 @@ class ContextVK final : public Context,
 
   const vk::Device& GetDevice() const;
 
-  const std::shared_ptr<fml::ConcurrentTaskRunner>
-  GetConcurrentWorkerTaskRunner() const;
+  // |Context|
+  std::shared_ptr<fml::ConcurrentTaskRunner> GetConcurrentWorkerTaskRunner()
+      const override;
 
   [[nodiscard]] bool SetWindowSurface(vk::UniqueSurfaceKHR surface);
 
@@ -136,7 +139,22 @@ class ContextVK final : public Context,
 
   std::shared_ptr<FenceWaiterVK> GetFenceWaiter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      The scheduler that encodes render passes submitted with
+  ///             `CommandBuffer::SubmitCommandsAsync` on the worker threads.
+  ///
+  const std::shared_ptr<EncodingSchedulerVK>& GetEncodingScheduler() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The recycler that encoders return their descriptor pools to
+  ///             once their command buffers have completed.
+  ///
+  const std::shared_ptr<DescriptorPoolRecyclerVK>& GetDescriptorPoolRecycler()
+      const;
+
  private:
+  friend class CommandBufferVK;
+
   struct DeviceHolderImpl : public DeviceHolder {
     // |DeviceHolder|
     const vk::Device& GetDevice() const override { return device.get(); }
@@ -162,6 +180,8 @@ class ContextVK final : public Context,
   std::shared_ptr<FenceWaiterVK> fence_waiter_;
   std::string device_name_;
   std::shared_ptr<fml::ConcurrentMessageLoop> raster_message_loop_;
+  std::shared_ptr<EncodingSchedulerVK> encoding_scheduler_;
+  std::shared_ptr<DescriptorPoolRecyclerVK> descriptor_pool_recycler_;
   const uint64_t hash_;
 
   bool is_valid_ = false;
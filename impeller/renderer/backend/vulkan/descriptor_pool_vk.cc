@@ -4,19 +4,12 @@
 
 #include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 
 namespace impeller {
 
-DescriptorPoolVK::DescriptorPoolVK(
-    const std::weak_ptr<const DeviceHolder>& device_holder)
-    : device_holder_(device_holder) {
-  FML_DCHECK(device_holder.lock());
-}
-
-DescriptorPoolVK::~DescriptorPoolVK() = default;
-
 static vk::UniqueDescriptorPool CreatePool(const vk::Device& device,
                                            uint32_t pool_count) {
   TRACE_EVENT0("impeller", "CreateDescriptorPool");
@@ -39,6 +32,144 @@ static vk::UniqueDescriptorPool CreatePool(const vk::Device& device,
   return std::move(pool);
 }
 
+template <class Handle>
+static uint64_t HandleKey(Handle handle) {
+  return reinterpret_cast<uint64_t>(
+      static_cast<typename Handle::CType>(handle));
+}
+
+DescriptorPoolRecyclerVK::DescriptorPoolRecyclerVK(
+    const std::weak_ptr<const DeviceHolder>& device_holder)
+    : device_holder_(device_holder) {}
+
+DescriptorPoolRecyclerVK::~DescriptorPoolRecyclerVK() = default;
+
+vk::UniqueDescriptorPool DescriptorPoolRecyclerVK::Get(uint32_t pool_size) {
+  {
+    std::scoped_lock lock(mutex_);
+    auto found = recycled_.find(pool_size);
+    if (found != recycled_.end() && !found->second.empty()) {
+      auto pool = std::move(found->second.back());
+      found->second.pop_back();
+      recycled_count_--;
+      return pool;
+    }
+  }
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    return {};
+  }
+  return CreatePool(strong_device->GetDevice(), pool_size);
+}
+
+void DescriptorPoolRecyclerVK::Reclaim(vk::UniqueDescriptorPool pool,
+                                       uint32_t pool_size) {
+  if (!pool) {
+    return;
+  }
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    // The pool can not be destroyed if its device has been destroyed.
+    pool.release();
+    return;
+  }
+  // The count is checked and updated under the same lock so that concurrent
+  // reclaims can't push the recycler past its limit.
+  std::scoped_lock lock(mutex_);
+  if (recycled_count_ >= kMaxRecycledPools) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "ResetDescriptorPool");
+  strong_device->GetDevice().resetDescriptorPool(*pool);
+  recycled_[pool_size].push_back(std::move(pool));
+  recycled_count_++;
+}
+
+size_t DescriptorPoolRecyclerVK::GetRecycledPoolCount() const {
+  std::scoped_lock lock(mutex_);
+  return recycled_count_;
+}
+
+std::size_t DescriptorPoolVK::DescriptorSetKeyHash::operator()(
+    const DescriptorSetKey& key) const {
+  std::size_t seed = fml::HashCombine();
+  for (auto value : key) {
+    fml::HashCombineSeed(seed, value);
+  }
+  return seed;
+}
+
+DescriptorPoolVK::DescriptorPoolVK(
+    const std::weak_ptr<const DeviceHolder>& device_holder,
+    std::weak_ptr<DescriptorPoolRecyclerVK> recycler)
+    : device_holder_(device_holder), recycler_(std::move(recycler)) {
+  FML_DCHECK(device_holder.lock());
+}
+
+DescriptorPoolVK::~DescriptorPoolVK() {
+  auto recycler = recycler_.lock();
+  if (!recycler) {
+    return;
+  }
+  while (!pools_.empty()) {
+    auto& [pool, size] = pools_.front();
+    recycler->Reclaim(std::move(pool), size);
+    pools_.pop();
+  }
+}
+
+std::optional<vk::DescriptorSet> DescriptorPoolVK::GetDescriptorSet(
+    const vk::DescriptorSetLayout& layout,
+    std::vector<vk::WriteDescriptorSet>& writes) {
+  DescriptorSetKey key;
+  key.reserve(1u + writes.size() * 5u);
+  key.push_back(HandleKey(layout));
+  for (const auto& write : writes) {
+    key.push_back(write.dstBinding);
+    key.push_back(static_cast<uint64_t>(write.descriptorType));
+    if (write.pBufferInfo) {
+      key.push_back(HandleKey(write.pBufferInfo->buffer));
+      key.push_back(write.pBufferInfo->offset);
+      key.push_back(write.pBufferInfo->range);
+    } else if (write.pImageInfo) {
+      key.push_back(HandleKey(write.pImageInfo->sampler));
+      key.push_back(HandleKey(write.pImageInfo->imageView));
+      key.push_back(static_cast<uint64_t>(write.pImageInfo->imageLayout));
+    } else {
+      // Only buffer and image descriptors can be identified by contents.
+      key.clear();
+      break;
+    }
+  }
+
+  if (!key.empty()) {
+    auto found = cached_sets_.find(key);
+    if (found != cached_sets_.end()) {
+      for (auto& write : writes) {
+        write.dstSet = found->second;
+      }
+      return found->second;
+    }
+  }
+
+  auto set = AllocateDescriptorSet(layout);
+  if (!set) {
+    return std::nullopt;
+  }
+  for (auto& write : writes) {
+    write.dstSet = set.value();
+  }
+  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+  if (!strong_device) {
+    return std::nullopt;
+  }
+  strong_device->GetDevice().updateDescriptorSets(writes, {});
+  if (!key.empty()) {
+    cached_sets_[std::move(key)] = set.value();
+  }
+  return set;
+}
+
 std::optional<vk::DescriptorSet> DescriptorPoolVK::AllocateDescriptorSet(
     const vk::DescriptorSetLayout& layout) {
   auto pool = GetDescriptorPool();
@@ -69,21 +200,26 @@ std::optional<vk::DescriptorPool> DescriptorPoolVK::GetDescriptorPool() {
   if (pools_.empty()) {
     return GrowPool() ? GetDescriptorPool() : std::nullopt;
   }
-  return *pools_.back();
+  return *pools_.back().first;
 }
 
 bool DescriptorPoolVK::GrowPool() {
   const auto new_pool_size = Allocation::NextPowerOfTwoSize(pool_size_ + 1u);
-  std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
-  if (!strong_device) {
-    return false;
+  vk::UniqueDescriptorPool new_pool;
+  if (auto recycler = recycler_.lock()) {
+    new_pool = recycler->Get(new_pool_size);
+  } else {
+    std::shared_ptr<const DeviceHolder> strong_device = device_holder_.lock();
+    if (!strong_device) {
+      return false;
+    }
+    new_pool = CreatePool(strong_device->GetDevice(), new_pool_size);
   }
-  auto new_pool = CreatePool(strong_device->GetDevice(), new_pool_size);
   if (!new_pool) {
     return false;
   }
   pool_size_ = new_pool_size;
-  pools_.push(std::move(new_pool));
+  pools_.emplace(std::move(new_pool), new_pool_size);
   return true;
 }
 
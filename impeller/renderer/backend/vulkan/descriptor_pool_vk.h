@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
 #include <optional>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
@@ -13,12 +17,64 @@
 
 namespace impeller {
 
+//------------------------------------------------------------------------------
+/// @brief      Keeps the descriptor pools of collected encoders around so
+///             that later encoders can reset and reuse them instead of
+///             creating new ones every frame.
+///
+///             The recycler may be accessed from multiple threads.
+///
+class DescriptorPoolRecyclerVK {
+ public:
+  /// The maximum number of pools that are kept around for reuse.
+  static constexpr size_t kMaxRecycledPools = 32u;
+
+  explicit DescriptorPoolRecyclerVK(
+      const std::weak_ptr<const DeviceHolder>& device_holder);
+
+  ~DescriptorPoolRecyclerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get a pool that can hold `pool_size` descriptors of each
+  ///             type, reusing a reclaimed one if possible.
+  ///
+  vk::UniqueDescriptorPool Get(uint32_t pool_size);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Return a pool of the given size for reuse. The pool is reset,
+  ///             so none of the sets allocated from it may still be in use.
+  ///
+  void Reclaim(vk::UniqueDescriptorPool pool, uint32_t pool_size);
+
+  size_t GetRecycledPoolCount() const;
+
+ private:
+  std::weak_ptr<const DeviceHolder> device_holder_;
+  mutable std::mutex mutex_;
+  std::map<uint32_t, std::vector<vk::UniqueDescriptorPool>> recycled_;
+  size_t recycled_count_ = 0u;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DescriptorPoolRecyclerVK);
+};
+
 //------------------------------------------------------------------------------
 /// @brief      A short-lived dynamically-sized descriptor pool. Descriptors
 ///             from this pool don't need to be freed individually. Instead, the
 ///             pool must be collected after all the descriptors allocated from
 ///             it are done being used.
 ///
+///             Descriptor sets are cached by their layout and contents, so
+///             commands that bind the same resources share a single set.
+///             Sets are never updated once written, which makes sharing them
+///             safe for as long as the pool is alive.
+///
+///             Sets are only shared within the pool of one encoder, never
+///             across frames. Uniform data lives in per-pass host buffers, so
+///             the contents of a set don't repeat from one frame to the next,
+///             and the handles of released resources may be reused by new
+///             ones. There is also no bindless texture table, since shaders
+///             bind every sampler to a fixed slot.
+///
 ///             The pool or it's descriptors may not be accessed from multiple
 ///             threads.
 ///
@@ -28,17 +84,36 @@ namespace impeller {
 class DescriptorPoolVK {
  public:
   explicit DescriptorPoolVK(
-      const std::weak_ptr<const DeviceHolder>& device_holder);
+      const std::weak_ptr<const DeviceHolder>& device_holder,
+      std::weak_ptr<DescriptorPoolRecyclerVK> recycler = {});
 
   ~DescriptorPoolVK();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Get a descriptor set of the given layout that contains the
+  ///             given writes. The destination set of the writes is updated
+  ///             to the returned set.
+  ///
+  std::optional<vk::DescriptorSet> GetDescriptorSet(
+      const vk::DescriptorSetLayout& layout,
+      std::vector<vk::WriteDescriptorSet>& writes);
+
   std::optional<vk::DescriptorSet> AllocateDescriptorSet(
       const vk::DescriptorSetLayout& layout);
 
  private:
+  using DescriptorSetKey = std::vector<uint64_t>;
+
+  struct DescriptorSetKeyHash {
+    std::size_t operator()(const DescriptorSetKey& key) const;
+  };
+
   std::weak_ptr<const DeviceHolder> device_holder_;
+  std::weak_ptr<DescriptorPoolRecyclerVK> recycler_;
   uint32_t pool_size_ = 31u;
-  std::queue<vk::UniqueDescriptorPool> pools_;
+  std::queue<std::pair<vk::UniqueDescriptorPool, uint32_t>> pools_;
+  std::unordered_map<DescriptorSetKey, vk::DescriptorSet, DescriptorSetKeyHash>
+      cached_sets_;
 
   std::optional<vk::DescriptorPool> GetDescriptorPool();
 
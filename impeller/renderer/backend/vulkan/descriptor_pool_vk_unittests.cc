@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/descriptor_pool_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+size_t CountCalls(const std::vector<std::string>& functions,
+                  const std::string& name) {
+  return std::count(functions.begin(), functions.end(), name);
+}
+
+vk::WriteDescriptorSet MakeBufferWrite(const vk::DescriptorBufferInfo& info) {
+  vk::WriteDescriptorSet write;
+  write.dstBinding = 0u;
+  write.descriptorCount = 1u;
+  write.descriptorType = vk::DescriptorType::eUniformBuffer;
+  write.pBufferInfo = &info;
+  return write;
+}
+}  // namespace
+
+TEST(DescriptorPoolVKTest, ReusesSetsWithIdenticalContents) {
+  auto context = CreateMockVulkanContext();
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  auto layout = vk::DescriptorSetLayout(
+      reinterpret_cast<VkDescriptorSetLayout>(0x77777777));
+
+  DescriptorPoolVK pool(context->GetDeviceHolder());
+
+  vk::DescriptorBufferInfo info;
+  info.buffer = vk::Buffer(reinterpret_cast<VkBuffer>(0xDEADDEAD));
+  info.offset = 0u;
+  info.range = 64u;
+  std::vector<vk::WriteDescriptorSet> writes = {MakeBufferWrite(info)};
+  auto first = pool.GetDescriptorSet(layout, writes);
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(writes[0].dstSet, first.value());
+
+  // The same contents are served from the cache.
+  std::vector<vk::WriteDescriptorSet> same_writes = {MakeBufferWrite(info)};
+  auto second = pool.GetDescriptorSet(layout, same_writes);
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first.value(), second.value());
+  EXPECT_EQ(CountCalls(*functions, "vkAllocateDescriptorSets"), 1u);
+  EXPECT_EQ(CountCalls(*functions, "vkUpdateDescriptorSets"), 1u);
+
+  // A different range of the same buffer needs its own set.
+  vk::DescriptorBufferInfo other_info = info;
+  other_info.offset = 256u;
+  std::vector<vk::WriteDescriptorSet> other_writes = {
+      MakeBufferWrite(other_info)};
+  auto third = pool.GetDescriptorSet(layout, other_writes);
+  ASSERT_TRUE(third.has_value());
+  EXPECT_NE(first.value(), third.value());
+  EXPECT_EQ(CountCalls(*functions, "vkAllocateDescriptorSets"), 2u);
+  EXPECT_EQ(CountCalls(*functions, "vkUpdateDescriptorSets"), 2u);
+}
+
+TEST(DescriptorPoolVKTest, RecyclesPoolsOfCollectedEncoders) {
+  auto context = CreateMockVulkanContext();
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  auto layout = vk::DescriptorSetLayout(
+      reinterpret_cast<VkDescriptorSetLayout>(0x77777777));
+  auto recycler = context->GetDescriptorPoolRecycler();
+  ASSERT_TRUE(recycler);
+
+  {
+    DescriptorPoolVK pool(context->GetDeviceHolder(), recycler);
+    ASSERT_TRUE(pool.AllocateDescriptorSet(layout).has_value());
+  }
+  EXPECT_EQ(recycler->GetRecycledPoolCount(), 1u);
+  EXPECT_EQ(CountCalls(*functions, "vkResetDescriptorPool"), 1u);
+
+  {
+    DescriptorPoolVK pool(context->GetDeviceHolder(), recycler);
+    ASSERT_TRUE(pool.AllocateDescriptorSet(layout).has_value());
+    EXPECT_EQ(recycler->GetRecycledPoolCount(), 0u);
+  }
+  EXPECT_EQ(CountCalls(*functions, "vkCreateDescriptorPool"), 1u);
+  EXPECT_EQ(CountCalls(*functions, "vkDestroyDescriptorPool"), 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -0,0 +1,139 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/renderer/backend/vulkan/encoding_scheduler_vk.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "flutter/fml/trace_event.h"
+#include "impeller/base/validation.h"
+
+namespace impeller {
+
+static bool Intersects(const EncodingSchedulerVK::Resources& a,
+                       const EncodingSchedulerVK::Resources& b) {
+  return std::any_of(a.begin(), a.end(), [&b](const auto& resource) {
+    return b.find(resource) != b.end();
+  });
+}
+
+EncodingSchedulerVK::EncodingSchedulerVK(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner)
+    : task_runner_(std::move(task_runner)) {}
+
+EncodingSchedulerVK::~EncodingSchedulerVK() {
+  Flush();
+}
+
+void EncodingSchedulerVK::Schedule(Resources reads,
+                                   Resources writes,
+                                   EncodeProc encode) {
+  TRACE_EVENT0("impeller", "EncodingSchedulerVK::Schedule");
+  uint64_t id = 0u;
+  bool ready = false;
+  {
+    std::scoped_lock lock(mutex_);
+    id = next_id_++;
+    // Encoding a workload that samples an image transitions the image to the
+    // layout for sampling unless it is already in that layout. An earlier
+    // workload that writes the image may leave it in another layout, so the
+    // workloads that sample it after that are encoded one at a time.
+    for (const auto& [other_id, other] : workloads_) {
+      for (auto it = reads.begin(); it != reads.end();) {
+        if (other.writes.find(*it) != other.writes.end()) {
+          writes.insert(*it);
+          it = reads.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+    Workload workload;
+    for (auto& [other_id, other] : workloads_) {
+      if (other.encoded) {
+        continue;
+      }
+      if (Intersects(reads, other.writes) ||
+          Intersects(writes, other.writes) ||
+          Intersects(writes, other.reads)) {
+        other.dependents.push_back(id);
+        workload.pending_dependencies++;
+      }
+    }
+    workload.reads = std::move(reads);
+    workload.writes = std::move(writes);
+    ready = workload.pending_dependencies == 0u;
+    if (!ready) {
+      workload.encode = std::move(encode);
+    }
+    workloads_[id] = std::move(workload);
+  }
+  if (ready) {
+    Dispatch(id, std::move(encode));
+  }
+}
+
+void EncodingSchedulerVK::Dispatch(uint64_t id, EncodeProc encode) {
+  if (!task_runner_) {
+    Encode(id, std::move(encode));
+    return;
+  }
+  task_runner_->PostTask(
+      [this, id, encode = std::move(encode)]() { Encode(id, encode); });
+}
+
+void EncodingSchedulerVK::Encode(uint64_t id, EncodeProc encode) {
+  SubmitProc submit;
+  {
+    TRACE_EVENT0("impeller", "EncodingSchedulerVK::Encode");
+    submit = encode();
+  }
+
+  std::vector<std::pair<uint64_t, EncodeProc>> ready;
+  {
+    std::scoped_lock lock(mutex_);
+    auto& workload = workloads_[id];
+    workload.submit = std::move(submit);
+    workload.encoded = true;
+    for (auto dependent_id : workload.dependents) {
+      auto& dependent = workloads_[dependent_id];
+      if (--dependent.pending_dependencies == 0u) {
+        ready.emplace_back(dependent_id, std::move(dependent.encode));
+      }
+    }
+
+    // Submit every encoded workload that no longer waits on an earlier one.
+    // Submitting with the lock held keeps the submissions in order.
+    while (!workloads_.empty() && workloads_.begin()->second.encoded) {
+      auto& submit_proc = workloads_.begin()->second.submit;
+      if (!submit_proc || !submit_proc()) {
+        VALIDATION_LOG << "Could not submit an asynchronously encoded command "
+                          "buffer.";
+      }
+      workloads_.erase(workloads_.begin());
+    }
+    submitted_cv_.notify_all();
+  }
+
+  for (auto& [ready_id, ready_encode] : ready) {
+    Dispatch(ready_id, std::move(ready_encode));
+  }
+}
+
+void EncodingSchedulerVK::Flush() {
+  std::unique_lock lock(mutex_);
+  if (workloads_.empty()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "EncodingSchedulerVK::Flush");
+  submitted_cv_.wait(lock, [&]() { return workloads_.empty(); });
+}
+
+size_t EncodingSchedulerVK::GetPendingCount() const {
+  std::scoped_lock lock(mutex_);
+  return workloads_.size();
+}
+
+}  // namespace impeller
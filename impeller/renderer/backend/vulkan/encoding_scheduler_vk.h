@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/macros.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Encodes command buffers on worker threads and submits them in
+///             the order they were scheduled.
+///
+///             Each workload declares the resources it reads and writes. A
+///             workload is only encoded once every earlier workload it
+///             conflicts with has been encoded, so that the layout
+///             transitions recorded by an encoder observe the ones recorded
+///             for the workloads before it. Workloads that don't conflict,
+///             such as the sibling subpasses of an entity pass, are encoded
+///             concurrently.
+///
+///             Since encoding a workload that samples an image may transition
+///             its layout, a resource must only be declared as read if it
+///             is already in the layout the workload needs. Reads of a
+///             resource that an earlier workload that isn't submitted yet
+///             writes are treated as writes.
+///
+///             Submission always follows scheduling order, which is a valid
+///             dependency order since a workload can only read what was
+///             scheduled before it.
+///
+class EncodingSchedulerVK {
+ public:
+  /// Identifies a resource, such as the image backing a texture.
+  using Resource = const void*;
+  using Resources = std::set<Resource>;
+
+  /// Submits an encoded workload. Called in scheduling order.
+  using SubmitProc = std::function<bool()>;
+
+  /// Encodes a workload on a worker thread and returns the procedure that
+  /// submits it, or null if encoding failed.
+  using EncodeProc = std::function<SubmitProc()>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Create a scheduler that encodes on the given task runner.
+  ///             Workloads are encoded on the calling thread if there is no
+  ///             task runner.
+  ///
+  explicit EncodingSchedulerVK(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
+  ~EncodingSchedulerVK();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Schedule a workload for encoding and submission.
+  ///
+  void Schedule(Resources reads, Resources writes, EncodeProc encode);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Block until every scheduled workload has been submitted.
+  ///
+  ///             Must be called before encoding or submitting work on the
+  ///             calling thread that may depend on scheduled workloads.
+  ///
+  void Flush();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of workloads that were scheduled but not
+  ///             submitted yet.
+  ///
+  size_t GetPendingCount() const;
+
+ private:
+  struct Workload {
+    Resources reads;
+    Resources writes;
+    EncodeProc encode;
+    SubmitProc submit;
+    bool encoded = false;
+    size_t pending_dependencies = 0u;
+    std::vector<uint64_t> dependents;
+  };
+
+  const std::shared_ptr<fml::ConcurrentTaskRunner> task_runner_;
+  mutable std::mutex mutex_;
+  std::condition_variable submitted_cv_;
+  /// The workloads that were not submitted yet, in scheduling order.
+  std::map<uint64_t, Workload> workloads_;
+  uint64_t next_id_ = 0u;
+
+  void Encode(uint64_t id, EncodeProc encode);
+
+  void Dispatch(uint64_t id, EncodeProc encode);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(EncodingSchedulerVK);
+};
+
+}  // namespace impeller
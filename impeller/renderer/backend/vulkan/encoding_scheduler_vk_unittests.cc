@@ -0,0 +1,168 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/base/validation.h"
+#include "impeller/renderer/backend/vulkan/encoding_scheduler_vk.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+struct SubmissionLog {
+  std::mutex mutex;
+  std::vector<int> submitted;
+
+  EncodingSchedulerVK::SubmitProc Submit(int id) {
+    return [this, id]() {
+      std::scoped_lock lock(mutex);
+      submitted.push_back(id);
+      return true;
+    };
+  }
+};
+}  // namespace
+
+TEST(EncodingSchedulerVKTest, EncodesIndependentWorkloadsConcurrently) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  EncodingSchedulerVK scheduler(loop->GetTaskRunner());
+  SubmissionLog log;
+  int texture_a = 0;
+  int texture_b = 0;
+
+  // The first workload can't finish encoding until the second one has been
+  // encoded, which is only possible if they are encoded concurrently.
+  fml::AutoResetWaitableEvent second_encoded;
+  scheduler.Schedule({}, {&texture_a}, [&]() {
+    second_encoded.Wait();
+    return log.Submit(0);
+  });
+  scheduler.Schedule({}, {&texture_b}, [&]() {
+    second_encoded.Signal();
+    return log.Submit(1);
+  });
+  scheduler.Flush();
+
+  // Submission still follows scheduling order.
+  EXPECT_EQ(log.submitted, std::vector<int>({0, 1}));
+  EXPECT_EQ(scheduler.GetPendingCount(), 0u);
+  loop->Terminate();
+}
+
+TEST(EncodingSchedulerVKTest, EncodesDependentWorkloadsInOrder) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  EncodingSchedulerVK scheduler(loop->GetTaskRunner());
+  SubmissionLog log;
+  int subpass_texture = 0;
+  int parent_texture = 0;
+  std::atomic_bool subpass_encoded = false;
+  std::atomic_bool parent_saw_subpass = false;
+
+  // A subpass renders to a texture that its parent samples.
+  scheduler.Schedule({}, {&subpass_texture}, [&]() {
+    subpass_encoded = true;
+    return log.Submit(0);
+  });
+  scheduler.Schedule({&subpass_texture}, {&parent_texture}, [&]() {
+    parent_saw_subpass = subpass_encoded.load();
+    return log.Submit(1);
+  });
+  scheduler.Flush();
+
+  EXPECT_TRUE(parent_saw_subpass);
+  EXPECT_EQ(log.submitted, std::vector<int>({0, 1}));
+  loop->Terminate();
+}
+
+TEST(EncodingSchedulerVKTest, EncodesSiblingsSamplingAWrittenTextureInOrder) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4u);
+  EncodingSchedulerVK scheduler(loop->GetTaskRunner());
+  SubmissionLog log;
+  int subpass_texture = 0;
+  int sibling_texture_a = 0;
+  int sibling_texture_b = 0;
+  std::atomic_int encoding_count = 0;
+  std::atomic_bool encoded_concurrently = false;
+  auto encode_sibling = [&](int id) {
+    return [&, id]() {
+      if (++encoding_count > 1) {
+        encoded_concurrently = true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      --encoding_count;
+      return log.Submit(id);
+    };
+  };
+
+  // Both siblings sample the texture that the subpass renders to, and the
+  // first one to be encoded transitions it for sampling.
+  fml::AutoResetWaitableEvent subpass_scheduled;
+  scheduler.Schedule({}, {&subpass_texture}, [&]() {
+    subpass_scheduled.Wait();
+    return log.Submit(0);
+  });
+  scheduler.Schedule({&subpass_texture}, {&sibling_texture_a},
+                     encode_sibling(1));
+  scheduler.Schedule({&subpass_texture}, {&sibling_texture_b},
+                     encode_sibling(2));
+  subpass_scheduled.Signal();
+  scheduler.Flush();
+
+  EXPECT_FALSE(encoded_concurrently);
+  EXPECT_EQ(log.submitted, std::vector<int>({0, 1, 2}));
+  loop->Terminate();
+}
+
+TEST(EncodingSchedulerVKTest, EncodesSiblingsSamplingReadyTextureConcurrently) {
+  auto loop = fml::ConcurrentMessageLoop::Create(2u);
+  EncodingSchedulerVK scheduler(loop->GetTaskRunner());
+  SubmissionLog log;
+  int sampled_texture = 0;
+  int sibling_texture_a = 0;
+  int sibling_texture_b = 0;
+
+  // The sampled texture is already in the layout for sampling, so neither
+  // sibling transitions it.
+  fml::AutoResetWaitableEvent second_encoded;
+  scheduler.Schedule({&sampled_texture}, {&sibling_texture_a}, [&]() {
+    second_encoded.Wait();
+    return log.Submit(0);
+  });
+  scheduler.Schedule({&sampled_texture}, {&sibling_texture_b}, [&]() {
+    second_encoded.Signal();
+    return log.Submit(1);
+  });
+  scheduler.Flush();
+
+  EXPECT_EQ(log.submitted, std::vector<int>({0, 1}));
+  loop->Terminate();
+}
+
+TEST(EncodingSchedulerVKTest, EncodesOnCallingThreadWithoutTaskRunner) {
+  EncodingSchedulerVK scheduler(nullptr);
+  SubmissionLog log;
+  int texture = 0;
+
+  scheduler.Schedule({}, {&texture}, [&]() { return log.Submit(0); });
+  {
+    // Failed encodes are dropped without blocking later submissions.
+    ScopedValidationDisable disable_validation;
+    scheduler.Schedule({}, {&texture}, [&]() { return nullptr; });
+  }
+  scheduler.Schedule({&texture}, {}, [&]() { return log.Submit(2); });
+
+  EXPECT_EQ(scheduler.GetPendingCount(), 0u);
+  EXPECT_EQ(log.submitted, std::vector<int>({0, 2}));
+}
+
+}  // namespace testing
+}  // namespace impeller
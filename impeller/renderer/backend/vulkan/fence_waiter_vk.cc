@@ -6,18 +6,21 @@
 
 #include <algorithm>
 #include <chrono>
+#include <deque>
 
 #include "flutter/fml/thread.h"
 #include "flutter/fml/trace_event.h"
+#include "impeller/renderer/backend/vulkan/queue_vk.h"
 
 namespace impeller {
 
 class WaitSetEntry {
  public:
   static std::shared_ptr<WaitSetEntry> Create(vk::UniqueFence p_fence,
+                                              uint64_t p_timeline_value,
                                               const fml::closure& p_callback) {
     return std::shared_ptr<WaitSetEntry>(
-        new WaitSetEntry(std::move(p_fence), p_callback));
+        new WaitSetEntry(std::move(p_fence), p_timeline_value, p_callback));
   }
 
   void UpdateSignalledStatus(const vk::Device& device) {
@@ -27,53 +30,189 @@ class WaitSetEntry {
     is_signalled_ = device.getFenceStatus(fence_.get()) == vk::Result::eSuccess;
   }
 
+  void UpdateSignalledStatus(uint64_t timeline_counter) {
+    is_signalled_ = is_signalled_ || timeline_counter >= timeline_value_;
+  }
+
   const vk::Fence& GetFence() const { return fence_.get(); }
 
+  vk::UniqueFence TakeFence() { return std::move(fence_); }
+
+  uint64_t GetTimelineValue() const { return timeline_value_; }
+
   bool IsSignalled() const { return is_signalled_; }
 
  private:
   vk::UniqueFence fence_;
+  const uint64_t timeline_value_;
   fml::ScopedCleanupClosure callback_;
   bool is_signalled_ = false;
 
-  WaitSetEntry(vk::UniqueFence p_fence, const fml::closure& p_callback)
+  WaitSetEntry(vk::UniqueFence p_fence,
+               uint64_t p_timeline_value,
+               const fml::closure& p_callback)
       : fence_(std::move(p_fence)),
+        timeline_value_(p_timeline_value),
         callback_(fml::ScopedCleanupClosure{p_callback}) {}
 
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(WaitSetEntry);
 };
 
-FenceWaiterVK::FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder)
-    : device_holder_(std::move(device_holder)) {
+// Batches of callbacks that are waiting to be invoked, in completion order.
+struct CallbackBatchesVK {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<WaitSet> batches;
+  bool is_invoking = false;
+};
+
+// Set on the thread that is invoking a batch of callbacks so that the waiter
+// can be terminated from within a callback.
+static thread_local bool tls_is_invoking_callbacks = false;
+
+FenceWaiterVK::FenceWaiterVK(
+    std::weak_ptr<DeviceHolder> device_holder,
+    std::shared_ptr<fml::ConcurrentTaskRunner> callback_runner,
+    bool use_timeline_semaphore)
+    : device_holder_(std::move(device_holder)),
+      callback_runner_(std::move(callback_runner)),
+      callback_batches_(std::make_shared<CallbackBatchesVK>()) {
+  if (use_timeline_semaphore) {
+    auto strong_device_holder = device_holder_.lock();
+    if (!strong_device_holder) {
+      return;
+    }
+    vk::StructureChain<vk::SemaphoreCreateInfo, vk::SemaphoreTypeCreateInfoKHR>
+        semaphore_info;
+    semaphore_info.get<vk::SemaphoreTypeCreateInfoKHR>().semaphoreType =
+        vk::SemaphoreType::eTimeline;
+    auto [result, semaphore] =
+        strong_device_holder->GetDevice().createSemaphoreUnique(
+            semaphore_info.get());
+    if (result == vk::Result::eSuccess) {
+      timeline_semaphore_ = std::move(semaphore);
+    } else {
+      FML_LOG(ERROR) << "Could not create a timeline semaphore. Falling back "
+                        "to fences: "
+                     << vk::to_string(result);
+    }
+  }
   waiter_thread_ = std::make_unique<std::thread>([&]() { Main(); });
   is_valid_ = true;
 }
 
 FenceWaiterVK::~FenceWaiterVK() {
   Terminate();
-  if (waiter_thread_) {
-    waiter_thread_->join();
-  }
 }
 
 bool FenceWaiterVK::IsValid() const {
   return is_valid_;
 }
 
-bool FenceWaiterVK::AddFence(vk::UniqueFence fence,
-                             const fml::closure& callback) {
-  TRACE_EVENT0("flutter", "FenceWaiterVK::AddFence");
-  if (!IsValid() || !fence || !callback) {
+bool FenceWaiterVK::UsesTimelineSemaphore() const {
+  return !!timeline_semaphore_;
+}
+
+size_t FenceWaiterVK::GetPooledFenceCount() const {
+  std::scoped_lock lock(fence_pool_mutex_);
+  return fence_pool_.size();
+}
+
+bool FenceWaiterVK::Submit(const QueueVK& queue,
+                           vk::SubmitInfo submit_info,
+                           const fml::closure& callback) {
+  TRACE_EVENT0("impeller", "FenceWaiterVK::Submit");
+  if (!IsValid() || !callback) {
+    return false;
+  }
+  auto device_holder = device_holder_.lock();
+  if (!device_holder) {
+    return false;
+  }
+  const auto& device = device_holder->GetDevice();
+
+  std::scoped_lock submit_lock(submit_mutex_);
+
+  vk::UniqueFence fence;
+  uint64_t timeline_value = 0u;
+  std::vector<vk::Semaphore> signal_semaphores;
+  std::vector<uint64_t> signal_values;
+  vk::TimelineSemaphoreSubmitInfoKHR timeline_info;
+  if (timeline_semaphore_) {
+    timeline_value = last_timeline_value_ + 1u;
+    signal_semaphores.assign(
+        submit_info.pSignalSemaphores,
+        submit_info.pSignalSemaphores + submit_info.signalSemaphoreCount);
+    // The values for binary semaphores are ignored.
+    signal_values.resize(signal_semaphores.size(), 0u);
+    signal_semaphores.push_back(timeline_semaphore_.get());
+    signal_values.push_back(timeline_value);
+    submit_info.setSignalSemaphores(signal_semaphores);
+    timeline_info.setSignalSemaphoreValues(signal_values);
+    timeline_info.pNext = submit_info.pNext;
+    submit_info.pNext = &timeline_info;
+  } else {
+    fence = AcquireFence(device);
+    if (!fence) {
+      return false;
+    }
+  }
+
+  if (queue.Submit(submit_info, fence.get()) != vk::Result::eSuccess) {
     return false;
   }
+  if (timeline_semaphore_) {
+    last_timeline_value_ = timeline_value;
+  }
+
   {
     std::scoped_lock lock(wait_set_mutex_);
-    wait_set_.emplace_back(WaitSetEntry::Create(std::move(fence), callback));
+    wait_set_.emplace_back(
+        WaitSetEntry::Create(std::move(fence), timeline_value, callback));
   }
   wait_set_cv_.notify_one();
   return true;
 }
 
+vk::UniqueFence FenceWaiterVK::AcquireFence(const vk::Device& device) {
+  {
+    std::scoped_lock lock(fence_pool_mutex_);
+    if (!fence_pool_.empty()) {
+      auto fence = std::move(fence_pool_.back());
+      fence_pool_.pop_back();
+      return fence;
+    }
+  }
+  auto [result, fence] = device.createFenceUnique({});
+  if (result != vk::Result::eSuccess) {
+    return {};
+  }
+  return std::move(fence);
+}
+
+void FenceWaiterVK::RecycleFences(const vk::Device& device,
+                                  std::vector<vk::UniqueFence> fences) {
+  if (fences.empty()) {
+    return;
+  }
+  TRACE_EVENT0("impeller", "RecycleFences");
+  std::vector<vk::Fence> handles;
+  handles.reserve(fences.size());
+  for (const auto& fence : fences) {
+    handles.push_back(fence.get());
+  }
+  if (device.resetFences(handles) != vk::Result::eSuccess) {
+    return;
+  }
+  std::scoped_lock lock(fence_pool_mutex_);
+  for (auto& fence : fences) {
+    if (fence_pool_.size() >= kMaxPooledFences) {
+      break;
+    }
+    fence_pool_.emplace_back(std::move(fence));
+  }
+}
+
 static std::vector<vk::Fence> GetFencesForWaitSet(const WaitSet& set) {
   std::vector<vk::Fence> fences;
   for (const auto& entry : set) {
@@ -84,12 +223,114 @@ static std::vector<vk::Fence> GetFencesForWaitSet(const WaitSet& set) {
   return fences;
 }
 
+static constexpr std::chrono::nanoseconds kWaitTimeout =
+    std::chrono::milliseconds{100};
+
+bool FenceWaiterVK::WaitForFences(const vk::Device& device,
+                                  WaitSet& wait_set) {
+  // Wait for one or more fences to be signaled. Any additional fences added
+  // to the waiter will be serviced in the next pass. If a fence that is going
+  // to be signaled at an abnormally long deadline is the only one in the set,
+  // a timeout will bail out the wait.
+  auto fences = GetFencesForWaitSet(wait_set);
+  if (fences.empty()) {
+    return true;
+  }
+
+  auto result = device.waitForFences(fences.size(),        // fences count
+                                     fences.data(),        // fences
+                                     false,                // wait for all
+                                     kWaitTimeout.count()  // timeout (ns)
+  );
+  if (!(result == vk::Result::eSuccess || result == vk::Result::eTimeout)) {
+    return false;
+  }
+
+  // One or more fences have been signaled. Find out which ones and update
+  // their signaled statuses.
+  TRACE_EVENT0("impeller", "CheckFenceStatus");
+  for (auto& entry : wait_set) {
+    entry->UpdateSignalledStatus(device);
+  }
+  return true;
+}
+
+bool FenceWaiterVK::WaitForTimelineSemaphore(const vk::Device& device,
+                                             WaitSet& wait_set) {
+  if (wait_set.empty()) {
+    return true;
+  }
+
+  // Entries are in submission order. Waiting for the first one is enough to
+  // make progress, and every later submission that has completed by then is
+  // collected in the same pass.
+  const auto semaphore = timeline_semaphore_.get();
+  const auto value = wait_set.front()->GetTimelineValue();
+  vk::SemaphoreWaitInfoKHR wait_info;
+  wait_info.semaphoreCount = 1u;
+  wait_info.pSemaphores = &semaphore;
+  wait_info.pValues = &value;
+  auto result = device.waitSemaphoresKHR(wait_info, kWaitTimeout.count());
+  if (!(result == vk::Result::eSuccess || result == vk::Result::eTimeout)) {
+    return false;
+  }
+
+  auto counter = device.getSemaphoreCounterValueKHR(semaphore);
+  if (counter.result != vk::Result::eSuccess) {
+    return false;
+  }
+  for (auto& entry : wait_set) {
+    entry->UpdateSignalledStatus(counter.value);
+  }
+  return true;
+}
+
+void FenceWaiterVK::InvokeCallbacks(WaitSet entries) {
+  if (!callback_runner_) {
+    TRACE_EVENT0("impeller", "ClearSignaledFences");
+    // Erase the entries which will invoke callbacks.
+    entries.clear();
+    return;
+  }
+
+  {
+    std::scoped_lock lock(callback_batches_->mutex);
+    callback_batches_->batches.push_back(std::move(entries));
+    // A task that is already invoking callbacks picks the batch up after the
+    // batches before it. Batches must not run concurrently on the worker
+    // task runner, or later submissions could complete first.
+    if (callback_batches_->is_invoking) {
+      return;
+    }
+    callback_batches_->is_invoking = true;
+  }
+  // The task must not touch the waiter. The last reference to the context,
+  // and with it the waiter, may be dropped by one of the callbacks.
+  callback_runner_->PostTask([callback_batches = callback_batches_]() {
+    tls_is_invoking_callbacks = true;
+    while (true) {
+      WaitSet batch;
+      {
+        std::scoped_lock lock(callback_batches->mutex);
+        if (callback_batches->batches.empty()) {
+          callback_batches->is_invoking = false;
+          callback_batches->cv.notify_all();
+          break;
+        }
+        batch = std::move(callback_batches->batches.front());
+        callback_batches->batches.pop_front();
+      }
+      TRACE_EVENT0("impeller", "ClearSignaledFences");
+      batch.clear();
+    }
+    tls_is_invoking_callbacks = false;
+  });
+}
+
 void FenceWaiterVK::Main() {
   fml::Thread::SetCurrentThreadName(
       fml::Thread::ThreadConfig{"io.flutter.impeller.fence_waiter"});
 
-  using namespace std::literals::chrono_literals;
-
   while (true) {
     std::unique_lock lock(wait_set_mutex_);
 
@@ -117,36 +358,15 @@ void FenceWaiterVK::Main() {
 
     const auto& device = device_holder->GetDevice();
 
-    // Wait for one or more fences to be signaled. Any additional fences added
-    // to the waiter will be serviced in the next pass. If a fence that is going
-    // to be signaled at an abnormally long deadline is the only one in the set,
-    // a timeout will bail out the wait.
-    auto fences = GetFencesForWaitSet(wait_set);
-    if (fences.empty()) {
-      continue;
-    }
-
-    auto result = device.waitForFences(
-        fences.size(),                           // fences count
-        fences.data(),                           // fences
-        false,                                   // wait for all
-        std::chrono::nanoseconds{100ms}.count()  // timeout (ns)
-    );
-    if (!(result == vk::Result::eSuccess || result == vk::Result::eTimeout)) {
+    const auto waited = timeline_semaphore_
+                            ? WaitForTimelineSemaphore(device, wait_set)
+                            : WaitForFences(device, wait_set);
+    if (!waited) {
       VALIDATION_LOG << "Fence waiter encountered an unexpected error. Tearing "
                         "down the waiter thread.";
       break;
     }
-
-    // One or more fences have been signaled. Find out which ones and update
-    // their signaled statuses.
-    {
-      TRACE_EVENT0("impeller", "CheckFenceStatus");
-      for (auto& entry : wait_set) {
-        entry->UpdateSignalledStatus(device);
-      }
-      wait_set.clear();
-    }
+    wait_set.clear();
 
     // Quickly acquire the wait set lock and erase signaled entries. Make sure
     // the mutex is unlocked before calling the destructors of the erased
@@ -163,12 +383,20 @@ void FenceWaiterVK::Main() {
           std::remove_if(wait_set_.begin(), wait_set_.end(), is_signalled),
           wait_set_.end());
     }
+    if (erased_entries.empty()) {
+      continue;
+    }
 
-    {
-      TRACE_EVENT0("impeller", "ClearSignaledFences");
-      // Erase the erased entries which will invoke callbacks.
-      erased_entries.clear();  // Bit redundant because of scope but hey.
+    // The fences of completed submissions are reset together and reused.
+    std::vector<vk::UniqueFence> signalled_fences;
+    for (auto& entry : erased_entries) {
+      if (auto fence = entry->TakeFence()) {
+        signalled_fences.emplace_back(std::move(fence));
+      }
     }
+    RecycleFences(device, std::move(signalled_fences));
+
+    InvokeCallbacks(std::move(erased_entries));
   }
 }
 
@@ -178,6 +406,25 @@ void FenceWaiterVK::Terminate() {
     terminate_ = true;
   }
   wait_set_cv_.notify_one();
+
+  if (waiter_thread_ && waiter_thread_->joinable()) {
+    if (waiter_thread_->get_id() == std::this_thread::get_id()) {
+      waiter_thread_->detach();
+    } else {
+      waiter_thread_->join();
+    }
+  }
+
+  // The callbacks may reference objects that are collected along with the
+  // owner of the waiter.
+  if (tls_is_invoking_callbacks) {
+    return;
+  }
+  std::unique_lock lock(callback_batches_->mutex);
+  callback_batches_->cv.wait(lock, [&]() {
+    return callback_batches_->batches.empty() &&
+           !callback_batches_->is_invoking;
+  });
 }
 
 }  // namespace impeller
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "impeller/base/thread.h"
 #include "impeller/renderer/backend/vulkan/device_holder.h"
@@ -19,35 +20,96 @@
 namespace impeller {
 
 class ContextVK;
+class QueueVK;
 class WaitSetEntry;
+struct CallbackBatchesVK;
 
 using WaitSet = std::vector<std::shared_ptr<WaitSetEntry>>;
 
+//------------------------------------------------------------------------------
+/// @brief      Submits work to device queues and invokes callbacks once the
+///             device is done with it.
+///
+///             Where timeline semaphores are supported, every submission
+///             signals the next value of a single timeline semaphore and the
+///             waiter thread waits on that semaphore once for all the
+///             submissions that are pending. Otherwise, each submission
+///             signals a fence taken from a pool.
+///
+///             The callbacks of all the submissions that completed together
+///             are invoked in submission order. Batches of callbacks are
+///             invoked one after the other, in the order they completed, by a
+///             single task on the worker task runner at a time.
+///
 class FenceWaiterVK {
  public:
   ~FenceWaiterVK();
 
   bool IsValid() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Stop waiting and block until the callbacks of completed
+  ///             submissions have been invoked. The callbacks of pending
+  ///             submissions are invoked when the waiter is collected.
+  ///
   void Terminate();
 
-  bool AddFence(vk::UniqueFence fence, const fml::closure& callback);
+  //----------------------------------------------------------------------------
+  /// @brief      Submit work to the queue and invoke the callback once the
+  ///             device is done with it. The callback is dropped without
+  ///             being invoked if the submission fails.
+  ///
+  bool Submit(const QueueVK& queue,
+              vk::SubmitInfo submit_info,
+              const fml::closure& callback);
+
+  bool UsesTimelineSemaphore() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of signalled fences kept around for reuse.
+  ///
+  size_t GetPooledFenceCount() const;
 
  private:
   friend class ContextVK;
 
+  static constexpr size_t kMaxPooledFences = 64u;
+
   std::weak_ptr<DeviceHolder> device_holder_;
+  std::shared_ptr<fml::ConcurrentTaskRunner> callback_runner_;
   std::unique_ptr<std::thread> waiter_thread_;
   std::mutex wait_set_mutex_;
   std::condition_variable wait_set_cv_;
   WaitSet wait_set_;
   bool terminate_ = false;
+  // Keeps timeline values increasing in submission order.
+  std::mutex submit_mutex_;
+  vk::UniqueSemaphore timeline_semaphore_;
+  uint64_t last_timeline_value_ = 0u;
+  mutable std::mutex fence_pool_mutex_;
+  std::vector<vk::UniqueFence> fence_pool_;
+  // Shared with the task that invokes the callbacks. A callback may collect
+  // the waiter while the task is still draining batches.
+  std::shared_ptr<CallbackBatchesVK> callback_batches_;
   bool is_valid_ = false;
 
-  explicit FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder);
+  FenceWaiterVK(std::weak_ptr<DeviceHolder> device_holder,
+                std::shared_ptr<fml::ConcurrentTaskRunner> callback_runner,
+                bool use_timeline_semaphore);
 
   void Main();
 
+  vk::UniqueFence AcquireFence(const vk::Device& device);
+
+  void RecycleFences(const vk::Device& device,
+                     std::vector<vk::UniqueFence> fences);
+
+  bool WaitForTimelineSemaphore(const vk::Device& device, WaitSet& wait_set);
+
+  bool WaitForFences(const vk::Device& device, WaitSet& wait_set);
+
+  void InvokeCallbacks(WaitSet entries);
+
   FML_DISALLOW_COPY_AND_ASSIGN(FenceWaiterVK);
 };
 
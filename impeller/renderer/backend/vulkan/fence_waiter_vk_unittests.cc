@@ -0,0 +1,115 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/testing/testing.h"
+#include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/fence_waiter_vk.h"
+#include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
+
+namespace impeller {
+namespace testing {
+
+TEST(FenceWaiterVKTest, RecyclesSignalledFences) {
+  auto context = CreateMockVulkanContext();
+  auto waiter = context->GetFenceWaiter();
+  ASSERT_FALSE(waiter->UsesTimelineSemaphore());
+
+  for (size_t i = 0; i < 3; i++) {
+    fml::AutoResetWaitableEvent latch;
+    ASSERT_TRUE(waiter->Submit(*context->GetGraphicsQueue(), {},
+                               [&latch]() { latch.Signal(); }));
+    latch.Wait();
+    // Fences are reset before the callbacks of their submissions run.
+    EXPECT_EQ(waiter->GetPooledFenceCount(), 1u);
+  }
+
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::count(functions->begin(), functions->end(), "vkCreateFence"),
+            1);
+  EXPECT_EQ(std::count(functions->begin(), functions->end(), "vkResetFences"),
+            3);
+}
+
+TEST(FenceWaiterVKTest, InvokesCallbacksBeforeContextIsCollected) {
+  auto context = CreateMockVulkanContext();
+  auto waiter = context->GetFenceWaiter();
+
+  bool invoked = false;
+  ASSERT_TRUE(waiter->Submit(*context->GetGraphicsQueue(), {},
+                             [&invoked]() { invoked = true; }));
+  waiter.reset();
+  context.reset();
+  EXPECT_TRUE(invoked);
+}
+
+TEST(FenceWaiterVKTest, InvokesCallbacksInSubmissionOrder) {
+  auto context = CreateMockVulkanContext();
+  auto waiter = context->GetFenceWaiter();
+
+  constexpr size_t kSubmissionCount = 32u;
+  std::mutex mutex;
+  std::vector<size_t> order;
+  fml::CountDownLatch latch(kSubmissionCount);
+  for (size_t i = 0; i < kSubmissionCount; i++) {
+    ASSERT_TRUE(waiter->Submit(*context->GetGraphicsQueue(), {}, [&, i]() {
+      // Slow callbacks give later batches the chance to overtake them.
+      if (i % 4 == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      {
+        std::scoped_lock lock(mutex);
+        order.push_back(i);
+      }
+      latch.CountDown();
+    }));
+  }
+  latch.Wait();
+  EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+}
+
+TEST(FenceWaiterVKTest, WaitsOnTimelineSemaphoreWhenSupported) {
+  auto context =
+      CreateMockVulkanContext(/*supports_timeline_semaphores=*/true);
+  auto waiter = context->GetFenceWaiter();
+  ASSERT_TRUE(waiter->UsesTimelineSemaphore());
+
+  constexpr size_t kSubmissionCount = 8u;
+  std::mutex mutex;
+  std::vector<size_t> order;
+  fml::CountDownLatch latch(kSubmissionCount);
+  for (size_t i = 0; i < kSubmissionCount; i++) {
+    ASSERT_TRUE(waiter->Submit(*context->GetGraphicsQueue(), {}, [&, i]() {
+      {
+        std::scoped_lock lock(mutex);
+        order.push_back(i);
+      }
+      latch.CountDown();
+    }));
+  }
+  latch.Wait();
+  EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+
+  // Submissions signal the timeline semaphore instead of fences.
+  EXPECT_EQ(waiter->GetPooledFenceCount(), 0u);
+  auto functions = GetMockVulkanFunctions(context->GetDevice());
+  EXPECT_EQ(std::count(functions->begin(), functions->end(), "vkCreateFence"),
+            0);
+  EXPECT_EQ(
+      std::count(functions->begin(), functions->end(), "vkCreateSemaphore"),
+      1);
+  EXPECT_NE(std::find(functions->begin(), functions->end(),
+                      "vkWaitSemaphoresKHR"),
+            functions->end());
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -11,4 +11,14 @@ namespace impeller {
 constexpr size_t kImageSizeThresholdForDedicatedMemoryAllocation =
     4 * 1024 * 1024;
 
+// Size of the ring pool that small host visible buffers used by a single
+// frame, such as the uniform and vertex data of its passes, are suballocated
+// from.
+constexpr size_t kTransientBufferPoolSize = 16 * 1024 * 1024;
+
+// Per frame host visible buffers up to this size are suballocated from the
+// transient buffer pool. Larger ones, and any that don't fit in the pool, get
+// an allocation of their own.
+constexpr size_t kTransientBufferPoolMaxAllocationSize = 1024 * 1024;
+
 }  // namespace impeller
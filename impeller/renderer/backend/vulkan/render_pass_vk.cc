@@ -18,6 +18,7 @@
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/device_buffer_vk.h"
+#include "impeller/renderer/backend/vulkan/encoding_scheduler_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/pipeline_vk.h"
 #include "impeller/renderer/backend/vulkan/sampler_vk.h"
@@ -286,11 +287,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
                                           const PipelineVK& pipeline) {
   auto desc_set =
       pipeline.GetDescriptor().GetVertexDescriptor()->GetDescriptorSetLayouts();
-  auto vk_desc_set =
-      encoder.AllocateDescriptorSet(pipeline.GetDescriptorSetLayout());
-  if (!vk_desc_set) {
-    return false;
-  }
 
   auto& allocator = *context.GetResourceAllocator();
 
@@ -298,10 +294,9 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
   std::unordered_map<uint32_t, vk::DescriptorImageInfo> images;
   std::vector<vk::WriteDescriptorSet> writes;
 
-  auto bind_images = [&encoder,     //
-                      &images,      //
-                      &writes,      //
-                      &vk_desc_set  //
+  auto bind_images = [&encoder,  //
+                      &images,   //
+                      &writes    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [index, sampler_handle] : bindings.samplers) {
       if (bindings.textures.find(index) == bindings.textures.end()) {
@@ -325,7 +320,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       image_info.imageView = texture_vk.GetImageView();
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = slot.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = vk::DescriptorType::eCombinedImageSampler;
@@ -337,12 +331,11 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return true;
   };
 
-  auto bind_buffers = [&allocator,   //
-                       &encoder,     //
-                       &buffers,     //
-                       &writes,      //
-                       &desc_set,    //
-                       &vk_desc_set  //
+  auto bind_buffers = [&allocator,  //
+                       &encoder,    //
+                       &buffers,    //
+                       &writes,     //
+                       &desc_set    //
   ](const Bindings& bindings) -> bool {
     for (const auto& [buffer_index, view] : bindings.buffers) {
       const auto& buffer_view = view.resource.buffer;
@@ -387,7 +380,6 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
       auto layout = *layout_it;
 
       vk::WriteDescriptorSet write_set;
-      write_set.dstSet = vk_desc_set.value();
       write_set.dstBinding = uniform.binding;
       write_set.descriptorCount = 1u;
       write_set.descriptorType = ToVKDescriptorType(layout.descriptor_type);
@@ -404,7 +396,11 @@ static bool AllocateAndBindDescriptorSets(const ContextVK& context,
     return false;
   }
 
-  context.GetDevice().updateDescriptorSets(writes, {});
+  auto vk_desc_set =
+      encoder.GetDescriptorSet(pipeline.GetDescriptorSetLayout(), writes);
+  if (!vk_desc_set) {
+    return false;
+  }
 
   encoder.GetCommandBuffer().bindDescriptorSets(
       vk::PipelineBindPoint::eGraphics,   // bind point
@@ -561,15 +557,26 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
     return false;
   }
 
+  // Passes encoded on this thread must observe the image layouts left behind
+  // by the passes being encoded on the workers.
+  if (const auto& scheduler = vk_context.GetEncodingScheduler()) {
+    scheduler->Flush();
+  }
+
+  return EncodeCommands(vk_context, *encoder);
+}
+
+bool RenderPassVK::EncodeCommands(const ContextVK& vk_context,
+                                  CommandEncoderVK& encoder) const {
   fml::ScopedCleanupClosure pop_marker(
-      [&encoder]() { encoder->PopDebugGroup(); });
+      [&encoder]() { encoder.PopDebugGroup(); });
   if (!debug_label_.empty()) {
-    encoder->PushDebugGroup(debug_label_.c_str());
+    encoder.PushDebugGroup(debug_label_.c_str());
   } else {
     pop_marker.Release();
   }
 
-  auto cmd_buffer = encoder->GetCommandBuffer();
+  auto cmd_buffer = encoder.GetCommandBuffer();
 
   if (!UpdateBindingLayouts(commands_, cmd_buffer)) {
     return false;
@@ -577,8 +584,8 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
 
   render_target_.IterateAllAttachments(
       [&encoder](const auto& attachment) -> bool {
-        encoder->Track(attachment.texture);
-        encoder->Track(attachment.resolve_texture);
+        encoder.Track(attachment.texture);
+        encoder.Track(attachment.resolve_texture);
         return true;
       });
 
@@ -596,7 +603,7 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
     return false;
   }
 
-  if (!encoder->Track(framebuffer) || !encoder->Track(render_pass)) {
+  if (!encoder.Track(framebuffer) || !encoder.Track(render_pass)) {
     return false;
   }
 
@@ -622,7 +629,7 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
         continue;
       }
 
-      if (!EncodeCommand(context, command, *encoder, pass_bindings_cache_,
+      if (!EncodeCommand(vk_context, command, encoder, pass_bindings_cache_,
                          target_size)) {
         return false;
       }
@@ -632,4 +639,45 @@ bool RenderPassVK::OnEncodeCommands(const Context& context) const {
   return true;
 }
 
+static const void* GetResourceKey(
+    const std::shared_ptr<const Texture>& texture) {
+  if (!texture) {
+    return nullptr;
+  }
+  return TextureVK::Cast(*texture).GetTextureSource().get();
+}
+
+void RenderPassVK::CollectResources(std::set<const void*>& reads,
+                                    std::set<const void*>& writes) const {
+  render_target_.IterateAllAttachments(
+      [&writes](const auto& attachment) -> bool {
+        if (auto key = GetResourceKey(attachment.texture)) {
+          writes.insert(key);
+        }
+        if (auto key = GetResourceKey(attachment.resolve_texture)) {
+          writes.insert(key);
+        }
+        return true;
+      });
+  for (const auto& command : commands_) {
+    for (const auto* bindings :
+         {&command.vertex_bindings, &command.fragment_bindings}) {
+      for (const auto& [_, texture] : bindings->textures) {
+        auto key = GetResourceKey(texture.resource);
+        if (!key) {
+          continue;
+        }
+        // Encoding transitions textures that aren't ready for sampling yet,
+        // which changes the layout that other passes sampling them observe.
+        if (TextureVK::Cast(*texture.resource).GetLayout() ==
+            vk::ImageLayout::eShaderReadOnlyOptimal) {
+          reads.insert(key);
+        } else {
+          writes.insert(key);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace impeller
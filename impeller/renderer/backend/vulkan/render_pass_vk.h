@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <set>
+
 #include "flutter/fml/macros.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
 #include "impeller/renderer/backend/vulkan/pass_bindings_cache.h"
@@ -42,6 +44,17 @@ class RenderPassVK final : public RenderPass {
   // |RenderPass|
   bool OnEncodeCommands(const Context& context) const override;
 
+  bool EncodeCommands(const ContextVK& context,
+                      CommandEncoderVK& encoder) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Collect the images sampled by the commands of this pass and
+  ///             the images it renders to. Sampled images that encoding the
+  ///             pass transitions to another layout are collected as written.
+  ///
+  void CollectResources(std::set<const void*>& reads,
+                        std::set<const void*>& writes) const;
+
   SharedHandleVK<vk::RenderPass> CreateVKRenderPass(
       const ContextVK& context) const;
 
@@ -7,6 +7,7 @@
 #include "impeller/renderer/backend/vulkan/command_buffer_vk.h"
 #include "impeller/renderer/backend/vulkan/command_encoder_vk.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
+#include "impeller/renderer/backend/vulkan/encoding_scheduler_vk.h"
 #include "impeller/renderer/backend/vulkan/formats_vk.h"
 #include "impeller/renderer/backend/vulkan/surface_vk.h"
 #include "impeller/renderer/backend/vulkan/swapchain_image_vk.h"
@@ -392,6 +393,14 @@ bool SwapchainImplVK::Present(const std::shared_ptr<SwapchainImageVK>& image,
 
   const auto& sync = synchronizers_[current_frame_];
 
+  //----------------------------------------------------------------------------
+  /// Make sure the frame has been encoded and submitted before the image is
+  /// transitioned for presentation.
+  ///
+  if (const auto& scheduler = context.GetEncodingScheduler()) {
+    scheduler->Flush();
+  }
+
   //----------------------------------------------------------------------------
   /// Transition the image to color-attachment-optimal.
   ///
@@ -4,6 +4,8 @@
 
 #include "impeller/renderer/backend/vulkan/test/mock_vulkan.h"
 
+#include <atomic>
+
 namespace impeller {
 namespace testing {
 
@@ -27,8 +29,30 @@ struct MockDevice {
   }
   std::shared_ptr<std::vector<std::string>> called_functions_;
   std::vector<std::unique_ptr<MockCommandBuffer>> command_buffers_;
+  uint64_t next_handle_ = 1u;
+};
+
+/// Buffers remember their size so that their memory requirements match it.
+struct MockBuffer {
+  VkDeviceSize size = 0u;
+};
+
+/// Device memory is only backed by host memory once it is mapped.
+struct MockDeviceMemory {
+  VkDeviceSize size = 0u;
+  std::vector<uint8_t> contents;
 };
 
+/// Submissions complete immediately, so semaphores only track the last value
+/// that a submission signalled.
+struct MockSemaphore {
+  std::atomic<uint64_t> value = 0u;
+};
+
+/// Whether devices report support for timeline semaphores. Contexts are set
+/// up synchronously on the thread that creates them.
+thread_local bool tls_supports_timeline_semaphores = false;
+
 void noop() {}
 
 VkResult vkEnumerateInstanceExtensionProperties(
@@ -85,6 +109,8 @@ void vkGetPhysicalDeviceProperties(VkPhysicalDevice physicalDevice,
       static_cast<VkSampleCountFlags>(VK_SAMPLE_COUNT_1_BIT |
                                       VK_SAMPLE_COUNT_4_BIT);
   pProperties->limits.maxImageDimension2D = 4096;
+  pProperties->limits.bufferImageGranularity = 1u;
+  pProperties->limits.nonCoherentAtomSize = 1u;
 }
 
 void vkGetPhysicalDeviceQueueFamilyProperties(
@@ -106,10 +132,14 @@ VkResult vkEnumerateDeviceExtensionProperties(
     uint32_t* pPropertyCount,
     VkExtensionProperties* pProperties) {
   if (!pProperties) {
-    *pPropertyCount = 1;
+    *pPropertyCount = tls_supports_timeline_semaphores ? 2 : 1;
   } else {
     strcpy(pProperties[0].extensionName, "VK_KHR_swapchain");
     pProperties[0].specVersion = 0;
+    if (*pPropertyCount > 1) {
+      strcpy(pProperties[1].extensionName, "VK_KHR_timeline_semaphore");
+      pProperties[1].specVersion = 0;
+    }
   }
   return VK_SUCCESS;
 }
@@ -134,9 +164,10 @@ void vkGetPhysicalDeviceMemoryProperties(
     VkPhysicalDeviceMemoryProperties* pMemoryProperties) {
   pMemoryProperties->memoryTypeCount = 1;
   pMemoryProperties->memoryTypes[0].heapIndex = 0;
-  // pMemoryProperties->memoryTypes[0].propertyFlags =
-  //     VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
-  //     VK_MEMORY_PROPERTY_DEVICE_COHERENT_BIT_AMD;
+  pMemoryProperties->memoryTypes[0].propertyFlags =
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+      VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
   pMemoryProperties->memoryHeapCount = 1;
   pMemoryProperties->memoryHeaps[0].size = 1024 * 1024 * 1024;
   pMemoryProperties->memoryHeaps[0].flags = 0;
@@ -195,10 +226,31 @@ VkResult vkAllocateMemory(VkDevice device,
                           const VkMemoryAllocateInfo* pAllocateInfo,
                           const VkAllocationCallbacks* pAllocator,
                           VkDeviceMemory* pMemory) {
-  *pMemory = reinterpret_cast<VkDeviceMemory>(0xCAFEB0BA);
+  *pMemory = reinterpret_cast<VkDeviceMemory>(
+      new MockDeviceMemory{.size = pAllocateInfo->allocationSize});
+  return VK_SUCCESS;
+}
+
+void vkFreeMemory(VkDevice device,
+                  VkDeviceMemory memory,
+                  const VkAllocationCallbacks* pAllocator) {
+  delete reinterpret_cast<MockDeviceMemory*>(memory);
+}
+
+VkResult vkMapMemory(VkDevice device,
+                     VkDeviceMemory memory,
+                     VkDeviceSize offset,
+                     VkDeviceSize size,
+                     VkMemoryMapFlags flags,
+                     void** ppData) {
+  auto* mock_memory = reinterpret_cast<MockDeviceMemory*>(memory);
+  mock_memory->contents.resize(mock_memory->size);
+  *ppData = mock_memory->contents.data() + offset;
   return VK_SUCCESS;
 }
 
+void vkUnmapMemory(VkDevice device, VkDeviceMemory memory) {}
+
 VkResult vkBindImageMemory(VkDevice device,
                            VkImage image,
                            VkDeviceMemory memory,
@@ -218,16 +270,31 @@ VkResult vkCreateBuffer(VkDevice device,
                         const VkBufferCreateInfo* pCreateInfo,
                         const VkAllocationCallbacks* pAllocator,
                         VkBuffer* pBuffer) {
-  *pBuffer = reinterpret_cast<VkBuffer>(0xDEADDEAD);
+  *pBuffer =
+      reinterpret_cast<VkBuffer>(new MockBuffer{.size = pCreateInfo->size});
   return VK_SUCCESS;
 }
 
+void vkDestroyBuffer(VkDevice device,
+                     VkBuffer buffer,
+                     const VkAllocationCallbacks* pAllocator) {
+  delete reinterpret_cast<MockBuffer*>(buffer);
+}
+
+void vkGetBufferMemoryRequirements(VkDevice device,
+                                   VkBuffer buffer,
+                                   VkMemoryRequirements* pMemoryRequirements) {
+  pMemoryRequirements->size = reinterpret_cast<MockBuffer*>(buffer)->size;
+  pMemoryRequirements->alignment = 16u;
+  pMemoryRequirements->memoryTypeBits = 1;
+}
+
 void vkGetBufferMemoryRequirements2KHR(
     VkDevice device,
     const VkBufferMemoryRequirementsInfo2* pInfo,
     VkMemoryRequirements2* pMemoryRequirements) {
-  pMemoryRequirements->memoryRequirements.size = 1024;
-  pMemoryRequirements->memoryRequirements.memoryTypeBits = 1;
+  vkGetBufferMemoryRequirements(device, pInfo->buffer,
+                                &pMemoryRequirements->memoryRequirements);
 }
 
 VkResult vkBindBufferMemory(VkDevice device,
@@ -346,6 +413,151 @@ void vkCmdSetViewport(VkCommandBuffer commandBuffer,
   mock_command_buffer->called_functions_->push_back("vkCmdSetViewport");
 }
 
+VkResult vkCreateDescriptorPool(VkDevice device,
+                                const VkDescriptorPoolCreateInfo* pCreateInfo,
+                                const VkAllocationCallbacks* pAllocator,
+                                VkDescriptorPool* pDescriptorPool) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkCreateDescriptorPool");
+  *pDescriptorPool =
+      reinterpret_cast<VkDescriptorPool>(mock_device->next_handle_++);
+  return VK_SUCCESS;
+}
+
+void vkDestroyDescriptorPool(VkDevice device,
+                             VkDescriptorPool descriptorPool,
+                             const VkAllocationCallbacks* pAllocator) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkDestroyDescriptorPool");
+}
+
+VkResult vkResetDescriptorPool(VkDevice device,
+                               VkDescriptorPool descriptorPool,
+                               VkDescriptorPoolResetFlags flags) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkResetDescriptorPool");
+  return VK_SUCCESS;
+}
+
+VkResult vkAllocateDescriptorSets(
+    VkDevice device,
+    const VkDescriptorSetAllocateInfo* pAllocateInfo,
+    VkDescriptorSet* pDescriptorSets) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkAllocateDescriptorSets");
+  for (uint32_t i = 0; i < pAllocateInfo->descriptorSetCount; i++) {
+    pDescriptorSets[i] =
+        reinterpret_cast<VkDescriptorSet>(mock_device->next_handle_++);
+  }
+  return VK_SUCCESS;
+}
+
+void vkUpdateDescriptorSets(VkDevice device,
+                            uint32_t descriptorWriteCount,
+                            const VkWriteDescriptorSet* pDescriptorWrites,
+                            uint32_t descriptorCopyCount,
+                            const VkCopyDescriptorSet* pDescriptorCopies) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkUpdateDescriptorSets");
+}
+
+VkResult vkCreateFence(VkDevice device,
+                       const VkFenceCreateInfo* pCreateInfo,
+                       const VkAllocationCallbacks* pAllocator,
+                       VkFence* pFence) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkCreateFence");
+  *pFence = reinterpret_cast<VkFence>(mock_device->next_handle_++);
+  return VK_SUCCESS;
+}
+
+void vkDestroyFence(VkDevice device,
+                    VkFence fence,
+                    const VkAllocationCallbacks* pAllocator) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkDestroyFence");
+}
+
+VkResult vkResetFences(VkDevice device,
+                       uint32_t fenceCount,
+                       const VkFence* pFences) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkResetFences");
+  return VK_SUCCESS;
+}
+
+// Submissions complete immediately.
+VkResult vkGetFenceStatus(VkDevice device, VkFence fence) {
+  return VK_SUCCESS;
+}
+
+VkResult vkWaitForFences(VkDevice device,
+                         uint32_t fenceCount,
+                         const VkFence* pFences,
+                         VkBool32 waitAll,
+                         uint64_t timeout) {
+  return VK_SUCCESS;
+}
+
+VkResult vkCreateSemaphore(VkDevice device,
+                           const VkSemaphoreCreateInfo* pCreateInfo,
+                           const VkAllocationCallbacks* pAllocator,
+                           VkSemaphore* pSemaphore) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkCreateSemaphore");
+  *pSemaphore = reinterpret_cast<VkSemaphore>(new MockSemaphore());
+  return VK_SUCCESS;
+}
+
+void vkDestroySemaphore(VkDevice device,
+                        VkSemaphore semaphore,
+                        const VkAllocationCallbacks* pAllocator) {
+  delete reinterpret_cast<MockSemaphore*>(semaphore);
+}
+
+VkResult vkGetSemaphoreCounterValueKHR(VkDevice device,
+                                       VkSemaphore semaphore,
+                                       uint64_t* pValue) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkGetSemaphoreCounterValueKHR");
+  *pValue = reinterpret_cast<MockSemaphore*>(semaphore)->value;
+  return VK_SUCCESS;
+}
+
+VkResult vkWaitSemaphoresKHR(VkDevice device,
+                             const VkSemaphoreWaitInfo* pWaitInfo,
+                             uint64_t timeout) {
+  MockDevice* mock_device = reinterpret_cast<MockDevice*>(device);
+  mock_device->called_functions_->push_back("vkWaitSemaphoresKHR");
+  return VK_SUCCESS;
+}
+
+VkResult vkQueueSubmit(VkQueue queue,
+                       uint32_t submitCount,
+                       const VkSubmitInfo* pSubmits,
+                       VkFence fence) {
+  for (uint32_t i = 0; i < submitCount; i++) {
+    const auto& submit = pSubmits[i];
+    for (auto next = reinterpret_cast<const VkBaseInStructure*>(submit.pNext);
+         next != nullptr; next = next->pNext) {
+      if (next->sType != VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO) {
+        continue;
+      }
+      const auto* timeline_info =
+          reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(next);
+      for (uint32_t j = 0; j < timeline_info->signalSemaphoreValueCount &&
+                           j < submit.signalSemaphoreCount;
+           j++) {
+        if (auto semaphore = reinterpret_cast<MockSemaphore*>(
+                submit.pSignalSemaphores[j])) {
+          semaphore->value = timeline_info->pSignalSemaphoreValues[j];
+        }
+      }
+    }
+  }
+  return VK_SUCCESS;
+}
+
 PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
                                             const char* pName) {
   if (strcmp("vkEnumerateInstanceExtensionProperties", pName) == 0) {
@@ -387,12 +599,22 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkGetImageMemoryRequirements2KHR;
   } else if (strcmp("vkAllocateMemory", pName) == 0) {
     return (PFN_vkVoidFunction)vkAllocateMemory;
+  } else if (strcmp("vkFreeMemory", pName) == 0) {
+    return (PFN_vkVoidFunction)vkFreeMemory;
+  } else if (strcmp("vkMapMemory", pName) == 0) {
+    return (PFN_vkVoidFunction)vkMapMemory;
+  } else if (strcmp("vkUnmapMemory", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUnmapMemory;
   } else if (strcmp("vkBindImageMemory", pName) == 0) {
     return (PFN_vkVoidFunction)vkBindImageMemory;
   } else if (strcmp("vkCreateImageView", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateImageView;
   } else if (strcmp("vkCreateBuffer", pName) == 0) {
     return (PFN_vkVoidFunction)vkCreateBuffer;
+  } else if (strcmp("vkDestroyBuffer", pName) == 0) {
+    return (PFN_vkVoidFunction)vkDestroyBuffer;
+  } else if (strcmp("vkGetBufferMemoryRequirements", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetBufferMemoryRequirements;
   } else if (strcmp("vkGetBufferMemoryRequirements2KHR", pName) == 0 ||
              strcmp("vkGetBufferMemoryRequirements2", pName) == 0) {
     return (PFN_vkVoidFunction)vkGetBufferMemoryRequirements2KHR;
@@ -424,17 +646,53 @@ PFN_vkVoidFunction GetMockVulkanProcAddress(VkInstance instance,
     return (PFN_vkVoidFunction)vkCmdSetScissor;
   } else if (strcmp("vkCmdSetViewport", pName) == 0) {
     return (PFN_vkVoidFunction)vkCmdSetViewport;
+  } else if (strcmp("vkCreateDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCreateDescriptorPool;
+  } else if (strcmp("vkDestroyDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkDestroyDescriptorPool;
+  } else if (strcmp("vkResetDescriptorPool", pName) == 0) {
+    return (PFN_vkVoidFunction)vkResetDescriptorPool;
+  } else if (strcmp("vkAllocateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkAllocateDescriptorSets;
+  } else if (strcmp("vkUpdateDescriptorSets", pName) == 0) {
+    return (PFN_vkVoidFunction)vkUpdateDescriptorSets;
+  } else if (strcmp("vkCreateFence", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCreateFence;
+  } else if (strcmp("vkDestroyFence", pName) == 0) {
+    return (PFN_vkVoidFunction)vkDestroyFence;
+  } else if (strcmp("vkResetFences", pName) == 0) {
+    return (PFN_vkVoidFunction)vkResetFences;
+  } else if (strcmp("vkGetFenceStatus", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetFenceStatus;
+  } else if (strcmp("vkWaitForFences", pName) == 0) {
+    return (PFN_vkVoidFunction)vkWaitForFences;
+  } else if (strcmp("vkCreateSemaphore", pName) == 0) {
+    return (PFN_vkVoidFunction)vkCreateSemaphore;
+  } else if (strcmp("vkDestroySemaphore", pName) == 0) {
+    return (PFN_vkVoidFunction)vkDestroySemaphore;
+  } else if (strcmp("vkGetSemaphoreCounterValueKHR", pName) == 0 ||
+             strcmp("vkGetSemaphoreCounterValue", pName) == 0) {
+    return (PFN_vkVoidFunction)vkGetSemaphoreCounterValueKHR;
+  } else if (strcmp("vkWaitSemaphoresKHR", pName) == 0 ||
+             strcmp("vkWaitSemaphores", pName) == 0) {
+    return (PFN_vkVoidFunction)vkWaitSemaphoresKHR;
+  } else if (strcmp("vkQueueSubmit", pName) == 0) {
+    return (PFN_vkVoidFunction)vkQueueSubmit;
   }
   return noop;
 }
 
 }  // namespace
 
-std::shared_ptr<ContextVK> CreateMockVulkanContext(void) {
+std::shared_ptr<ContextVK> CreateMockVulkanContext(
+    bool supports_timeline_semaphores) {
   ContextVK::Settings settings;
   auto message_loop = fml::ConcurrentMessageLoop::Create();
   settings.proc_address_callback = GetMockVulkanProcAddress;
-  return ContextVK::Create(std::move(settings));
+  tls_supports_timeline_semaphores = supports_timeline_semaphores;
+  auto context = ContextVK::Create(std::move(settings));
+  tls_supports_timeline_semaphores = false;
+  return context;
 }
 
 std::shared_ptr<std::vector<std::string>> GetMockVulkanFunctions(
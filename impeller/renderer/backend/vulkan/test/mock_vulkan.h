@@ -15,7 +15,16 @@ namespace testing {
 std::shared_ptr<std::vector<std::string>> GetMockVulkanFunctions(
     VkDevice device);
 
-std::shared_ptr<ContextVK> CreateMockVulkanContext(void);
+//------------------------------------------------------------------------------
+/// @brief      Create a context backed by a mock device on which submissions
+///             complete immediately.
+///
+/// @param[in]  supports_timeline_semaphores  Whether the device supports the
+///                                           VK_KHR_timeline_semaphore
+///                                           extension.
+///
+std::shared_ptr<ContextVK> CreateMockVulkanContext(
+    bool supports_timeline_semaphores = false);
 
 }  // namespace testing
 }  // namespace impeller
@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/macros.h"
 #include "impeller/core/formats.h"
 #include "impeller/renderer/capabilities.h"
@@ -131,6 +132,19 @@ class Context {
   ///
   virtual std::shared_ptr<CommandBuffer> CreateCommandBuffer() const = 0;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Returns a task runner that may be used to perform work
+  ///             concurrently on worker threads owned by the context.
+  ///
+  ///             Tasks posted after the context is shut down are executed on
+  ///             the caller's thread.
+  ///
+  /// @return     The task runner or `nullptr` if the backend does not own a
+  ///             pool of workers.
+  ///
+  virtual std::shared_ptr<fml::ConcurrentTaskRunner>
+  GetConcurrentWorkerTaskRunner() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Force all pending asynchronous work to finish. This is
   ///             achieved by deleting all owned concurrent message loops.
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <future>
 
 #include "compute_pipeline_descriptor.h"
@@ -114,6 +115,16 @@ class RenderPipelineT {
     return pipeline_;
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Whether the pipeline has finished building, in which case
+  ///             `WaitAndGet` returns without blocking.
+  ///
+  bool IsReady() const {
+    return did_wait_ || !pipeline_future_.IsValid() ||
+           pipeline_future_.future.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+  }
+
   std::optional<PipelineDescriptor> GetDescriptor() const {
     return pipeline_future_.descriptor;
   }
@@ -17,6 +17,33 @@ namespace impeller {
 
 class Context;
 
+/// @brief  The source of the textures backing offscreen render targets.
+///
+///         The default implementation forwards every request to the
+///         allocator it was created with. Subclasses may recycle textures
+///         across frames. `Start` and `End` bracket the work done for a single
+///         frame.
+class RenderTargetAllocator {
+ public:
+  explicit RenderTargetAllocator(std::shared_ptr<Allocator> allocator);
+
+  virtual ~RenderTargetAllocator() = default;
+
+  virtual std::shared_ptr<Texture> CreateTexture(
+      const TextureDescriptor& desc);
+
+  /// @brief  Mark the beginning of a frame workload.
+  virtual void Start();
+
+  /// @brief  Mark the end of a frame workload.
+  virtual void End();
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RenderTargetAllocator);
+};
+
 class RenderTarget final {
  public:
   struct AttachmentConfig {
@@ -61,6 +88,15 @@ class RenderTarget final {
       std::optional<AttachmentConfig> stencil_attachment_config =
           kDefaultStencilAttachmentConfig);
 
+  static RenderTarget CreateOffscreen(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen",
+      AttachmentConfig color_attachment_config = kDefaultColorAttachmentConfig,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig);
+
   static RenderTarget CreateOffscreenMSAA(
       const Context& context,
       ISize size,
@@ -70,6 +106,16 @@ class RenderTarget final {
       std::optional<AttachmentConfig> stencil_attachment_config =
           kDefaultStencilAttachmentConfig);
 
+  static RenderTarget CreateOffscreenMSAA(
+      const Context& context,
+      RenderTargetAllocator& allocator,
+      ISize size,
+      const std::string& label = "Offscreen MSAA",
+      AttachmentConfigMSAA color_attachment_config =
+          kDefaultColorAttachmentConfigMSAA,
+      std::optional<AttachmentConfig> stencil_attachment_config =
+          kDefaultStencilAttachmentConfig);
+
   RenderTarget();
 
   ~RenderTarget();
@@ -83,6 +129,14 @@ class RenderTarget final {
                               AttachmentConfig stencil_attachment_config =
                                   kDefaultStencilAttachmentConfig);
 
+  void SetupStencilAttachment(const Context& context,
+                              RenderTargetAllocator& allocator,
+                              ISize size,
+                              bool msaa,
+                              const std::string& label = "Offscreen",
+                              AttachmentConfig stencil_attachment_config =
+                                  kDefaultStencilAttachmentConfig);
+
   SampleCount GetSampleCount() const;
 
   bool HasColorAttachment(size_t index) const;
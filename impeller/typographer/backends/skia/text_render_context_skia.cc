@@ -4,14 +4,21 @@
 
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <set>
+#include <thread>
 #include <utility>
 
 #include "flutter/fml/logging.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/trace_event.h"
 #include "impeller/base/allocation.h"
 #include "impeller/core/allocator.h"
 #include "impeller/typographer/backends/skia/typeface_skia.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkFont.h"
@@ -35,6 +42,28 @@ std::unique_ptr<TextRenderContext> TextRenderContext::Create(
 //              https://github.com/flutter/flutter/issues/114563
 constexpr auto kPadding = 2;
 
+static constexpr auto kMinAtlasSize = 8u;
+static constexpr auto kMinAlphaBitmapSize = 1024u;
+static constexpr auto kMaxAtlasSize = 4096u;
+
+// Glyphs are only rasterized on worker threads when each task gets at least
+// this many glyphs. Below that the dispatch overhead is not worth it.
+static constexpr size_t kMinGlyphsPerTask = 32u;
+
+// The maximum number of pages an atlas may grow to before the least recently
+// used page is recycled for new glyphs.
+static constexpr size_t kMaxAtlasPages = 4u;
+
+// Signed distance fields extend beyond the outline of the glyph so glyphs in
+// those atlases get a margin on every side for the field to fall off in.
+static int64_t GetGlyphMargin(GlyphAtlas::Type type) {
+  if (type != GlyphAtlas::Type::kSignedDistanceField) {
+    return 0;
+  }
+  return static_cast<int64_t>(
+      std::ceil(GlyphAtlas::kSignedDistanceFieldSpread));
+}
+
 TextRenderContextSkia::TextRenderContextSkia(std::shared_ptr<Context> context)
     : TextRenderContext(std::move(context)) {}
 
@@ -47,7 +76,7 @@ static FontGlyphPair::Set CollectUniqueFontGlyphPairs(
   FontGlyphPair::Set set;
   while (const TextFrame* frame = frame_iterator()) {
     for (const TextRun& run : frame->GetRuns()) {
-      const Font& font = run.GetFont();
+      const Font font = GlyphAtlas::GetAtlasFont(type, run.GetFont());
       for (const TextRun::GlyphPosition& glyph_position :
            run.GetGlyphPositions()) {
         set.insert({font, glyph_position.glyph});
@@ -60,6 +89,7 @@ static FontGlyphPair::Set CollectUniqueFontGlyphPairs(
 static size_t PairsFitInAtlasOfSize(
     const FontGlyphPair::Set& pairs,
     const ISize& atlas_size,
+    int64_t glyph_margin,
     std::vector<Rect>& glyph_positions,
     const std::shared_ptr<RectanglePacker>& rect_packer) {
   if (atlas_size.IsEmpty()) {
@@ -76,55 +106,169 @@ static size_t PairsFitInAtlasOfSize(
     const auto glyph_size =
         ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
     IPoint16 location_in_atlas;
-    if (!rect_packer->addRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
+    if (!rect_packer->addRect(
+            glyph_size.width + 2 * glyph_margin + kPadding,   //
+            glyph_size.height + 2 * glyph_margin + kPadding,  //
+            &location_in_atlas                                //
+            )) {
       return pairs.size() - i;
     }
-    glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
-                                                location_in_atlas.y(),  //
-                                                glyph_size.width,       //
-                                                glyph_size.height       //
-                                                ));
+    glyph_positions.emplace_back(
+        Rect::MakeXYWH(location_in_atlas.x() + glyph_margin,  //
+                       location_in_atlas.y() + glyph_margin,  //
+                       glyph_size.width,                      //
+                       glyph_size.height                      //
+                       ));
   }
 
   return 0;
 }
 
-static bool CanAppendToExistingAtlas(
+static std::shared_ptr<SkBitmap> AllocateAtlasBitmap(GlyphAtlas::Type type,
+                                                     const ISize& atlas_size) {
+  auto bitmap = std::make_shared<SkBitmap>();
+  SkImageInfo image_info;
+
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
+      image_info = SkImageInfo::MakeA8(atlas_size.width, atlas_size.height);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      image_info =
+          SkImageInfo::MakeN32Premul(atlas_size.width, atlas_size.height);
+      break;
+  }
+
+  if (!bitmap->tryAllocPixels(image_info)) {
+    return nullptr;
+  }
+  return bitmap;
+}
+
+static bool AppendToExistingAtlas(
     const std::shared_ptr<GlyphAtlas>& atlas,
     const FontGlyphPairRefVector& extra_pairs,
-    std::vector<Rect>& glyph_positions,
-    ISize atlas_size,
-    const std::shared_ptr<RectanglePacker>& rect_packer) {
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+    std::set<size_t>& dirty_pages) {
   TRACE_EVENT0("impeller", __FUNCTION__);
-  if (!rect_packer || atlas_size.IsEmpty()) {
+  const auto& atlas_size = atlas_context->GetAtlasSize();
+  if (!atlas_context->GetRectPacker() || atlas_size.IsEmpty()) {
     return false;
   }
 
-  // We assume that all existing glyphs will fit. After all, they fit before.
-  // The glyph_positions only contains the values for the additional glyphs
-  // from extra_pairs.
-  FML_DCHECK(glyph_positions.size() == 0);
-  glyph_positions.reserve(extra_pairs.size());
-  for (size_t i = 0; i < extra_pairs.size(); i++) {
-    const FontGlyphPair& pair = extra_pairs[i];
+  // Pages added after the first one are never smaller than the minimum alpha
+  // atlas size so that small color atlases don't fragment into tiny pages.
+  const auto page_size =
+      ISize(std::max<int64_t>(atlas_size.width, kMinAlphaBitmapSize),
+            std::max<int64_t>(atlas_size.height, kMinAlphaBitmapSize));
+  const auto glyph_margin = GetGlyphMargin(atlas->GetType());
+
+  // The glyphs are placed in staged pages and positions first, and only
+  // committed to the atlas and its context once all of them found a spot. If
+  // they don't, the atlas is left untouched and recreated by the caller. The
+  // space taken in the packers of existing pages is dropped along with them.
+  struct StagedPage {
+    std::shared_ptr<SkBitmap> bitmap;
+    std::shared_ptr<RectanglePacker> rect_packer;
+    bool recycled = false;
+  };
+  std::map<size_t, StagedPage> staged_pages;
+  std::vector<GlyphAtlas::GlyphLocation> locations;
+  locations.reserve(extra_pairs.size());
+  size_t page_count = atlas_context->GetPageCount();
+
+  auto get_rect_packer = [&](size_t page) {
+    auto staged = staged_pages.find(page);
+    if (staged != staged_pages.end()) {
+      return staged->second.rect_packer;
+    }
+    return atlas_context->GetPageRectPacker(page);
+  };
 
+  for (const FontGlyphPair& pair : extra_pairs) {
     const auto glyph_size =
         ISize::Ceil((pair.glyph.bounds * pair.font.GetMetrics().scale).size);
     IPoint16 location_in_atlas;
-    if (!rect_packer->addRect(glyph_size.width + kPadding,   //
-                              glyph_size.height + kPadding,  //
-                              &location_in_atlas             //
-                              )) {
-      return false;
+    auto try_add_rect = [&](size_t page) -> bool {
+      return get_rect_packer(page)->addRect(
+          glyph_size.width + 2 * glyph_margin + kPadding,   //
+          glyph_size.height + 2 * glyph_margin + kPadding,  //
+          &location_in_atlas                                //
+      );
+    };
+
+    std::optional<size_t> page;
+    for (size_t i = 0; i < page_count; i++) {
+      if (try_add_rect(i)) {
+        page = i;
+        break;
+      }
+    }
+
+    if (!page.has_value()) {
+      StagedPage staged;
+      if (page_count < kMaxAtlasPages) {
+        // Grow the atlas by another page.
+        staged.bitmap = AllocateAtlasBitmap(atlas->GetType(), page_size);
+        if (!staged.bitmap) {
+          return false;
+        }
+        staged.rect_packer = std::shared_ptr<RectanglePacker>(
+            RectanglePacker::Factory(page_size.width, page_size.height));
+        page = page_count++;
+      } else {
+        // Recycle the least recently used page not needed by this frame.
+        page = atlas_context->FindEvictablePage();
+        if (!page.has_value()) {
+          return false;
+        }
+        const auto& bitmap = atlas_context->GetPageBitmap(page.value());
+        staged.rect_packer = std::shared_ptr<RectanglePacker>(
+            RectanglePacker::Factory(bitmap->width(), bitmap->height()));
+        staged.recycled = true;
+      }
+      staged_pages[page.value()] = std::move(staged);
+      // Pages are marked as used right away so that a page is recycled at
+      // most once per frame.
+      atlas_context->MarkPageUsed(page.value());
+      if (!try_add_rect(page.value())) {
+        // The glyph does not fit even in an empty page.
+        return false;
+      }
     }
-    glyph_positions.emplace_back(Rect::MakeXYWH(location_in_atlas.x(),  //
-                                                location_in_atlas.y(),  //
-                                                glyph_size.width,       //
-                                                glyph_size.height       //
-                                                ));
+
+    locations.push_back(GlyphAtlas::GlyphLocation{
+        .page = page.value(),
+        .bounds = Rect::MakeXYWH(location_in_atlas.x() + glyph_margin,  //
+                                 location_in_atlas.y() + glyph_margin,  //
+                                 glyph_size.width,                      //
+                                 glyph_size.height                      //
+                                 ),
+    });
+  }
+
+  // Every glyph has a spot. Commit the staged pages, in order so that added
+  // pages get the indices they were staged with.
+  for (auto& [page, staged] : staged_pages) {
+    if (staged.recycled) {
+      atlas->RemovePageGlyphs(page);
+      atlas_context->GetPageBitmap(page)->eraseColor(SK_ColorTRANSPARENT);
+      atlas_context->SetPageRectPacker(page, std::move(staged.rect_packer));
+      atlas_context->RecordEviction();
+    } else {
+      FML_DCHECK(page == atlas_context->GetPageCount());
+      atlas_context->AddPage(std::move(staged.bitmap),
+                             std::move(staged.rect_packer));
+      atlas->SetPageTexture(page, nullptr);
+    }
+  }
+  for (size_t i = 0; i < extra_pairs.size(); i++) {
+    const auto& location = locations[i];
+    atlas->AddTypefaceGlyphPosition(extra_pairs[i], location.bounds,
+                                    location.page);
+    atlas_context->MarkPageUsed(location.page);
+    dirty_pages.insert(location.page);
   }
 
   return true;
@@ -136,22 +280,19 @@ ISize OptimumAtlasSizeForFontGlyphPairs(
     std::vector<Rect>& glyph_positions,
     const std::shared_ptr<GlyphAtlasContext>& atlas_context,
     GlyphAtlas::Type type) {
-  static constexpr auto kMinAtlasSize = 8u;
-  static constexpr auto kMinAlphaBitmapSize = 1024u;
-  static constexpr auto kMaxAtlasSize = 4096u;
-
   TRACE_EVENT0("impeller", __FUNCTION__);
 
-  ISize current_size = type == GlyphAtlas::Type::kAlphaBitmap
-                           ? ISize(kMinAlphaBitmapSize, kMinAlphaBitmapSize)
-                           : ISize(kMinAtlasSize, kMinAtlasSize);
+  ISize current_size = type == GlyphAtlas::Type::kColorBitmap
+                           ? ISize(kMinAtlasSize, kMinAtlasSize)
+                           : ISize(kMinAlphaBitmapSize, kMinAlphaBitmapSize);
   size_t total_pairs = pairs.size() + 1;
   do {
     auto rect_packer = std::shared_ptr<RectanglePacker>(
         RectanglePacker::Factory(current_size.width, current_size.height));
 
-    auto remaining_pairs = PairsFitInAtlasOfSize(pairs, current_size,
-                                                 glyph_positions, rect_packer);
+    auto remaining_pairs =
+        PairsFitInAtlasOfSize(pairs, current_size, GetGlyphMargin(type),
+                              glyph_positions, rect_packer);
     if (remaining_pairs == 0) {
       atlas_context->UpdateRectPacker(rect_packer);
       return current_size;
@@ -174,6 +315,7 @@ ISize OptimumAtlasSizeForFontGlyphPairs(
 static void DrawGlyph(SkCanvas* canvas,
                       const FontGlyphPair& font_glyph,
                       const Rect& location,
+                      int64_t margin,
                       bool has_color) {
   const auto& metrics = font_glyph.font.GetMetrics();
   const auto position = SkPoint::Make(location.origin.x / metrics.scale,
@@ -191,7 +333,16 @@ static void DrawGlyph(SkCanvas* canvas,
 
   SkPaint glyph_paint;
   glyph_paint.setColor(glyph_color);
+  canvas->save();
   canvas->resetMatrix();
+  // Never touch pixels outside of the slot assigned by the rect packer. This
+  // keeps glyphs drawn concurrently into the same bitmap from racing.
+  canvas->clipRect(
+      SkRect::MakeXYWH(location.origin.x - margin,                   //
+                       location.origin.y - margin,                   //
+                       location.size.width + 2 * margin + kPadding,  //
+                       location.size.height + 2 * margin + kPadding  //
+                       ));
   canvas->scale(metrics.scale, metrics.scale);
   canvas->drawGlyphs(
       1u,         // count
@@ -202,72 +353,141 @@ static void DrawGlyph(SkCanvas* canvas,
       sk_font,                                           // font
       glyph_paint                                        // paint
   );
+  canvas->restore();
 }
 
-static bool UpdateAtlasBitmap(const GlyphAtlas& atlas,
-                              const std::shared_ptr<SkBitmap>& bitmap,
-                              const FontGlyphPairRefVector& new_pairs) {
-  TRACE_EVENT0("impeller", __FUNCTION__);
-  FML_DCHECK(bitmap != nullptr);
+struct GlyphDraw {
+  const FontGlyphPair* pair;
+  Rect location;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Draw the glyphs into the pixels. The rect packer has already
+///             assigned each glyph its own region so when there are enough
+///             glyphs the work is split across the worker threads of the
+///             context. The calling thread draws its share and then waits for
+///             the workers to finish.
+///
+static bool DrawGlyphs(
+    const SkPixmap& pixmap,
+    const std::vector<GlyphDraw>& draws,
+    GlyphAtlas::Type type,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  const bool has_color = type == GlyphAtlas::Type::kColorBitmap;
+  const bool is_sdf = type == GlyphAtlas::Type::kSignedDistanceField;
+  const int64_t margin = GetGlyphMargin(type);
+  auto draw_range = [&pixmap, &draws, has_color, is_sdf, margin](
+                        size_t begin, size_t end) -> bool {
+    auto surface = SkSurfaces::WrapPixels(pixmap);
+    if (!surface) {
+      return false;
+    }
+    auto canvas = surface->getCanvas();
+    if (!canvas) {
+      return false;
+    }
+    for (size_t i = begin; i < end; i++) {
+      const auto& location = draws[i].location;
+      DrawGlyph(canvas, *draws[i].pair, location, margin, has_color);
+      if (is_sdf) {
+        // The coverage of the glyph is converted in place. Only the slot of
+        // this glyph is touched so this is safe to do concurrently too.
+        const auto region = IRect::MakeXYWH(
+            location.origin.x - margin, location.origin.y - margin,
+            std::ceil(location.size.width) + 2 * margin,
+            std::ceil(location.size.height) + 2 * margin);
+        ConvertCoverageToSignedDistanceField(
+            static_cast<uint8_t*>(
+                pixmap.writable_addr(region.origin.x, region.origin.y)),
+            region.size.width, region.size.height, pixmap.rowBytes(),
+            GlyphAtlas::kSignedDistanceFieldSpread);
+      }
+    }
+    return true;
+  };
 
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
-  if (!surface) {
-    return false;
+  const size_t task_count =
+      std::min<size_t>(draws.size() / kMinGlyphsPerTask,
+                       std::max(1u, std::thread::hardware_concurrency()));
+  if (!worker_task_runner || task_count <= 1u) {
+    return draw_range(0u, draws.size());
   }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
-    return false;
+
+  TRACE_EVENT0("impeller", "DrawGlyphsConcurrently");
+  const size_t glyphs_per_task = (draws.size() + task_count - 1) / task_count;
+  std::atomic_bool success = true;
+  fml::CountDownLatch latch(task_count - 1);
+  for (size_t task = 1; task < task_count; task++) {
+    worker_task_runner->PostTask([&, task]() {
+      const size_t begin = std::min(task * glyphs_per_task, draws.size());
+      const size_t end = std::min(begin + glyphs_per_task, draws.size());
+      if (!draw_range(begin, end)) {
+        success = false;
+      }
+      latch.CountDown();
+    });
+  }
+  if (!draw_range(0u, std::min(glyphs_per_task, draws.size()))) {
+    success = false;
   }
+  latch.Wait();
+  return success;
+}
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
+static bool UpdateAtlasBitmaps(
+    const GlyphAtlas& atlas,
+    const std::shared_ptr<GlyphAtlasContext>& atlas_context,
+    const FontGlyphPairRefVector& new_pairs,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
+  TRACE_EVENT0("impeller", __FUNCTION__);
 
+  std::vector<std::vector<GlyphDraw>> page_draws(
+      atlas_context->GetPageCount());
   for (const FontGlyphPair& pair : new_pairs) {
-    auto pos = atlas.FindFontGlyphBounds(pair);
-    if (!pos.has_value()) {
+    auto location = atlas.FindFontGlyphLocation(pair);
+    if (!location.has_value()) {
       continue;
     }
-    DrawGlyph(canvas, pair, pos.value(), has_color);
+    page_draws[location->page].push_back({&pair, location->bounds});
+  }
+
+  for (size_t page = 0; page < page_draws.size(); page++) {
+    if (page_draws[page].empty()) {
+      continue;
+    }
+    auto bitmap = atlas_context->GetPageBitmap(page);
+    FML_DCHECK(bitmap != nullptr);
+    if (!DrawGlyphs(bitmap->pixmap(), page_draws[page], atlas.GetType(),
+                    worker_task_runner)) {
+      return false;
+    }
   }
   return true;
 }
 
-static std::shared_ptr<SkBitmap> CreateAtlasBitmap(const GlyphAtlas& atlas,
-                                                   const ISize& atlas_size) {
+static std::shared_ptr<SkBitmap> CreateAtlasBitmap(
+    const GlyphAtlas& atlas,
+    const ISize& atlas_size,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& worker_task_runner) {
   TRACE_EVENT0("impeller", __FUNCTION__);
-  auto bitmap = std::make_shared<SkBitmap>();
-  SkImageInfo image_info;
-
-  switch (atlas.GetType()) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      image_info = SkImageInfo::MakeA8(atlas_size.width, atlas_size.height);
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      image_info =
-          SkImageInfo::MakeN32Premul(atlas_size.width, atlas_size.height);
-      break;
-  }
-
-  if (!bitmap->tryAllocPixels(image_info)) {
+  auto bitmap = AllocateAtlasBitmap(atlas.GetType(), atlas_size);
+  if (!bitmap) {
     return nullptr;
   }
 
-  auto surface = SkSurfaces::WrapPixels(bitmap->pixmap());
-  if (!surface) {
-    return nullptr;
-  }
-  auto canvas = surface->getCanvas();
-  if (!canvas) {
+  std::vector<GlyphDraw> draws;
+  draws.reserve(atlas.GetGlyphCount());
+  atlas.IterateGlyphs(
+      [&draws](const FontGlyphPair& font_glyph, const Rect& location) -> bool {
+        draws.push_back({&font_glyph, location});
+        return true;
+      });
+
+  if (!DrawGlyphs(bitmap->pixmap(), draws, atlas.GetType(),
+                  worker_task_runner)) {
     return nullptr;
   }
 
-  bool has_color = atlas.GetType() == GlyphAtlas::Type::kColorBitmap;
-
-  atlas.IterateGlyphs([canvas, has_color](const FontGlyphPair& font_glyph,
-                                          const Rect& location) -> bool {
-    DrawGlyph(canvas, font_glyph, location, has_color);
-    return true;
-  });
-
   return bitmap;
 }
 
@@ -287,6 +507,17 @@ static bool UpdateGlyphTextureAtlas(std::shared_ptr<SkBitmap> bitmap,
   return texture->SetContents(mapping);
 }
 
+static PixelFormat GetAtlasPixelFormat(GlyphAtlas::Type type) {
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+    case GlyphAtlas::Type::kSignedDistanceField:
+      return PixelFormat::kA8UNormInt;
+    case GlyphAtlas::Type::kColorBitmap:
+      return PixelFormat::kR8G8B8A8UNormInt;
+  }
+  FML_UNREACHABLE();
+}
+
 static std::shared_ptr<Texture> UploadGlyphTextureAtlas(
     const std::shared_ptr<Allocator>& allocator,
     std::shared_ptr<SkBitmap> bitmap,
@@ -350,12 +581,17 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 2: Determine if the atlas type and font glyph pairs are compatible
-  //         with the current atlas and reuse if possible.
+  //         with the current atlas and reuse if possible. Pages holding glyphs
+  //         used by this frame are marked as recently used.
   // ---------------------------------------------------------------------------
+  atlas_context->AdvanceGeneration();
   FontGlyphPairRefVector new_glyphs;
   for (const FontGlyphPair& pair : font_glyph_pairs) {
-    if (!last_atlas->FindFontGlyphBounds(pair).has_value()) {
+    auto location = last_atlas->FindFontGlyphLocation(pair);
+    if (!location.has_value()) {
       new_glyphs.push_back(pair);
+    } else if (last_atlas->GetType() == type) {
+      atlas_context->MarkPageUsed(location->page);
     }
   }
   if (last_atlas->GetType() == type && new_glyphs.size() == 0) {
@@ -364,38 +600,46 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
 
   // ---------------------------------------------------------------------------
   // Step 3: Determine if the additional missing glyphs can be appended to the
-  //         existing bitmap without recreating the atlas. This requires that
-  //         the type is identical.
+  //         existing pages, a new page or the least recently used page without
+  //         recreating the atlas. This requires that the type is identical.
+  //         The positions of the newly added glyphs are recorded as they are
+  //         placed.
   // ---------------------------------------------------------------------------
-  std::vector<Rect> glyph_positions;
+  std::set<size_t> dirty_pages;
   if (last_atlas->GetType() == type &&
-      CanAppendToExistingAtlas(last_atlas, new_glyphs, glyph_positions,
-                               atlas_context->GetAtlasSize(),
-                               atlas_context->GetRectPacker())) {
-    // The old bitmap will be reused and only the additional glyphs will be
+      AppendToExistingAtlas(last_atlas, new_glyphs, atlas_context,
+                            dirty_pages)) {
+    // The old bitmaps will be reused and only the additional glyphs will be
     // added.
 
     // ---------------------------------------------------------------------------
-    // Step 4: Record the positions in the glyph atlas of the newly added
-    // glyphs.
+    // Step 4: Draw new font-glyph pairs into the bitmaps of their pages.
     // ---------------------------------------------------------------------------
-    for (size_t i = 0, count = glyph_positions.size(); i < count; i++) {
-      last_atlas->AddTypefaceGlyphPosition(new_glyphs[i], glyph_positions[i]);
-    }
-
-    // ---------------------------------------------------------------------------
-    // Step 5: Draw new font-glyph pairs into the existing bitmap.
-    // ---------------------------------------------------------------------------
-    auto bitmap = atlas_context->GetBitmap();
-    if (!UpdateAtlasBitmap(*last_atlas, bitmap, new_glyphs)) {
+    if (!UpdateAtlasBitmaps(*last_atlas, atlas_context, new_glyphs,
+                            GetContext()->GetConcurrentWorkerTaskRunner())) {
       return nullptr;
     }
 
     // ---------------------------------------------------------------------------
-    // Step 6: Update the existing texture with the updated bitmap.
+    // Step 5: Upload only the pages that changed. Pages that were just added
+    //         get a new texture.
     // ---------------------------------------------------------------------------
-    if (!UpdateGlyphTextureAtlas(bitmap, last_atlas->GetTexture())) {
-      return nullptr;
+    for (size_t page : dirty_pages) {
+      auto bitmap = atlas_context->GetPageBitmap(page);
+      const auto& texture = last_atlas->GetPageTexture(page);
+      if (texture) {
+        if (!UpdateGlyphTextureAtlas(bitmap, texture)) {
+          return nullptr;
+        }
+        continue;
+      }
+      auto page_texture = UploadGlyphTextureAtlas(
+          GetContext()->GetResourceAllocator(), bitmap,
+          ISize(bitmap->width(), bitmap->height()), GetAtlasPixelFormat(type));
+      if (!page_texture) {
+        return nullptr;
+      }
+      last_atlas->SetPageTexture(page, std::move(page_texture));
     }
     return last_atlas;
   }
@@ -404,6 +648,7 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 4: Get the optimum size of the texture atlas.
   // ---------------------------------------------------------------------------
+  std::vector<Rect> glyph_positions;
   auto glyph_atlas = std::make_shared<GlyphAtlas>(type);
   auto atlas_size = OptimumAtlasSizeForFontGlyphPairs(
       font_glyph_pairs, glyph_positions, atlas_context, type);
@@ -434,9 +679,11 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   }
 
   // ---------------------------------------------------------------------------
-  // Step 7: Draw font-glyph pairs in the correct spot in the atlas.
+  // Step 7: Draw font-glyph pairs in the correct spot in the atlas. Large
+  //         batches are split across the context's worker threads.
   // ---------------------------------------------------------------------------
-  auto bitmap = CreateAtlasBitmap(*glyph_atlas, atlas_size);
+  auto bitmap = CreateAtlasBitmap(
+      *glyph_atlas, atlas_size, GetContext()->GetConcurrentWorkerTaskRunner());
   if (!bitmap) {
     return nullptr;
   }
@@ -445,17 +692,9 @@ std::shared_ptr<GlyphAtlas> TextRenderContextSkia::CreateGlyphAtlas(
   // ---------------------------------------------------------------------------
   // Step 8: Upload the atlas as a texture.
   // ---------------------------------------------------------------------------
-  PixelFormat format;
-  switch (type) {
-    case GlyphAtlas::Type::kAlphaBitmap:
-      format = PixelFormat::kA8UNormInt;
-      break;
-    case GlyphAtlas::Type::kColorBitmap:
-      format = PixelFormat::kR8G8B8A8UNormInt;
-      break;
-  }
-  auto texture = UploadGlyphTextureAtlas(GetContext()->GetResourceAllocator(),
-                                         bitmap, atlas_size, format);
+  auto texture =
+      UploadGlyphTextureAtlas(GetContext()->GetResourceAllocator(), bitmap,
+                              atlas_size, GetAtlasPixelFormat(type));
   if (!texture) {
     return nullptr;
   }
@@ -6,11 +6,14 @@
 
 #include <utility>
 
+#include "flutter/fml/logging.h"
+
 namespace impeller {
 
 GlyphAtlasContext::GlyphAtlasContext()
     : atlas_(std::make_shared<GlyphAtlas>(GlyphAtlas::Type::kAlphaBitmap)),
-      atlas_size_(ISize(0, 0)) {}
+      atlas_size_(ISize(0, 0)),
+      pages_(1u) {}
 
 GlyphAtlasContext::~GlyphAtlasContext() {}
 
@@ -23,34 +26,112 @@ const ISize& GlyphAtlasContext::GetAtlasSize() const {
 }
 
 std::shared_ptr<SkBitmap> GlyphAtlasContext::GetBitmap() const {
-  return bitmap_;
+  return pages_.front().bitmap;
 }
 
 std::shared_ptr<RectanglePacker> GlyphAtlasContext::GetRectPacker() const {
-  return rect_packer_;
+  return pages_.front().rect_packer;
 }
 
 void GlyphAtlasContext::UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas,
                                          ISize size) {
   atlas_ = std::move(atlas);
   atlas_size_ = size;
+  pages_.resize(1u);
+  pages_.front().last_used_generation = generation_;
 }
 
 void GlyphAtlasContext::UpdateBitmap(std::shared_ptr<SkBitmap> bitmap) {
-  bitmap_ = std::move(bitmap);
+  pages_.front().bitmap = std::move(bitmap);
 }
 
 void GlyphAtlasContext::UpdateRectPacker(
     std::shared_ptr<RectanglePacker> rect_packer) {
-  rect_packer_ = std::move(rect_packer);
+  pages_.front().rect_packer = std::move(rect_packer);
+}
+
+size_t GlyphAtlasContext::GetPageCount() const {
+  return pages_.size();
+}
+
+std::shared_ptr<SkBitmap> GlyphAtlasContext::GetPageBitmap(size_t page) const {
+  FML_DCHECK(page < pages_.size());
+  return pages_[page].bitmap;
+}
+
+std::shared_ptr<RectanglePacker> GlyphAtlasContext::GetPageRectPacker(
+    size_t page) const {
+  FML_DCHECK(page < pages_.size());
+  return pages_[page].rect_packer;
+}
+
+void GlyphAtlasContext::SetPageRectPacker(
+    size_t page,
+    std::shared_ptr<RectanglePacker> rect_packer) {
+  FML_DCHECK(page < pages_.size());
+  pages_[page].rect_packer = std::move(rect_packer);
+}
+
+size_t GlyphAtlasContext::AddPage(
+    std::shared_ptr<SkBitmap> bitmap,
+    std::shared_ptr<RectanglePacker> rect_packer) {
+  pages_.push_back(Page{
+      .bitmap = std::move(bitmap),
+      .rect_packer = std::move(rect_packer),
+      .last_used_generation = generation_,
+  });
+  return pages_.size() - 1u;
+}
+
+uint64_t GlyphAtlasContext::AdvanceGeneration() {
+  return ++generation_;
+}
+
+void GlyphAtlasContext::MarkPageUsed(size_t page) {
+  FML_DCHECK(page < pages_.size());
+  pages_[page].last_used_generation = generation_;
+}
+
+std::optional<size_t> GlyphAtlasContext::FindEvictablePage() const {
+  std::optional<size_t> result;
+  for (size_t i = 0; i < pages_.size(); i++) {
+    const auto& page = pages_[i];
+    if (page.last_used_generation >= generation_ || !page.rect_packer) {
+      continue;
+    }
+    if (!result.has_value() ||
+        page.last_used_generation <
+            pages_[result.value()].last_used_generation) {
+      result = i;
+    }
+  }
+  return result;
 }
 
-GlyphAtlas::GlyphAtlas(Type type) : type_(type) {}
+size_t GlyphAtlasContext::GetEvictionCount() const {
+  return eviction_count_;
+}
+
+void GlyphAtlasContext::RecordEviction() {
+  eviction_count_++;
+}
+
+GlyphAtlas::GlyphAtlas(Type type) : type_(type), textures_(1u) {}
+
+Font GlyphAtlas::GetAtlasFont(Type type, const Font& font) {
+  if (type != Type::kSignedDistanceField ||
+      font.GetMetrics().point_size <= 0.0f) {
+    return font;
+  }
+  auto metrics = font.GetMetrics();
+  metrics.scale = kSignedDistanceFieldPixelSize / metrics.point_size;
+  return Font(font.GetTypeface(), metrics);
+}
 
 GlyphAtlas::~GlyphAtlas() = default;
 
 bool GlyphAtlas::IsValid() const {
-  return !!texture_;
+  return !!textures_.front();
 }
 
 GlyphAtlas::Type GlyphAtlas::GetType() const {
@@ -58,16 +139,48 @@ GlyphAtlas::Type GlyphAtlas::GetType() const {
 }
 
 const std::shared_ptr<Texture>& GlyphAtlas::GetTexture() const {
-  return texture_;
+  return textures_.front();
 }
 
 void GlyphAtlas::SetTexture(std::shared_ptr<Texture> texture) {
-  texture_ = std::move(texture);
+  textures_.front() = std::move(texture);
+}
+
+void GlyphAtlas::SetPageTexture(size_t page, std::shared_ptr<Texture> texture) {
+  FML_DCHECK(page <= textures_.size());
+  if (page == textures_.size()) {
+    textures_.emplace_back(std::move(texture));
+    return;
+  }
+  textures_[page] = std::move(texture);
+}
+
+const std::shared_ptr<Texture>& GlyphAtlas::GetPageTexture(size_t page) const {
+  FML_DCHECK(page < textures_.size());
+  return textures_[page];
+}
+
+size_t GlyphAtlas::GetPageCount() const {
+  return textures_.size();
 }
 
 void GlyphAtlas::AddTypefaceGlyphPosition(const FontGlyphPair& pair,
-                                          Rect rect) {
-  positions_[pair] = rect;
+                                          Rect rect,
+                                          size_t page) {
+  positions_[pair] = GlyphLocation{.page = page, .bounds = rect};
+}
+
+size_t GlyphAtlas::RemovePageGlyphs(size_t page) {
+  size_t removed = 0u;
+  for (auto it = positions_.begin(); it != positions_.end();) {
+    if (it->second.page == page) {
+      it = positions_.erase(it);
+      removed++;
+    } else {
+      ++it;
+    }
+  }
+  return removed;
 }
 
 std::optional<Rect> GlyphAtlas::FindFontGlyphBounds(
@@ -76,6 +189,15 @@ std::optional<Rect> GlyphAtlas::FindFontGlyphBounds(
   if (found == positions_.end()) {
     return std::nullopt;
   }
+  return found->second.bounds;
+}
+
+std::optional<GlyphAtlas::GlyphLocation> GlyphAtlas::FindFontGlyphLocation(
+    const FontGlyphPair& pair) const {
+  const auto& found = positions_.find(pair);
+  if (found == positions_.end()) {
+    return std::nullopt;
+  }
   return found->second;
 }
 
@@ -93,7 +215,7 @@ size_t GlyphAtlas::IterateGlyphs(
   size_t count = 0u;
   for (const auto& position : positions_) {
     count++;
-    if (!iterator(position.first, position.second)) {
+    if (!iterator(position.first, position.second.bounds)) {
       return count;
     }
   }
@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "impeller/core/texture.h"
@@ -41,6 +42,51 @@ class GlyphAtlas {
     /// colors.
     ///
     kColorBitmap,
+
+    //--------------------------------------------------------------------------
+    /// The glyphs are represented as 8-bit signed distance fields rasterized
+    /// at `kSignedDistanceFieldPixelSize` regardless of their requested
+    /// size. A single entry can be drawn over a wide range of scales.
+    ///
+    kSignedDistanceField,
+  };
+
+  //----------------------------------------------------------------------------
+  /// The size in pixels of the em square glyphs are rasterized at in signed
+  /// distance field atlases.
+  ///
+  static constexpr Scalar kSignedDistanceFieldPixelSize = 64.0f;
+
+  //----------------------------------------------------------------------------
+  /// The distance in atlas pixels from the glyph edge at which the values of
+  /// a signed distance field saturate. Each glyph in a signed distance field
+  /// atlas is surrounded by a margin of this many pixels.
+  ///
+  static constexpr Scalar kSignedDistanceFieldSpread = 8.0f;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the font that glyphs of the given font are keyed by in an
+  ///             atlas of the given type.
+  ///
+  ///             Bitmap atlases rasterize glyphs at the scale they are drawn
+  ///             at so the font is returned unmodified. Signed distance field
+  ///             atlases rasterize all glyphs at the same pixel size so the
+  ///             scale of the font is replaced.
+  ///
+  /// @param[in]  type  The atlas type
+  /// @param[in]  font  The font the glyph is drawn with
+  ///
+  /// @return     The font used to key and rasterize the glyph in the atlas.
+  ///
+  static Font GetAtlasFont(Type type, const Font& font);
+
+  //----------------------------------------------------------------------------
+  /// @brief      The location of a font-glyph pair in one of the pages of the
+  ///             atlas.
+  ///
+  struct GlyphLocation {
+    size_t page = 0u;
+    Rect bounds;
   };
 
   //----------------------------------------------------------------------------
@@ -60,27 +106,64 @@ class GlyphAtlas {
   Type GetType() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Set the texture for the glyph atlas.
+  /// @brief      Set the texture for the first page of the glyph atlas.
   ///
   /// @param[in]  texture  The texture
   ///
   void SetTexture(std::shared_ptr<Texture> texture);
 
   //----------------------------------------------------------------------------
-  /// @brief      Get the texture for the glyph atlas.
+  /// @brief      Get the texture for the first page of the glyph atlas.
   ///
   /// @return     The texture.
   ///
   const std::shared_ptr<Texture>& GetTexture() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Set the texture for a page of the glyph atlas. Setting the
+  ///             texture of the page just past the last one adds a page.
+  ///
+  /// @param[in]  page     The page index
+  /// @param[in]  texture  The texture
+  ///
+  void SetPageTexture(size_t page, std::shared_ptr<Texture> texture);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the texture for a page of the glyph atlas.
+  ///
+  /// @param[in]  page  The page index. Must be less than the page count.
+  ///
+  /// @return     The texture.
+  ///
+  const std::shared_ptr<Texture>& GetPageTexture(size_t page) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Get the number of pages (textures) in this atlas. An atlas
+  ///             always has at least one page.
+  ///
+  size_t GetPageCount() const;
+
   //----------------------------------------------------------------------------
   /// @brief      Record the location of a specific font-glyph pair within the
   ///             atlas.
   ///
   /// @param[in]  pair  The font-glyph pair
   /// @param[in]  rect  The rectangle
+  /// @param[in]  page  The page the rectangle is located on.
   ///
-  void AddTypefaceGlyphPosition(const FontGlyphPair& pair, Rect rect);
+  void AddTypefaceGlyphPosition(const FontGlyphPair& pair,
+                                Rect rect,
+                                size_t page = 0u);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Forget the locations of all font-glyph pairs on the given
+  ///             page. The page texture is left as is so it may be reused.
+  ///
+  /// @param[in]  page  The page index
+  ///
+  /// @return     The number of font-glyph pairs removed.
+  ///
+  size_t RemovePageGlyphs(size_t page);
 
   //----------------------------------------------------------------------------
   /// @brief      Get the number of unique font-glyph pairs in this atlas.
@@ -112,12 +195,24 @@ class GlyphAtlas {
   ///
   std::optional<Rect> FindFontGlyphBounds(const FontGlyphPair& pair) const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Find the page and location of a specific font-glyph pair in
+  ///             the atlas.
+  ///
+  /// @param[in]  pair  The font-glyph pair
+  ///
+  /// @return     The location of the font-glyph pair in the atlas.
+  ///             `std::nullopt` of the pair in not in the atlas.
+  ///
+  std::optional<GlyphLocation> FindFontGlyphLocation(
+      const FontGlyphPair& pair) const;
+
  private:
   const Type type_;
-  std::shared_ptr<Texture> texture_;
+  std::vector<std::shared_ptr<Texture>> textures_;
 
   std::unordered_map<FontGlyphPair,
-                     Rect,
+                     GlyphLocation,
                      FontGlyphPair::Hash,
                      FontGlyphPair::Equal>
       positions_;
@@ -128,6 +223,11 @@ class GlyphAtlas {
 //------------------------------------------------------------------------------
 /// @brief      A container for caching a glyph atlas across frames.
 ///
+///             The cached atlas may be made up of several pages. Each page
+///             tracks the last generation in which any of its glyphs were used
+///             so that the least recently used page can be recycled when new
+///             glyphs no longer fit.
+///
 class GlyphAtlasContext {
  public:
   GlyphAtlasContext();
@@ -139,30 +239,95 @@ class GlyphAtlasContext {
   std::shared_ptr<GlyphAtlas> GetGlyphAtlas() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the size of the current glyph atlas.
+  /// @brief      Retrieve the size the current glyph atlas was created with,
+  ///             which is the size of its first page. Pages added as the
+  ///             atlas grows are this size, but never smaller than the
+  ///             minimum alpha atlas size in either dimension.
   const ISize& GetAtlasSize() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the previous (if any) SkBitmap instance.
+  /// @brief      Retrieve the previous (if any) SkBitmap instance of the first
+  ///             page.
   std::shared_ptr<SkBitmap> GetBitmap() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Retrieve the previous (if any) rect packer.
+  /// @brief      Retrieve the previous (if any) rect packer of the first page.
   std::shared_ptr<RectanglePacker> GetRectPacker() const;
 
   //----------------------------------------------------------------------------
-  /// @brief      Update the context with a newly constructed glyph atlas.
+  /// @brief      Update the context with a newly constructed glyph atlas. All
+  ///             pages but the first are discarded.
   void UpdateGlyphAtlas(std::shared_ptr<GlyphAtlas> atlas, ISize size);
 
   void UpdateBitmap(std::shared_ptr<SkBitmap> bitmap);
 
   void UpdateRectPacker(std::shared_ptr<RectanglePacker> rect_packer);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the number of pages tracked by this context.
+  size_t GetPageCount() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the SkBitmap instance of the given page.
+  std::shared_ptr<SkBitmap> GetPageBitmap(size_t page) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Retrieve the rect packer of the given page.
+  std::shared_ptr<RectanglePacker> GetPageRectPacker(size_t page) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Replace the rect packer of the given page, for example when
+  ///             the page is recycled.
+  void SetPageRectPacker(size_t page,
+                         std::shared_ptr<RectanglePacker> rect_packer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Add a new page with its own bitmap and rect packer.
+  ///
+  /// @return     The index of the new page.
+  ///
+  size_t AddPage(std::shared_ptr<SkBitmap> bitmap,
+                 std::shared_ptr<RectanglePacker> rect_packer);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Start tracking usage for a new atlas generation (typically
+  ///             one per frame).
+  ///
+  /// @return     The new generation.
+  ///
+  uint64_t AdvanceGeneration();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Mark the given page as used in the current generation.
+  void MarkPageUsed(size_t page);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Find the least recently used page that has not been used in
+  ///             the current generation.
+  ///
+  /// @return     The page index or `std::nullopt` if every page is in use.
+  ///
+  std::optional<size_t> FindEvictablePage() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of pages recycled because they were least
+  ///             recently used.
+  size_t GetEvictionCount() const;
+
+  void RecordEviction();
+
  private:
+  struct Page {
+    std::shared_ptr<SkBitmap> bitmap;
+    std::shared_ptr<RectanglePacker> rect_packer;
+    uint64_t last_used_generation = 0u;
+  };
+
   std::shared_ptr<GlyphAtlas> atlas_;
   ISize atlas_size_;
-  std::shared_ptr<SkBitmap> bitmap_;
-  std::shared_ptr<RectanglePacker> rect_packer_;
+  std::vector<Page> pages_;
+  uint64_t generation_ = 0u;
+  size_t eviction_count_ = 0u;
 
   FML_DISALLOW_COPY_AND_ASSIGN(GlyphAtlasContext);
 };
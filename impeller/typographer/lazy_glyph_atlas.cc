@@ -18,10 +18,16 @@ LazyGlyphAtlas::~LazyGlyphAtlas() = default;
 
 void LazyGlyphAtlas::AddTextFrame(const TextFrame& frame) {
   FML_DCHECK(atlas_map_.empty());
-  if (frame.GetAtlasType() == GlyphAtlas::Type::kAlphaBitmap) {
-    alpha_frames_.emplace_back(frame);
-  } else {
-    color_frames_.emplace_back(frame);
+  switch (frame.GetAtlasType()) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      alpha_frames_.emplace_back(frame);
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      color_frames_.emplace_back(frame);
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      sdf_frames_.emplace_back(frame);
+      break;
   }
 }
 
@@ -41,13 +47,23 @@ std::shared_ptr<GlyphAtlas> LazyGlyphAtlas::CreateOrGetGlyphAtlas(
     return nullptr;
   }
   size_t i = 0;
-  auto frames =
-      type == GlyphAtlas::Type::kAlphaBitmap ? alpha_frames_ : color_frames_;
+  const std::vector<TextFrame>* frames = nullptr;
+  switch (type) {
+    case GlyphAtlas::Type::kAlphaBitmap:
+      frames = &alpha_frames_;
+      break;
+    case GlyphAtlas::Type::kColorBitmap:
+      frames = &color_frames_;
+      break;
+    case GlyphAtlas::Type::kSignedDistanceField:
+      frames = &sdf_frames_;
+      break;
+  }
   TextRenderContext::FrameIterator iterator = [&]() -> const TextFrame* {
-    if (i >= frames.size()) {
+    if (i >= frames->size()) {
       return nullptr;
     }
-    const auto& result = frames[i];
+    const auto& result = (*frames)[i];
     i++;
     return &result;
   };
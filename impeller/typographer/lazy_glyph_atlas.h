@@ -29,6 +29,7 @@ class LazyGlyphAtlas {
  private:
   std::vector<TextFrame> alpha_frames_;
   std::vector<TextFrame> color_frames_;
+  std::vector<TextFrame> sdf_frames_;
   mutable std::unordered_map<GlyphAtlas::Type, std::shared_ptr<GlyphAtlas>>
       atlas_map_;
 
@@ -0,0 +1,142 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/typographer/signed_distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace impeller {
+
+static constexpr float kInfinity = 1e20f;
+
+namespace {
+
+//------------------------------------------------------------------------------
+/// @brief      Scratch space for the one dimensional distance transforms.
+///
+struct DistanceTransformScratch {
+  explicit DistanceTransformScratch(size_t length)
+      : f(length), d(length), v(length), z(length + 1) {}
+
+  std::vector<float> f;
+  std::vector<float> d;
+  std::vector<size_t> v;
+  std::vector<float> z;
+};
+
+}  // namespace
+
+// Felzenszwalb & Huttenlocher, "Distance Transforms of Sampled Functions".
+// Computes the squared euclidean distance transform of `scratch.f` into
+// `scratch.d`.
+static void DistanceTransform1D(DistanceTransformScratch& scratch,
+                                size_t length) {
+  const auto& f = scratch.f;
+  auto& d = scratch.d;
+  auto& v = scratch.v;
+  auto& z = scratch.z;
+
+  int k = 0;
+  v[0] = 0;
+  z[0] = -kInfinity;
+  z[1] = kInfinity;
+  for (size_t q = 1; q < length; q++) {
+    float s = 0;
+    do {
+      const auto r = v[k];
+      s = ((f[q] + q * q) - (f[r] + r * r)) / (2.0f * q - 2.0f * r);
+    } while (s <= z[k] && --k > -1);
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = kInfinity;
+  }
+
+  k = 0;
+  for (size_t q = 0; q < length; q++) {
+    while (z[k + 1] < q) {
+      k++;
+    }
+    const float delta = static_cast<float>(q) - static_cast<float>(v[k]);
+    d[q] = delta * delta + f[v[k]];
+  }
+}
+
+static void DistanceTransform2D(std::vector<float>& grid,
+                                size_t width,
+                                size_t height,
+                                DistanceTransformScratch& scratch) {
+  for (size_t x = 0; x < width; x++) {
+    for (size_t y = 0; y < height; y++) {
+      scratch.f[y] = grid[y * width + x];
+    }
+    DistanceTransform1D(scratch, height);
+    for (size_t y = 0; y < height; y++) {
+      grid[y * width + x] = scratch.d[y];
+    }
+  }
+  for (size_t y = 0; y < height; y++) {
+    for (size_t x = 0; x < width; x++) {
+      scratch.f[x] = grid[y * width + x];
+    }
+    DistanceTransform1D(scratch, width);
+    for (size_t x = 0; x < width; x++) {
+      grid[y * width + x] = scratch.d[x];
+    }
+  }
+}
+
+void ConvertCoverageToSignedDistanceField(uint8_t* pixels,
+                                          size_t width,
+                                          size_t height,
+                                          size_t row_bytes,
+                                          Scalar spread) {
+  if (pixels == nullptr || width == 0 || height == 0 || spread <= 0) {
+    return;
+  }
+
+  // Squared distances to the nearest pixel outside and inside of the shape.
+  std::vector<float> outer(width * height);
+  std::vector<float> inner(width * height);
+  for (size_t y = 0; y < height; y++) {
+    const uint8_t* row = pixels + y * row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      const float coverage = row[x] / 255.0f;
+      const size_t index = y * width + x;
+      if (coverage >= 1.0f) {
+        outer[index] = kInfinity;
+        inner[index] = 0.0f;
+      } else if (coverage <= 0.0f) {
+        outer[index] = 0.0f;
+        inner[index] = kInfinity;
+      } else {
+        // Approximate the distance to the edge within an edge pixel from its
+        // coverage.
+        const float edge = 0.5f - coverage;
+        outer[index] = edge < 0.0f ? edge * edge : 0.0f;
+        inner[index] = edge > 0.0f ? edge * edge : 0.0f;
+      }
+    }
+  }
+
+  DistanceTransformScratch scratch(std::max(width, height));
+  DistanceTransform2D(outer, width, height, scratch);
+  DistanceTransform2D(inner, width, height, scratch);
+
+  for (size_t y = 0; y < height; y++) {
+    uint8_t* row = pixels + y * row_bytes;
+    for (size_t x = 0; x < width; x++) {
+      const size_t index = y * width + x;
+      // Positive inside of the shape.
+      const float distance = std::sqrt(outer[index]) - std::sqrt(inner[index]);
+      const float value =
+          std::clamp(0.5f + distance / (2.0f * spread), 0.0f, 1.0f);
+      row[x] = static_cast<uint8_t>(std::round(value * 255.0f));
+    }
+  }
+}
+
+}  // namespace impeller
@@ -0,0 +1,35 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      Replace the 8-bit coverage values of a region of pixels with the
+///             signed distance field of the shape they describe.
+///
+///             Partial coverage is treated as a sub-pixel offset of the edge.
+///             The distance is encoded so that 128 lies on the edge of the
+///             shape, larger values are inside and smaller values outside.
+///             Distances larger than `spread` pixels are clamped.
+///
+/// @param      pixels     The first pixel of the region.
+/// @param[in]  width      The width of the region.
+/// @param[in]  height     The height of the region.
+/// @param[in]  row_bytes  The distance in bytes between rows of the region.
+/// @param[in]  spread     The distance in pixels at which values saturate.
+///
+void ConvertCoverageToSignedDistanceField(uint8_t* pixels,
+                                          size_t width,
+                                          size_t height,
+                                          size_t row_bytes,
+                                          Scalar spread);
+
+}  // namespace impeller
@@ -4,8 +4,17 @@
 
 #include "impeller/typographer/text_frame.h"
 
+#include <algorithm>
+
 namespace impeller {
 
+// Text with at least this point size is rendered from a signed distance field
+// atlas. Smaller text keeps using bitmaps rasterized at the exact size as
+// hinting and stem darkening matter more than reuse there. The point size is
+// used rather than the size after scaling so that text animated across the
+// threshold doesn't switch atlases, and rebuild them, between frames.
+static constexpr Scalar kMinSignedDistanceFieldPointSize = 48.0f;
+
 TextFrame::TextFrame() = default;
 
 TextFrame::~TextFrame() = default;
@@ -30,6 +39,8 @@ bool TextFrame::AddTextRun(const TextRun& run) {
     return false;
   }
   has_color_ |= run.HasColor();
+  min_point_size_ =
+      std::min(min_point_size_, run.GetFont().GetMetrics().point_size);
   runs_.emplace_back(run);
   return true;
 }
@@ -43,8 +54,13 @@ const std::vector<TextRun>& TextFrame::GetRuns() const {
 }
 
 GlyphAtlas::Type TextFrame::GetAtlasType() const {
-  return has_color_ ? GlyphAtlas::Type::kColorBitmap
-                    : GlyphAtlas::Type::kAlphaBitmap;
+  if (has_color_) {
+    return GlyphAtlas::Type::kColorBitmap;
+  }
+  if (!runs_.empty() && min_point_size_ >= kMinSignedDistanceFieldPointSize) {
+    return GlyphAtlas::Type::kSignedDistanceField;
+  }
+  return GlyphAtlas::Type::kAlphaBitmap;
 }
 
 bool TextFrame::MaybeHasOverlapping() const {
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <limits>
+
 #include "flutter/fml/macros.h"
 #include "impeller/typographer/glyph_atlas.h"
 #include "impeller/typographer/text_run.h"
@@ -65,11 +67,17 @@ class TextFrame {
 
   //----------------------------------------------------------------------------
   /// @brief      The type of atlas this run should be emplaced in.
+  ///
+  ///             Frames with color glyphs use a color bitmap atlas. Frames
+  ///             where all runs have a large point size use a signed distance
+  ///             field atlas, however they are scaled. Everything else uses
+  ///             an alpha bitmap atlas.
   GlyphAtlas::Type GetAtlasType() const;
 
  private:
   std::vector<TextRun> runs_;
   bool has_color_ = false;
+  Scalar min_point_size_ = std::numeric_limits<Scalar>::max();
 };
 
 }  // namespace impeller
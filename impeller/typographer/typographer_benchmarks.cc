@@ -0,0 +1,177 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "impeller/core/allocator.h"
+#include "impeller/core/texture.h"
+#include "impeller/renderer/capabilities.h"
+#include "impeller/renderer/context.h"
+#include "impeller/typographer/backends/skia/text_frame_skia.h"
+#include "impeller/typographer/text_render_context.h"
+#include "third_party/skia/include/core/SkFont.h"
+#include "third_party/skia/include/core/SkTextBlob.h"
+
+namespace impeller {
+
+namespace {
+
+/// A texture backed by nothing that only counts the bytes uploaded to it. The
+/// glyph atlas only ever writes to its textures so this is enough to measure
+/// the CPU side cost of populating it.
+class HostTexture final : public Texture {
+ public:
+  HostTexture(TextureDescriptor desc, size_t& bytes_uploaded)
+      : Texture(desc), bytes_uploaded_(bytes_uploaded) {}
+
+  // |Texture|
+  void SetLabel(std::string_view label) override {}
+
+  // |Texture|
+  bool IsValid() const override { return true; }
+
+  // |Texture|
+  ISize GetSize() const override { return GetTextureDescriptor().size; }
+
+ private:
+  size_t& bytes_uploaded_;
+
+  // |Texture|
+  bool OnSetContents(const uint8_t* contents,
+                     size_t length,
+                     size_t slice) override {
+    bytes_uploaded_ += length;
+    return true;
+  }
+
+  // |Texture|
+  bool OnSetContents(std::shared_ptr<const fml::Mapping> mapping,
+                     size_t slice) override {
+    bytes_uploaded_ += mapping->GetSize();
+    return true;
+  }
+};
+
+class HostAllocator final : public Allocator {
+ public:
+  HostAllocator() = default;
+
+  size_t bytes_uploaded = 0u;
+
+  // |Allocator|
+  ISize GetMaxTextureSizeSupported() const override { return {4096, 4096}; }
+
+ private:
+  // |Allocator|
+  std::shared_ptr<DeviceBuffer> OnCreateBuffer(
+      const DeviceBufferDescriptor& desc) override {
+    return nullptr;
+  }
+
+  // |Allocator|
+  std::shared_ptr<Texture> OnCreateTexture(
+      const TextureDescriptor& desc) override {
+    return std::make_shared<HostTexture>(desc, bytes_uploaded);
+  }
+};
+
+class HostContext final : public Context {
+ public:
+  HostContext()
+      : allocator_(std::make_shared<HostAllocator>()),
+        capabilities_(CapabilitiesBuilder().Build()) {}
+
+  const std::shared_ptr<HostAllocator>& GetHostAllocator() const {
+    return allocator_;
+  }
+
+  // |Context|
+  std::string DescribeGpuModel() const override { return "Host"; }
+
+  // |Context|
+  bool IsValid() const override { return true; }
+
+  // |Context|
+  const std::shared_ptr<const Capabilities>& GetCapabilities() const override {
+    return capabilities_;
+  }
+
+  // |Context|
+  std::shared_ptr<Allocator> GetResourceAllocator() const override {
+    return allocator_;
+  }
+
+  // |Context|
+  std::shared_ptr<ShaderLibrary> GetShaderLibrary() const override {
+    return nullptr;
+  }
+
+  // |Context|
+  std::shared_ptr<SamplerLibrary> GetSamplerLibrary() const override {
+    return nullptr;
+  }
+
+  // |Context|
+  std::shared_ptr<PipelineLibrary> GetPipelineLibrary() const override {
+    return nullptr;
+  }
+
+  // |Context|
+  std::shared_ptr<CommandBuffer> CreateCommandBuffer() const override {
+    return nullptr;
+  }
+
+  // |Context|
+  void Shutdown() override {}
+
+ private:
+  std::shared_ptr<HostAllocator> allocator_;
+  std::shared_ptr<const Capabilities> capabilities_;
+};
+
+}  // namespace
+
+/// Simulates scrolling through text that keeps introducing glyphs at sizes the
+/// atlas has not seen recently. Each frame reuses most of the glyphs of the
+/// previous frame and adds a new size.
+static void BM_GlyphAtlasChurn(benchmark::State& state) {
+  auto context = std::make_shared<HostContext>();
+  auto text_context = TextRenderContext::Create(context);
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  const auto sizes_per_frame = state.range(0);
+
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString(
+      "the quick brown fox jumped over the lazy dog. THE QUICK BROWN FOX "
+      "JUMPED OVER THE LAZY DOG! 0123456789",
+      sk_font);
+
+  std::vector<TextFrame> frames;
+  size_t frame_count = 0u;
+  while (state.KeepRunning()) {
+    frames.clear();
+    for (auto i = 0; i < sizes_per_frame; i++) {
+      frames.push_back(
+          TextFrameFromTextBlob(blob, 1.0 + 0.25 * ((frame_count + i) % 32)));
+    }
+    size_t index = 0u;
+    TextRenderContext::FrameIterator iterator = [&]() -> const TextFrame* {
+      return index < frames.size() ? &frames[index++] : nullptr;
+    };
+    auto atlas = text_context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap,
+                                                atlas_context, iterator);
+    benchmark::DoNotOptimize(atlas);
+    frame_count++;
+  }
+
+  state.counters["Pages"] = atlas_context->GetPageCount();
+  state.counters["Evictions"] = atlas_context->GetEvictionCount();
+  state.counters["BytesUploadedPerFrame"] =
+      context->GetHostAllocator()->bytes_uploaded /
+      std::max<size_t>(frame_count, 1u);
+}
+
+BENCHMARK(BM_GlyphAtlasChurn)->Arg(1)->Arg(4)->Arg(8);
+
+}  // namespace impeller
@@ -2,12 +2,15 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <array>
+
 #include "flutter/testing/testing.h"
 #include "impeller/playground/playground_test.h"
 #include "impeller/typographer/backends/skia/text_frame_skia.h"
 #include "impeller/typographer/backends/skia/text_render_context_skia.h"
 #include "impeller/typographer/lazy_glyph_atlas.h"
 #include "impeller/typographer/rectangle_packer.h"
+#include "impeller/typographer/signed_distance_field.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkData.h"
 #include "third_party/skia/include/core/SkFontMgr.h"
@@ -276,6 +279,212 @@ TEST_P(TypographerTest, GlyphAtlasTextureIsRecreatedIfTypeChanges) {
   ASSERT_NE(old_packer, new_packer);
 }
 
+TEST_P(TypographerTest, GlyphAtlasAddsPageInsteadOfRecreating) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob));
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_EQ(atlas->GetPageCount(), 1u);
+  auto* first_texture = atlas->GetTexture().get();
+
+  // Large glyphs that cannot all fit in the remaining space of the first page.
+  auto large_blob =
+      SkTextBlob::MakeFromString("ABCDEFGHIJKLMNOPQRSTUVWXYZ", sk_font);
+  auto next_atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(large_blob, 30));
+  ASSERT_EQ(atlas, next_atlas);
+  ASSERT_GT(next_atlas->GetPageCount(), 1u);
+  ASSERT_EQ(next_atlas->GetPageCount(), atlas_context->GetPageCount());
+  ASSERT_EQ(next_atlas->GetTexture().get(), first_texture);
+  for (size_t i = 0; i < next_atlas->GetPageCount(); i++) {
+    ASSERT_NE(next_atlas->GetPageTexture(i), nullptr);
+  }
+
+  // Glyphs from the first frame are still available on the first page.
+  auto frame = TextFrameFromTextBlob(blob);
+  for (const auto& run : frame.GetRuns()) {
+    for (const auto& position : run.GetGlyphPositions()) {
+      FontGlyphPair pair = {.font = run.GetFont(), .glyph = position.glyph};
+      auto location = next_atlas->FindFontGlyphLocation(pair);
+      ASSERT_TRUE(location.has_value());
+      ASSERT_EQ(location->page, 0u);
+    }
+  }
+}
+
+TEST_P(TypographerTest, GlyphAtlasEvictsLeastRecentlyUsedPage) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob));
+  ASSERT_NE(atlas, nullptr);
+
+  auto large_blob =
+      SkTextBlob::MakeFromString("ABCDEFGHIJKLMNOPQRSTUVWXYZ", sk_font);
+  std::shared_ptr<GlyphAtlas> next_atlas;
+  TextFrame frame;
+  for (auto scale = 30; scale < 36; scale++) {
+    frame = TextFrameFromTextBlob(large_blob, scale);
+    next_atlas = context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap,
+                                           atlas_context, frame);
+    ASSERT_NE(next_atlas, nullptr);
+  }
+
+  ASSERT_GT(atlas_context->GetEvictionCount(), 0u);
+  ASSERT_EQ(next_atlas->GetPageCount(), atlas_context->GetPageCount());
+
+  // Glyphs of the first frame were on the least recently used page.
+  auto first_frame = TextFrameFromTextBlob(blob);
+  const auto& first_run = first_frame.GetRuns().front();
+  FontGlyphPair first_pair = {
+      .font = first_run.GetFont(),
+      .glyph = first_run.GetGlyphPositions().front().glyph};
+  ASSERT_FALSE(next_atlas->FindFontGlyphBounds(first_pair).has_value());
+
+  // All glyphs of the last frame are present.
+  for (const auto& run : frame.GetRuns()) {
+    for (const auto& position : run.GetGlyphPositions()) {
+      FontGlyphPair pair = {.font = run.GetFont(), .glyph = position.glyph};
+      ASSERT_TRUE(next_atlas->FindFontGlyphBounds(pair).has_value());
+    }
+  }
+}
+
+TEST_P(TypographerTest, GlyphAtlasIsUnchangedIfGlyphsCannotBeAppended) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas =
+      context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                                TextFrameFromTextBlob(blob));
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_EQ(atlas->GetPageCount(), 1u);
+
+  // A glyph too large for an empty page can't be appended. The frame also
+  // has a glyph that fits, which must not be left behind in the atlas.
+  auto large_blob = SkTextBlob::MakeFromString("A", sk_font);
+  auto small_blob = SkTextBlob::MakeFromString("B", sk_font);
+  auto large_frame = TextFrameFromTextBlob(large_blob, 500);
+  auto small_frame = TextFrameFromTextBlob(small_blob);
+  std::vector<const TextFrame*> frames = {&small_frame, &large_frame};
+  size_t frame_index = 0;
+  context->CreateGlyphAtlas(GlyphAtlas::Type::kAlphaBitmap, atlas_context,
+                            [&]() -> const TextFrame* {
+                              return frame_index < frames.size()
+                                         ? frames[frame_index++]
+                                         : nullptr;
+                            });
+
+  ASSERT_EQ(atlas->GetPageCount(), 1u);
+  auto frame = TextFrameFromTextBlob(blob);
+  for (const auto& run : frame.GetRuns()) {
+    for (const auto& position : run.GetGlyphPositions()) {
+      FontGlyphPair pair = {.font = run.GetFont(), .glyph = position.glyph};
+      ASSERT_TRUE(atlas->FindFontGlyphBounds(pair).has_value());
+    }
+  }
+  const auto& small_run = small_frame.GetRuns().front();
+  FontGlyphPair small_pair = {
+      .font = small_run.GetFont(),
+      .glyph = small_run.GetGlyphPositions().front().glyph};
+  ASSERT_FALSE(atlas->FindFontGlyphBounds(small_pair).has_value());
+}
+
+TEST_P(TypographerTest, LargeTextUsesSignedDistanceFieldAtlas) {
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  sk_font.setSize(64);
+  auto large_blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(large_blob);
+  ASSERT_EQ(TextFrameFromTextBlob(blob).GetAtlasType(),
+            GlyphAtlas::Type::kAlphaBitmap);
+  ASSERT_EQ(TextFrameFromTextBlob(large_blob).GetAtlasType(),
+            GlyphAtlas::Type::kSignedDistanceField);
+
+  // The type doesn't change while the text is scaled across the threshold.
+  for (Scalar scale : {0.5f, 2.0f, 8.0f}) {
+    ASSERT_EQ(TextFrameFromTextBlob(blob, scale).GetAtlasType(),
+              GlyphAtlas::Type::kAlphaBitmap);
+    ASSERT_EQ(TextFrameFromTextBlob(large_blob, scale).GetAtlasType(),
+              GlyphAtlas::Type::kSignedDistanceField);
+  }
+}
+
+TEST_P(TypographerTest, SignedDistanceFieldAtlasIsReusedAcrossScales) {
+  auto context = TextRenderContext::Create(GetContext());
+  auto atlas_context = std::make_shared<GlyphAtlasContext>();
+  ASSERT_TRUE(context && context->IsValid());
+  SkFont sk_font;
+  auto blob = SkTextBlob::MakeFromString("hello", sk_font);
+  ASSERT_TRUE(blob);
+  auto atlas = context->CreateGlyphAtlas(
+      GlyphAtlas::Type::kSignedDistanceField, atlas_context,
+      TextFrameFromTextBlob(blob, 8));
+  ASSERT_NE(atlas, nullptr);
+  ASSERT_EQ(atlas->GetType(), GlyphAtlas::Type::kSignedDistanceField);
+  ASSERT_EQ(atlas->GetTexture()->GetTextureDescriptor().format,
+            PixelFormat::kA8UNormInt);
+  const auto glyph_count = atlas->GetGlyphCount();
+  ASSERT_GT(glyph_count, 0u);
+
+  // Zooming into the same text needs no new glyphs.
+  auto next_atlas = context->CreateGlyphAtlas(
+      GlyphAtlas::Type::kSignedDistanceField, atlas_context,
+      TextFrameFromTextBlob(blob, 12));
+  ASSERT_EQ(atlas, next_atlas);
+  ASSERT_EQ(next_atlas->GetGlyphCount(), glyph_count);
+
+  auto frame = TextFrameFromTextBlob(blob, 12);
+  for (const auto& run : frame.GetRuns()) {
+    auto font = GlyphAtlas::GetAtlasFont(next_atlas->GetType(), run.GetFont());
+    for (const auto& position : run.GetGlyphPositions()) {
+      FontGlyphPair pair = {.font = font, .glyph = position.glyph};
+      ASSERT_TRUE(next_atlas->FindFontGlyphLocation(pair).has_value());
+    }
+  }
+}
+
+TEST_P(TypographerTest, ConvertsCoverageToSignedDistanceField) {
+  constexpr size_t kSize = 16u;
+  std::array<uint8_t, kSize * kSize> pixels = {};
+  // An opaque square in the middle.
+  for (size_t y = 4; y < 12; y++) {
+    for (size_t x = 4; x < 12; x++) {
+      pixels[y * kSize + x] = 255;
+    }
+  }
+  ConvertCoverageToSignedDistanceField(pixels.data(), kSize, kSize, kSize,
+                                       4.0f);
+
+  auto at = [&pixels](size_t x, size_t y) { return pixels[y * kSize + x]; };
+  // Far outside and deep inside saturate.
+  ASSERT_EQ(at(0, 0), 0u);
+  ASSERT_EQ(at(7, 7), 255u);
+  // The edge is encoded around the midpoint.
+  ASSERT_LT(at(3, 7), 128u);
+  ASSERT_GT(at(4, 7), 128u);
+  // Values change monotonically with the distance to the edge.
+  ASSERT_LT(at(2, 7), at(3, 7));
+  ASSERT_LT(at(4, 7), at(5, 7));
+  ASSERT_EQ(at(3, 7), at(7, 3));
+}
+
 TEST_P(TypographerTest, FontGlyphPairTypeChangesHashAndEquals) {
   Font font = Font(nullptr, {});
   FontGlyphPair pair_1 = {
@@ -807,6 +807,41 @@ void hooksTests() async {
     expectEquals(data.data.length, 0);
   });
 
+  await test('onPointerDataPacket reads omitted fields as zero', () {
+    late PointerDataPacket packet;
+    window.onPointerDataPacket = (PointerDataPacket value) {
+      packet = value;
+    };
+
+    // Encoded by PointerDataPacket::WriteColumns, which leaves out the fields
+    // that are zero in both pointer data.
+    _callHook('_dispatchPointerDataPacket', 1, _encodePointerDataPacket());
+    expectEquals(packet.data.length, 2);
+
+    final PointerData down = packet.data[0];
+    expectEquals(down.change, PointerChange.down);
+    expectEquals(down.kind, PointerDeviceKind.mouse);
+    expectEquals(down.device, 1);
+    expectEquals(down.physicalX, 10.5);
+    expectEquals(down.physicalY, 20.0);
+    expectEquals(down.buttons, 1);
+    expectEquals(down.pressure, 0.0);
+    expectEquals(down.timeStamp, Duration.zero);
+    expectEquals(down.signalKind, PointerSignalKind.none);
+    expectEquals(down.synthesized, false);
+
+    final PointerData move = packet.data[1];
+    expectEquals(move.change, PointerChange.move);
+    expectEquals(move.kind, PointerDeviceKind.mouse);
+    expectEquals(move.device, 1);
+    expectEquals(move.physicalX, 30.5);
+    expectEquals(move.physicalY, 20.0);
+    expectEquals(move.buttons, 1);
+    expectEquals(move.pressure, 0.5);
+    expectEquals(move.scrollDeltaX, 0.0);
+    expectEquals(move.rotation, 0.0);
+  });
+
   await test('onSemanticsEnabledChanged preserves callback zone', () {
     late Zone innerZone;
     late Zone runZone;
@@ -1076,6 +1111,9 @@ Future<T> _futurize<T>(_Callbacker<T> callbacker) {
   return completer.future;
 }
 
+@pragma('vm:external-name', 'EncodePointerDataPacket')
+external ByteData _encodePointerDataPacket();
+
 @pragma('vm:external-name', 'CallHook')
 external void _callHook(
   String name, [
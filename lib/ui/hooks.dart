@@ -79,6 +79,11 @@ void _updateWindowMetrics(
   );
 }
 
+@pragma('vm:entry-point')
+void _removeView(int id) {
+  PlatformDispatcher.instance._removeView(id);
+}
+
 typedef _LocaleClosure = String Function();
 
 @pragma('vm:entry-point')
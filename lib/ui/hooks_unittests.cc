@@ -6,6 +6,7 @@
 
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/thread_host.h"
@@ -65,10 +66,44 @@ TEST_F(HooksTest, HooksUnitTests) {
     CHECK_DART_ERROR(hook_result);
   };
 
+  // Two pointer data in which most fields are zero, so that their columns
+  // are left out of the packet.
+  auto encode_pointer_data_packet = [](Dart_NativeArguments args) {
+    PointerDataPacket packet(2);
+    PointerData data;
+    data.Clear();
+    data.change = PointerData::Change::kDown;
+    data.kind = PointerData::DeviceKind::kMouse;
+    data.device = 1;
+    data.physical_x = 10.5;
+    data.physical_y = 20.0;
+    data.buttons = 1;
+    packet.SetPointerData(0, data);
+    data.change = PointerData::Change::kMove;
+    data.physical_x = 30.5;
+    data.pressure = 0.5;
+    packet.SetPointerData(1, data);
+
+    const uint64_t fields = packet.GetNonZeroFields();
+    Dart_Handle byte_data = Dart_NewTypedData(Dart_TypedData_kByteData,
+                                              packet.GetColumnsSize(fields));
+    CHECK_DART_ERROR(byte_data);
+    Dart_TypedData_Type type;
+    void* buffer = nullptr;
+    intptr_t size = 0;
+    CHECK_DART_ERROR(Dart_TypedDataAcquireData(byte_data, &type, &buffer,
+                                               &size));
+    packet.WriteColumns(fields, static_cast<uint8_t*>(buffer));
+    CHECK_DART_ERROR(Dart_TypedDataReleaseData(byte_data));
+    Dart_SetReturnValue(args, byte_data);
+  };
+
   auto finished = [&message_latch](Dart_NativeArguments args) {
     message_latch->Signal();
   };
   AddNativeCallback("CallHook", CREATE_NATIVE_ENTRY(call_hook));
+  AddNativeCallback("EncodePointerDataPacket",
+                    CREATE_NATIVE_ENTRY(encode_pointer_data_packet));
   AddNativeCallback("Finish", CREATE_NATIVE_ENTRY(finished));
 
   auto configuration = RunConfiguration::InferFromSettings(settings);
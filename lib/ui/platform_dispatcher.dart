@@ -329,6 +329,16 @@ class PlatformDispatcher {
     _invoke(onMetricsChanged, _onMetricsChangedZone);
   }
 
+  // Called from the engine, via hooks.dart
+  //
+  // Removes the view with the given id.
+  void _removeView(int id) {
+    assert(id != 0, 'The implicit view cannot be removed.');
+    _views.remove(id);
+    _viewConfigurations.remove(id);
+    _invoke(onMetricsChanged, _onMetricsChangedZone);
+  }
+
   List<DisplayFeature> _decodeDisplayFeatures({
     required List<double> bounds,
     required List<int> type,
@@ -436,53 +446,79 @@ class PlatformDispatcher {
   //  * AndroidTouchProcessor.java
   static const int _kPointerDataFieldCount = 35;
 
+  // The packet is laid out by PointerDataPacket::WriteColumns in
+  // pointer_data_packet.cc: the number of pointer data and a bit mask of the
+  // fields in the packet, followed by a column for each field in the mask with
+  // the values of that field in all the pointer data. Fields that aren't in
+  // the mask are zero in all the pointer data.
   static PointerDataPacket _unpackPointerDataPacket(ByteData packet) {
     const int kStride = Int64List.bytesPerElement;
-    const int kBytesPerPointerData = _kPointerDataFieldCount * kStride;
-    final int length = packet.lengthInBytes ~/ kBytesPerPointerData;
-    assert(length * kBytesPerPointerData == packet.lengthInBytes);
+    if (packet.lengthInBytes == 0) {
+      return const PointerDataPacket();
+    }
+    final int length = packet.getInt64(0, _kFakeHostEndian);
+    final int fields = packet.getInt64(kStride, _kFakeHostEndian);
+    // The offset of the column of each field, or -1 if the field isn't in the
+    // packet.
+    final List<int> columns = List<int>.filled(_kPointerDataFieldCount, -1);
+    int offset = 2 * kStride;
+    for (int field = 0; field < _kPointerDataFieldCount; ++field) {
+      if ((fields & (1 << field)) != 0) {
+        columns[field] = offset;
+        offset += length * kStride;
+      }
+    }
+    assert(offset == packet.lengthInBytes);
+
+    int getInt64(int field, int i) {
+      final int column = columns[field];
+      return column < 0 ? 0 : packet.getInt64(column + kStride * i, _kFakeHostEndian);
+    }
+    double getFloat64(int field, int i) {
+      final int column = columns[field];
+      return column < 0 ? 0.0 : packet.getFloat64(column + kStride * i, _kFakeHostEndian);
+    }
+
     final List<PointerData> data = <PointerData>[];
     for (int i = 0; i < length; ++i) {
-      int offset = i * _kPointerDataFieldCount;
       data.add(PointerData(
         // TODO(goderbauer): Wire up viewId.
-        embedderId: packet.getInt64(kStride * offset++, _kFakeHostEndian),
-        timeStamp: Duration(microseconds: packet.getInt64(kStride * offset++, _kFakeHostEndian)),
-        change: PointerChange.values[packet.getInt64(kStride * offset++, _kFakeHostEndian)],
-        kind: PointerDeviceKind.values[packet.getInt64(kStride * offset++, _kFakeHostEndian)],
-        signalKind: PointerSignalKind.values[packet.getInt64(kStride * offset++, _kFakeHostEndian)],
-        device: packet.getInt64(kStride * offset++, _kFakeHostEndian),
-        pointerIdentifier: packet.getInt64(kStride * offset++, _kFakeHostEndian),
-        physicalX: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        physicalY: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        physicalDeltaX: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        physicalDeltaY: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        buttons: packet.getInt64(kStride * offset++, _kFakeHostEndian),
-        obscured: packet.getInt64(kStride * offset++, _kFakeHostEndian) != 0,
-        synthesized: packet.getInt64(kStride * offset++, _kFakeHostEndian) != 0,
-        pressure: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        pressureMin: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        pressureMax: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        distance: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        distanceMax: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        size: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        radiusMajor: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        radiusMinor: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        radiusMin: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        radiusMax: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        orientation: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        tilt: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        platformData: packet.getInt64(kStride * offset++, _kFakeHostEndian),
-        scrollDeltaX: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        scrollDeltaY: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        panX: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        panY: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        panDeltaX: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        panDeltaY: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        scale: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
-        rotation: packet.getFloat64(kStride * offset++, _kFakeHostEndian),
+        embedderId: getInt64(0, i),
+        timeStamp: Duration(microseconds: getInt64(1, i)),
+        change: PointerChange.values[getInt64(2, i)],
+        kind: PointerDeviceKind.values[getInt64(3, i)],
+        signalKind: PointerSignalKind.values[getInt64(4, i)],
+        device: getInt64(5, i),
+        pointerIdentifier: getInt64(6, i),
+        physicalX: getFloat64(7, i),
+        physicalY: getFloat64(8, i),
+        physicalDeltaX: getFloat64(9, i),
+        physicalDeltaY: getFloat64(10, i),
+        buttons: getInt64(11, i),
+        obscured: getInt64(12, i) != 0,
+        synthesized: getInt64(13, i) != 0,
+        pressure: getFloat64(14, i),
+        pressureMin: getFloat64(15, i),
+        pressureMax: getFloat64(16, i),
+        distance: getFloat64(17, i),
+        distanceMax: getFloat64(18, i),
+        size: getFloat64(19, i),
+        radiusMajor: getFloat64(20, i),
+        radiusMinor: getFloat64(21, i),
+        radiusMin: getFloat64(22, i),
+        radiusMax: getFloat64(23, i),
+        orientation: getFloat64(24, i),
+        tilt: getFloat64(25, i),
+        platformData: getInt64(26, i),
+        scrollDeltaX: getFloat64(27, i),
+        scrollDeltaY: getFloat64(28, i),
+        panX: getFloat64(29, i),
+        panY: getFloat64(30, i),
+        panDeltaX: getFloat64(31, i),
+        panDeltaY: getFloat64(32, i),
+        scale: getFloat64(33, i),
+        rotation: getFloat64(34, i),
       ));
-      assert(offset == (i + 1) * _kPointerDataFieldCount);
     }
     return PointerDataPacket(data: data);
   }
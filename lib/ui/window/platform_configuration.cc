@@ -6,6 +6,7 @@
 
 #include <cstring>
 
+#include "flutter/common/constants.h"
 #include "flutter/lib/ui/compositing/scene.h"
 #include "flutter/lib/ui/ui_dart_state.h"
 #include "flutter/lib/ui/window/platform_message_response_dart.h"
@@ -22,8 +23,6 @@
 namespace flutter {
 namespace {
 
-constexpr int kImplicitViewId = 0;
-
 Dart_Handle ToByteData(const fml::Mapping& buffer) {
   return tonic::DartByteData::Create(buffer.GetMapping(), buffer.GetSize());
 }
@@ -75,13 +74,45 @@ void PlatformConfiguration::DidCreateIsolate() {
                   Dart_GetField(library, tonic::ToDart("_drawFrame")));
   report_timings_.Set(tonic::DartState::Current(),
                       Dart_GetField(library, tonic::ToDart("_reportTimings")));
+  remove_view_.Set(tonic::DartState::Current(),
+                   Dart_GetField(library, tonic::ToDart("_removeView")));
 
   // TODO(loicsharma): This should only be created if the embedder enables the
   // implicit view.
   // See: https://github.com/flutter/flutter/issues/120306
-  windows_.emplace(kImplicitViewId,
-                   std::make_unique<Window>(
-                       kImplicitViewId, ViewportMetrics{1.0, 0.0, 0.0, -1, 0}));
+  windows_.emplace(
+      kFlutterImplicitViewId,
+      std::make_unique<Window>(kFlutterImplicitViewId,
+                               ViewportMetrics{1.0, 0.0, 0.0, -1, 0}));
+}
+
+void PlatformConfiguration::SetViewMetrics(
+    int64_t view_id,
+    const ViewportMetrics& viewport_metrics) {
+  auto found = windows_.find(view_id);
+  if (found == windows_.end()) {
+    found = windows_
+                .emplace(view_id,
+                         std::make_unique<Window>(view_id, viewport_metrics))
+                .first;
+  }
+  found->second->UpdateWindowMetrics(viewport_metrics);
+}
+
+bool PlatformConfiguration::RemoveView(int64_t view_id) {
+  if (view_id == kFlutterImplicitViewId || windows_.erase(view_id) == 0) {
+    return false;
+  }
+
+  std::shared_ptr<tonic::DartState> dart_state =
+      remove_view_.dart_state().lock();
+  if (!dart_state) {
+    return true;
+  }
+  tonic::DartState::Scope scope(dart_state);
+  tonic::CheckAndHandleError(
+      tonic::DartInvoke(remove_view_.Get(), {tonic::ToDart(view_id)}));
+  return true;
 }
 
 void PlatformConfiguration::UpdateDisplays(
@@ -225,12 +256,23 @@ void PlatformConfiguration::DispatchPointerDataPacket(
   }
   tonic::DartState::Scope scope(dart_state);
 
-  const std::vector<uint8_t>& buffer = packet.data();
-  Dart_Handle data_handle =
-      tonic::DartByteData::Create(buffer.data(), buffer.size());
+  // The packet is written straight into the Dart byte data, without the
+  // fields that are zero in all its pointer data.
+  const uint64_t fields = packet.GetNonZeroFields();
+  Dart_Handle data_handle = Dart_NewTypedData(Dart_TypedData_kByteData,
+                                              packet.GetColumnsSize(fields));
   if (Dart_IsError(data_handle)) {
     return;
   }
+  Dart_TypedData_Type type;
+  void* data = nullptr;
+  intptr_t num_acquired = 0;
+  FML_CHECK(!Dart_IsError(
+      Dart_TypedDataAcquireData(data_handle, &type, &data, &num_acquired)));
+  FML_DCHECK(static_cast<size_t>(num_acquired) ==
+             packet.GetColumnsSize(fields));
+  packet.WriteColumns(fields, static_cast<uint8_t*>(data));
+  FML_CHECK(Dart_TypedDataReleaseData(data_handle));
 
   tonic::CheckAndHandleError(
       tonic::DartInvoke(dispatch_pointer_data_packet_.Get(), {data_handle}));
@@ -337,9 +379,10 @@ void PlatformConfiguration::CompletePlatformMessageResponse(
   response->Complete(std::make_unique<fml::DataMapping>(std::move(data)));
 }
 
-void PlatformConfigurationNativeApi::Render(Scene* scene) {
+void PlatformConfigurationNativeApi::Render(int64_t view_id, Scene* scene) {
   UIDartState::ThrowIfUIOperationsProhibited();
-  UIDartState::Current()->platform_configuration()->client()->Render(scene);
+  UIDartState::Current()->platform_configuration()->client()->Render(view_id,
+                                                                     scene);
 }
 
 void PlatformConfigurationNativeApi::SetNeedsReportTimings(bool value) {
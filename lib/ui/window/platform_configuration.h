@@ -77,9 +77,9 @@ class PlatformConfigurationClient {
 
   //--------------------------------------------------------------------------
   /// @brief      Updates the client's rendering on the GPU with the newly
-  ///             provided Scene.
+  ///             provided Scene for the view with the given ID.
   ///
-  virtual void Render(Scene* scene) = 0;
+  virtual void Render(int64_t view_id, Scene* scene) = 0;
 
   //--------------------------------------------------------------------------
   /// @brief      Receives an updated semantics tree from the Framework.
@@ -413,9 +413,33 @@ class PlatformConfiguration final {
   ///
   /// @param[in] window_id The id of the window to find and return.
   ///
-  /// @return     a pointer to the Window.
+  /// @return     a pointer to the Window, or `nullptr` if there is no window
+  ///             with the ID.
   ///
-  Window* get_window(int window_id) { return windows_[window_id].get(); }
+  Window* get_window(int64_t window_id) {
+    auto found = windows_.find(window_id);
+    return found == windows_.end() ? nullptr : found->second.get();
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the framework of the metrics of the view with the
+  ///             given ID, adding the view if the framework doesn't know about
+  ///             it yet.
+  ///
+  /// @param[in] view_id          The ID of the view.
+  /// @param[in] viewport_metrics The metrics of the view.
+  ///
+  void SetViewMetrics(int64_t view_id, const ViewportMetrics& viewport_metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Notifies the framework that the view with the given ID was
+  ///             removed. The implicit view can't be removed.
+  ///
+  /// @param[in] view_id The ID of the view.
+  ///
+  /// @return     Whether a view with the ID was removed.
+  ///
+  bool RemoveView(int64_t view_id);
 
   //----------------------------------------------------------------------------
   /// @brief      Responds to a previous platform message to the engine from the
@@ -454,6 +478,7 @@ class PlatformConfiguration final {
   tonic::DartPersistentValue begin_frame_;
   tonic::DartPersistentValue draw_frame_;
   tonic::DartPersistentValue report_timings_;
+  tonic::DartPersistentValue remove_view_;
 
   std::unordered_map<int64_t, std::unique_ptr<Window>> windows_;
 
@@ -495,7 +520,7 @@ class PlatformConfigurationNativeApi {
 
   static void ScheduleFrame();
 
-  static void Render(Scene* scene);
+  static void Render(int64_t view_id, Scene* scene);
 
   static void UpdateSemantics(SemanticsUpdate* update);
 
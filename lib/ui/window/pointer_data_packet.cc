@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/window/pointer_data_packet.h"
 #include "flutter/fml/logging.h"
 
+#include <bitset>
 #include <cstring>
 
 namespace flutter {
@@ -33,4 +34,49 @@ size_t PointerDataPacket::GetLength() const {
   return data_.size() / sizeof(PointerData);
 }
 
+void PointerDataPacket::Truncate(size_t length) {
+  FML_DCHECK(length <= GetLength());
+  data_.resize(length * sizeof(PointerData));
+}
+
+uint64_t PointerDataPacket::GetNonZeroFields() const {
+  constexpr uint64_t kAllFields = (uint64_t{1} << kPointerDataFieldCount) - 1;
+  uint64_t fields = 0;
+  for (size_t offset = 0; offset < data_.size() && fields != kAllFields;
+       offset += sizeof(PointerData)) {
+    for (int field = 0; field < kPointerDataFieldCount; field++) {
+      uint64_t value;
+      memcpy(&value, &data_[offset + field * kBytesPerField], kBytesPerField);
+      if (value != 0) {
+        fields |= uint64_t{1} << field;
+      }
+    }
+  }
+  return fields;
+}
+
+size_t PointerDataPacket::GetColumnsSize(uint64_t fields) const {
+  const size_t column_count =
+      std::bitset<kPointerDataFieldCount>(fields).count();
+  return (2 + column_count * GetLength()) * kBytesPerField;
+}
+
+void PointerDataPacket::WriteColumns(uint64_t fields, uint8_t* buffer) const {
+  FML_DCHECK((GetNonZeroFields() & ~fields) == 0);
+  const int64_t header[] = {static_cast<int64_t>(GetLength()),
+                            static_cast<int64_t>(fields)};
+  memcpy(buffer, header, sizeof(header));
+  buffer += sizeof(header);
+  for (int field = 0; field < kPointerDataFieldCount; field++) {
+    if ((fields & (uint64_t{1} << field)) == 0) {
+      continue;
+    }
+    for (size_t offset = field * kBytesPerField; offset < data_.size();
+         offset += sizeof(PointerData)) {
+      memcpy(buffer, &data_[offset], kBytesPerField);
+      buffer += kBytesPerField;
+    }
+  }
+}
+
 }  // namespace flutter
@@ -24,6 +24,42 @@ class PointerDataPacket {
   size_t GetLength() const;
   const std::vector<uint8_t>& data() const { return data_; }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Drops the pointer data after the first |length|.
+  ///
+  void Truncate(size_t length);
+
+  //----------------------------------------------------------------------------
+  /// @brief      A bit for each field of `PointerData`, in declaration order,
+  ///             that is set if the field isn't zero in some pointer data of
+  ///             the packet.
+  ///
+  uint64_t GetNonZeroFields() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The size of the packet in the column layout written by
+  ///             `WriteColumns` with the given |fields|.
+  ///
+  size_t GetColumnsSize(uint64_t fields) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Writes the packet in the layout it is sent to the framework
+  ///             in, which is decoded by `_unpackPointerDataPacket` in
+  ///             platform_dispatcher.dart.
+  ///
+  ///             The layout starts with the number of pointer data and
+  ///             |fields| as two 64-bit integers, followed by a column for
+  ///             each field in |fields| with the values of that field in all
+  ///             the pointer data. The fields that aren't in |fields| are left
+  ///             out and read as zero.
+  ///
+  /// @param[in]  fields  The fields to write, which must include all the
+  ///                     fields from `GetNonZeroFields`.
+  /// @param[out] buffer  The buffer to write to, which must be
+  ///                     `GetColumnsSize(fields)` bytes long.
+  ///
+  void WriteColumns(uint64_t fields, uint8_t* buffer) const;
+
  private:
   std::vector<uint8_t> data_;
 
@@ -17,22 +17,39 @@ PointerDataPacketConverter::~PointerDataPacketConverter() = default;
 
 std::unique_ptr<PointerDataPacket> PointerDataPacketConverter::Convert(
     std::unique_ptr<PointerDataPacket> packet) {
+  // Most pointer data converts to a single pointer data, so the converted
+  // pointer data is written back over the pointer data that was already
+  // converted. Only once synthesized pointer data would overwrite pointer data
+  // that wasn't converted yet does the rest go to |overflow|.
+  const size_t length = packet->GetLength();
+  size_t converted_count = 0;
   std::vector<PointerData> converted_pointers;
-  // Converts each pointer data in the buffer and stores it in the
-  // converted_pointers.
-  for (size_t i = 0; i < packet->GetLength(); i++) {
-    PointerData pointer_data = packet->GetPointerData(i);
-    ConvertPointerData(pointer_data, converted_pointers);
+  std::vector<PointerData> overflow;
+  for (size_t i = 0; i < length; i++) {
+    converted_pointers.clear();
+    ConvertPointerData(packet->GetPointerData(i), converted_pointers);
+    for (const auto& converted_pointer : converted_pointers) {
+      if (overflow.empty() && converted_count <= i) {
+        packet->SetPointerData(converted_count++, converted_pointer);
+      } else {
+        overflow.push_back(converted_pointer);
+      }
+    }
   }
 
-  // Writes converted_pointers into converted_packet.
-  auto converted_packet =
-      std::make_unique<flutter::PointerDataPacket>(converted_pointers.size());
-  size_t count = 0;
-  for (auto& converted_pointer : converted_pointers) {
-    converted_packet->SetPointerData(count++, converted_pointer);
+  if (overflow.empty()) {
+    packet->Truncate(converted_count);
+    return packet;
   }
 
+  auto converted_packet = std::make_unique<flutter::PointerDataPacket>(
+      converted_count + overflow.size());
+  for (size_t i = 0; i < converted_count; i++) {
+    converted_packet->SetPointerData(i, packet->GetPointerData(i));
+  }
+  for (size_t i = 0; i < overflow.size(); i++) {
+    converted_packet->SetPointerData(converted_count + i, overflow[i]);
+  }
   return converted_packet;
 }
 
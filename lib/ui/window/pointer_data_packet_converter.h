@@ -92,6 +92,8 @@ class PointerDataPacketConverter {
   /// filled.
   ///             It may contain synthetic pointer data as the result of
   ///             converter's attempt to correct illegal pointer transitions.
+  ///             Unless synthetic pointer data makes it longer, this is
+  ///             |packet| converted in place.
   ///
   std::unique_ptr<PointerDataPacket> Convert(
       std::unique_ptr<PointerDataPacket> packet);
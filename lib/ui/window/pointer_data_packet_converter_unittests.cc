@@ -189,6 +189,31 @@ TEST(PointerDataPacketConverterTest, CanConvertPointerDataPacket) {
   ASSERT_EQ(result[5].synthesized, 0);
 }
 
+TEST(PointerDataPacketConverterTest, ConvertsPacketInPlace) {
+  PointerDataPacketConverter converter;
+  auto packet = std::make_unique<PointerDataPacket>(3);
+  PointerData data;
+  // A cancel of a pointer that isn't added is dropped.
+  CreateSimulatedPointerData(data, PointerData::Change::kCancel, 1, 0.0, 0.0,
+                             0);
+  packet->SetPointerData(0, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kAdd, 0, 0.0, 0.0, 0);
+  packet->SetPointerData(1, data);
+  CreateSimulatedPointerData(data, PointerData::Change::kDown, 0, 0.0, 0.0, 1);
+  packet->SetPointerData(2, data);
+  const PointerDataPacket* raw_packet = packet.get();
+  auto converted_packet = converter.Convert(std::move(packet));
+  ASSERT_EQ(converted_packet.get(), raw_packet);
+
+  std::vector<PointerData> result;
+  UnpackPointerPacket(result, std::move(converted_packet));
+
+  ASSERT_EQ(result.size(), (size_t)2);
+  ASSERT_EQ(result[0].change, PointerData::Change::kAdd);
+  ASSERT_EQ(result[1].change, PointerData::Change::kDown);
+  ASSERT_EQ(result[1].pointer_identifier, 1);
+}
+
 TEST(PointerDataPacketConverterTest, CanSynthesizeDownAndUp) {
   PointerDataPacketConverter converter;
   auto packet = std::make_unique<PointerDataPacket>(4);
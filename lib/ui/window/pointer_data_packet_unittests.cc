@@ -5,6 +5,7 @@
 #include "flutter/lib/ui/window/pointer_data.h"
 
 #include <cstring>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "pointer_data_packet.h"
@@ -65,5 +66,67 @@ TEST(PointerDataPacketTest, CanGetLength) {
   ASSERT_EQ(packet->GetLength(), (size_t)6);
 }
 
+TEST(PointerDataPacketTest, CanTruncate) {
+  auto packet = std::make_unique<PointerDataPacket>(3);
+  PointerData data;
+  CreateSimpleSimulatedPointerData(data, PointerData::Change::kAdd, 1, 2.0, 3.0,
+                                   4);
+  packet->SetPointerData(0, data);
+  packet->Truncate(1);
+  ASSERT_EQ(packet->GetLength(), (size_t)1);
+  ASSERT_EQ(packet->GetPointerData(0).physical_x, 2.0);
+}
+
+TEST(PointerDataPacketTest, CanGetNonZeroFields) {
+  auto packet = std::make_unique<PointerDataPacket>(2);
+  ASSERT_EQ(packet->GetNonZeroFields(), (uint64_t)0);
+
+  PointerData data;
+  data.Clear();
+  CreateSimpleSimulatedPointerData(data, PointerData::Change::kCancel, 0, 2.0,
+                                   0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimpleSimulatedPointerData(data, PointerData::Change::kCancel, 0, 0.0,
+                                   3.0, 0);
+  packet->SetPointerData(1, data);
+  // physical_x and physical_y.
+  ASSERT_EQ(packet->GetNonZeroFields(),
+            (uint64_t{1} << 7) | (uint64_t{1} << 8));
+}
+
+TEST(PointerDataPacketTest, CanWriteColumns) {
+  auto packet = std::make_unique<PointerDataPacket>(2);
+  PointerData data;
+  data.Clear();
+  CreateSimpleSimulatedPointerData(data, PointerData::Change::kCancel, 0, 2.0,
+                                   0.0, 0);
+  packet->SetPointerData(0, data);
+  CreateSimpleSimulatedPointerData(data, PointerData::Change::kCancel, 0, 4.0,
+                                   0.0, 5);
+  packet->SetPointerData(1, data);
+
+  const uint64_t fields = packet->GetNonZeroFields();
+  // physical_x and buttons.
+  ASSERT_EQ(fields, (uint64_t{1} << 7) | (uint64_t{1} << 11));
+  const size_t size = packet->GetColumnsSize(fields);
+  ASSERT_EQ(size, (2 + 2 * 2) * sizeof(int64_t));
+
+  std::vector<uint8_t> buffer(size);
+  packet->WriteColumns(fields, buffer.data());
+  int64_t header[2];
+  memcpy(header, buffer.data(), sizeof(header));
+  ASSERT_EQ(header[0], 2);
+  ASSERT_EQ(header[1], static_cast<int64_t>(fields));
+
+  double physical_xs[2];
+  int64_t buttons[2];
+  memcpy(physical_xs, &buffer[2 * sizeof(int64_t)], sizeof(physical_xs));
+  memcpy(buttons, &buffer[4 * sizeof(int64_t)], sizeof(buttons));
+  ASSERT_EQ(physical_xs[0], 2.0);
+  ASSERT_EQ(physical_xs[1], 4.0);
+  ASSERT_EQ(buttons[0], 0);
+  ASSERT_EQ(buttons[1], 5);
+}
+
 }  // namespace testing
 }  // namespace flutter
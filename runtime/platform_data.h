@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "flutter/lib/ui/window/viewport_metrics.h"
@@ -33,6 +34,9 @@ struct PlatformData {
   ~PlatformData();
 
   ViewportMetrics viewport_metrics;
+  // The metrics of the views that were added in addition to the implicit
+  // view, by view ID.
+  std::unordered_map<int64_t, ViewportMetrics> view_metrics;
   std::string language_code;
   std::string country_code;
   std::string script_code;
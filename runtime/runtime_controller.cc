@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "flutter/common/constants.h"
 #include "flutter/fml/message_loop.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/lib/ui/compositing/scene.h"
@@ -20,8 +21,6 @@
 
 namespace flutter {
 
-const uint64_t kFlutterDefaultViewId = 0llu;
-
 RuntimeController::RuntimeController(RuntimeDelegate& p_client,
                                      const TaskRunners& task_runners)
     : client_(p_client), vm_(nullptr), context_(task_runners) {}
@@ -77,6 +76,7 @@ std::unique_ptr<RuntimeController> RuntimeController::Spawn(
                                           spawned_context);              //
   result->spawning_isolate_ = root_isolate_;
   result->platform_data_.viewport_metrics = ViewportMetrics();
+  result->platform_data_.view_metrics.clear();
   return result;
 }
 
@@ -115,6 +115,11 @@ std::unique_ptr<RuntimeController> RuntimeController::Clone() const {
 }
 
 bool RuntimeController::FlushRuntimeStateToIsolate() {
+  for (const auto& [view_id, metrics] : platform_data_.view_metrics) {
+    if (!SetViewportMetrics(view_id, metrics)) {
+      return false;
+    }
+  }
   return SetViewportMetrics(platform_data_.viewport_metrics) &&
          SetLocales(platform_data_.locale_data) &&
          SetSemanticsEnabled(platform_data_.semantics_enabled) &&
@@ -130,13 +135,42 @@ bool RuntimeController::SetViewportMetrics(const ViewportMetrics& metrics) {
   platform_data_.viewport_metrics = metrics;
 
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
-    platform_configuration->get_window(0)->UpdateWindowMetrics(metrics);
+    platform_configuration->get_window(kFlutterImplicitViewId)
+        ->UpdateWindowMetrics(metrics);
+    return true;
+  }
+
+  return false;
+}
+
+bool RuntimeController::SetViewportMetrics(int64_t view_id,
+                                           const ViewportMetrics& metrics) {
+  if (view_id == kFlutterImplicitViewId) {
+    return SetViewportMetrics(metrics);
+  }
+  TRACE_EVENT0("flutter", "SetViewportMetrics");
+  platform_data_.view_metrics[view_id] = metrics;
+
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    platform_configuration->SetViewMetrics(view_id, metrics);
     return true;
   }
 
   return false;
 }
 
+bool RuntimeController::RemoveView(int64_t view_id) {
+  if (platform_data_.view_metrics.erase(view_id) == 0) {
+    return false;
+  }
+
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    return platform_configuration->RemoveView(view_id);
+  }
+
+  return false;
+}
+
 bool RuntimeController::SetLocales(
     const std::vector<std::string>& locale_data) {
   platform_data_.locale_data = locale_data;
@@ -318,16 +352,15 @@ void RuntimeController::ScheduleFrame() {
 }
 
 // |PlatformConfigurationClient|
-void RuntimeController::Render(Scene* scene) {
-  // TODO(dkwingsmt): Currently only supports a single window.
-  int64_t view_id = kFlutterDefaultViewId;
+void RuntimeController::Render(int64_t view_id, Scene* scene) {
   auto window =
       UIDartState::Current()->platform_configuration()->get_window(view_id);
   if (window == nullptr) {
     return;
   }
   const auto& viewport_metrics = window->viewport_metrics();
-  client_.Render(scene->takeLayerTree(viewport_metrics.physical_width,
+  client_.Render(view_id,
+                 scene->takeLayerTree(viewport_metrics.physical_width,
                                       viewport_metrics.physical_height),
                  viewport_metrics.device_pixel_ratio);
 }
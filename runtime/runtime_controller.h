@@ -174,6 +174,29 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   bool SetViewportMetrics(const ViewportMetrics& metrics);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Forward the viewport metrics of the view with the given ID to
+  ///             the running isolate, adding the view if it wasn't known yet.
+  ///             If the isolate is not running, these metrics will be saved
+  ///             and flushed to the isolate when it starts.
+  ///
+  /// @param[in]  view_id  The ID of the view.
+  /// @param[in]  metrics  The view's viewport metrics.
+  ///
+  /// @return     If the view metrics were forwarded to the running isolate.
+  ///
+  bool SetViewportMetrics(int64_t view_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Remove the view with the given ID, which was previously added
+  ///             with `SetViewportMetrics`. The implicit view can't be removed.
+  ///
+  /// @param[in]  view_id  The ID of the view.
+  ///
+  /// @return     If the removal was forwarded to the running isolate.
+  ///
+  bool RemoveView(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Forward the specified display metrics to the running isolate.
   ///             If the isolate is not running, these metrics will be saved and
@@ -630,7 +653,7 @@ class RuntimeController : public PlatformConfigurationClient {
   void ScheduleFrame() override;
 
   // |PlatformConfigurationClient|
-  void Render(Scene* scene) override;
+  void Render(int64_t view_id, Scene* scene) override;
 
   // |PlatformConfigurationClient|
   void UpdateSemantics(SemanticsUpdate* update) override;
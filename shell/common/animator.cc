@@ -4,7 +4,11 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+
+#include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/dart/runtime/include/dart_tools_api.h"
@@ -23,12 +27,21 @@ constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
 
 Animator::Animator(Delegate& delegate,
                    const TaskRunners& task_runners,
-                   std::unique_ptr<VsyncWaiter> waiter)
+                   std::unique_ptr<VsyncWaiter> waiter,
+                   std::shared_ptr<FrameScheduler> frame_scheduler,
+                   PipelineOverflow pipeline_overflow)
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
+      frame_scheduler_(std::move(frame_scheduler)),
 #if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(2)),
+      layer_tree_pipeline_(std::make_shared<LayerTreePipeline>(
+          2,
+          pipeline_overflow,
+          // Items are only dropped while the animator completes a frame.
+          [this](std::unique_ptr<LayerTreeItem> item) {
+            OnLayerTreeItemDropped(std::move(item));
+          })),
 #else   // SHELL_ENABLE_METAL
       // TODO(dnfield): We should remove this logic and set the pipeline depth
       // back to 2 in this case. See
@@ -37,7 +50,12 @@ Animator::Animator(Delegate& delegate,
           task_runners.GetPlatformTaskRunner() ==
                   task_runners.GetRasterTaskRunner()
               ? 1
-              : 2)),
+              : 2,
+          pipeline_overflow,
+          // Items are only dropped while the animator completes a frame.
+          [this](std::unique_ptr<LayerTreeItem> item) {
+            OnLayerTreeItemDropped(std::move(item));
+          })),
 #endif  // SHELL_ENABLE_METAL
       pending_frame_semaphore_(1),
       weak_factory_(this) {
@@ -78,11 +96,36 @@ void Animator::BeginFrame(
   regenerate_layer_tree_ = false;
   pending_frame_semaphore_.Signal();
 
+  const fml::TimePoint frame_target_time =
+      frame_timings_recorder_->GetVsyncTargetTime();
+  const fml::TimeDelta frame_interval =
+      frame_target_time - frame_timings_recorder_->GetVsyncStartTime();
+  last_frame_target_time_ = frame_target_time;
+
   if (!producer_continuation_) {
+    // Only build ahead of the rasterizer when the frame scheduler predicts
+    // that building and rasterizing the frame won't fit in a frame interval.
+    // Otherwise, skipping a frame is better than adding a frame of latency.
+    const bool is_pipeline_full =
+        frame_scheduler_ &&
+        static_cast<uint32_t>(layer_tree_pipeline_->GetInFlightCount()) >=
+            frame_scheduler_->GetPipelineDepth(
+                frame_interval, layer_tree_pipeline_->GetDepth());
+    if (is_pipeline_full && layer_tree_pipeline_->GetOverflow() !=
+                                PipelineOverflow::kReplaceOldest) {
+      TRACE_EVENT0("flutter", "PipelineFull");
+      RequestFrame();
+      return;
+    }
+
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animator::Render. Simply reuse that
-    // instead of asking the pipeline for a fresh continuation.
-    producer_continuation_ = layer_tree_pipeline_->Produce();
+    // instead of asking the pipeline for a fresh continuation. When the frame
+    // scheduler limits the pipeline depth, the latest frame replaces a queued
+    // one instead of taking one more spot.
+    producer_continuation_ = is_pipeline_full
+                                 ? layer_tree_pipeline_->ProduceReplacement()
+                                 : layer_tree_pipeline_->Produce();
 
     if (!producer_continuation_) {
       // If we still don't have valid continuation, the pipeline is currently
@@ -97,11 +140,12 @@ void Animator::BeginFrame(
   // We have acquired a valid continuation from the pipeline and are ready
   // to service potential frame.
   FML_DCHECK(producer_continuation_);
-  const fml::TimePoint frame_target_time =
-      frame_timings_recorder_->GetVsyncTargetTime();
   dart_frame_deadline_ = frame_target_time.ToEpochDelta();
   uint64_t frame_number = frame_timings_recorder_->GetFrameNumber();
+  is_building_frame_ = true;
   delegate_.OnAnimatorBeginFrame(frame_target_time, frame_number);
+  is_building_frame_ = false;
+  EndFrame();
 
   if (!frame_scheduled_ && has_rendered_) {
     // Wait a tad more than 3 60hz frames before reporting a big idle period.
@@ -128,10 +172,13 @@ void Animator::BeginFrame(
   }
 }
 
-void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
+void Animator::Render(int64_t view_id,
+                      std::unique_ptr<flutter::LayerTree> layer_tree,
                       float device_pixel_ratio) {
   has_rendered_ = true;
-  last_layer_tree_size_ = layer_tree->frame_size();
+  if (view_id == kFlutterImplicitViewId) {
+    last_layer_tree_size_ = layer_tree->frame_size();
+  }
 
   if (!frame_timings_recorder_) {
     // Framework can directly call render with a built scene.
@@ -143,14 +190,33 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
 
   TRACE_EVENT_WITH_FRAME_NUMBER(frame_timings_recorder_, "flutter",
                                 "Animator::Render");
+  const bool is_rendered = std::any_of(
+      layer_tree_tasks_.begin(), layer_tree_tasks_.end(),
+      [view_id](const auto& task) { return task->view_id == view_id; });
+  if (!is_rendered) {
+    layer_tree_tasks_.push_back(std::make_unique<LayerTreeTask>(
+        view_id, std::move(layer_tree), device_pixel_ratio));
+  }
+
+  if (!is_building_frame_) {
+    EndFrame();
+  }
+}
+
+void Animator::EndFrame() {
+  if (layer_tree_tasks_.empty()) {
+    // No view was rendered in this frame.
+    return;
+  }
+
   frame_timings_recorder_->RecordBuildEnd(fml::TimePoint::Now());
 
   delegate_.OnAnimatorUpdateLatestFrameTargetTime(
       frame_timings_recorder_->GetVsyncTargetTime());
 
   auto layer_tree_item = std::make_unique<LayerTreeItem>(
-      std::move(layer_tree), std::move(frame_timings_recorder_),
-      device_pixel_ratio);
+      std::move(layer_tree_tasks_), std::move(frame_timings_recorder_));
+  layer_tree_tasks_.clear();
   // Commit the pending continuation.
   PipelineProduceResult result =
       producer_continuation_.Complete(std::move(layer_tree_item));
@@ -162,14 +228,26 @@ void Animator::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
 
   if (!result.is_first_item) {
     // It has been successfully pushed to the pipeline but not as the first
-    // item. Eventually the 'Rasterizer' will consume it, so we don't need to
-    // notify the delegate.
+    // item, possibly in place of an older item or as the item that follows the
+    // one being rasterized. Eventually the 'Rasterizer' will consume it, so we
+    // don't need to notify the delegate.
     return;
   }
 
   delegate_.OnAnimatorDraw(layer_tree_pipeline_);
 }
 
+void Animator::OnLayerTreeItemDropped(std::unique_ptr<LayerTreeItem> item) {
+  dropped_frame_count_++;
+  if (item && item->frame_timings_recorder) {
+    TRACE_EVENT_INSTANT1(
+        "flutter", "Animator::FrameDropped", "frame_number",
+        item->frame_timings_recorder->GetFrameNumberTraceArg());
+  }
+  FML_TRACE_COUNTER("flutter", "Animator", reinterpret_cast<int64_t>(this),
+                    "DroppedFrames", dropped_frame_count_);
+}
+
 const std::weak_ptr<VsyncWaiter> Animator::GetVsyncWaiter() const {
   std::weak_ptr<VsyncWaiter> weak = waiter_;
   return weak;
@@ -235,11 +313,7 @@ void Animator::AwaitVSync() {
       [self = weak_factory_.GetWeakPtr()](
           std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
         if (self) {
-          if (self->CanReuseLastLayerTree()) {
-            self->DrawLastLayerTree(std::move(frame_timings_recorder));
-          } else {
-            self->BeginFrame(std::move(frame_timings_recorder));
-          }
+          self->OnVSync(std::move(frame_timings_recorder));
         }
       });
   if (has_rendered_) {
@@ -247,14 +321,62 @@ void Animator::AwaitVSync() {
   }
 }
 
+void Animator::OnVSync(
+    std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
+  if (CanReuseLastLayerTree()) {
+    DrawLastLayerTree(std::move(frame_timings_recorder));
+    return;
+  }
+
+  // The first frame after the app was idle is built right away since there is
+  // no telling how long it will take.
+  const fml::TimePoint vsync_start =
+      frame_timings_recorder->GetVsyncStartTime();
+  const fml::TimePoint vsync_target =
+      frame_timings_recorder->GetVsyncTargetTime();
+  const fml::TimeDelta frame_interval = vsync_target - vsync_start;
+  const bool is_consecutive_frame =
+      vsync_start <= last_frame_target_time_ + frame_interval / 2;
+  const fml::TimeDelta build_delay =
+      frame_scheduler_ && is_consecutive_frame
+          ? frame_scheduler_->GetBuildDelay(frame_interval)
+          : fml::TimeDelta::Zero();
+  if (build_delay <= fml::TimeDelta::Zero()) {
+    BeginFrame(std::move(frame_timings_recorder));
+    return;
+  }
+
+  TRACE_EVENT1("flutter", "Animator::DelayBuild", "delay_ms",
+               std::to_string(build_delay.ToMilliseconds()).c_str());
+  auto begin_frame = fml::MakeCopyable(
+      [self = weak_factory_.GetWeakPtr(),
+       recorder = std::move(frame_timings_recorder)]() mutable {
+        if (self) {
+          self->BeginFrame(std::move(recorder));
+        }
+      });
+  task_runners_.GetUITaskRunner()->PostTaskForTime(std::move(begin_frame),
+                                                   vsync_start + build_delay);
+}
+
 void Animator::ScheduleSecondaryVsyncCallback(uintptr_t id,
                                               const fml::closure& callback) {
   waiter_->ScheduleSecondaryCallback(id, callback);
 }
 
+void Animator::ScheduleSecondaryVsyncCallback(
+    uintptr_t id,
+    const char* name,
+    VsyncWaiter::SecondaryCallbackPriority priority,
+    const VsyncWaiter::SecondaryCallback& callback) {
+  waiter_->ScheduleSecondaryCallback(id, name, priority, callback);
+}
+
 void Animator::ScheduleMaybeClearTraceFlowIds() {
   waiter_->ScheduleSecondaryCallback(
-      reinterpret_cast<uintptr_t>(this), [self = weak_factory_.GetWeakPtr()] {
+      reinterpret_cast<uintptr_t>(this), "Animator::MaybeClearTraceFlowIds",
+      VsyncWaiter::SecondaryCallbackPriority::kDefault,
+      [self = weak_factory_.GetWeakPtr()](fml::TimePoint, fml::TimePoint) {
         if (!self) {
           return;
         }
@@ -6,6 +6,7 @@
 #define FLUTTER_SHELL_COMMON_ANIMATOR_H_
 
 #include <deque>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/frame_timings.h"
@@ -13,6 +14,7 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_scheduler.h"
 #include "flutter/shell/common/pipeline.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
@@ -46,15 +48,39 @@ class Animator final {
         std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) = 0;
   };
 
+  //----------------------------------------------------------------------------
+  /// @param[in]  frame_scheduler  If set, used to decide when to start
+  ///                              building each frame and how many frames to
+  ///                              pipeline. Otherwise frames are built as
+  ///                              soon as the vsync fires.
+  /// @param[in]  pipeline_overflow  What happens to a frame that is built
+  ///                                while the layer tree pipeline is full.
+  ///                                With |PipelineOverflow::kReplaceOldest|
+  ///                                it replaces the frame that has waited the
+  ///                                longest for the rasterizer, which is then
+  ///                                reported as dropped.
+  ///
   Animator(Delegate& delegate,
            const TaskRunners& task_runners,
-           std::unique_ptr<VsyncWaiter> waiter);
+           std::unique_ptr<VsyncWaiter> waiter,
+           std::shared_ptr<FrameScheduler> frame_scheduler = nullptr,
+           PipelineOverflow pipeline_overflow = PipelineOverflow::kReject);
 
   ~Animator();
 
   void RequestFrame(bool regenerate_layer_tree = true);
 
-  void Render(std::unique_ptr<flutter::LayerTree> layer_tree,
+  //----------------------------------------------------------------------------
+  /// @brief      Submits the layer tree of a view for the current frame.
+  ///
+  ///             The layer trees of all the views rendered while a frame is
+  ///             being built are sent to the rasterizer together once the
+  ///             frame is built. A layer tree rendered outside of a frame, for
+  ///             example a warm up frame, is sent right away. Only the first
+  ///             layer tree rendered for each view in a frame is used.
+  ///
+  void Render(int64_t view_id,
+              std::unique_ptr<flutter::LayerTree> layer_tree,
               float device_pixel_ratio);
 
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
@@ -77,6 +103,19 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Like `ScheduleSecondaryVsyncCallback` above, with the vsync
+  ///           timing passed to the callback. The callback is invoked in the
+  ///           order of its |priority| among the secondary callbacks of the
+  ///           vsync, and its delay is recorded for the subscriber |name|.
+  ///
+  /// @see      `VsyncWaiter::ScheduleSecondaryCallback`.
+  void ScheduleSecondaryVsyncCallback(
+      uintptr_t id,
+      const char* name,
+      VsyncWaiter::SecondaryCallbackPriority priority,
+      const VsyncWaiter::SecondaryCallback& callback);
+
   // Enqueue |trace_flow_id| into |trace_flow_ids_|.  The flow event will be
   // ended at either the next frame, or the next vsync interval with no active
   // rendering.
@@ -85,6 +124,9 @@ class Animator final {
  private:
   void BeginFrame(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
 
+  // Sends the layer trees rendered since the last frame to the rasterizer.
+  void EndFrame();
+
   bool CanReuseLastLayerTree();
 
   void DrawLastLayerTree(
@@ -92,12 +134,19 @@ class Animator final {
 
   void AwaitVSync();
 
+  void OnVSync(std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
+
   // Clear |trace_flow_ids_| if |frame_scheduled_| is false.
   void ScheduleMaybeClearTraceFlowIds();
 
+  // Called when a newer frame replaced |item| in the layer tree pipeline
+  // before it could be rasterized.
+  void OnLayerTreeItemDropped(std::unique_ptr<LayerTreeItem> item);
+
   Delegate& delegate_;
   TaskRunners task_runners_;
   std::shared_ptr<VsyncWaiter> waiter_;
+  std::shared_ptr<FrameScheduler> frame_scheduler_;
 
   std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder_;
   uint64_t frame_request_number_ = 1;
@@ -108,8 +157,19 @@ class Animator final {
   bool regenerate_layer_tree_ = false;
   bool frame_scheduled_ = false;
   SkISize last_layer_tree_size_ = {0, 0};
+  // The layer trees rendered in the current frame, in the order in which the
+  // views were rendered.
+  std::vector<std::unique_ptr<LayerTreeTask>> layer_tree_tasks_;
+  // Whether the delegate is building a frame, in which case the views it
+  // renders are only sent to the rasterizer once it is done.
+  bool is_building_frame_ = false;
   std::deque<uint64_t> trace_flow_ids_;
   bool has_rendered_ = false;
+  // The target time of the vsync of the last frame that began.
+  fml::TimePoint last_frame_target_time_;
+  // The number of frames that were replaced by newer ones before they could be
+  // rasterized.
+  uint64_t dropped_frame_count_ = 0;
 
   fml::WeakPtrFactory<Animator> weak_factory_;
 
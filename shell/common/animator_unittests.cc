@@ -10,6 +10,7 @@
 #include <future>
 #include <memory>
 
+#include "flutter/common/constants.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
 #include "flutter/testing/post_task_sync.h"
@@ -158,7 +159,7 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyIdleBeforeRender) {
         ASSERT_FALSE(delegate.notify_idle_called_);
         auto layer_tree = std::make_unique<LayerTree>(LayerTree::Config(),
                                                       SkISize::Make(600, 800));
-        animator->Render(std::move(layer_tree), 1.0);
+        animator->Render(kFlutterImplicitViewId, std::move(layer_tree), 1.0);
         task_runners.GetPlatformTaskRunner()->PostTask(flush_vsync_task);
       },
       // See kNotifyIdleTaskWaitTime in animator.cc.
@@ -241,7 +242,7 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
     PostTaskSync(task_runners.GetUITaskRunner(), [&] {
       auto layer_tree = std::make_unique<LayerTree>(LayerTree::Config(),
                                                     SkISize::Make(600, 800));
-      animator->Render(std::move(layer_tree), 1.0);
+      animator->Render(kFlutterImplicitViewId, std::move(layer_tree), 1.0);
     });
   }
 
@@ -297,6 +297,17 @@ void Engine::SetViewportMetrics(const ViewportMetrics& metrics) {
   ScheduleFrame();
 }
 
+void Engine::SetViewportMetrics(int64_t view_id,
+                                const ViewportMetrics& metrics) {
+  runtime_controller_->SetViewportMetrics(view_id, metrics);
+  ScheduleFrame();
+}
+
+void Engine::RemoveView(int64_t view_id) {
+  runtime_controller_->RemoveView(view_id);
+  ScheduleFrame();
+}
+
 void Engine::DispatchPlatformMessage(std::unique_ptr<PlatformMessage> message) {
   std::string channel = message->channel();
   if (channel == kLifecycleChannel) {
@@ -456,7 +467,8 @@ void Engine::ScheduleFrame(bool regenerate_layer_tree) {
   animator_->RequestFrame(regenerate_layer_tree);
 }
 
-void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
+void Engine::Render(int64_t view_id,
+                    std::unique_ptr<flutter::LayerTree> layer_tree,
                     float device_pixel_ratio) {
   if (!layer_tree) {
     return;
@@ -467,7 +479,7 @@ void Engine::Render(std::unique_ptr<flutter::LayerTree> layer_tree,
     return;
   }
 
-  animator_->Render(std::move(layer_tree), device_pixel_ratio);
+  animator_->Render(view_id, std::move(layer_tree), device_pixel_ratio);
 }
 
 void Engine::UpdateSemantics(SemanticsNodeUpdates update,
@@ -513,6 +525,14 @@ void Engine::DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
   }
 }
 
+void Engine::ScheduleSecondaryVsyncCallback(
+    uintptr_t id,
+    const char* name,
+    VsyncWaiter::SecondaryCallbackPriority priority,
+    const VsyncWaiter::SecondaryCallback& callback) {
+  animator_->ScheduleSecondaryVsyncCallback(id, name, priority, callback);
+}
+
 void Engine::ScheduleSecondaryVsyncCallback(uintptr_t id,
                                             const fml::closure& callback) {
   animator_->ScheduleSecondaryVsyncCallback(id, callback);
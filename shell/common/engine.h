@@ -688,6 +688,24 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///
   void SetViewportMetrics(const ViewportMetrics& metrics);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Updates the viewport metrics of the view with the given ID,
+  ///             adding the view to the currently running Flutter application
+  ///             if it wasn't known yet.
+  ///
+  /// @param[in]  view_id  The ID of the view.
+  /// @param[in]  metrics  The metrics
+  ///
+  void SetViewportMetrics(int64_t view_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Removes the view with the given ID from the currently running
+  ///             Flutter application.
+  ///
+  /// @param[in]  view_id  The ID of the view.
+  ///
+  void RemoveView(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Updates the display metrics for the currently running Flutter
   ///             application.
@@ -799,8 +817,19 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
                         uint64_t trace_flow_id) override;
 
   // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(
+      uintptr_t id,
+      const char* name,
+      VsyncWaiter::SecondaryCallbackPriority priority,
+      const VsyncWaiter::SecondaryCallback& callback) override;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Schedule a secondary callback to be executed at the next
+  ///             vsync.
+  ///
+  /// @see        `Animator::ScheduleSecondaryVsyncCallback`.
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
-                                      const fml::closure& callback) override;
+                                      const fml::closure& callback);
 
   //----------------------------------------------------------------------------
   /// @brief      Get the last Entrypoint that was used in the RunConfiguration
@@ -906,7 +935,8 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   std::string DefaultRouteName() override;
 
   // |RuntimeDelegate|
-  void Render(std::unique_ptr<flutter::LayerTree> layer_tree,
+  void Render(int64_t view_id,
+              std::unique_ptr<flutter::LayerTree> layer_tree,
               float device_pixel_ratio) override;
 
   // |RuntimeDelegate|
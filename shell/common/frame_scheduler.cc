@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace flutter {
+
+namespace {
+
+fml::TimeDelta GetPercentile(const std::deque<fml::TimeDelta>& durations,
+                             double percentile) {
+  std::vector<fml::TimeDelta> sorted(durations.begin(), durations.end());
+  auto nth = sorted.begin() + static_cast<size_t>(
+                                  percentile * (sorted.size() - 1) + 0.5);
+  std::nth_element(sorted.begin(), nth, sorted.end());
+  return *nth;
+}
+
+void AddSample(std::deque<fml::TimeDelta>& durations,
+               fml::TimeDelta duration) {
+  durations.push_back(duration);
+  if (durations.size() > FrameScheduler::kMaxSamples) {
+    durations.pop_front();
+  }
+}
+
+}  // namespace
+
+FrameScheduler::FrameScheduler() = default;
+
+FrameScheduler::~FrameScheduler() = default;
+
+void FrameScheduler::AddFrameTiming(const FrameTiming& timing) {
+  const auto build_duration = timing.Get(FrameTiming::kBuildFinish) -
+                              timing.Get(FrameTiming::kBuildStart);
+  const auto raster_duration = timing.Get(FrameTiming::kRasterFinish) -
+                               timing.Get(FrameTiming::kRasterStart);
+  std::scoped_lock lock(mutex_);
+  AddSample(build_durations_, build_duration);
+  AddSample(raster_durations_, raster_duration);
+}
+
+std::optional<FrameScheduler::Prediction> FrameScheduler::Predict() const {
+  std::scoped_lock lock(mutex_);
+  if (build_durations_.size() < kMinSamples) {
+    return std::nullopt;
+  }
+  return Prediction{
+      .build_duration = GetPercentile(build_durations_, kPercentile),
+      .raster_duration = GetPercentile(raster_durations_, kPercentile),
+  };
+}
+
+uint32_t FrameScheduler::GetPipelineDepth(fml::TimeDelta frame_interval,
+                                          uint32_t max_depth) const {
+  auto prediction = Predict();
+  if (!prediction.has_value() ||
+      prediction->build_duration + prediction->raster_duration >
+          frame_interval) {
+    return max_depth;
+  }
+  return 1u;
+}
+
+fml::TimeDelta FrameScheduler::GetBuildDelay(
+    fml::TimeDelta frame_interval) const {
+  auto prediction = Predict();
+  if (!prediction.has_value()) {
+    return fml::TimeDelta::Zero();
+  }
+  const auto margin = frame_interval / 4;
+  const auto slack = frame_interval - prediction->build_duration -
+                     prediction->raster_duration - margin;
+  return std::max(slack, fml::TimeDelta::Zero());
+}
+
+}  // namespace flutter
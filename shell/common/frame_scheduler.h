@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
+#define FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
+
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "flutter/common/settings.h"
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Predicts how long the next frame will take to build and to
+///             rasterize from the frames before it, and uses that to decide
+///             when the |Animator| starts building frames.
+///
+///             The prediction is a high percentile of the durations of the
+///             most recent frames, so that a frame only rarely takes longer
+///             than predicted.
+///
+///             Timings are added on the raster thread and the decisions are
+///             made on the UI thread.
+///
+class FrameScheduler {
+ public:
+  struct Prediction {
+    fml::TimeDelta build_duration;
+    fml::TimeDelta raster_duration;
+  };
+
+  /// The number of most recent frames the prediction is based on.
+  static constexpr size_t kMaxSamples = 60;
+
+  /// The number of frames needed before anything is predicted.
+  static constexpr size_t kMinSamples = 10;
+
+  /// The percentile of the recent durations that is predicted.
+  static constexpr double kPercentile = 0.9;
+
+  FrameScheduler();
+
+  ~FrameScheduler();
+
+  void AddFrameTiming(const FrameTiming& timing);
+
+  std::optional<Prediction> Predict() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      The number of frames to have in flight at most, between 1 and
+  ///             `max_depth`.
+  ///
+  ///             Frames are only pipelined, trading a frame of latency for
+  ///             throughput, when building and rasterizing a frame is not
+  ///             predicted to fit in a single frame interval.
+  ///
+  uint32_t GetPipelineDepth(fml::TimeDelta frame_interval,
+                            uint32_t max_depth) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      How long after the start of a frame interval to wait before
+  ///             building the frame.
+  ///
+  ///             Building a frame later makes it reflect more recent input,
+  ///             but delaying it is only safe when the frame is predicted to
+  ///             finish in time anyway. Part of the frame interval is always
+  ///             left as a margin for frames that take longer than predicted.
+  ///
+  fml::TimeDelta GetBuildDelay(fml::TimeDelta frame_interval) const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<fml::TimeDelta> build_durations_;
+  std::deque<fml::TimeDelta> raster_durations_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameScheduler);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_SCHEDULER_H_
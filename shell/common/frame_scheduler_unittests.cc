@@ -0,0 +1,102 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kFrameInterval =
+    fml::TimeDelta::FromMicroseconds(16667);
+
+FrameTiming CreateFrameTiming(fml::TimeDelta build_duration,
+                              fml::TimeDelta raster_duration) {
+  FrameTiming timing;
+  const auto vsync_start = fml::TimePoint::Now();
+  timing.Set(FrameTiming::kVsyncStart, vsync_start);
+  timing.Set(FrameTiming::kBuildStart, vsync_start);
+  timing.Set(FrameTiming::kBuildFinish, vsync_start + build_duration);
+  timing.Set(FrameTiming::kRasterStart, vsync_start + build_duration);
+  timing.Set(FrameTiming::kRasterFinish,
+             vsync_start + build_duration + raster_duration);
+  return timing;
+}
+
+void AddFrames(FrameScheduler& scheduler,
+               size_t count,
+               fml::TimeDelta build_duration,
+               fml::TimeDelta raster_duration) {
+  for (size_t i = 0; i < count; i++) {
+    scheduler.AddFrameTiming(
+        CreateFrameTiming(build_duration, raster_duration));
+  }
+}
+
+}  // namespace
+
+TEST(FrameSchedulerTest, DoesNotPredictWithoutEnoughFrames) {
+  FrameScheduler scheduler;
+  AddFrames(scheduler, FrameScheduler::kMinSamples - 1,
+            fml::TimeDelta::FromMilliseconds(2),
+            fml::TimeDelta::FromMilliseconds(2));
+
+  EXPECT_FALSE(scheduler.Predict().has_value());
+  EXPECT_EQ(scheduler.GetPipelineDepth(kFrameInterval, 2), 2u);
+  EXPECT_EQ(scheduler.GetBuildDelay(kFrameInterval), fml::TimeDelta::Zero());
+}
+
+TEST(FrameSchedulerTest, PredictsHighPercentileOfRecentFrames) {
+  FrameScheduler scheduler;
+  AddFrames(scheduler, 95, fml::TimeDelta::FromMilliseconds(2),
+            fml::TimeDelta::FromMilliseconds(3));
+  // A few slow frames are above the predicted percentile.
+  AddFrames(scheduler, 5, fml::TimeDelta::FromMilliseconds(20),
+            fml::TimeDelta::FromMilliseconds(30));
+
+  auto prediction = scheduler.Predict();
+  ASSERT_TRUE(prediction.has_value());
+  EXPECT_EQ(prediction->build_duration, fml::TimeDelta::FromMilliseconds(2));
+  EXPECT_EQ(prediction->raster_duration, fml::TimeDelta::FromMilliseconds(3));
+
+  // Only the most recent frames are taken into account.
+  AddFrames(scheduler, FrameScheduler::kMaxSamples,
+            fml::TimeDelta::FromMilliseconds(4),
+            fml::TimeDelta::FromMilliseconds(5));
+  prediction = scheduler.Predict();
+  ASSERT_TRUE(prediction.has_value());
+  EXPECT_EQ(prediction->build_duration, fml::TimeDelta::FromMilliseconds(4));
+  EXPECT_EQ(prediction->raster_duration, fml::TimeDelta::FromMilliseconds(5));
+}
+
+TEST(FrameSchedulerTest, DelaysCheapFramesWithoutPipelining) {
+  FrameScheduler scheduler;
+  AddFrames(scheduler, FrameScheduler::kMaxSamples,
+            fml::TimeDelta::FromMilliseconds(2),
+            fml::TimeDelta::FromMilliseconds(3));
+
+  EXPECT_EQ(scheduler.GetPipelineDepth(kFrameInterval, 2), 1u);
+  // The frame interval less the predicted frame time and a quarter of the
+  // interval as a margin.
+  EXPECT_EQ(scheduler.GetBuildDelay(kFrameInterval),
+            kFrameInterval - fml::TimeDelta::FromMilliseconds(5) -
+                kFrameInterval / 4);
+}
+
+TEST(FrameSchedulerTest, PipelinesExpensiveFramesWithoutDelay) {
+  FrameScheduler scheduler;
+  AddFrames(scheduler, FrameScheduler::kMaxSamples,
+            fml::TimeDelta::FromMilliseconds(10),
+            fml::TimeDelta::FromMilliseconds(10));
+
+  EXPECT_EQ(scheduler.GetPipelineDepth(kFrameInterval, 2), 2u);
+  EXPECT_EQ(scheduler.GetPipelineDepth(kFrameInterval, 1), 1u);
+  EXPECT_EQ(scheduler.GetBuildDelay(kFrameInterval), fml::TimeDelta::Zero());
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -4,14 +4,17 @@
 
 #include "flutter/common/graphics/persistent_cache.h"
 
+#include <cstring>
 #include <memory>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/graphics/persistent_cache_pack.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/fml/command_line.h"
 #include "flutter/fml/file.h"
 #include "flutter/fml/log_settings.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/unique_fd.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/switches.h"
@@ -200,5 +203,153 @@ TEST_F(PersistentCacheTest, PurgeAllowsFutureSkSLCache) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(PersistentCacheTest, StoresObjectsInASinglePack) {
+  sk_sp<SkData> key_1 = SkData::MakeWithCString("key_1");
+  sk_sp<SkData> value_1 = SkData::MakeWithCString("value_1");
+  sk_sp<SkData> key_2 = SkData::MakeWithCString("key_2");
+  sk_sp<SkData> value_2 = SkData::MakeWithCString("value_2");
+
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  // Without workers, the objects are stored synchronously.
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  StorePersistentCache(persistent_cache, *key_1, *value_1);
+  StorePersistentCache(persistent_cache, *key_2, *value_2);
+
+  auto cache_dir = fml::OpenDirectoryReadOnly(
+      base_dir.fd(),
+      fml::JoinPaths({"flutter_engine", GetFlutterEngineVersion(), "skia",
+                      GetSkiaVersion()})
+          .c_str());
+  ASSERT_TRUE(cache_dir.is_valid());
+  std::vector<std::string> filenames;
+  fml::VisitFiles(cache_dir, [&filenames](const fml::UniqueFD& directory,
+                                          const std::string& filename) {
+    filenames.push_back(filename);
+    return true;
+  });
+  ASSERT_EQ(filenames.size(), 1u);
+  ASSERT_EQ(filenames[0], PersistentCachePack::kFileName);
+
+  // A new cache for the process finds the objects in the pack.
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  CheckTextSkData(persistent_cache->load(*key_1), "value_1");
+  CheckTextSkData(persistent_cache->load(*key_2), "value_2");
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, MovesObjectsStoredInFilesIntoThePack) {
+  sk_sp<SkData> key = SkData::MakeWithCString("key");
+  sk_sp<SkData> value = SkData::MakeWithCString("value");
+  std::string filename = PersistentCache::SkKeyToFilePath(*key);
+
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  auto cache_dir = fml::CreateDirectory(
+      base_dir.fd(),
+      {"flutter_engine", GetFlutterEngineVersion(), "skia", GetSkiaVersion()},
+      fml::FilePermission::kReadWrite);
+  PersistentCache::SetCacheDirectoryPath(base_dir.path());
+  PersistentCache::ResetCacheForProcess();
+
+  // Store the object in its own file, as previous versions did.
+  auto object = PersistentCache::BuildCacheObject(*key, *value);
+  ASSERT_TRUE(fml::WriteAtomically(cache_dir, filename.c_str(), *object));
+
+  // Without workers, the object is moved synchronously when it is loaded.
+  auto persistent_cache = PersistentCache::GetCacheForProcess();
+  CheckTextSkData(persistent_cache->load(*key), "value");
+  ASSERT_FALSE(fml::OpenFileReadOnly(cache_dir, filename.c_str()).is_valid());
+
+  PersistentCache::ResetCacheForProcess();
+  persistent_cache = PersistentCache::GetCacheForProcess();
+  CheckTextSkData(persistent_cache->load(*key), "value");
+
+  // Cleanup
+  fml::RemoveFilesInDirectory(base_dir.fd());
+}
+
+TEST_F(PersistentCacheTest, PackDiscardsIncompleteRecords) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      base_dir.path().c_str(), false, fml::FilePermission::kReadWrite));
+
+  sk_sp<SkData> key_1 = SkData::MakeWithCString("key_1");
+  sk_sp<SkData> key_2 = SkData::MakeWithCString("key_2");
+  sk_sp<SkData> key_3 = SkData::MakeWithCString("key_3");
+  {
+    PersistentCachePack pack(directory, false);
+    ASSERT_TRUE(pack.Append(*key_1, *SkData::MakeWithCString("value_1")));
+    ASSERT_TRUE(pack.Append(*key_2, *SkData::MakeWithCString("value_2")));
+  }
+
+  // Corrupt the value of the last record, as a crash partway through writing
+  // it would.
+  {
+    auto file = fml::OpenFile(*directory, PersistentCachePack::kFileName,
+                              false, fml::FilePermission::kReadWrite);
+    fml::FileMapping mapping(file, {fml::FileMapping::Protection::kRead,
+                                    fml::FileMapping::Protection::kWrite});
+    ASSERT_TRUE(mapping.IsValid());
+    const size_t record_size = sizeof(PersistentCachePack::RecordHeader) +
+                               key_1->size() + strlen("value_1") + 1;
+    const size_t last_value_offset = sizeof(PersistentCachePack::FileHeader) +
+                                     record_size +
+                                     sizeof(PersistentCachePack::RecordHeader) +
+                                     key_2->size();
+    mapping.GetMutableMapping()[last_value_offset] = 'x';
+  }
+
+  {
+    PersistentCachePack pack(directory, false);
+    CheckTextSkData(pack.Find(*key_1), "value_1");
+    ASSERT_EQ(pack.Find(*key_2), nullptr);
+    ASSERT_TRUE(pack.Append(*key_3, *SkData::MakeWithCString("value_3")));
+  }
+
+  PersistentCachePack pack(directory, true);
+  ASSERT_EQ(pack.GetEntries().size(), 2u);
+  CheckTextSkData(pack.Find(*key_1), "value_1");
+  CheckTextSkData(pack.Find(*key_3), "value_3");
+}
+
+TEST_F(PersistentCacheTest, PackCompactionKeepsLatestValues) {
+  fml::ScopedTemporaryDirectory base_dir;
+  ASSERT_TRUE(base_dir.fd().is_valid());
+  auto directory = std::make_shared<fml::UniqueFD>(fml::OpenDirectory(
+      base_dir.path().c_str(), false, fml::FilePermission::kReadWrite));
+
+  PersistentCachePack pack(directory, false);
+  sk_sp<SkData> key = SkData::MakeWithCString("key");
+  sk_sp<SkData> other_key = SkData::MakeWithCString("other_key");
+  ASSERT_TRUE(pack.Append(*other_key, *SkData::MakeWithCString("other")));
+
+  std::vector<uint8_t> value(100 * 1024);
+  for (uint8_t i = 0; i < 8; i++) {
+    value[0] = i;
+    ASSERT_TRUE(
+        pack.Append(*key, *SkData::MakeWithCopy(value.data(), value.size())));
+  }
+  ASSERT_GT(pack.GetDeadBytes(), 0u);
+  ASSERT_TRUE(pack.NeedsCompaction());
+
+  ASSERT_TRUE(pack.Compact());
+  ASSERT_EQ(pack.GetDeadBytes(), 0u);
+  ASSERT_FALSE(pack.NeedsCompaction());
+  ASSERT_EQ(pack.GetEntries().size(), 2u);
+  CheckTextSkData(pack.Find(*other_key), "other");
+  auto latest = pack.Find(*key);
+  ASSERT_NE(latest, nullptr);
+  ASSERT_EQ(latest->size(), value.size());
+  ASSERT_EQ(latest->bytes()[0], 7u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -6,9 +6,12 @@
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
 #include <deque>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
+#include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/fml/macros.h"
@@ -32,6 +35,15 @@ enum class PipelineConsumeResult {
   MoreAvailable,
 };
 
+/// What |Pipeline::Produce| does when the pipeline is at its maximum depth.
+enum class PipelineOverflow {
+  /// Nothing can be produced until the consumer catches up.
+  kReject,
+  /// The produced resource replaces the oldest resource that is waiting to be
+  /// consumed, which is dropped.
+  kReplaceOldest,
+};
+
 size_t GetNextPipelineTraceID();
 
 /// A thread-safe queue of resources for a single consumer and a single
@@ -48,6 +60,14 @@ size_t GetNextPipelineTraceID();
 /// calls `Complete` on the continuation, which enqueues the resource and
 /// signals the waiting consumer.
 ///
+/// With |PipelineOverflow::kReplaceOldest|, a producer can still produce a
+/// resource when the pipeline is at its maximum depth. Completing it drops the
+/// oldest resource that is waiting to be consumed, so that the consumer always
+/// gets the latest resource without waiting for the stale ones. If no resource
+/// is waiting because the consumer is busy with the only one, the resource is
+/// kept as pending and takes the spot that the consumer frees, replacing any
+/// older pending resource.
+///
 /// Pipelines generate the following tracing information:
 /// * PipelineItem: async flow tracking time taken from the time a producer
 ///   calls |Produce| to the time a consumer consumes calls |Consume|.
@@ -124,21 +144,46 @@ class Pipeline {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+  /// Called with the resources that were dropped because a newer resource
+  /// replaced them. It is called on the producer's thread from
+  /// `ProducerContinuation::Complete`.
+  using DroppedCallback = std::function<void(ResourcePtr)>;
+
+  explicit Pipeline(uint32_t depth,
+                    PipelineOverflow overflow = PipelineOverflow::kReject,
+                    DroppedCallback dropped_callback = nullptr)
+      : depth_(depth),
+        overflow_(overflow),
+        dropped_callback_(std::move(dropped_callback)),
+        empty_(depth),
+        available_(0),
+        inflight_(0) {}
 
   ~Pipeline() = default;
 
   bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
 
+  /// The maximum number of resources in flight.
+  uint32_t GetDepth() const { return depth_; }
+
+  /// The number of resources that were reserved by |Produce| and not consumed
+  /// yet, including ones whose continuation wasn't completed.
+  int GetInFlightCount() const { return inflight_; }
+
+  PipelineOverflow GetOverflow() const { return overflow_; }
+
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
   ///
   /// If the queue is already at its maximum depth, the `ProducerContinuation`
-  /// is returned with success = false.
+  /// is returned with success = false, unless the pipeline replaces the
+  /// oldest resource on overflow.
   ProducerContinuation Produce() {
     if (!empty_.TryWait()) {
-      return {};
+      if (overflow_ != PipelineOverflow::kReplaceOldest) {
+        return {};
+      }
+      return ProduceReplacement();
     }
     ++inflight_;
     FML_TRACE_COUNTER("flutter", "Pipeline Depth",
@@ -152,6 +197,21 @@ class Pipeline {
         GetNextPipelineTraceID()};         // trace id
   }
 
+  /// Creates a `ProducerContinuation` that doesn't reserve a spot in the
+  /// pipeline. Completing it replaces the oldest resource that is waiting to
+  /// be consumed, or becomes the pending resource if the consumer is busy.
+  /// It only takes a free spot if the pipeline is idle.
+  ///
+  /// This lets a producer keep the number of resources in flight below the
+  /// maximum depth without skipping the latest resource.
+  ProducerContinuation ProduceReplacement() {
+    return ProducerContinuation{
+        std::bind(&Pipeline::ProducerReplaceOldest, this,
+                  std::placeholders::_1,
+                  std::placeholders::_2),  // continuation
+        GetNextPipelineTraceID()};         // trace id
+  }
+
   /// Creates a `ProducerContinuation` that will only push the task if the
   /// queue is empty.
   ///
@@ -194,12 +254,31 @@ class Pipeline {
       std::tie(resource, trace_id) = std::move(queue_.front());
       queue_.pop_front();
       items_count = queue_.size();
+      consuming_ = true;
     }
 
     consumer(std::move(resource));
 
-    empty_.Signal();
-    --inflight_;
+    bool took_pending = false;
+    {
+      std::scoped_lock lock(queue_mutex_);
+      consuming_ = false;
+      if (pending_.first) {
+        // The pending resource takes the freed spot.
+        queue_.push_back(std::move(pending_));
+        pending_ = {};
+        took_pending = true;
+      } else {
+        // Signaled with the lock held so that a replacement that finds no
+        // pending spot is certain to see it.
+        empty_.Signal();
+        --inflight_;
+      }
+    }
+    if (took_pending) {
+      available_.Signal();
+      items_count++;
+    }
 
     TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
     TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", trace_id);
@@ -209,11 +288,18 @@ class Pipeline {
   }
 
  private:
+  const uint32_t depth_;
+  const PipelineOverflow overflow_;
+  const DroppedCallback dropped_callback_;
   fml::Semaphore empty_;
   fml::Semaphore available_;
   std::atomic<int> inflight_;
   std::mutex queue_mutex_;
   std::deque<std::pair<ResourcePtr, size_t>> queue_;
+  // The resource that takes the spot of the resource being consumed, and
+  // whether a resource is being consumed.
+  std::pair<ResourcePtr, size_t> pending_;
+  bool consuming_ = false;
 
   /// Commits a produced resource to the queue and signals the consumer that a
   /// resource is available.
@@ -248,19 +334,90 @@ class Pipeline {
     return {.success = true, .is_first_item = true};
   }
 
+  /// Commits a resource produced without a reserved spot in place of the
+  /// oldest resource waiting to be consumed. If there is none, the resource
+  /// waits as the pending resource for the spot that the consumer frees, unless
+  /// the pipeline is idle and it can take a free spot right away.
+  PipelineProduceResult ProducerReplaceOldest(ResourcePtr resource,
+                                              size_t trace_id) {
+    if (!resource) {
+      // The continuation was dropped before being completed.
+      return {};
+    }
+
+    std::pair<ResourcePtr, size_t> replaced;
+    bool is_first_item = false;
+    {
+      std::scoped_lock lock(queue_mutex_);
+      if (!queue_.empty()) {
+        // The consumer has already been signaled for the replaced resource and
+        // takes the replacement instead.
+        replaced = std::move(queue_.front());
+        queue_.pop_front();
+        queue_.emplace_back(std::move(resource), trace_id);
+      } else if (consuming_ || !empty_.TryWait()) {
+        // The spot is freed when the resource being consumed, or the resource
+        // of a continuation that isn't completed yet, is consumed.
+        replaced = std::move(pending_);
+        pending_ = {std::move(resource), trace_id};
+      } else {
+        ++inflight_;
+        queue_.emplace_back(std::move(resource), trace_id);
+        is_first_item = true;
+      }
+    }
+
+    if (replaced.first) {
+      TRACE_FLOW_END("flutter", "PipelineItem", replaced.second);
+      TRACE_EVENT_ASYNC_END0("flutter", "PipelineItem", replaced.second);
+      Drop(std::move(replaced.first));
+    }
+    if (is_first_item) {
+      available_.Signal();
+    }
+    return {.success = true, .is_first_item = is_first_item};
+  }
+
+  void Drop(ResourcePtr resource) {
+    if (resource && dropped_callback_) {
+      dropped_callback_(std::move(resource));
+    }
+  }
+
   FML_DISALLOW_COPY_AND_ASSIGN(Pipeline);
 };
 
+/// The layer tree that a view renders in a frame.
+struct LayerTreeTask {
+  LayerTreeTask(int64_t view_id,
+                std::unique_ptr<LayerTree> layer_tree,
+                float device_pixel_ratio)
+      : view_id(view_id),
+        layer_tree(std::move(layer_tree)),
+        device_pixel_ratio(device_pixel_ratio) {}
+  int64_t view_id;
+  std::unique_ptr<LayerTree> layer_tree;
+  float device_pixel_ratio;
+};
+
+/// A frame, made of the layer trees of all the views rendered in it.
 struct LayerTreeItem {
+  LayerTreeItem(std::vector<std::unique_ptr<LayerTreeTask>> layer_tree_tasks,
+                std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder)
+      : layer_tree_tasks(std::move(layer_tree_tasks)),
+        frame_timings_recorder(std::move(frame_timings_recorder)) {}
+
+  /// A frame in which only the implicit view is rendered.
   LayerTreeItem(std::unique_ptr<LayerTree> layer_tree,
                 std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
                 float device_pixel_ratio)
-      : layer_tree(std::move(layer_tree)),
-        frame_timings_recorder(std::move(frame_timings_recorder)),
-        device_pixel_ratio(device_pixel_ratio) {}
-  std::unique_ptr<LayerTree> layer_tree;
+      : frame_timings_recorder(std::move(frame_timings_recorder)) {
+    layer_tree_tasks.push_back(std::make_unique<LayerTreeTask>(
+        kFlutterImplicitViewId, std::move(layer_tree), device_pixel_ratio));
+  }
+
+  std::vector<std::unique_ptr<LayerTreeTask>> layer_tree_tasks;
   std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder;
-  float device_pixel_ratio;
 };
 
 using LayerTreePipeline = Pipeline<LayerTreeItem>;
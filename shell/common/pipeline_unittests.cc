@@ -9,6 +9,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -144,5 +145,162 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, ReplaceOldestDropsWaitingItemWhenFull) {
+  const int depth = 1;
+  std::vector<int> dropped;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(
+      depth, PipelineOverflow::kReplaceOldest,
+      [&dropped](std::unique_ptr<int> v) { dropped.push_back(*v); });
+
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+
+  const int test_val_1 = 1, test_val_2 = 2;
+  PipelineProduceResult result =
+      continuation_1.Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, true);
+  result = continuation_2.Complete(std::make_unique<int>(test_val_2));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, false);
+  ASSERT_EQ(dropped, std::vector<int>{test_val_1});
+
+  PipelineConsumeResult consume_result = pipeline->Consume(
+      [&test_val_2](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_2); });
+  ASSERT_EQ(consume_result, PipelineConsumeResult::Done);
+  ASSERT_EQ(pipeline->GetInFlightCount(), 0);
+}
+
+TEST(PipelineTest, ReplaceOldestTakesFreedSpotIfConsumerCaughtUp) {
+  const int depth = 1;
+  std::vector<int> dropped;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(
+      depth, PipelineOverflow::kReplaceOldest,
+      [&dropped](std::unique_ptr<int> v) { dropped.push_back(*v); });
+
+  Continuation continuation_1 = pipeline->Produce();
+  const int test_val_1 = 1, test_val_2 = 2;
+  PipelineProduceResult result =
+      continuation_1.Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result.success, true);
+
+  Continuation continuation_2 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+
+  PipelineConsumeResult consume_result_1 = pipeline->Consume(
+      [&test_val_1](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_1); });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
+
+  result = continuation_2.Complete(std::make_unique<int>(test_val_2));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, true);
+  ASSERT_TRUE(dropped.empty());
+
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [&test_val_2](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_2); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+}
+
+TEST(PipelineTest, ReplaceOldestKeepsLatestItemWhileConsumerIsBusy) {
+  const int depth = 1;
+  std::vector<int> dropped;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(
+      depth, PipelineOverflow::kReplaceOldest,
+      [&dropped](std::unique_ptr<int> v) { dropped.push_back(*v); });
+
+  const int test_val_1 = 1, test_val_2 = 2, test_val_3 = 3;
+  Continuation continuation_1 = pipeline->Produce();
+  PipelineProduceResult result =
+      continuation_1.Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result.success, true);
+
+  // The items are produced while the consumer holds the only spot.
+  PipelineConsumeResult consume_result_1 =
+      pipeline->Consume([&](std::unique_ptr<int> v) {
+        ASSERT_EQ(*v, test_val_1);
+        Continuation continuation_2 = pipeline->Produce();
+        ASSERT_TRUE(continuation_2);
+        PipelineProduceResult result_2 =
+            continuation_2.Complete(std::make_unique<int>(test_val_2));
+        ASSERT_EQ(result_2.success, true);
+        ASSERT_EQ(result_2.is_first_item, false);
+
+        Continuation continuation_3 = pipeline->Produce();
+        PipelineProduceResult result_3 =
+            continuation_3.Complete(std::make_unique<int>(test_val_3));
+        ASSERT_EQ(result_3.success, true);
+        ASSERT_EQ(result_3.is_first_item, false);
+      });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(dropped, std::vector<int>{test_val_2});
+
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [&test_val_3](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_3); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+  ASSERT_EQ(pipeline->GetInFlightCount(), 0);
+}
+
+TEST(PipelineTest, ReplaceOldestWaitsForUncompletedContinuation) {
+  const int depth = 1;
+  std::vector<int> dropped;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(
+      depth, PipelineOverflow::kReplaceOldest,
+      [&dropped](std::unique_ptr<int> v) { dropped.push_back(*v); });
+
+  // The first continuation holds the only spot but isn't completed yet, so
+  // there is nothing to replace.
+  Continuation continuation_1 = pipeline->Produce();
+  Continuation continuation_2 = pipeline->Produce();
+
+  const int test_val_1 = 1, test_val_2 = 2;
+  PipelineProduceResult result =
+      continuation_2.Complete(std::make_unique<int>(test_val_2));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, false);
+  ASSERT_TRUE(dropped.empty());
+
+  result = continuation_1.Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, true);
+
+  PipelineConsumeResult consume_result_1 = pipeline->Consume(
+      [&test_val_1](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_1); });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::MoreAvailable);
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [&test_val_2](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_2); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+  ASSERT_EQ(pipeline->GetInFlightCount(), 0);
+}
+
+TEST(PipelineTest, ProduceReplacementDoesNotTakeSpotWhileConsumerIsBusy) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(
+      depth, PipelineOverflow::kReplaceOldest);
+
+  const int test_val_1 = 1, test_val_2 = 2;
+  Continuation continuation_1 = pipeline->Produce();
+  PipelineProduceResult result =
+      continuation_1.Complete(std::make_unique<int>(test_val_1));
+  ASSERT_EQ(result.success, true);
+
+  PipelineConsumeResult consume_result_1 =
+      pipeline->Consume([&](std::unique_ptr<int> v) {
+        ASSERT_EQ(*v, test_val_1);
+        Continuation continuation_2 = pipeline->ProduceReplacement();
+        PipelineProduceResult result_2 =
+            continuation_2.Complete(std::make_unique<int>(test_val_2));
+        ASSERT_EQ(result_2.success, true);
+        ASSERT_EQ(result_2.is_first_item, false);
+        ASSERT_EQ(pipeline->GetInFlightCount(), 1);
+      });
+  ASSERT_EQ(consume_result_1, PipelineConsumeResult::MoreAvailable);
+
+  PipelineConsumeResult consume_result_2 = pipeline->Consume(
+      [&test_val_2](std::unique_ptr<int> v) { ASSERT_EQ(*v, test_val_2); });
+  ASSERT_EQ(consume_result_2, PipelineConsumeResult::Done);
+  ASSERT_EQ(pipeline->GetInFlightCount(), 0);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -142,6 +142,10 @@ std::unique_ptr<Surface> PlatformView::CreateRenderingSurface() {
   return nullptr;
 }
 
+std::unique_ptr<Surface> PlatformView::CreateSurfaceForView(int64_t view_id) {
+  return nullptr;
+}
+
 std::shared_ptr<ExternalViewEmbedder>
 PlatformView::CreateExternalViewEmbedder() {
   FML_DLOG(WARNING)
@@ -476,6 +476,20 @@ class PlatformView {
   ///
   void SetViewportMetrics(const ViewportMetrics& metrics);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by the shell to obtain the rendering surface of a view
+  ///             added with |Shell::AddView|. Platforms that can't render into
+  ///             more than the implicit view don't override this method.
+  ///
+  /// @attention  This method is called on the raster task runner.
+  ///
+  /// @param[in]  view_id  The ID of the added view.
+  ///
+  /// @return     The rendering surface of the view, or nullptr if views can't
+  ///             be added on this platform.
+  ///
+  virtual std::unique_ptr<Surface> CreateSurfaceForView(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Used by embedders to notify the shell that a platform view
   ///             has been created. This notification is used to create a
@@ -4,10 +4,23 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
 
+namespace {
+
+// Whether later events of the same pointer can be coalesced into |data|.
+bool IsCoalescable(const PointerData& data) {
+  return (data.change == PointerData::Change::kMove ||
+          data.change == PointerData::Change::kHover) &&
+         data.signal_kind == PointerData::SignalKind::kNone;
+}
+
+}  // namespace
+
 PointerDataDispatcher::~PointerDataDispatcher() = default;
 DefaultPointerDataDispatcher::~DefaultPointerDataDispatcher() = default;
 
@@ -15,6 +28,14 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+BatchingPointerDataDispatcher::BatchingPointerDataDispatcher(
+    Delegate& delegate,
+    const Options& options)
+    : DefaultPointerDataDispatcher(delegate),
+      options_(options),
+      weak_factory_(this) {}
+BatchingPointerDataDispatcher::~BatchingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -46,8 +67,10 @@ void SmoothPointerDataDispatcher::DispatchPacket(
 
 void SmoothPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
   delegate_.ScheduleSecondaryVsyncCallback(
-      reinterpret_cast<uintptr_t>(this),
-      [dispatcher = weak_factory_.GetWeakPtr()]() {
+      reinterpret_cast<uintptr_t>(this), "SmoothPointerDataDispatcher",
+      VsyncWaiter::SecondaryCallbackPriority::kInput,
+      [dispatcher = weak_factory_.GetWeakPtr()](fml::TimePoint,
+                                                fml::TimePoint) {
         if (dispatcher && dispatcher->is_pointer_data_in_progress_) {
           if (dispatcher->pending_packet_ != nullptr) {
             dispatcher->DispatchPendingPacket();
@@ -68,4 +91,175 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+void BatchingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0("flutter", "BatchingPointerDataDispatcher::DispatchPacket");
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  for (size_t i = 0; i < packet->GetLength(); i++) {
+    AddPointerData(packet->GetPointerData(i));
+  }
+  received_count_ += packet->GetLength();
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+  ScheduleSecondaryVsyncCallback();
+}
+
+void BatchingPointerDataDispatcher::AddPointerData(const PointerData& data) {
+  const int64_t device = data.device;
+  const Sample sample = {
+      .time_stamp = data.time_stamp,
+      .physical_x = data.physical_x,
+      .physical_y = data.physical_y,
+  };
+  std::optional<Sample> previous;
+  if (auto last = last_samples_.find(device); last != last_samples_.end()) {
+    previous = last->second;
+  }
+  if (data.change == PointerData::Change::kRemove) {
+    last_samples_.erase(device);
+  } else {
+    last_samples_[device] = sample;
+  }
+
+  PointerData added = data;
+  if (auto held = held_moves_.find(device); held != held_moves_.end()) {
+    // Discrete events carry the position of the pointer, so only moves need
+    // to make up for the movement that wasn't delivered.
+    if (IsCoalescable(added)) {
+      added.physical_delta_x += held->second.physical_delta_x;
+      added.physical_delta_y += held->second.physical_delta_y;
+    }
+    held_moves_.erase(held);
+  }
+
+  auto open = open_moves_.find(device);
+  if (!IsCoalescable(added)) {
+    if (open != open_moves_.end()) {
+      open_moves_.erase(open);
+    }
+    pending_data_.push_back(added);
+    return;
+  }
+
+  if (open != open_moves_.end()) {
+    PointerData& coalesced = pending_data_[open->second.index];
+    if (coalesced.change == added.change &&
+        coalesced.buttons == added.buttons) {
+      added.physical_delta_x += coalesced.physical_delta_x;
+      added.physical_delta_y += coalesced.physical_delta_y;
+      coalesced = added;
+      open->second.previous = previous;
+      return;
+    }
+  }
+  open_moves_[device] = {.index = pending_data_.size(), .previous = previous};
+  pending_data_.push_back(added);
+}
+
+void BatchingPointerDataDispatcher::ResamplePendingData(
+    fml::TimePoint frame_start_time) {
+  const int64_t sample_time =
+      (frame_start_time + options_.sampling_offset).ToEpochDelta()
+          .ToMicroseconds();
+  for (const auto& [device, open] : open_moves_) {
+    if (!open.previous.has_value()) {
+      continue;
+    }
+    PointerData& data = pending_data_[open.index];
+    const Sample& previous = open.previous.value();
+    if (sample_time >= data.time_stamp ||
+        previous.time_stamp >= data.time_stamp) {
+      continue;
+    }
+    const double t =
+        std::max(sample_time - previous.time_stamp, static_cast<int64_t>(0)) /
+        static_cast<double>(data.time_stamp - previous.time_stamp);
+    const double x =
+        previous.physical_x + (data.physical_x - previous.physical_x) * t;
+    const double y =
+        previous.physical_y + (data.physical_y - previous.physical_y) * t;
+
+    PointerData held = data;
+    held.physical_delta_x = data.physical_x - x;
+    held.physical_delta_y = data.physical_y - y;
+    held_moves_[device] = held;
+
+    data.time_stamp = std::max(sample_time, previous.time_stamp);
+    data.physical_x = x;
+    data.physical_y = y;
+    data.physical_delta_x -= held.physical_delta_x;
+    data.physical_delta_y -= held.physical_delta_y;
+  }
+}
+
+void BatchingPointerDataDispatcher::DispatchPendingData(
+    fml::TimePoint frame_start_time) {
+  TRACE_EVENT0("flutter", "BatchingPointerDataDispatcher::DispatchPendingData");
+
+  // The devices that still have a move to deliver had no new events since the
+  // last VSYNC.
+  for (const auto& [device, held] : held_moves_) {
+    pending_data_.push_back(held);
+  }
+  held_moves_.clear();
+  if (options_.resample) {
+    ResamplePendingData(frame_start_time);
+  }
+  open_moves_.clear();
+
+  if (!pending_data_.empty()) {
+    uint64_t trace_flow_id;
+    if (pending_trace_flow_ids_.empty()) {
+      trace_flow_id = fml::tracing::TraceNonce();
+      TRACE_FLOW_BEGIN("flutter", "PointerEvent", trace_flow_id);
+    } else {
+      // The flows of the packets batched together end here, except for the
+      // last one that continues on to the framework.
+      trace_flow_id = pending_trace_flow_ids_.back();
+      pending_trace_flow_ids_.pop_back();
+      for (uint64_t batched_trace_flow_id : pending_trace_flow_ids_) {
+        TRACE_FLOW_END("flutter", "PointerEvent", batched_trace_flow_id);
+      }
+    }
+
+#if !FLUTTER_RELEASE
+    FML_TRACE_COUNTER("flutter", "PointerEventsPerFrame",
+                      reinterpret_cast<int64_t>(this), "Received",
+                      received_count_, "Dispatched", pending_data_.size());
+#endif  // !FLUTTER_RELEASE
+
+    auto packet = std::make_unique<PointerDataPacket>(pending_data_.size());
+    for (size_t i = 0; i < pending_data_.size(); i++) {
+      packet->SetPointerData(i, pending_data_[i]);
+    }
+    DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                                 trace_flow_id);
+  }
+  pending_data_.clear();
+  pending_trace_flow_ids_.clear();
+  received_count_ = 0;
+
+  if (!held_moves_.empty()) {
+    ScheduleSecondaryVsyncCallback();
+  }
+}
+
+void BatchingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  if (is_vsync_scheduled_) {
+    return;
+  }
+  is_vsync_scheduled_ = true;
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this), "BatchingPointerDataDispatcher",
+      VsyncWaiter::SecondaryCallbackPriority::kInput,
+      [dispatcher = weak_factory_.GetWeakPtr()](fml::TimePoint frame_start_time,
+                                                fml::TimePoint) {
+        if (dispatcher) {
+          dispatcher->is_vsync_scheduled_ = false;
+          dispatcher->DispatchPendingData(frame_start_time);
+        }
+      });
+}
+
 }  // namespace flutter
@@ -5,6 +5,10 @@
 #ifndef POINTER_DATA_DISPATCHER_H_
 #define POINTER_DATA_DISPATCHER_H_
 
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
 #include "flutter/runtime/runtime_controller.h"
 #include "flutter/shell/common/animator.h"
 
@@ -61,9 +65,15 @@ class PointerDataDispatcher {
     ///           This callback is used to provide the vsync signal needed by
     ///           `SmoothPointerDataDispatcher`, and for `Animator` input flow
     ///           events.
+    ///
+    ///           The callback is invoked with the timing of the vsync, in the
+    ///           order of its |priority| among the secondary callbacks of the
+    ///           vsync, and its delay is recorded for the subscriber |name|.
     virtual void ScheduleSecondaryVsyncCallback(
         uintptr_t id,
-        const fml::closure& callback) = 0;
+        const char* name,
+        VsyncWaiter::SecondaryCallbackPriority priority,
+        const VsyncWaiter::SecondaryCallback& callback) = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -163,6 +173,81 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that holds the pointer data it receives until the next VSYNC
+/// and then dispatches it in a single packet.
+///
+/// Between two VSYNCs, the move and hover events of each pointer are coalesced
+/// into one event with the latest position and the sum of the deltas, so input
+/// devices that report far more often than the display refreshes, such as
+/// 1000 Hz mice and pens, don't flood the framework with events it can't show.
+/// All other events (downs, ups, signals, pan/zoom events, ...) are kept, and
+/// moves are never coalesced across them. A packet hence holds at most one move
+/// or hover per pointer, plus one after each other event of that pointer.
+///
+/// With resampling, the position of the last coalesced move or hover of each
+/// pointer is interpolated between the two latest samples of the pointer at
+/// the VSYNC time plus `Options::sampling_offset`. The movement that is left is
+/// delivered at the next VSYNC, so the deltas still add up to the distance the
+/// pointer travelled. Resampling requires pointer data time stamps, in
+/// microseconds, to be on the clock of `fml::TimePoint`.
+class BatchingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  struct Options {
+    bool resample = false;
+
+    /// The offset from the VSYNC time at which positions are resampled. Events
+    /// are delivered around a frame after they happened, so a negative offset
+    /// keeps the sampling time between two samples rather than past the
+    /// latest one, where positions aren't extrapolated.
+    fml::TimeDelta sampling_offset = fml::TimeDelta::FromMilliseconds(-8);
+  };
+
+  BatchingPointerDataDispatcher(Delegate& delegate, const Options& options);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~BatchingPointerDataDispatcher();
+
+ private:
+  struct Sample {
+    int64_t time_stamp;
+    double physical_x;
+    double physical_y;
+  };
+
+  // A move or hover that later moves and hovers of the same pointer are
+  // coalesced into.
+  struct OpenMove {
+    size_t index;
+    // The sample of the pointer before the one of the move, if any.
+    std::optional<Sample> previous;
+  };
+
+  const Options options_;
+  std::vector<PointerData> pending_data_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  size_t received_count_ = 0;
+  // By device.
+  std::unordered_map<int64_t, OpenMove> open_moves_;
+  std::unordered_map<int64_t, Sample> last_samples_;
+  // The latest move or hover of the devices whose position was resampled, with
+  // the deltas that are left to deliver.
+  std::unordered_map<int64_t, PointerData> held_moves_;
+  bool is_vsync_scheduled_ = false;
+
+  void AddPointerData(const PointerData& data);
+  void ResamplePendingData(fml::TimePoint frame_start_time);
+  void DispatchPendingData(fml::TimePoint frame_start_time);
+  void ScheduleSecondaryVsyncCallback();
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<BatchingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(BatchingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
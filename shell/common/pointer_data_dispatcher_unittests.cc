@@ -0,0 +1,232 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pointer_data_dispatcher.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+class TestDelegate : public PointerDataDispatcher::Delegate {
+ public:
+  // |PointerDataDispatcher::Delegate|
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets.push_back(std::move(packet));
+  }
+
+  // |PointerDataDispatcher::Delegate|
+  void ScheduleSecondaryVsyncCallback(
+      uintptr_t id,
+      const char* name,
+      VsyncWaiter::SecondaryCallbackPriority priority,
+      const VsyncWaiter::SecondaryCallback& callback) override {
+    EXPECT_EQ(priority, VsyncWaiter::SecondaryCallbackPriority::kInput);
+    vsync_callback = callback;
+  }
+
+  void FireVsync(int64_t frame_start_time_micros) {
+    ASSERT_TRUE(vsync_callback);
+    auto callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    const auto frame_start_time = fml::TimePoint::FromEpochDelta(
+        fml::TimeDelta::FromMicroseconds(frame_start_time_micros));
+    callback(frame_start_time,
+             frame_start_time + fml::TimeDelta::FromMilliseconds(16));
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> packets;
+  VsyncWaiter::SecondaryCallback vsync_callback;
+};
+
+PointerData MakePointerData(PointerData::Change change,
+                            int64_t device,
+                            int64_t time_stamp,
+                            double x,
+                            double delta_x) {
+  PointerData data;
+  data.Clear();
+  data.change = change;
+  data.kind = PointerData::DeviceKind::kMouse;
+  data.device = device;
+  data.time_stamp = time_stamp;
+  data.physical_x = x;
+  data.physical_delta_x = delta_x;
+  return data;
+}
+
+void Dispatch(PointerDataDispatcher& dispatcher,
+              const std::vector<PointerData>& data) {
+  auto packet = std::make_unique<PointerDataPacket>(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    packet->SetPointerData(i, data[i]);
+  }
+  dispatcher.DispatchPacket(std::move(packet), 0);
+}
+
+std::vector<PointerData> GetPointerData(const PointerDataPacket& packet) {
+  std::vector<PointerData> data;
+  for (size_t i = 0; i < packet.GetLength(); i++) {
+    data.push_back(packet.GetPointerData(i));
+  }
+  return data;
+}
+
+using Change = PointerData::Change;
+
+}  // namespace
+
+TEST(BatchingPointerDataDispatcherTest, CoalescesMovesUntilVsync) {
+  TestDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate, {});
+
+  Dispatch(dispatcher, {MakePointerData(Change::kDown, 1, 0, 0, 0)});
+  // A 1000 Hz mouse reports 16 moves in a frame.
+  for (int i = 1; i <= 16; i++) {
+    Dispatch(dispatcher, {MakePointerData(Change::kMove, 1, i * 1000, i, 1)});
+  }
+  EXPECT_TRUE(delegate.packets.empty());
+
+  delegate.FireVsync(16000);
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  auto data = GetPointerData(*delegate.packets[0]);
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_EQ(data[0].change, Change::kDown);
+  EXPECT_EQ(data[1].change, Change::kMove);
+  EXPECT_EQ(data[1].time_stamp, 16000);
+  EXPECT_EQ(data[1].physical_x, 16);
+  EXPECT_EQ(data[1].physical_delta_x, 16);
+
+  // Nothing is left to dispatch.
+  EXPECT_FALSE(delegate.vsync_callback);
+}
+
+TEST(BatchingPointerDataDispatcherTest, KeepsEventsOtherThanMoves) {
+  TestDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate, {});
+
+  Dispatch(dispatcher, {
+                           MakePointerData(Change::kHover, 1, 1000, 1, 1),
+                           MakePointerData(Change::kHover, 1, 2000, 2, 1),
+                           MakePointerData(Change::kDown, 1, 3000, 2, 0),
+                           MakePointerData(Change::kMove, 1, 4000, 3, 1),
+                           MakePointerData(Change::kMove, 1, 5000, 4, 1),
+                           MakePointerData(Change::kUp, 1, 6000, 4, 0),
+                           MakePointerData(Change::kHover, 1, 7000, 5, 1),
+                       });
+  delegate.FireVsync(16000);
+
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  auto data = GetPointerData(*delegate.packets[0]);
+  ASSERT_EQ(data.size(), 5u);
+  EXPECT_EQ(data[0].change, Change::kHover);
+  EXPECT_EQ(data[0].physical_x, 2);
+  EXPECT_EQ(data[1].change, Change::kDown);
+  EXPECT_EQ(data[2].change, Change::kMove);
+  EXPECT_EQ(data[2].physical_x, 4);
+  EXPECT_EQ(data[2].physical_delta_x, 2);
+  EXPECT_EQ(data[3].change, Change::kUp);
+  EXPECT_EQ(data[4].change, Change::kHover);
+}
+
+TEST(BatchingPointerDataDispatcherTest, CoalescesEachPointerSeparately) {
+  TestDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate, {});
+
+  for (int i = 1; i <= 4; i++) {
+    const int64_t time = i * 1000;
+    Dispatch(dispatcher, {
+                             MakePointerData(Change::kMove, 1, time, i, 1),
+                             MakePointerData(Change::kMove, 2, time, -i, -1),
+                         });
+  }
+  delegate.FireVsync(16000);
+
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  auto data = GetPointerData(*delegate.packets[0]);
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_EQ(data[0].device, 1);
+  EXPECT_EQ(data[0].physical_x, 4);
+  EXPECT_EQ(data[1].device, 2);
+  EXPECT_EQ(data[1].physical_x, -4);
+}
+
+TEST(BatchingPointerDataDispatcherTest, ResamplesMovesToVsyncTime) {
+  TestDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(
+      delegate, {.resample = true, .sampling_offset = fml::TimeDelta()});
+
+  Dispatch(dispatcher, {
+                           MakePointerData(Change::kDown, 1, 0, 0, 0),
+                           MakePointerData(Change::kMove, 1, 10000, 10, 10),
+                           MakePointerData(Change::kMove, 1, 20000, 20, 10),
+                       });
+  delegate.FireVsync(15000);
+
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  auto data = GetPointerData(*delegate.packets[0]);
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_EQ(data[1].change, Change::kMove);
+  EXPECT_EQ(data[1].time_stamp, 15000);
+  EXPECT_DOUBLE_EQ(data[1].physical_x, 15);
+  EXPECT_DOUBLE_EQ(data[1].physical_delta_x, 15);
+
+  // The rest of the movement is delivered at the next vsync even if the
+  // pointer doesn't move anymore.
+  delegate.FireVsync(31000);
+  ASSERT_EQ(delegate.packets.size(), 2u);
+  data = GetPointerData(*delegate.packets[1]);
+  ASSERT_EQ(data.size(), 1u);
+  EXPECT_EQ(data[0].change, Change::kMove);
+  EXPECT_EQ(data[0].time_stamp, 20000);
+  EXPECT_DOUBLE_EQ(data[0].physical_x, 20);
+  EXPECT_DOUBLE_EQ(data[0].physical_delta_x, 5);
+  EXPECT_FALSE(delegate.vsync_callback);
+}
+
+TEST(BatchingPointerDataDispatcherTest, ResampledDeltasAddUpToTheDistance) {
+  TestDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(
+      delegate, {.resample = true, .sampling_offset = fml::TimeDelta()});
+
+  // The pointer moves at 1 pixel per millisecond, reported every 3
+  // milliseconds, and vsyncs happen every 16 milliseconds.
+  Dispatch(dispatcher, {MakePointerData(Change::kDown, 1, 0, 0, 0)});
+  int64_t vsync = 16000;
+  for (int64_t time = 3000; time <= 90000; time += 3000) {
+    if (time > vsync) {
+      delegate.FireVsync(vsync);
+      vsync += 16000;
+    }
+    const double x = time / 1000.0;
+    Dispatch(dispatcher, {MakePointerData(Change::kMove, 1, time, x, 3)});
+  }
+  Dispatch(dispatcher, {MakePointerData(Change::kUp, 1, 90000, 90, 0)});
+  delegate.FireVsync(vsync);
+
+  double delta_x = 0;
+  double last_x = 0;
+  for (const auto& packet : delegate.packets) {
+    for (const auto& data : GetPointerData(*packet)) {
+      delta_x += data.physical_delta_x;
+      if (data.change == Change::kMove) {
+        EXPECT_GE(data.physical_x, last_x);
+        last_x = data.physical_x;
+      }
+    }
+  }
+  EXPECT_DOUBLE_EQ(delta_x, 90);
+  EXPECT_DOUBLE_EQ(last_x, 90);
+  // One packet per vsync.
+  EXPECT_EQ(delegate.packets.size(), 6u);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "flow/frame_timings.h"
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/fml/time/time_delta.h"
@@ -21,6 +22,7 @@
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkSerialProcs.h"
 #include "third_party/skia/include/core/SkSize.h"
@@ -36,6 +38,10 @@ namespace flutter {
 // used within this interval.
 static constexpr std::chrono::milliseconds kSkiaCleanupExpiration(15000);
 
+// How often the resource cache controller samples the caches.
+static constexpr fml::TimeDelta kResourceCacheAdjustmentInterval =
+    fml::TimeDelta::FromSeconds(1);
+
 Rasterizer::Rasterizer(Delegate& delegate,
                        MakeGpuImageBehavior gpu_image_behavior)
     : delegate_(delegate),
@@ -104,6 +110,8 @@ void Rasterizer::TeardownExternalViewEmbedder() {
 }
 
 void Rasterizer::Teardown() {
+  view_records_.clear();
+
   if (surface_) {
     auto context_switch = surface_->MakeRenderContextCurrent();
     if (context_switch->GetResult()) {
@@ -115,8 +123,6 @@ void Rasterizer::Teardown() {
     surface_.reset();
   }
 
-  last_layer_tree_.reset();
-
   if (raster_thread_merger_.get() != nullptr &&
       raster_thread_merger_.get()->IsMerged()) {
     FML_DCHECK(raster_thread_merger_->IsEnabled());
@@ -125,6 +131,24 @@ void Rasterizer::Teardown() {
   }
 }
 
+void Rasterizer::AddSurface(int64_t view_id, std::unique_ptr<Surface> surface) {
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+  view_records_[view_id].surface = std::move(surface);
+}
+
+void Rasterizer::RemoveSurface(int64_t view_id) {
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+  view_records_.erase(view_id);
+}
+
+Surface* Rasterizer::GetSurfaceForView(int64_t view_id) const {
+  if (view_id == kFlutterImplicitViewId) {
+    return surface_.get();
+  }
+  auto found = view_records_.find(view_id);
+  return found == view_records_.end() ? nullptr : found->second.surface.get();
+}
+
 void Rasterizer::EnableThreadMergerIfNeeded() {
   if (raster_thread_merger_) {
     raster_thread_merger_->Enable();
@@ -165,16 +189,32 @@ GrDirectContext* Rasterizer::GetGrContext() {
 }
 
 flutter::LayerTree* Rasterizer::GetLastLayerTree() {
-  return last_layer_tree_.get();
+  auto found = view_records_.find(kFlutterImplicitViewId);
+  return found == view_records_.end() ? nullptr
+                                      : found->second.last_layer_tree.get();
 }
 
 void Rasterizer::DrawLastLayerTree(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) {
-  if (!last_layer_tree_ || !surface_) {
+  if (!surface_) {
     return;
   }
-  RasterStatus raster_status = DrawToSurface(
-      *frame_timings_recorder, *last_layer_tree_, last_device_pixel_ratio_);
+  std::vector<std::unique_ptr<LayerTreeTask>> tasks;
+  for (auto& [view_id, view_record] : view_records_) {
+    if (view_record.last_layer_tree) {
+      tasks.push_back(std::make_unique<LayerTreeTask>(
+          view_id, std::move(view_record.last_layer_tree),
+          view_record.last_device_pixel_ratio));
+    }
+  }
+  if (tasks.empty()) {
+    return;
+  }
+  RasterStatus raster_status = DrawToSurfaces(*frame_timings_recorder, tasks);
+  // The layer trees that couldn't be drawn are still the last ones.
+  for (auto& task : tasks) {
+    view_records_[task->view_id].last_layer_tree = std::move(task->layer_tree);
+  }
 
   // EndFrame should perform cleanups for the external_view_embedder.
   if (external_view_embedder_ && external_view_embedder_->GetUsedThisFrame()) {
@@ -201,15 +241,17 @@ RasterStatus Rasterizer::Draw(
   RasterStatus raster_status = RasterStatus::kFailed;
   LayerTreePipeline::Consumer consumer =
       [&](std::unique_ptr<LayerTreeItem> item) {
-        std::unique_ptr<LayerTree> layer_tree = std::move(item->layer_tree);
-        std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder =
-            std::move(item->frame_timings_recorder);
-        float device_pixel_ratio = item->device_pixel_ratio;
-        if (discard_callback(*layer_tree.get())) {
+        std::vector<std::unique_ptr<LayerTreeTask>> tasks;
+        for (auto& task : item->layer_tree_tasks) {
+          if (!discard_callback(task->view_id, *task->layer_tree)) {
+            tasks.push_back(std::move(task));
+          }
+        }
+        if (tasks.empty()) {
           raster_status = RasterStatus::kDiscarded;
         } else {
-          raster_status = DoDraw(std::move(frame_timings_recorder),
-                                 std::move(layer_tree), device_pixel_ratio);
+          raster_status = DoDraw(std::move(item->frame_timings_recorder),
+                                 std::move(tasks));
         }
       };
 
@@ -223,8 +265,8 @@ RasterStatus Rasterizer::Draw(
   bool should_resubmit_frame = ShouldResubmitFrame(raster_status);
   if (should_resubmit_frame) {
     auto resubmitted_layer_tree_item = std::make_unique<LayerTreeItem>(
-        std::move(resubmitted_layer_tree_), std::move(resubmitted_recorder_),
-        resubmitted_pixel_ratio_);
+        std::move(resubmitted_tasks_), std::move(resubmitted_recorder_));
+    resubmitted_tasks_.clear();
     auto front_continuation = pipeline->ProduceIfEmpty();
     PipelineProduceResult result =
         front_continuation.Complete(std::move(resubmitted_layer_tree_item));
@@ -383,15 +425,14 @@ fml::Milliseconds Rasterizer::GetFrameBudget() const {
 
 RasterStatus Rasterizer::DoDraw(
     std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
-    std::unique_ptr<flutter::LayerTree> layer_tree,
-    float device_pixel_ratio) {
+    std::vector<std::unique_ptr<LayerTreeTask>> tasks) {
   TRACE_EVENT_WITH_FRAME_NUMBER(frame_timings_recorder, "flutter",
                                 "Rasterizer::DoDraw");
   FML_DCHECK(delegate_.GetTaskRunners()
                  .GetRasterTaskRunner()
                  ->RunsTasksOnCurrentThread());
 
-  if (!layer_tree || !surface_) {
+  if (tasks.empty() || !surface_) {
     return RasterStatus::kFailed;
   }
 
@@ -399,13 +440,10 @@ RasterStatus Rasterizer::DoDraw(
   persistent_cache->ResetStoredNewShaders();
 
   RasterStatus raster_status =
-      DrawToSurface(*frame_timings_recorder, *layer_tree, device_pixel_ratio);
-  if (raster_status == RasterStatus::kSuccess) {
-    last_layer_tree_ = std::move(layer_tree);
-    last_device_pixel_ratio_ = device_pixel_ratio;
-  } else if (ShouldResubmitFrame(raster_status)) {
-    resubmitted_pixel_ratio_ = device_pixel_ratio;
-    resubmitted_layer_tree_ = std::move(layer_tree);
+      DrawToSurfaces(*frame_timings_recorder, tasks);
+  if (ShouldResubmitFrame(raster_status)) {
+    // Only the layer trees that weren't rasterized are left.
+    resubmitted_tasks_ = std::move(tasks);
     resubmitted_recorder_ = frame_timings_recorder->CloneUntil(
         FrameTimingsRecorder::State::kBuildEnd);
     return raster_status;
@@ -424,6 +462,7 @@ RasterStatus Rasterizer::DoDraw(
   // Rasterizer::DoDraw finishes. Future work is needed to adapt the timestamp
   // for Fuchsia to capture SceneUpdateContext::ExecutePaintTasks.
   delegate_.OnFrameRasterized(frame_timings_recorder->GetRecordedTime());
+  AdjustResourceCaches();
 
 // SceneDisplayLag events are disabled on Fuchsia.
 // see: https://github.com/flutter/flutter/issues/56598
@@ -485,24 +524,22 @@ RasterStatus Rasterizer::DoDraw(
   return raster_status;
 }
 
-RasterStatus Rasterizer::DrawToSurface(
+RasterStatus Rasterizer::DrawToSurfaces(
     FrameTimingsRecorder& frame_timings_recorder,
-    flutter::LayerTree& layer_tree,
-    float device_pixel_ratio) {
-  TRACE_EVENT0("flutter", "Rasterizer::DrawToSurface");
+    std::vector<std::unique_ptr<LayerTreeTask>>& tasks) {
+  TRACE_EVENT0("flutter", "Rasterizer::DrawToSurfaces");
   FML_DCHECK(surface_);
 
   RasterStatus raster_status;
   if (surface_->AllowsDrawingWhenGpuDisabled()) {
-    raster_status = DrawToSurfaceUnsafe(frame_timings_recorder, layer_tree,
-                                        device_pixel_ratio);
+    raster_status = DrawToSurfacesUnsafe(frame_timings_recorder, tasks);
   } else {
     delegate_.GetIsGpuDisabledSyncSwitch()->Execute(
         fml::SyncSwitch::Handlers()
             .SetIfTrue([&] { raster_status = RasterStatus::kDiscarded; })
             .SetIfFalse([&] {
-              raster_status = DrawToSurfaceUnsafe(
-                  frame_timings_recorder, layer_tree, device_pixel_ratio);
+              raster_status =
+                  DrawToSurfacesUnsafe(frame_timings_recorder, tasks);
             }));
   }
 
@@ -511,36 +548,105 @@ RasterStatus Rasterizer::DrawToSurface(
 
 /// Unsafe because it assumes we have access to the GPU which isn't the case
 /// when iOS is backgrounded, for example.
-/// \see Rasterizer::DrawToSurface
-RasterStatus Rasterizer::DrawToSurfaceUnsafe(
+/// \see Rasterizer::DrawToSurfaces
+RasterStatus Rasterizer::DrawToSurfacesUnsafe(
     FrameTimingsRecorder& frame_timings_recorder,
-    flutter::LayerTree& layer_tree,
-    float device_pixel_ratio) {
+    std::vector<std::unique_ptr<LayerTreeTask>>& tasks) {
   FML_DCHECK(surface_);
 
   compositor_context_->ui_time().SetLapTime(
       frame_timings_recorder.GetBuildDuration());
 
+  frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
+
+  // All views share the raster cache, so that it is only swept once every view
+  // of the frame has been prerolled.
+  compositor_context_->raster_cache().BeginFrame(tasks.size());
+
+  // The raster time covers every view of the frame, so the compositor frames
+  // of the views are acquired without instrumentation.
+  compositor_context_->raster_time().Start();
+
+  // A frame is resubmitted if any of its views needs to be, and succeeds if
+  // any of its views was rasterized otherwise.
+  RasterStatus raster_status = RasterStatus::kFailed;
+  bool any_view_rasterized = false;
+  bool any_frame_submitted = false;
+  for (auto& task : tasks) {
+    const RasterStatus view_status =
+        DrawToSurfaceUnsafe(frame_timings_recorder, task->view_id,
+                            *task->layer_tree, task->device_pixel_ratio);
+    if (ShouldResubmitFrame(view_status) ||
+        (view_status == RasterStatus::kSuccess &&
+         !ShouldResubmitFrame(raster_status))) {
+      raster_status = view_status;
+    }
+    if (view_status == RasterStatus::kSuccess ||
+        view_status == RasterStatus::kResubmit) {
+      any_frame_submitted = true;
+    }
+    if (view_status == RasterStatus::kSuccess) {
+      any_view_rasterized = true;
+      ViewRecord& view_record = view_records_[task->view_id];
+      view_record.last_layer_tree = std::move(task->layer_tree);
+      view_record.last_device_pixel_ratio = task->device_pixel_ratio;
+      task.reset();
+    }
+  }
+  tasks.erase(std::remove(tasks.begin(), tasks.end(), nullptr), tasks.end());
+
+  compositor_context_->raster_time().Stop();
+
+  // Do not update raster cache metrics if no view was actually painted.
+  if (any_view_rasterized) {
+    compositor_context_->raster_cache().EndFrame();
+  }
+
+  frame_timings_recorder.RecordRasterEnd(&compositor_context_->raster_cache());
+
+  if (any_frame_submitted) {
+    FireNextFrameCallbackIfPresent();
+
+    if (surface_->GetContext()) {
+      surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
+    }
+  }
+
+  return raster_status;
+}
+
+RasterStatus Rasterizer::DrawToSurfaceUnsafe(
+    FrameTimingsRecorder& frame_timings_recorder,
+    int64_t view_id,
+    flutter::LayerTree& layer_tree,
+    float device_pixel_ratio) {
+  Surface* surface = GetSurfaceForView(view_id);
+  if (!surface) {
+    // The view was removed after the frame was built.
+    return RasterStatus::kFailed;
+  }
+
+  // Platform views can only be embedded in the implicit view.
+  ExternalViewEmbedder* external_view_embedder =
+      view_id == kFlutterImplicitViewId ? external_view_embedder_.get()
+                                        : nullptr;
+
   DlCanvas* embedder_root_canvas = nullptr;
-  if (external_view_embedder_) {
-    FML_DCHECK(!external_view_embedder_->GetUsedThisFrame());
-    external_view_embedder_->SetUsedThisFrame(true);
-    external_view_embedder_->BeginFrame(
-        layer_tree.frame_size(), surface_->GetContext(), device_pixel_ratio,
+  if (external_view_embedder) {
+    FML_DCHECK(!external_view_embedder->GetUsedThisFrame());
+    external_view_embedder->SetUsedThisFrame(true);
+    external_view_embedder->BeginFrame(
+        layer_tree.frame_size(), surface->GetContext(), device_pixel_ratio,
         raster_thread_merger_);
-    embedder_root_canvas = external_view_embedder_->GetRootCanvas();
+    embedder_root_canvas = external_view_embedder->GetRootCanvas();
   }
 
-  frame_timings_recorder.RecordRasterStart(fml::TimePoint::Now());
-
   // On Android, the external view embedder deletes surfaces in `BeginFrame`.
   //
   // Deleting a surface also clears the GL context. Therefore, acquire the
   // frame after calling `BeginFrame` as this operation resets the GL context.
-  auto frame = surface_->AcquireFrame(layer_tree.frame_size());
+  auto frame = surface->AcquireFrame(layer_tree.frame_size());
   if (frame == nullptr) {
-    frame_timings_recorder.RecordRasterEnd(
-        &compositor_context_->raster_cache());
     return RasterStatus::kFailed;
   }
 
@@ -548,26 +654,24 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
   // root surface transformation is set by the embedder instead of
   // having to apply it here.
   SkMatrix root_surface_transformation =
-      embedder_root_canvas ? SkMatrix{} : surface_->GetRootTransformation();
+      embedder_root_canvas ? SkMatrix{} : surface->GetRootTransformation();
 
   auto root_surface_canvas =
       embedder_root_canvas ? embedder_root_canvas : frame->Canvas();
 
   auto compositor_frame = compositor_context_->AcquireFrame(
-      surface_->GetContext(),         // skia GrContext
+      surface->GetContext(),          // skia GrContext
       root_surface_canvas,            // root surface canvas
-      external_view_embedder_.get(),  // external view embedder
+      external_view_embedder,         // external view embedder
       root_surface_transformation,    // root surface transformation
-      true,                           // instrumentation enabled
+      false,                          // instrumentation enabled
       frame->framebuffer_info()
           .supports_readback,                // surface supports pixel reads
       raster_thread_merger_,                 // thread merger
       frame->GetDisplayListBuilder().get(),  // display list builder
-      surface_->GetAiksContext().get()       // aiks context
+      surface->GetAiksContext().get()        // aiks context
   );
   if (compositor_frame) {
-    compositor_context_->raster_cache().BeginFrame();
-
     std::unique_ptr<FrameDamage> damage;
     // when leaf layer tracing is enabled we wish to repaint the whole frame
     // for accurate performance metrics.
@@ -578,13 +682,17 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
       // surface and also partial repaint with platform view present is
       // something that still need to be figured out.
       bool force_full_repaint =
-          external_view_embedder_ &&
+          external_view_embedder &&
           (!raster_thread_merger_ || raster_thread_merger_->IsMerged());
 
       damage = std::make_unique<FrameDamage>();
       auto existing_damage = frame->framebuffer_info().existing_damage;
       if (existing_damage.has_value() && !force_full_repaint) {
-        damage->SetPreviousLayerTree(last_layer_tree_.get());
+        auto view_record = view_records_.find(view_id);
+        damage->SetPreviousLayerTree(
+            view_record == view_records_.end()
+                ? nullptr
+                : view_record->second.last_layer_tree.get());
         damage->AddAdditionalDamage(existing_damage.value());
         damage->SetClipAlignment(
             frame->framebuffer_info().horizontal_clip_alignment,
@@ -593,7 +701,7 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
     }
 
     bool ignore_raster_cache = true;
-    if (surface_->EnableRasterCache() &&
+    if (surface->EnableRasterCache() &&
         !layer_tree.is_leaf_layer_tracing_enabled()) {
       ignore_raster_cache = false;
     }
@@ -624,29 +732,15 @@ RasterStatus Rasterizer::DrawToSurfaceUnsafe(
 
     frame->set_submit_info(submit_info);
 
-    if (external_view_embedder_ &&
+    if (external_view_embedder &&
         (!raster_thread_merger_ || raster_thread_merger_->IsMerged())) {
       FML_DCHECK(!frame->IsSubmitted());
-      external_view_embedder_->SubmitFrame(
-          surface_->GetContext(), surface_->GetAiksContext(), std::move(frame));
+      external_view_embedder->SubmitFrame(
+          surface->GetContext(), surface->GetAiksContext(), std::move(frame));
     } else {
       frame->Submit();
     }
 
-    // Do not update raster cache metrics for kResubmit because that status
-    // indicates that the frame was not actually painted.
-    if (raster_status != RasterStatus::kResubmit) {
-      compositor_context_->raster_cache().EndFrame();
-    }
-
-    frame_timings_recorder.RecordRasterEnd(
-        &compositor_context_->raster_cache());
-    FireNextFrameCallbackIfPresent();
-
-    if (surface_->GetContext()) {
-      surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
-    }
-
     return raster_status;
   }
 
@@ -788,6 +882,50 @@ Rasterizer::Screenshot Rasterizer::ScreenshotLastLayerTree(
   return Rasterizer::Screenshot{data, layer_tree->frame_size(), format};
 }
 
+void Rasterizer::ScreenshotLastLayerTreeAsync(
+    const ScreenshotEncodingOptions& options,
+    const std::shared_ptr<fml::ConcurrentTaskRunner>& encode_task_runner,
+    const ScreenshotCallback& callback) {
+  TRACE_EVENT0("flutter", "Rasterizer::ScreenshotLastLayerTreeAsync");
+  sk_sp<SkData> pixels;
+  SkISize frame_size = SkISize::MakeEmpty();
+  auto* layer_tree = GetLastLayerTree();
+  if (layer_tree == nullptr) {
+    FML_LOG(ERROR) << "Last layer tree was null when screenshotting.";
+  } else {
+    frame_size = layer_tree->frame_size();
+    // Only the read back has to happen on the raster thread.
+    pixels = ScreenshotLayerTreeAsImage(
+        layer_tree, *compositor_context_,
+        surface_ ? surface_->GetContext() : nullptr, false);
+  }
+
+  encode_task_runner->PostTask([pixels = std::move(pixels), frame_size,
+                                options, callback]() {
+    const auto info = SkImageInfo::MakeN32Premul(frame_size);
+    if (!pixels || frame_size.isEmpty() ||
+        pixels->size() < info.computeMinByteSize()) {
+      FML_LOG(ERROR) << "Screenshot data was null.";
+      callback({});
+      return;
+    }
+    // The read back pixels are already in the raw format.
+    sk_sp<SkData> data =
+        options.encoding == ScreenshotEncoding::kRaw && !options.base64_encode
+            ? pixels
+            : EncodeScreenshot(
+                  SkPixmap(info, pixels->data(),
+                           pixels->size() / frame_size.height()),
+                  options);
+    if (!data) {
+      callback({});
+      return;
+    }
+    callback(Rasterizer::Screenshot{
+        data, frame_size, GetScreenshotEncodingFormat(options.encoding)});
+  });
+}
+
 void Rasterizer::SetNextFrameCallback(const fml::closure& callback) {
   next_frame_callback_ = callback;
 }
@@ -826,6 +964,19 @@ void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   }
 
   max_cache_bytes_ = max_bytes;
+  if (resource_cache_controller_) {
+    // The images of the raster cache are held by the resource cache, so they
+    // can't usefully take more than all of it.
+    resource_cache_controller_->SetBaseline({
+        .resource_cache_bytes = max_bytes,
+        .raster_cache_bytes = max_bytes,
+    });
+    const auto limits = resource_cache_controller_->GetLimits();
+    compositor_context_->raster_cache().SetMaxBytes(limits.raster_cache_bytes);
+    if (!user_override_resource_cache_bytes_) {
+      max_bytes = limits.resource_cache_bytes;
+    }
+  }
   if (!surface_) {
     return;
   }
@@ -852,6 +1003,89 @@ std::optional<size_t> Rasterizer::GetResourceCacheMaxBytes() const {
   return std::nullopt;
 }
 
+void Rasterizer::SetResourceCacheController(
+    std::unique_ptr<ResourceCacheController> controller) {
+  const bool was_sampling = resource_cache_controller_ != nullptr;
+  resource_cache_controller_ = std::move(controller);
+  if (resource_cache_controller_ && max_cache_bytes_.has_value()) {
+    SetResourceCacheMaxBytes(max_cache_bytes_.value(),
+                             user_override_resource_cache_bytes_);
+  }
+  if (resource_cache_controller_ && !was_sampling) {
+    ScheduleResourceCacheAdjustment();
+  }
+}
+
+void Rasterizer::ScheduleResourceCacheAdjustment() {
+  // Memory pressure also has to be noticed while no frames are rasterized.
+  delegate_.GetTaskRunners().GetRasterTaskRunner()->PostDelayedTask(
+      [weak_this = weak_factory_.GetWeakPtr()]() {
+        if (!weak_this || !weak_this->resource_cache_controller_) {
+          return;
+        }
+        weak_this->AdjustResourceCaches();
+        weak_this->ScheduleResourceCacheAdjustment();
+      },
+      kResourceCacheAdjustmentInterval);
+}
+
+void Rasterizer::AdjustResourceCaches() {
+  // There is nothing to adjust until the baseline limits are known.
+  if (!resource_cache_controller_ || !max_cache_bytes_.has_value()) {
+    return;
+  }
+  const auto now = fml::TimePoint::Now();
+  if (now - last_resource_cache_adjustment_time_ <
+      kResourceCacheAdjustmentInterval) {
+    return;
+  }
+  last_resource_cache_adjustment_time_ = now;
+  TRACE_EVENT0("flutter", "Rasterizer::AdjustResourceCaches");
+
+  auto sample = ResourceCacheController::SampleProcessMemory();
+  GrDirectContext* context = surface_ ? surface_->GetContext() : nullptr;
+  if (context) {
+    int resource_count = 0;
+    context->getResourceCacheUsage(&resource_count,
+                                   &sample.resource_cache_bytes);
+    sample.resource_cache_purgeable_bytes =
+        context->getResourceCachePurgeableBytes();
+  }
+  RasterCache& raster_cache = compositor_context_->raster_cache();
+  sample.raster_cache_hits =
+      raster_cache.hit_count() - last_raster_cache_hit_count_;
+  sample.raster_cache_misses =
+      raster_cache.budget_miss_count() - last_raster_cache_miss_count_;
+  last_raster_cache_hit_count_ = raster_cache.hit_count();
+  last_raster_cache_miss_count_ = raster_cache.budget_miss_count();
+
+  const auto adjustment = resource_cache_controller_->Update(sample);
+  if (adjustment.purge) {
+    raster_cache.Clear();
+    NotifyLowMemoryWarning();
+    delegate_.OnCriticalMemoryPressure();
+  }
+  raster_cache.SetMaxBytes(adjustment.limits.raster_cache_bytes);
+  if (context && !user_override_resource_cache_bytes_ &&
+      context->getResourceCacheLimit() !=
+          adjustment.limits.resource_cache_bytes) {
+    auto context_switch = surface_->MakeRenderContextCurrent();
+    if (context_switch->GetResult()) {
+      context->setResourceCacheLimit(adjustment.limits.resource_cache_bytes);
+    }
+  }
+
+#if !FLUTTER_RELEASE
+  const auto& limits = adjustment.limits;
+  FML_TRACE_COUNTER(
+      "flutter",                                               //
+      "ResourceCacheLimits", reinterpret_cast<int64_t>(this),  //
+      "ResourceCacheMBytes",                                   //
+      limits.resource_cache_bytes / kMegaByteSizeInBytes,      //
+      "RasterCacheMBytes", limits.raster_cache_bytes / kMegaByteSizeInBytes);
+#endif  // !FLUTTER_RELEASE
+}
+
 Rasterizer::Screenshot::Screenshot() {}
 
 Rasterizer::Screenshot::Screenshot(sk_sp<SkData> p_data,
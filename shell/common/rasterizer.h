@@ -5,8 +5,11 @@
 #ifndef SHELL_COMMON_RASTERIZER_H_
 #define SHELL_COMMON_RASTERIZER_H_
 
+#include <functional>
 #include <memory>
 #include <optional>
+#include <unordered_map>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
@@ -17,6 +20,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -30,6 +34,8 @@
 #endif                                           // IMPELLER_SUPPORTS_RENDERING
 #include "flutter/lib/ui/snapshot_delegate.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/resource_cache_controller.h"
+#include "flutter/shell/common/screenshot_encoder.h"
 #include "flutter/shell/common/snapshot_controller.h"
 #include "flutter/shell/common/snapshot_surface_producer.h"
 #include "third_party/skia/include/core/SkData.h"
@@ -118,6 +124,11 @@ class Rasterizer final : public SnapshotDelegate,
         const = 0;
 
     virtual const Settings& GetSettings() const = 0;
+
+    /// Called on the raster thread when the rasterizer purged its caches
+    /// because the process came under critical memory pressure, so that the
+    /// caches outside of it can be purged too.
+    virtual void OnCriticalMemoryPressure() = 0;
   };
 
   //----------------------------------------------------------------------------
@@ -176,9 +187,32 @@ class Rasterizer final : public SnapshotDelegate,
   ///             collects associated resources. No more rendering may occur
   ///             till the next call to `Rasterizer::Setup` with a new render
   ///             surface. Calling a teardown without a setup is user error.
+  ///             The surfaces of all other views are released as well.
   ///
   void Teardown();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Provides the on-screen render surface of a view other than
+  ///             the implicit view, whose surface is provided with
+  ///             `Rasterizer::Setup`. The layer trees of the view are only
+  ///             rendered once it has a surface. All views share the
+  ///             compositor context, and with it the raster cache, of the
+  ///             rasterizer.
+  ///
+  /// @param[in]  view_id  The ID of the view.
+  /// @param[in]  surface  The on-screen render surface of the view.
+  ///
+  void AddSurface(int64_t view_id, std::unique_ptr<Surface> surface);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Releases the on-screen render surface of a view that was
+  ///             provided with `Rasterizer::AddSurface`, along with the last
+  ///             layer tree rendered to it.
+  ///
+  /// @param[in]  view_id  The ID of the view.
+  ///
+  void RemoveSurface(int64_t view_id);
+
   //----------------------------------------------------------------------------
   /// @brief      Releases any resource used by the external view embedder.
   ///             For example, overlay surfaces or Android views.
@@ -214,8 +248,9 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   /// @bug        https://github.com/flutter/flutter/issues/33939
   ///
-  /// @return     A pointer to the last layer or `nullptr` if this rasterizer
-  ///             has never rendered a frame.
+  /// @return     A pointer to the last layer tree of the implicit view or
+  ///             `nullptr` if this rasterizer has never rendered a frame to
+  ///             it.
   ///
   flutter::LayerTree* GetLastLayerTree();
 
@@ -231,6 +266,7 @@ class Rasterizer final : public SnapshotDelegate,
   ///             Flutter can re-render the layer tree with just the updated
   ///             textures instead of waiting for the framework to do the work
   ///             to generate the layer tree describing the same contents.
+  ///             The last layer trees of all views are drawn.
   ///
   void DrawLastLayerTree(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder);
@@ -240,7 +276,8 @@ class Rasterizer final : public SnapshotDelegate,
 
   std::shared_ptr<flutter::TextureRegistry> GetTextureRegistry() override;
 
-  using LayerTreeDiscardCallback = std::function<bool(flutter::LayerTree&)>;
+  using LayerTreeDiscardCallback =
+      std::function<bool(int64_t view_id, flutter::LayerTree&)>;
 
   //----------------------------------------------------------------------------
   /// @brief      Takes the next item from the layer tree pipeline and executes
@@ -270,8 +307,9 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   /// @param[in]  pipeline  The layer tree pipeline to take the next layer tree
   ///                       to render from.
-  /// @param[in]  discard_callback if specified and returns true, the layer tree
-  ///                             is discarded instead of being rendered
+  /// @param[in]  discard_callback if specified and returns true for the layer
+  ///                             tree of a view, that layer tree is discarded
+  ///                             instead of being rendered
   ///
   RasterStatus Draw(const std::shared_ptr<LayerTreePipeline>& pipeline,
                     LayerTreeDiscardCallback discard_callback = NoDiscard);
@@ -381,6 +419,26 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   Screenshot ScreenshotLastLayerTree(ScreenshotType type, bool base64_encode);
 
+  using ScreenshotCallback = std::function<void(Screenshot screenshot)>;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Screenshots the last layer tree without encoding it on the
+  ///             raster thread. The layer tree is rasterized and its pixels
+  ///             are read back right away, and then encoded on the encode
+  ///             task runner, where the callback is invoked.
+  ///
+  /// @param[in]  options             How the pixels are encoded.
+  /// @param[in]  encode_task_runner  The task runner the pixels are encoded
+  ///                                 on.
+  /// @param[in]  callback            Invoked with the screenshot once it is
+  ///                                 encoded, or with an empty screenshot if
+  ///                                 none could be captured.
+  ///
+  void ScreenshotLastLayerTreeAsync(
+      const ScreenshotEncodingOptions& options,
+      const std::shared_ptr<fml::ConcurrentTaskRunner>& encode_task_runner,
+      const ScreenshotCallback& callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Sets a callback that will be executed when the next layer tree
   ///             in rendered to the on-screen surface. This is used by
@@ -475,6 +533,17 @@ class Rasterizer final : public SnapshotDelegate,
   ///
   std::optional<size_t> GetResourceCacheMaxBytes() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      Lets the controller adjust the limits of the resource cache
+  ///             and of the raster cache as frames are rasterized, and
+  ///             periodically while none are. The limit set with
+  ///             `SetResourceCacheMaxBytes` becomes the baseline of both.
+  ///
+  /// @see        `ResourceCacheController`
+  ///
+  void SetResourceCacheController(
+      std::unique_ptr<ResourceCacheController> controller);
+
   //----------------------------------------------------------------------------
   /// @brief      Enables the thread merger if the external view embedder
   ///             supports dynamic thread merging.
@@ -556,40 +625,71 @@ class Rasterizer final : public SnapshotDelegate,
 
   RasterStatus DoDraw(
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder,
-      std::unique_ptr<flutter::LayerTree> layer_tree,
-      float device_pixel_ratio);
+      std::vector<std::unique_ptr<LayerTreeTask>> tasks);
+
+  // Draws the layer trees of a frame to the surfaces of their views. The layer
+  // trees that were rasterized are moved into the view records and their
+  // tasks are removed, leaving the tasks of the layer trees that weren't.
+  RasterStatus DrawToSurfaces(
+      FrameTimingsRecorder& frame_timings_recorder,
+      std::vector<std::unique_ptr<LayerTreeTask>>& tasks);
 
-  RasterStatus DrawToSurface(FrameTimingsRecorder& frame_timings_recorder,
-                             flutter::LayerTree& layer_tree,
-                             float device_pixel_ratio);
+  RasterStatus DrawToSurfacesUnsafe(
+      FrameTimingsRecorder& frame_timings_recorder,
+      std::vector<std::unique_ptr<LayerTreeTask>>& tasks);
 
   RasterStatus DrawToSurfaceUnsafe(FrameTimingsRecorder& frame_timings_recorder,
+                                   int64_t view_id,
                                    flutter::LayerTree& layer_tree,
                                    float device_pixel_ratio);
 
+  // The on-screen render surface of the view, or `nullptr` if it has none.
+  Surface* GetSurfaceForView(int64_t view_id) const;
+
   void FireNextFrameCallbackIfPresent();
 
-  static bool NoDiscard(const flutter::LayerTree& layer_tree) { return false; }
+  static bool NoDiscard(int64_t view_id, const flutter::LayerTree& layer_tree) {
+    return false;
+  }
   static bool ShouldResubmitFrame(const RasterStatus& raster_status);
 
+  // Feeds a sample of the caches and of the process memory to the resource
+  // cache controller, at most once per adjustment interval, and applies the
+  // limits it computes.
+  void AdjustResourceCaches();
+
+  // Samples the caches every adjustment interval for as long as there is a
+  // resource cache controller, whether or not frames are rasterized.
+  void ScheduleResourceCacheAdjustment();
+
   Delegate& delegate_;
   MakeGpuImageBehavior gpu_image_behavior_;
   std::weak_ptr<impeller::Context> impeller_context_;
   std::unique_ptr<Surface> surface_;
   std::unique_ptr<SnapshotSurfaceProducer> snapshot_surface_producer_;
   std::unique_ptr<flutter::CompositorContext> compositor_context_;
-  // This is the last successfully rasterized layer tree.
-  std::unique_ptr<flutter::LayerTree> last_layer_tree_;
-  float last_device_pixel_ratio_;
-  // Set when we need attempt to rasterize the layer tree again. This layer_tree
-  // has not successfully rasterized. This can happen due to the change in the
-  // thread configuration. This will be inserted to the front of the pipeline.
-  std::unique_ptr<flutter::LayerTree> resubmitted_layer_tree_;
+  struct ViewRecord {
+    // The on-screen render surface of the view. Always null for the implicit
+    // view, which renders to |surface_|.
+    std::unique_ptr<Surface> surface;
+    // This is the last successfully rasterized layer tree of the view.
+    std::unique_ptr<flutter::LayerTree> last_layer_tree;
+    float last_device_pixel_ratio = 1.0f;
+  };
+  std::unordered_map<int64_t, ViewRecord> view_records_;
+  // Set when we need attempt to rasterize the layer trees again. These layer
+  // trees have not successfully rasterized. This can happen due to the change
+  // in the thread configuration. They will be inserted to the front of the
+  // pipeline.
+  std::vector<std::unique_ptr<LayerTreeTask>> resubmitted_tasks_;
   std::unique_ptr<FrameTimingsRecorder> resubmitted_recorder_;
-  float resubmitted_pixel_ratio_;
   fml::closure next_frame_callback_;
   bool user_override_resource_cache_bytes_;
   std::optional<size_t> max_cache_bytes_;
+  std::unique_ptr<ResourceCacheController> resource_cache_controller_;
+  fml::TimePoint last_resource_cache_adjustment_time_;
+  size_t last_raster_cache_hit_count_ = 0;
+  size_t last_raster_cache_miss_count_ = 0;
   fml::RefPtr<fml::RasterThreadMerger> raster_thread_merger_;
   std::shared_ptr<ExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<SnapshotController> snapshot_controller_;
@@ -43,6 +43,7 @@ class MockDelegate : public Rasterizer::Delegate {
                      std::shared_ptr<const fml::SyncSwitch>());
   MOCK_METHOD0(CreateSnapshotSurface, std::unique_ptr<Surface>());
   MOCK_CONST_METHOD0(GetSettings, const Settings&());
+  MOCK_METHOD0(OnCriticalMemoryPressure, void());
 };
 
 class MockSurface : public Surface {
@@ -199,7 +200,7 @@ TEST(RasterizerTest,
     PipelineProduceResult result =
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     rasterizer->Draw(pipeline, no_discard);
     latch.Signal();
   });
@@ -265,7 +266,7 @@ TEST(
     PipelineProduceResult result =
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     rasterizer->Draw(pipeline, no_discard);
     latch.Signal();
   });
@@ -336,7 +337,7 @@ TEST(
   PipelineProduceResult result =
       pipeline->Produce().Complete(std::move(layer_tree_item));
   EXPECT_TRUE(result.success);
-  auto no_discard = [](LayerTree&) { return false; };
+  auto no_discard = [](int64_t, LayerTree&) { return false; };
   rasterizer->Draw(pipeline, no_discard);
 }
 
@@ -410,7 +411,7 @@ TEST(RasterizerTest,
   PipelineProduceResult result =
       pipeline->Produce().Complete(std::move(layer_tree_item));
   EXPECT_TRUE(result.success);
-  auto no_discard = [](LayerTree&) { return false; };
+  auto no_discard = [](int64_t, LayerTree&) { return false; };
 
   // The Draw() will respectively call BeginFrame(), SubmitFrame() and
   // EndFrame() one time.
@@ -460,7 +461,7 @@ TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenNoSurfaceIsSet) {
     PipelineProduceResult result =
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     rasterizer->Draw(pipeline, no_discard);
     latch.Signal();
   });
@@ -517,7 +518,7 @@ TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenNotUsedThisFrame) {
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
     // Always discard the layer tree.
-    auto discard_callback = [](LayerTree&) { return true; };
+    auto discard_callback = [](int64_t, LayerTree&) { return true; };
     RasterStatus status = rasterizer->Draw(pipeline, discard_callback);
     EXPECT_EQ(status, RasterStatus::kDiscarded);
     latch.Signal();
@@ -561,7 +562,7 @@ TEST(RasterizerTest, externalViewEmbedderDoesntEndFrameWhenPipelineIsEmpty) {
   fml::AutoResetWaitableEvent latch;
   thread_host.raster_thread->GetTaskRunner()->PostTask([&] {
     auto pipeline = std::make_shared<LayerTreePipeline>(/*depth=*/10);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     RasterStatus status = rasterizer->Draw(pipeline, no_discard);
     EXPECT_EQ(status, RasterStatus::kFailed);
     latch.Signal();
@@ -619,7 +620,7 @@ TEST(RasterizerTest,
     PipelineProduceResult result =
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     rasterizer->Draw(pipeline, no_discard);
     latch.Signal();
   });
@@ -677,7 +678,7 @@ TEST(
     PipelineProduceResult result =
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     RasterStatus status = rasterizer->Draw(pipeline, no_discard);
     EXPECT_EQ(status, RasterStatus::kSuccess);
     latch.Signal();
@@ -735,7 +736,7 @@ TEST(
     PipelineProduceResult result =
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     RasterStatus status = rasterizer->Draw(pipeline, no_discard);
     EXPECT_EQ(status, RasterStatus::kSuccess);
     latch.Signal();
@@ -792,7 +793,7 @@ TEST(
     PipelineProduceResult result =
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     RasterStatus status = rasterizer->Draw(pipeline, no_discard);
     EXPECT_EQ(status, RasterStatus::kDiscarded);
     latch.Signal();
@@ -848,7 +849,7 @@ TEST(
     PipelineProduceResult result =
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     RasterStatus status = rasterizer->Draw(pipeline, no_discard);
     EXPECT_EQ(status, RasterStatus::kFailed);
     latch.Signal();
@@ -929,7 +930,7 @@ TEST(RasterizerTest,
       EXPECT_TRUE(result.success);
       EXPECT_EQ(result.is_first_item, i == 0);
     }
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     // Although we only call 'Rasterizer::Draw' once, it will be called twice
     // finally because there are two items in the pipeline.
     rasterizer->Draw(pipeline, no_discard);
@@ -1100,7 +1101,7 @@ TEST(RasterizerTest, presentationTimeSetWhenVsyncTargetInFuture) {
       EXPECT_TRUE(result.success);
       EXPECT_EQ(result.is_first_item, i == 0);
     }
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     // Although we only call 'Rasterizer::Draw' once, it will be called twice
     // finally because there are two items in the pipeline.
     rasterizer->Draw(pipeline, no_discard);
@@ -1179,7 +1180,7 @@ TEST(RasterizerTest, presentationTimeNotSetWhenVsyncTargetInPast) {
         pipeline->Produce().Complete(std::move(layer_tree_item));
     EXPECT_TRUE(result.success);
     EXPECT_EQ(result.is_first_item, true);
-    auto no_discard = [](LayerTree&) { return false; };
+    auto no_discard = [](int64_t, LayerTree&) { return false; };
     rasterizer->Draw(pipeline, no_discard);
   });
 
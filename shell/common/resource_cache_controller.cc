@@ -0,0 +1,211 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resource_cache_controller.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "flutter/fml/build_config.h"
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "flutter/fml/eintr_wrapper.h"
+#include "flutter/fml/unique_fd.h"
+#endif
+
+namespace flutter {
+
+namespace {
+
+// A cache is saturated when it holds at least this fraction of its limit and
+// at most the rest of it can be freed.
+constexpr double kSaturatedFraction = 0.9;
+
+// The raster cache is saturated when more than one in this many of the images
+// it is asked for were turned away because it was full.
+constexpr size_t kRasterCacheMissRatio = 10;
+
+// Limits only grow while the resident set size leaves this much of the budget.
+constexpr double kResidentHeadroomFraction = 0.9;
+
+// The share of the physical memory the process may keep resident before it is
+// considered to be under pressure, when no budget is configured.
+constexpr double kDefaultResidentBudgetFraction = 0.5;
+
+// Pressure stall thresholds, in percent of the last 10 seconds.
+constexpr double kModerateSomeStall = 10.0;
+constexpr double kModerateFullStall = 1.0;
+constexpr double kCriticalFullStall = 5.0;
+
+// Returns the value of the avg10 field of a line of pressure stall
+// information, or 0 if there is none.
+double ParseAverage10(std::string_view line) {
+  constexpr std::string_view kKey = "avg10=";
+  const size_t found = line.find(kKey);
+  if (found == std::string_view::npos) {
+    return 0.0;
+  }
+  const std::string value(line.substr(found + kKey.size()));
+  return std::strtod(value.c_str(), nullptr);
+}
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+std::string ReadProcFile(const char* path) {
+  // Files in /proc report a size of zero, so they can't be mapped.
+  fml::UniqueFD fd(FML_HANDLE_EINTR(::open(path, O_RDONLY | O_CLOEXEC)));
+  if (!fd.is_valid()) {
+    return {};
+  }
+  std::string contents;
+  char buffer[256];
+  ssize_t size;
+  while ((size = FML_HANDLE_EINTR(::read(fd.get(), buffer, sizeof(buffer)))) >
+         0) {
+    contents.append(buffer, size);
+  }
+  return contents;
+}
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+}  // namespace
+
+ResourceCacheController::ResourceCacheController(const Options& options)
+    : options_(options), samples_since_shrink_(options.growth_hold_samples) {}
+
+ResourceCacheController::~ResourceCacheController() = default;
+
+void ResourceCacheController::SetBaseline(const Limits& baseline) {
+  baseline_ = baseline;
+}
+
+ResourceCacheController::Limits ResourceCacheController::GetLimits() const {
+  return {
+      .resource_cache_bytes =
+          Scale(baseline_.resource_cache_bytes, resource_cache_scale_),
+      .raster_cache_bytes =
+          Scale(baseline_.raster_cache_bytes, raster_cache_scale_),
+  };
+}
+
+ResourceCacheController::Adjustment ResourceCacheController::Update(
+    const Sample& sample) {
+  const bool over_budget =
+      options_.resident_bytes_budget > 0 &&
+      sample.resident_bytes > options_.resident_bytes_budget;
+  MemoryPressure pressure = sample.pressure;
+  if (pressure == MemoryPressure::kNone && over_budget) {
+    pressure = MemoryPressure::kModerate;
+  }
+
+  Adjustment adjustment;
+  switch (pressure) {
+    case MemoryPressure::kCritical:
+      resource_cache_scale_ = options_.min_scale;
+      raster_cache_scale_ = options_.min_scale;
+      adjustment.purge = !was_critical_;
+      samples_since_shrink_ = 0;
+      break;
+    case MemoryPressure::kModerate:
+      resource_cache_scale_ = std::max(
+          options_.min_scale, resource_cache_scale_ * options_.shrink_factor);
+      raster_cache_scale_ = std::max(
+          options_.min_scale, raster_cache_scale_ * options_.shrink_factor);
+      samples_since_shrink_ = 0;
+      break;
+    case MemoryPressure::kNone: {
+      if (samples_since_shrink_ < options_.growth_hold_samples) {
+        samples_since_shrink_++;
+        break;
+      }
+      if (options_.resident_bytes_budget > 0 &&
+          sample.resident_bytes > options_.resident_bytes_budget *
+                                      kResidentHeadroomFraction) {
+        break;
+      }
+      const Limits limits = GetLimits();
+      if (limits.resource_cache_bytes > 0 &&
+          sample.resource_cache_bytes >=
+              limits.resource_cache_bytes * kSaturatedFraction &&
+          sample.resource_cache_purgeable_bytes <=
+              limits.resource_cache_bytes * (1.0 - kSaturatedFraction)) {
+        resource_cache_scale_ =
+            std::min(1.0, resource_cache_scale_ + options_.growth_step);
+      }
+      if (sample.raster_cache_misses * kRasterCacheMissRatio >
+          sample.raster_cache_hits + sample.raster_cache_misses) {
+        raster_cache_scale_ =
+            std::min(1.0, raster_cache_scale_ + options_.growth_step);
+      }
+      break;
+    }
+  }
+  was_critical_ = pressure == MemoryPressure::kCritical;
+
+  adjustment.limits = GetLimits();
+  return adjustment;
+}
+
+ResourceCacheController::MemoryPressure
+ResourceCacheController::ParsePressureStallInformation(std::string_view psi) {
+  double some = 0.0;
+  double full = 0.0;
+  while (!psi.empty()) {
+    const size_t end = std::min(psi.find('\n'), psi.size());
+    const std::string_view line = psi.substr(0, end);
+    if (line.substr(0, 5) == "some ") {
+      some = ParseAverage10(line);
+    } else if (line.substr(0, 5) == "full ") {
+      full = ParseAverage10(line);
+    }
+    psi.remove_prefix(std::min(end + 1, psi.size()));
+  }
+
+  if (full >= kCriticalFullStall) {
+    return MemoryPressure::kCritical;
+  }
+  if (some >= kModerateSomeStall || full >= kModerateFullStall) {
+    return MemoryPressure::kModerate;
+  }
+  return MemoryPressure::kNone;
+}
+
+ResourceCacheController::Sample ResourceCacheController::SampleProcessMemory() {
+  Sample sample;
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  sample.pressure =
+      ParsePressureStallInformation(ReadProcFile("/proc/pressure/memory"));
+
+  // The second field is the resident set size in pages.
+  const std::string statm = ReadProcFile("/proc/self/statm");
+  const size_t separator = statm.find(' ');
+  if (separator != std::string::npos) {
+    sample.resident_bytes =
+        std::strtoull(statm.c_str() + separator, nullptr, 10) *
+        ::sysconf(_SC_PAGESIZE);
+  }
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  return sample;
+}
+
+size_t ResourceCacheController::GetDefaultResidentBytesBudget() {
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  const long pages = ::sysconf(_SC_PHYS_PAGES);
+  const long page_size = ::sysconf(_SC_PAGESIZE);
+  if (pages > 0 && page_size > 0) {
+    return static_cast<size_t>(static_cast<double>(pages) * page_size *
+                               kDefaultResidentBudgetFraction);
+  }
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+  return 0;
+}
+
+size_t ResourceCacheController::Scale(size_t baseline, double scale) const {
+  return static_cast<size_t>(baseline * scale);
+}
+
+}  // namespace flutter
@@ -0,0 +1,154 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_RESOURCE_CACHE_CONTROLLER_H_
+#define FLUTTER_SHELL_COMMON_RESOURCE_CACHE_CONTROLLER_H_
+
+#include <cstddef>
+#include <string_view>
+
+#include "flutter/fml/macros.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Adjusts the limits of the GPU resource cache and of the raster
+///             cache to how well they are used and to how much memory the
+///             process can afford.
+///
+///             The limits computed by |ResourceCacheLimitCalculator| are the
+///             baseline. Each cache's limit is a fraction of its baseline
+///             that shrinks multiplicatively while the system is under memory
+///             pressure or the process is over its memory budget, and grows
+///             additively back towards the baseline while the cache is
+///             saturated without pressure. Growth is held off for a few
+///             samples after every shrink so the limits don't oscillate.
+///
+///             The controller only does arithmetic on the samples it is
+///             given and can be driven by a simulation.
+///
+class ResourceCacheController {
+ public:
+  enum class MemoryPressure {
+    kNone,
+    /// Caches should give memory back.
+    kModerate,
+    /// The process is at risk of being killed and caches should be purged.
+    kCritical,
+  };
+
+  struct Options {
+    /// The resident set size above which the process is considered to be
+    /// under moderate memory pressure. Zero if there is no budget.
+    size_t resident_bytes_budget = 0;
+
+    /// The smallest fraction of its baseline a limit shrinks to.
+    double min_scale = 0.25;
+
+    /// The fraction a limit is multiplied by for every sample with pressure.
+    double shrink_factor = 0.75;
+
+    /// The fraction of the baseline a limit grows by for every sample in
+    /// which its cache is saturated.
+    double growth_step = 0.125;
+
+    /// The number of samples after a shrink during which limits don't grow.
+    size_t growth_hold_samples = 5;
+  };
+
+  /// The state of the process and of the caches since the last sample.
+  struct Sample {
+    MemoryPressure pressure = MemoryPressure::kNone;
+
+    /// The resident set size of the process, or zero if it is unknown.
+    size_t resident_bytes = 0;
+
+    /// The bytes held by the GPU resource cache.
+    size_t resource_cache_bytes = 0;
+
+    /// The bytes held by the GPU resource cache that could be freed right
+    /// away.
+    size_t resource_cache_purgeable_bytes = 0;
+
+    /// The number of times cached raster cache images were drawn.
+    size_t raster_cache_hits = 0;
+
+    /// The number of images that weren't added to the raster cache because
+    /// it was at its limit.
+    size_t raster_cache_misses = 0;
+  };
+
+  struct Limits {
+    size_t resource_cache_bytes = 0;
+    size_t raster_cache_bytes = 0;
+  };
+
+  struct Adjustment {
+    Limits limits;
+
+    /// Whether the caches should be purged because the process just came
+    /// under critical memory pressure.
+    bool purge = false;
+  };
+
+  explicit ResourceCacheController(const Options& options);
+
+  ~ResourceCacheController();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the limits the caches have without memory pressure.
+  ///
+  void SetBaseline(const Limits& baseline);
+
+  const Limits& GetBaseline() const { return baseline_; }
+
+  Limits GetLimits() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Feeds a sample to the controller.
+  ///
+  /// @return     The new limits of the caches.
+  ///
+  Adjustment Update(const Sample& sample);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Parses the contents of `/proc/pressure/memory`, the memory
+  ///             pressure stall information of Linux.
+  ///
+  ///             Memory pressure is moderate once some tasks stalled on memory
+  ///             for 10% of the last 10 seconds, or all tasks did for 1% of
+  ///             them, and critical once all tasks did for 5% of them.
+  ///
+  static MemoryPressure ParsePressureStallInformation(std::string_view psi);
+
+  //----------------------------------------------------------------------------
+  /// @brief      A sample with the memory pressure and the resident set size
+  ///             of the process filled in, on the platforms where they can be
+  ///             read.
+  ///
+  static Sample SampleProcessMemory();
+
+  //----------------------------------------------------------------------------
+  /// @brief      The resident set size budget to use when none is configured:
+  ///             a share of the physical memory of the device, or zero where
+  ///             it can't be read.
+  ///
+  static size_t GetDefaultResidentBytesBudget();
+
+ private:
+  const Options options_;
+  Limits baseline_;
+  double resource_cache_scale_ = 1.0;
+  double raster_cache_scale_ = 1.0;
+  size_t samples_since_shrink_ = 0;
+  bool was_critical_ = false;
+
+  size_t Scale(size_t baseline, double scale) const;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ResourceCacheController);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_RESOURCE_CACHE_CONTROLLER_H_
@@ -0,0 +1,296 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/resource_cache_controller.h"
+
+#include <algorithm>
+
+#include "flutter/fml/build_config.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using MemoryPressure = ResourceCacheController::MemoryPressure;
+
+constexpr size_t kMB = 1 << 20;
+
+// A process that fills its caches up to their limits or to its working sets,
+// on a device that reports memory pressure as the process approaches the
+// memory it has available.
+class SimulatedProcess {
+ public:
+  struct Workload {
+    size_t available_bytes;
+    size_t base_bytes;
+    size_t resource_working_set_bytes;
+    size_t raster_working_set_bytes;
+  };
+
+  explicit SimulatedProcess(const Workload& workload) : workload_(workload) {}
+
+  ResourceCacheController::Sample Step(
+      const ResourceCacheController::Limits& limits) {
+    const size_t resource_bytes =
+        std::min(limits.resource_cache_bytes,
+                 workload_.resource_working_set_bytes);
+    const size_t raster_bytes =
+        std::min(limits.raster_cache_bytes, workload_.raster_working_set_bytes);
+    resident_bytes_ = workload_.base_bytes + resource_bytes + raster_bytes;
+
+    ResourceCacheController::Sample sample;
+    if (resident_bytes_ > workload_.available_bytes) {
+      sample.pressure = MemoryPressure::kCritical;
+    } else if (resident_bytes_ > workload_.available_bytes * 0.85) {
+      sample.pressure = MemoryPressure::kModerate;
+    }
+    sample.resident_bytes = resident_bytes_;
+    sample.resource_cache_bytes = resource_bytes;
+    // Images that don't fit in the raster cache miss it every frame.
+    const size_t frames = 60;
+    const size_t missing_bytes =
+        workload_.raster_working_set_bytes - raster_bytes;
+    sample.raster_cache_misses =
+        frames * missing_bytes / workload_.raster_working_set_bytes;
+    sample.raster_cache_hits = frames - sample.raster_cache_misses;
+    return sample;
+  }
+
+  size_t resident_bytes() const { return resident_bytes_; }
+
+ private:
+  const Workload workload_;
+  size_t resident_bytes_ = 0;
+};
+
+ResourceCacheController::Sample SaturatedSample(
+    const ResourceCacheController::Limits& limits) {
+  return {
+      .resource_cache_bytes = limits.resource_cache_bytes,
+      .raster_cache_hits = 10,
+      .raster_cache_misses = 10,
+  };
+}
+
+}  // namespace
+
+TEST(ResourceCacheControllerTest, StartsAtBaseline) {
+  ResourceCacheController controller({});
+  controller.SetBaseline(
+      {.resource_cache_bytes = 100 * kMB, .raster_cache_bytes = 50 * kMB});
+  EXPECT_EQ(controller.GetLimits().resource_cache_bytes, 100 * kMB);
+  EXPECT_EQ(controller.GetLimits().raster_cache_bytes, 50 * kMB);
+
+  auto adjustment = controller.Update({});
+  EXPECT_FALSE(adjustment.purge);
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 100 * kMB);
+  EXPECT_EQ(adjustment.limits.raster_cache_bytes, 50 * kMB);
+}
+
+TEST(ResourceCacheControllerTest, ShrinksUnderModeratePressure) {
+  ResourceCacheController controller({});
+  controller.SetBaseline(
+      {.resource_cache_bytes = 100 * kMB, .raster_cache_bytes = 100 * kMB});
+
+  auto adjustment = controller.Update({.pressure = MemoryPressure::kModerate});
+  EXPECT_FALSE(adjustment.purge);
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 75 * kMB);
+  EXPECT_EQ(adjustment.limits.raster_cache_bytes, 75 * kMB);
+
+  for (int i = 0; i < 10; i++) {
+    adjustment = controller.Update({.pressure = MemoryPressure::kModerate});
+  }
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 25 * kMB);
+  EXPECT_EQ(adjustment.limits.raster_cache_bytes, 25 * kMB);
+}
+
+TEST(ResourceCacheControllerTest, PurgesOnlyWhenPressureBecomesCritical) {
+  ResourceCacheController controller({});
+  controller.SetBaseline(
+      {.resource_cache_bytes = 100 * kMB, .raster_cache_bytes = 100 * kMB});
+
+  auto adjustment = controller.Update({.pressure = MemoryPressure::kCritical});
+  EXPECT_TRUE(adjustment.purge);
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 25 * kMB);
+  EXPECT_EQ(adjustment.limits.raster_cache_bytes, 25 * kMB);
+
+  adjustment = controller.Update({.pressure = MemoryPressure::kCritical});
+  EXPECT_FALSE(adjustment.purge);
+
+  adjustment = controller.Update({.pressure = MemoryPressure::kModerate});
+  EXPECT_FALSE(adjustment.purge);
+
+  adjustment = controller.Update({.pressure = MemoryPressure::kCritical});
+  EXPECT_TRUE(adjustment.purge);
+}
+
+TEST(ResourceCacheControllerTest, HoldsGrowthAfterShrinking) {
+  ResourceCacheController controller({.growth_hold_samples = 3});
+  controller.SetBaseline(
+      {.resource_cache_bytes = 80 * kMB, .raster_cache_bytes = 80 * kMB});
+  controller.Update({.pressure = MemoryPressure::kCritical});
+  ASSERT_EQ(controller.GetLimits().resource_cache_bytes, 20 * kMB);
+
+  for (int i = 0; i < 3; i++) {
+    auto adjustment =
+        controller.Update(SaturatedSample(controller.GetLimits()));
+    EXPECT_EQ(adjustment.limits.resource_cache_bytes, 20 * kMB);
+    EXPECT_EQ(adjustment.limits.raster_cache_bytes, 20 * kMB);
+  }
+
+  auto adjustment = controller.Update(SaturatedSample(controller.GetLimits()));
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 30 * kMB);
+  EXPECT_EQ(adjustment.limits.raster_cache_bytes, 30 * kMB);
+}
+
+TEST(ResourceCacheControllerTest, GrowsOnlySaturatedCaches) {
+  ResourceCacheController controller({.growth_hold_samples = 0});
+  controller.SetBaseline(
+      {.resource_cache_bytes = 80 * kMB, .raster_cache_bytes = 80 * kMB});
+  controller.Update({.pressure = MemoryPressure::kCritical});
+
+  // Half of the resource cache is purgeable and every raster cache lookup
+  // hits.
+  auto adjustment = controller.Update({
+      .resource_cache_bytes = 20 * kMB,
+      .resource_cache_purgeable_bytes = 10 * kMB,
+      .raster_cache_hits = 100,
+  });
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 20 * kMB);
+  EXPECT_EQ(adjustment.limits.raster_cache_bytes, 20 * kMB);
+
+  adjustment = controller.Update({
+      .resource_cache_bytes = 20 * kMB,
+      .raster_cache_hits = 100,
+  });
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 30 * kMB);
+  EXPECT_EQ(adjustment.limits.raster_cache_bytes, 20 * kMB);
+
+  adjustment = controller.Update({
+      .raster_cache_hits = 50,
+      .raster_cache_misses = 50,
+  });
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 30 * kMB);
+  EXPECT_EQ(adjustment.limits.raster_cache_bytes, 30 * kMB);
+}
+
+TEST(ResourceCacheControllerTest, ResidentBudgetActsAsModeratePressure) {
+  ResourceCacheController controller(
+      {.resident_bytes_budget = 200 * kMB, .growth_hold_samples = 0});
+  controller.SetBaseline(
+      {.resource_cache_bytes = 100 * kMB, .raster_cache_bytes = 100 * kMB});
+
+  auto adjustment = controller.Update({.resident_bytes = 250 * kMB});
+  EXPECT_FALSE(adjustment.purge);
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 75 * kMB);
+
+  // Limits don't grow while the process is close to its budget.
+  auto sample = SaturatedSample(adjustment.limits);
+  sample.resident_bytes = 190 * kMB;
+  adjustment = controller.Update(sample);
+  EXPECT_EQ(adjustment.limits.resource_cache_bytes, 75 * kMB);
+
+  sample.resident_bytes = 150 * kMB;
+  adjustment = controller.Update(sample);
+  EXPECT_GT(adjustment.limits.resource_cache_bytes, 75 * kMB);
+}
+
+#if defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+TEST(ResourceCacheControllerTest, DefaultResidentBudgetIsShareOfMemory) {
+  EXPECT_GT(ResourceCacheController::GetDefaultResidentBytesBudget(), 0u);
+}
+#endif  // defined(FML_OS_LINUX) || defined(FML_OS_ANDROID)
+
+TEST(ResourceCacheControllerTest, ParsePressureStallInformation) {
+  EXPECT_EQ(ResourceCacheController::ParsePressureStallInformation(""),
+            MemoryPressure::kNone);
+  EXPECT_EQ(ResourceCacheController::ParsePressureStallInformation(
+                "some avg10=0.00 avg60=0.00 avg300=0.00 total=0\n"
+                "full avg10=0.00 avg60=0.00 avg300=0.00 total=0\n"),
+            MemoryPressure::kNone);
+  EXPECT_EQ(ResourceCacheController::ParsePressureStallInformation(
+                "some avg10=12.50 avg60=3.00 avg300=1.00 total=123456\n"
+                "full avg10=0.40 avg60=0.10 avg300=0.00 total=1234\n"),
+            MemoryPressure::kModerate);
+  EXPECT_EQ(ResourceCacheController::ParsePressureStallInformation(
+                "some avg10=2.00 avg60=0.00 avg300=0.00 total=0\n"
+                "full avg10=1.50 avg60=0.00 avg300=0.00 total=0\n"),
+            MemoryPressure::kModerate);
+  EXPECT_EQ(ResourceCacheController::ParsePressureStallInformation(
+                "some avg10=40.00 avg60=20.00 avg300=5.00 total=999999\n"
+                "full avg10=8.25 avg60=4.00 avg300=1.00 total=99999"),
+            MemoryPressure::kCritical);
+}
+
+TEST(ResourceCacheControllerTest, SettlesBelowTheMemoryCliff) {
+  ResourceCacheController controller({});
+  controller.SetBaseline(
+      {.resource_cache_bytes = 256 * kMB, .raster_cache_bytes = 256 * kMB});
+  // The working sets don't fit in the memory the process has available.
+  SimulatedProcess process({
+      .available_bytes = 400 * kMB,
+      .base_bytes = 150 * kMB,
+      .resource_working_set_bytes = 200 * kMB,
+      .raster_working_set_bytes = 100 * kMB,
+  });
+
+  size_t critical_samples = 0;
+  size_t moderate_samples = 0;
+  size_t peak_resident_bytes = 0;
+  ResourceCacheController::Limits limits = controller.GetLimits();
+  for (int i = 0; i < 600; i++) {
+    const auto sample = process.Step(limits);
+    if (i >= 60) {
+      critical_samples += sample.pressure == MemoryPressure::kCritical;
+      moderate_samples += sample.pressure == MemoryPressure::kModerate;
+      peak_resident_bytes =
+          std::max(peak_resident_bytes, process.resident_bytes());
+    }
+    limits = controller.Update(sample).limits;
+  }
+
+  // Once settled, the process never goes over the cliff and only brushes the
+  // pressure threshold every so often instead of bouncing off it.
+  EXPECT_EQ(critical_samples, 0u);
+  EXPECT_LE(peak_resident_bytes, 400 * kMB);
+  EXPECT_LT(moderate_samples, 540u / 5);
+  // The caches still use most of the memory there is to give them.
+  EXPECT_GT(limits.resource_cache_bytes + limits.raster_cache_bytes,
+            150 * kMB);
+}
+
+TEST(ResourceCacheControllerTest, RecoversBaselineWhenPressureGoesAway) {
+  ResourceCacheController controller({});
+  controller.SetBaseline(
+      {.resource_cache_bytes = 256 * kMB, .raster_cache_bytes = 256 * kMB});
+  SimulatedProcess tight({
+      .available_bytes = 400 * kMB,
+      .base_bytes = 150 * kMB,
+      .resource_working_set_bytes = 200 * kMB,
+      .raster_working_set_bytes = 100 * kMB,
+  });
+  auto limits = controller.GetLimits();
+  for (int i = 0; i < 60; i++) {
+    limits = controller.Update(tight.Step(limits)).limits;
+  }
+  ASSERT_LT(limits.resource_cache_bytes, 256 * kMB);
+
+  // Another app was closed and the working sets now fit.
+  SimulatedProcess roomy({
+      .available_bytes = 2048 * kMB,
+      .base_bytes = 150 * kMB,
+      .resource_working_set_bytes = 1024 * kMB,
+      .raster_working_set_bytes = 512 * kMB,
+  });
+  for (int i = 0; i < 60; i++) {
+    limits = controller.Update(roomy.Step(limits)).limits;
+  }
+  EXPECT_EQ(limits.resource_cache_bytes, 256 * kMB);
+  EXPECT_EQ(limits.raster_cache_bytes, 256 * kMB);
+}
+
+}  // namespace testing
+}  // namespace flutter
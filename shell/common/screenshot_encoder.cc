@@ -0,0 +1,222 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/screenshot_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
+#include "third_party/skia/include/utils/SkBase64.h"
+
+namespace flutter {
+
+namespace {
+
+sk_sp<SkData> EncodeRaw(const SkPixmap& pixels) {
+  const size_t row_size = pixels.info().minRowBytes();
+  auto data = SkData::MakeUninitialized(row_size * pixels.height());
+  auto* bytes = static_cast<uint8_t*>(data->writable_data());
+  for (int y = 0; y < pixels.height(); y++) {
+    memcpy(bytes + y * row_size, pixels.addr(0, y), row_size);
+  }
+  return data;
+}
+
+sk_sp<SkData> EncodePNG(const SkPixmap& pixels, int compression_level) {
+  SkPngEncoder::Options options;
+  options.fZLibLevel = std::clamp(compression_level, 0, 9);
+  SkDynamicMemoryWStream stream;
+  if (!SkPngEncoder::Encode(&stream, pixels, options)) {
+    return nullptr;
+  }
+  return stream.detachAsData();
+}
+
+// See https://qoiformat.org/qoi-specification.pdf.
+class QOIWriter {
+ public:
+  explicit QOIWriter(size_t pixel_count) {
+    // The header, the end marker and the worst case of one RGBA op per pixel.
+    bytes_.reserve(14 + 8 + pixel_count * 5);
+  }
+
+  void WriteHeader(uint32_t width, uint32_t height) {
+    Write('q');
+    Write('o');
+    Write('i');
+    Write('f');
+    Write32(width);
+    Write32(height);
+    Write(4);  // RGBA
+    Write(0);  // sRGB with linear alpha
+  }
+
+  void WritePixel(const uint8_t* pixel) {
+    const Pixel current = {pixel[0], pixel[1], pixel[2], pixel[3]};
+    if (current == previous_) {
+      run_++;
+      if (run_ == 62) {
+        FlushRun();
+      }
+      return;
+    }
+    FlushRun();
+
+    const size_t index = (current[0] * 3 + current[1] * 5 + current[2] * 7 +
+                          current[3] * 11) %
+                         64;
+    if (index_[index] == current) {
+      Write(kOpIndex | index);
+    } else {
+      index_[index] = current;
+      if (current[3] == previous_[3]) {
+        const int8_t dr = current[0] - previous_[0];
+        const int8_t dg = current[1] - previous_[1];
+        const int8_t db = current[2] - previous_[2];
+        const int8_t dr_dg = dr - dg;
+        const int8_t db_dg = db - dg;
+        if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 &&
+            db <= 1) {
+          Write(kOpDiff | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+        } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 &&
+                   db_dg >= -8 && db_dg <= 7) {
+          Write(kOpLuma | (dg + 32));
+          Write((dr_dg + 8) << 4 | (db_dg + 8));
+        } else {
+          Write(kOpRGB);
+          Write(current[0]);
+          Write(current[1]);
+          Write(current[2]);
+        }
+      } else {
+        Write(kOpRGBA);
+        Write(current[0]);
+        Write(current[1]);
+        Write(current[2]);
+        Write(current[3]);
+      }
+    }
+    previous_ = current;
+  }
+
+  sk_sp<SkData> Finish() {
+    FlushRun();
+    for (int i = 0; i < 7; i++) {
+      Write(0);
+    }
+    Write(1);
+    return SkData::MakeWithCopy(bytes_.data(), bytes_.size());
+  }
+
+ private:
+  using Pixel = std::array<uint8_t, 4>;
+
+  static constexpr uint8_t kOpIndex = 0x00;
+  static constexpr uint8_t kOpDiff = 0x40;
+  static constexpr uint8_t kOpLuma = 0x80;
+  static constexpr uint8_t kOpRun = 0xc0;
+  static constexpr uint8_t kOpRGB = 0xfe;
+  static constexpr uint8_t kOpRGBA = 0xff;
+
+  std::vector<uint8_t> bytes_;
+  std::array<Pixel, 64> index_ = {};
+  Pixel previous_ = {0, 0, 0, 255};
+  int run_ = 0;
+
+  void Write(int byte) { bytes_.push_back(static_cast<uint8_t>(byte)); }
+
+  void Write32(uint32_t value) {
+    Write(value >> 24);
+    Write(value >> 16);
+    Write(value >> 8);
+    Write(value);
+  }
+
+  void FlushRun() {
+    if (run_ > 0) {
+      Write(kOpRun | (run_ - 1));
+      run_ = 0;
+    }
+  }
+};
+
+sk_sp<SkData> EncodeQOI(const SkPixmap& pixels) {
+  // QOI only stores unpremultiplied RGBA pixels.
+  const auto rgba_info =
+      SkImageInfo::Make(pixels.width(), pixels.height(),
+                        kRGBA_8888_SkColorType, kUnpremul_SkAlphaType);
+  std::vector<uint8_t> rgba(rgba_info.computeMinByteSize());
+  if (!pixels.readPixels(rgba_info, rgba.data(), rgba_info.minRowBytes())) {
+    return nullptr;
+  }
+
+  QOIWriter writer(rgba.size() / 4);
+  writer.WriteHeader(pixels.width(), pixels.height());
+  for (size_t i = 0; i < rgba.size(); i += 4) {
+    writer.WritePixel(rgba.data() + i);
+  }
+  return writer.Finish();
+}
+
+sk_sp<SkData> Base64Encode(const SkData& data) {
+  size_t b64_size = SkBase64::Encode(data.data(), data.size(), nullptr);
+  auto b64_data = SkData::MakeUninitialized(b64_size);
+  SkBase64::Encode(data.data(), data.size(), b64_data->writable_data());
+  return b64_data;
+}
+
+}  // namespace
+
+sk_sp<SkData> EncodeScreenshot(const SkPixmap& pixels,
+                               const ScreenshotEncodingOptions& options) {
+  TRACE_EVENT0("flutter", "EncodeScreenshot");
+  if (pixels.addr() == nullptr || pixels.width() <= 0 ||
+      pixels.height() <= 0) {
+    return nullptr;
+  }
+
+  sk_sp<SkData> data;
+  switch (options.encoding) {
+    case ScreenshotEncoding::kRaw:
+      data = EncodeRaw(pixels);
+      break;
+    case ScreenshotEncoding::kPNG:
+      data = EncodePNG(pixels, options.png_compression_level);
+      break;
+    case ScreenshotEncoding::kQOI:
+      data = EncodeQOI(pixels);
+      break;
+  }
+  if (!data) {
+    FML_LOG(ERROR) << "Screenshot: unable to encode the pixels as "
+                   << GetScreenshotEncodingFormat(options.encoding);
+    return nullptr;
+  }
+
+  if (options.base64_encode) {
+    return Base64Encode(*data);
+  }
+  return data;
+}
+
+const char* GetScreenshotEncodingFormat(ScreenshotEncoding encoding) {
+  switch (encoding) {
+    case ScreenshotEncoding::kRaw:
+      return "ScreenshotEncoding::kRaw";
+    case ScreenshotEncoding::kPNG:
+      return "ScreenshotEncoding::kPNG";
+    case ScreenshotEncoding::kQOI:
+      return "ScreenshotEncoding::kQOI";
+  }
+  FML_UNREACHABLE();
+}
+
+}  // namespace flutter
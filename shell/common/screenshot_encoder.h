@@ -0,0 +1,68 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_SCREENSHOT_ENCODER_H_
+#define FLUTTER_SHELL_COMMON_SCREENSHOT_ENCODER_H_
+
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      The container the pixels of a screenshot are encoded into.
+///
+enum class ScreenshotEncoding {
+  //--------------------------------------------------------------------------
+  /// The pixels as they were read back, 32 bits per pixel in the
+  /// `kN32_SkColorType` color type with premultiplied alpha and tightly packed
+  /// rows. Nothing is left to do once the pixels are read back.
+  ///
+  kRaw,
+
+  //--------------------------------------------------------------------------
+  /// A PNG image. The compression level trades the size of the image for the
+  /// time it takes to encode.
+  ///
+  kPNG,
+
+  //--------------------------------------------------------------------------
+  /// A QOI image (https://qoiformat.org) with unpremultiplied RGBA pixels.
+  /// Encoding is a single pass over the pixels, which is many times faster
+  /// than PNG for images that are only somewhat larger.
+  ///
+  kQOI,
+};
+
+struct ScreenshotEncodingOptions {
+  ScreenshotEncoding encoding = ScreenshotEncoding::kPNG;
+
+  /// The zlib compression level of PNG images, from 0 for no compression to 9
+  /// for the smallest images.
+  int png_compression_level = 6;
+
+  /// Whether the encoded image is Base 64 encoded for transmission over the
+  /// service protocol.
+  bool base64_encode = false;
+};
+
+//------------------------------------------------------------------------------
+/// @brief      Encodes the pixels of a screenshot. This doesn't need a GPU
+///             context and can be called from any thread.
+///
+/// @return     The encoded image, or nullptr if the pixels couldn't be
+///             encoded.
+///
+sk_sp<SkData> EncodeScreenshot(const SkPixmap& pixels,
+                               const ScreenshotEncodingOptions& options);
+
+//------------------------------------------------------------------------------
+/// @brief      A description of the format of screenshots with the encoding,
+///             used as `Rasterizer::Screenshot::format`.
+///
+const char* GetScreenshotEncodingFormat(ScreenshotEncoding encoding);
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_SCREENSHOT_ENCODER_H_
@@ -0,0 +1,188 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/screenshot_encoder.h"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "third_party/skia/include/core/SkColor.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+using RGBA = std::array<uint8_t, 4>;
+
+// A straightforward decoder following the QOI specification.
+std::vector<RGBA> DecodeQOI(const SkData& data,
+                            uint32_t* width,
+                            uint32_t* height) {
+  const auto* bytes = data.bytes();
+  const auto read32 = [bytes](size_t offset) {
+    return static_cast<uint32_t>(bytes[offset]) << 24 |
+           static_cast<uint32_t>(bytes[offset + 1]) << 16 |
+           static_cast<uint32_t>(bytes[offset + 2]) << 8 |
+           static_cast<uint32_t>(bytes[offset + 3]);
+  };
+  *width = read32(4);
+  *height = read32(8);
+
+  std::vector<RGBA> pixels;
+  std::array<RGBA, 64> index = {};
+  RGBA pixel = {0, 0, 0, 255};
+  size_t offset = 14;
+  const size_t end = data.size() - 8;
+  while (pixels.size() < *width * *height && offset < end) {
+    const uint8_t op = bytes[offset++];
+    if (op == 0xfe) {
+      pixel = {bytes[offset], bytes[offset + 1], bytes[offset + 2], pixel[3]};
+      offset += 3;
+    } else if (op == 0xff) {
+      pixel = {bytes[offset], bytes[offset + 1], bytes[offset + 2],
+               bytes[offset + 3]};
+      offset += 4;
+    } else if ((op & 0xc0) == 0x00) {
+      pixel = index[op];
+    } else if ((op & 0xc0) == 0x40) {
+      pixel[0] += ((op >> 4) & 0x03) - 2;
+      pixel[1] += ((op >> 2) & 0x03) - 2;
+      pixel[2] += (op & 0x03) - 2;
+    } else if ((op & 0xc0) == 0x80) {
+      const int dg = (op & 0x3f) - 32;
+      const uint8_t next = bytes[offset++];
+      pixel[0] += dg + ((next >> 4) & 0x0f) - 8;
+      pixel[1] += dg;
+      pixel[2] += dg + (next & 0x0f) - 8;
+    } else {
+      for (int run = op & 0x3f; run > 0; run--) {
+        pixels.push_back(pixel);
+      }
+    }
+    index[(pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64] =
+        pixel;
+    pixels.push_back(pixel);
+  }
+  return pixels;
+}
+
+void SetPixel(SkPixmap& pixmap, int x, int y, SkColor color) {
+  *pixmap.writable_addr32(x, y) = SkPreMultiplyColor(color);
+}
+
+}  // namespace
+
+TEST(ScreenshotEncoderTest, RawEncodingPacksRows) {
+  const auto info = SkImageInfo::MakeN32Premul(2, 2);
+  // Each row is padded by one pixel.
+  std::vector<uint32_t> storage(6, 0u);
+  SkPixmap pixmap(info, storage.data(), 3 * sizeof(uint32_t));
+  SetPixel(pixmap, 0, 0, SK_ColorRED);
+  SetPixel(pixmap, 1, 0, SK_ColorGREEN);
+  SetPixel(pixmap, 0, 1, SK_ColorBLUE);
+  SetPixel(pixmap, 1, 1, SK_ColorWHITE);
+
+  auto data = EncodeScreenshot(pixmap, {.encoding = ScreenshotEncoding::kRaw});
+  ASSERT_NE(data, nullptr);
+  ASSERT_EQ(data->size(), 4 * sizeof(uint32_t));
+  const auto* pixels = static_cast<const uint32_t*>(data->data());
+  EXPECT_EQ(pixels[0], SkPreMultiplyColor(SK_ColorRED));
+  EXPECT_EQ(pixels[1], SkPreMultiplyColor(SK_ColorGREEN));
+  EXPECT_EQ(pixels[2], SkPreMultiplyColor(SK_ColorBLUE));
+  EXPECT_EQ(pixels[3], SkPreMultiplyColor(SK_ColorWHITE));
+}
+
+TEST(ScreenshotEncoderTest, QOIEncodingRoundTrips) {
+  const int width = 16;
+  const int height = 8;
+  const auto info = SkImageInfo::MakeN32Premul(width, height);
+  std::vector<uint32_t> storage(width * height);
+  SkPixmap pixmap(info, storage.data(), info.minRowBytes());
+  std::vector<RGBA> expected;
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      // A mix of runs, small and large differences, and transparency.
+      SkColor color;
+      if (y == 0) {
+        color = SK_ColorRED;
+      } else if (y == height - 1 && x % 2 == 0) {
+        color = SK_ColorTRANSPARENT;
+      } else {
+        color = SkColorSetARGB(255, x * 16, y * 3 + x, (x * y * 37) % 256);
+      }
+      SetPixel(pixmap, x, y, color);
+      expected.push_back({static_cast<uint8_t>(SkColorGetR(color)),
+                          static_cast<uint8_t>(SkColorGetG(color)),
+                          static_cast<uint8_t>(SkColorGetB(color)),
+                          static_cast<uint8_t>(SkColorGetA(color))});
+    }
+  }
+
+  auto data = EncodeScreenshot(pixmap, {.encoding = ScreenshotEncoding::kQOI});
+  ASSERT_NE(data, nullptr);
+  ASSERT_GT(data->size(), 22u);
+  EXPECT_EQ(memcmp(data->data(), "qoif", 4), 0);
+  EXPECT_EQ(data->bytes()[12], 4u);
+  const uint8_t end_marker[] = {0, 0, 0, 0, 0, 0, 0, 1};
+  EXPECT_EQ(memcmp(data->bytes() + data->size() - 8, end_marker, 8), 0);
+
+  uint32_t decoded_width = 0;
+  uint32_t decoded_height = 0;
+  auto decoded = DecodeQOI(*data, &decoded_width, &decoded_height);
+  EXPECT_EQ(decoded_width, static_cast<uint32_t>(width));
+  EXPECT_EQ(decoded_height, static_cast<uint32_t>(height));
+  EXPECT_EQ(decoded, expected);
+}
+
+TEST(ScreenshotEncoderTest, QOIEncodingCompressesRuns) {
+  const auto info = SkImageInfo::MakeN32Premul(100, 100);
+  std::vector<uint32_t> storage(100 * 100, SkPreMultiplyColor(SK_ColorRED));
+  SkPixmap pixmap(info, storage.data(), info.minRowBytes());
+
+  auto data = EncodeScreenshot(pixmap, {.encoding = ScreenshotEncoding::kQOI});
+  ASSERT_NE(data, nullptr);
+  // One op for the color and one run op for every 62 pixels.
+  EXPECT_LT(data->size(), 14u + 8u + 4u + 10000u / 62u + 1u);
+}
+
+TEST(ScreenshotEncoderTest, PNGCompressionLevelIsHonored) {
+  const auto info = SkImageInfo::MakeN32Premul(64, 64);
+  std::vector<uint32_t> storage(64 * 64, SkPreMultiplyColor(SK_ColorBLUE));
+  SkPixmap pixmap(info, storage.data(), info.minRowBytes());
+
+  auto uncompressed = EncodeScreenshot(
+      pixmap,
+      {.encoding = ScreenshotEncoding::kPNG, .png_compression_level = 0});
+  auto compressed = EncodeScreenshot(
+      pixmap,
+      {.encoding = ScreenshotEncoding::kPNG, .png_compression_level = 9});
+  ASSERT_NE(uncompressed, nullptr);
+  ASSERT_NE(compressed, nullptr);
+  const uint8_t signature[] = {0x89, 'P', 'N', 'G'};
+  EXPECT_EQ(memcmp(compressed->data(), signature, 4), 0);
+  EXPECT_LT(compressed->size(), uncompressed->size());
+}
+
+TEST(ScreenshotEncoderTest, Base64EncodesEncodedImage) {
+  const auto info = SkImageInfo::MakeN32Premul(1, 1);
+  uint32_t storage = SkPreMultiplyColor(SK_ColorBLACK);
+  SkPixmap pixmap(info, &storage, info.minRowBytes());
+
+  auto data = EncodeScreenshot(
+      pixmap, {.encoding = ScreenshotEncoding::kRaw, .base64_encode = true});
+  ASSERT_NE(data, nullptr);
+  // 4 bytes are encoded in 8 characters, including padding.
+  EXPECT_EQ(data->size(), 8u);
+}
+
+TEST(ScreenshotEncoderTest, EmptyPixelsAreNotEncoded) {
+  EXPECT_EQ(EncodeScreenshot(SkPixmap(), {}), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/fml/base32.h"
 #include "flutter/fml/file.h"
@@ -24,6 +25,7 @@
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/engine.h"
 #include "flutter/shell/common/skia_event_tracer_impl.h"
+#include "flutter/shell/common/startup_timeline.h"
 #include "flutter/shell/common/switches.h"
 #include "flutter/shell/common/vsync_waiter.h"
 #include "rapidjson/stringbuffer.h"
@@ -40,6 +42,7 @@
 #include "third_party/skia/include/core/SkGraphics.h"
 #include "third_party/skia/include/utils/SkBase64.h"
 #include "third_party/tonic/common/log.h"
+#include "txt/platform.h"
 
 namespace flutter {
 
@@ -47,6 +50,7 @@ constexpr char kSkiaChannel[] = "flutter/skia";
 constexpr char kSystemChannel[] = "flutter/system";
 constexpr char kTypeKey[] = "type";
 constexpr char kFontChange[] = "fontsChange";
+constexpr char kMemoryPressure[] = "memoryPressure";
 
 namespace {
 
@@ -211,8 +215,41 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                     !settings.skia_deterministic_rendering_on_cpu),
                 is_gpu_disabled));
 
+  // The subsystems of the shell are set up by steps on the threads that own
+  // them. Each step only waits for the steps it depends on, so steps that
+  // don't depend on each other run at the same time:
+  //
+  //   platform view (platform) -+-> rasterizer (raster) -+-> engine (UI)
+  //                             +-> IO manager (IO) -----+        |
+  //                             +-> vsync waiter (platform) ------+
+  //                                                               v
+  //   default font manager (concurrent worker)        setup (platform)
+  //
+  // How long each step took is recorded in the startup timeline of the shell.
+  auto startup_timeline = shell->startup_timeline_;
+
+  // Warm up the default font manager while the other subsystems are set up.
+  // This is the same manager the font collection of the engine asks for, so
+  // setting it up on the UI thread once the engine is created then doesn't
+  // have to wait for it. Embedders that prefetched it already don't need
+  // this. Font initialization data can only be used once, by the font
+  // collection, so there is nothing to warm up when it is provided.
+  if (!settings.prefetched_default_font_manager &&
+      settings.font_initialization_data == 0) {
+    shell->GetConcurrentWorkerTaskRunner()->PostTask([startup_timeline]() {
+      TRACE_EVENT0("flutter", "ShellPrefetchDefaultFontManager");
+      StartupTimeline::ScopedStep step(*startup_timeline,
+                                       "DefaultFontManager");
+      txt::GetDefaultFontManager(/*font_initialization_data=*/0);
+    });
+  }
+
   // Create the platform view on the platform thread (this thread).
-  auto platform_view = on_create_platform_view(*shell.get());
+  std::unique_ptr<PlatformView> platform_view;
+  {
+    StartupTimeline::ScopedStep step(*startup_timeline, "PlatformView");
+    platform_view = on_create_platform_view(*shell.get());
+  }
   if (!platform_view || !platform_view->GetWeakPtr()) {
     return nullptr;
   }
@@ -229,22 +266,30 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        &snapshot_delegate_promise,
        on_create_rasterizer,                                   //
        shell = shell.get(),                                    //
+       startup_timeline,                                       //
        impeller_context = platform_view->GetImpellerContext()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupGPUSubsystem");
+        const auto start = fml::TimePoint::Now();
         std::unique_ptr<Rasterizer> rasterizer(on_create_rasterizer(*shell));
         rasterizer->SetImpellerContext(impeller_context);
+        const auto& settings = shell->GetSettings();
+        if (settings.enable_adaptive_resource_cache) {
+          const size_t budget =
+              settings.resident_memory_budget_mb > 0
+                  ? settings.resident_memory_budget_mb * 1024 * 1024
+                  : ResourceCacheController::GetDefaultResidentBytesBudget();
+          rasterizer->SetResourceCacheController(
+              std::make_unique<ResourceCacheController>(
+                  ResourceCacheController::Options{
+                      .resident_bytes_budget = budget,
+                  }));
+        }
+        startup_timeline->AddStep("Rasterizer", start, fml::TimePoint::Now());
         snapshot_delegate_promise.set_value(rasterizer->GetSnapshotDelegate());
         rasterizer_promise.set_value(std::move(rasterizer));
       });
 
-  // Ask the platform view for the vsync waiter. This will be used by the engine
-  // to create the animator.
-  auto vsync_waiter = platform_view->CreateVSyncWaiter();
-  if (!vsync_waiter) {
-    return nullptr;
-  }
-
   // Create the IO manager on the IO thread. The IO manager must be initialized
   // first because it has state that the other subsystems depend on. It must
   // first be booted and the necessary references obtained to initialize the
@@ -268,9 +313,11 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
        &unref_queue_promise,                                              //
        platform_view_ptr,                                                 //
        io_task_runner,                                                    //
+       startup_timeline,                                                  //
        is_backgrounded_sync_switch = shell->GetIsGpuDisabledSyncSwitch()  //
   ]() {
         TRACE_EVENT0("flutter", "ShellSetupIOSubsystem");
+        const auto start = fml::TimePoint::Now();
         std::shared_ptr<ShellIOManager> io_manager;
         if (parent_io_manager) {
           io_manager = parent_io_manager;
@@ -282,14 +329,37 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
               platform_view_ptr->GetImpellerContext()  // impeller context
           );
         }
+        startup_timeline->AddStep("IOManager", start, fml::TimePoint::Now());
         weak_io_manager_promise.set_value(io_manager->GetWeakPtr());
         unref_queue_promise.set_value(io_manager->GetSkiaUnrefQueue());
         io_manager_promise.set_value(io_manager);
       });
 
+  // Ask the platform view for the vsync waiter. This will be used by the engine
+  // to create the animator while the IO manager and the rasterizer are set up.
+  std::unique_ptr<VsyncWaiter> vsync_waiter;
+  {
+    StartupTimeline::ScopedStep step(*startup_timeline, "VsyncWaiter");
+    vsync_waiter = platform_view->CreateVSyncWaiter();
+  }
+  if (!vsync_waiter) {
+    // The steps that are already running reference promises on this stack.
+    rasterizer_future.wait();
+    io_manager_future.wait();
+    return nullptr;
+  }
+
   // Send dispatcher_maker to the engine constructor because shell won't have
   // platform_view set until Shell::Setup is called later.
   auto dispatcher_maker = platform_view->GetDispatcherMaker();
+  if (settings.enable_pointer_batching || settings.enable_pointer_resampling) {
+    const BatchingPointerDataDispatcher::Options options = {
+        .resample = settings.enable_pointer_resampling,
+    };
+    dispatcher_maker = [options](PointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<BatchingPointerDataDispatcher>(delegate, options);
+    };
+  }
 
   // Create the engine on the UI thread.
   std::promise<std::unique_ptr<Engine>> engine_promise;
@@ -305,35 +375,51 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
                          &weak_io_manager_future,                         //
                          &snapshot_delegate_future,                       //
                          &unref_queue_future,                             //
-                         &on_create_engine]() mutable {
+                         &on_create_engine,                               //
+                         startup_timeline]() mutable {
         TRACE_EVENT0("flutter", "ShellSetupUISubsystem");
         const auto& task_runners = shell->GetTaskRunners();
 
         // The animator is owned by the UI thread but it gets its vsync pulses
         // from the platform.
-        auto animator = std::make_unique<Animator>(*shell, task_runners,
-                                                   std::move(vsync_waiter));
-
-        engine_promise.set_value(
-            on_create_engine(*shell,                          //
-                             dispatcher_maker,                //
-                             *shell->GetDartVM(),             //
-                             std::move(isolate_snapshot),     //
-                             task_runners,                    //
-                             platform_data,                   //
-                             shell->GetSettings(),            //
-                             std::move(animator),             //
-                             weak_io_manager_future.get(),    //
-                             unref_queue_future.get(),        //
-                             snapshot_delegate_future.get(),  //
-                             shell->volatile_path_tracker_,
-                             shell->is_gpu_disabled_sync_switch_));
+        auto animator = std::make_unique<Animator>(
+            *shell, task_runners, std::move(vsync_waiter),
+            shell->frame_scheduler_,
+            shell->settings_.enable_latest_frame_wins
+                ? PipelineOverflow::kReplaceOldest
+                : PipelineOverflow::kReject);
+
+        // Wait for the IO manager and the rasterizer the engine depends on.
+        auto weak_io_manager = weak_io_manager_future.get();
+        auto unref_queue = unref_queue_future.get();
+        auto snapshot_delegate = snapshot_delegate_future.get();
+
+        const auto start = fml::TimePoint::Now();
+        auto engine = on_create_engine(*shell,                        //
+                                       dispatcher_maker,              //
+                                       *shell->GetDartVM(),           //
+                                       std::move(isolate_snapshot),   //
+                                       task_runners,                  //
+                                       platform_data,                 //
+                                       shell->GetSettings(),          //
+                                       std::move(animator),           //
+                                       std::move(weak_io_manager),    //
+                                       std::move(unref_queue),        //
+                                       std::move(snapshot_delegate),  //
+                                       shell->volatile_path_tracker_,
+                                       shell->is_gpu_disabled_sync_switch_);
+        startup_timeline->AddStep("Engine", start, fml::TimePoint::Now());
+        engine_promise.set_value(std::move(engine));
       }));
 
+  auto engine = engine_future.get();
+  auto rasterizer = rasterizer_future.get();
+  auto io_manager = io_manager_future.get();
+  StartupTimeline::ScopedStep step(*startup_timeline, "Setup");
   if (!shell->Setup(std::move(platform_view),  //
-                    engine_future.get(),       //
-                    rasterizer_future.get(),   //
-                    io_manager_future.get())   //
+                    std::move(engine),         //
+                    std::move(rasterizer),     //
+                    io_manager)                //
   ) {
     return nullptr;
   }
@@ -417,6 +503,10 @@ Shell::Shell(DartVMRef vm,
       vm_(std::move(vm)),
       is_gpu_disabled_sync_switch_(new fml::SyncSwitch(is_gpu_disabled)),
       volatile_path_tracker_(std::move(volatile_path_tracker)),
+      startup_timeline_(std::make_shared<StartupTimeline>()),
+      frame_scheduler_(settings.enable_predictive_frame_scheduling
+                           ? std::make_shared<FrameScheduler>()
+                           : nullptr),
       weak_factory_gpu_(nullptr),
       weak_factory_(this) {
   FML_CHECK(vm_) << "Must have access to VM to create a shell.";
@@ -438,8 +528,10 @@ Shell::Shell(DartVMRef vm,
 
   // Install service protocol handlers.
 
+  // Screenshots are encoded on worker threads while this handler waits for
+  // them, so it must not occupy the raster thread.
   service_protocol_handlers_[ServiceProtocol::kScreenshotExtensionName] = {
-      task_runners_.GetRasterTaskRunner(),
+      task_runners_.GetIOTaskRunner(),
       std::bind(&Shell::OnServiceProtocolScreenshot, this,
                 std::placeholders::_1, std::placeholders::_2)};
   service_protocol_handlers_[ServiceProtocol::kScreenshotSkpExtensionName] = {
@@ -766,6 +858,139 @@ fml::WeakPtr<PlatformView> Shell::GetPlatformView() {
   return weak_platform_view_;
 }
 
+bool Shell::AddView(int64_t view_id, const ViewportMetrics& metrics) {
+  TRACE_EVENT0("flutter", "Shell::AddView");
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+
+  if (metrics.device_pixel_ratio <= 0 || metrics.physical_width <= 0 ||
+      metrics.physical_height <= 0) {
+    FML_LOG(ERROR) << "Invalid viewport metrics for view " << view_id;
+    return false;
+  }
+
+  {
+    std::scoped_lock<std::mutex> lock(resize_mutex_);
+    if (expected_frame_sizes_.count(view_id) > 0) {
+      FML_LOG(ERROR) << "View " << view_id << " was already added.";
+      return false;
+    }
+  }
+
+  // Like in |PlatformView::NotifyCreated|, the surface is created on the
+  // raster thread while the platform view is kept alive by the latch.
+  std::unique_ptr<Surface> surface;
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [platform_view = platform_view_.get(), view_id, &surface, &latch]() {
+        surface = platform_view->CreateSurfaceForView(view_id);
+        if (surface && !surface->IsValid()) {
+          surface.reset();
+        }
+        latch.Signal();
+      });
+  latch.Wait();
+  if (!surface) {
+    FML_LOG(ERROR) << "Failed to create the rendering surface for view "
+                   << view_id;
+    return false;
+  }
+
+  {
+    std::scoped_lock<std::mutex> lock(resize_mutex_);
+    expected_frame_sizes_[view_id] =
+        SkISize::Make(metrics.physical_width, metrics.physical_height);
+  }
+
+  // The surface must be in place before the framework can render into the
+  // view.
+  task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
+      [rasterizer = rasterizer_->GetWeakPtr(), view_id,
+       surface = std::move(surface)]() mutable {
+        if (rasterizer) {
+          rasterizer->AddSurface(view_id, std::move(surface));
+        }
+      }));
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), view_id, metrics]() {
+        if (engine) {
+          engine->SetViewportMetrics(view_id, metrics);
+        }
+      });
+  return true;
+}
+
+bool Shell::RemoveView(int64_t view_id) {
+  TRACE_EVENT0("flutter", "Shell::RemoveView");
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  FML_DCHECK(view_id != kFlutterImplicitViewId);
+
+  {
+    std::scoped_lock<std::mutex> lock(resize_mutex_);
+    if (expected_frame_sizes_.erase(view_id) == 0) {
+      return false;
+    }
+  }
+
+  // The framework stops rendering into the view before its surface goes away.
+  // Frames that were already built for it are dropped by the rasterizer.
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), view_id,
+       raster_task_runner = task_runners_.GetRasterTaskRunner(),
+       rasterizer = rasterizer_->GetWeakPtr()]() {
+        if (engine) {
+          engine->RemoveView(view_id);
+        }
+        raster_task_runner->PostTask([rasterizer, view_id]() {
+          if (rasterizer) {
+            rasterizer->RemoveSurface(view_id);
+          }
+        });
+      });
+  return true;
+}
+
+bool Shell::SetViewportMetrics(int64_t view_id,
+                               const ViewportMetrics& metrics) {
+  FML_DCHECK(is_setup_);
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+
+  if (view_id == kFlutterImplicitViewId) {
+    OnPlatformViewSetViewportMetrics(metrics);
+    return true;
+  }
+
+  if (metrics.device_pixel_ratio <= 0 || metrics.physical_width <= 0 ||
+      metrics.physical_height <= 0) {
+    // Ignore invalid view-port metrics.
+    return true;
+  }
+
+  {
+    std::scoped_lock<std::mutex> lock(resize_mutex_);
+    auto expected_frame_size = expected_frame_sizes_.find(view_id);
+    if (expected_frame_size == expected_frame_sizes_.end()) {
+      FML_LOG(ERROR) << "Viewport metrics were sent for unknown view "
+                     << view_id;
+      return false;
+    }
+    expected_frame_size->second =
+        SkISize::Make(metrics.physical_width, metrics.physical_height);
+  }
+
+  task_runners_.GetUITaskRunner()->PostTask(
+      [engine = engine_->GetWeakPtr(), view_id, metrics]() {
+        if (engine) {
+          engine->SetViewportMetrics(view_id, metrics);
+        }
+      });
+  return true;
+}
+
 fml::WeakPtr<ShellIOManager> Shell::GetIOManager() {
   FML_DCHECK(is_setup_);
   return io_manager_->GetWeakPtr();
@@ -986,7 +1211,7 @@ void Shell::OnPlatformViewSetViewportMetrics(const ViewportMetrics& metrics) {
 
   {
     std::scoped_lock<std::mutex> lock(resize_mutex_);
-    expected_frame_size_ =
+    expected_frame_sizes_[kFlutterImplicitViewId] =
         SkISize::Make(metrics.physical_width, metrics.physical_height);
     device_pixel_ratio_ = metrics.device_pixel_ratio;
   }
@@ -1210,10 +1435,12 @@ void Shell::OnAnimatorUpdateLatestFrameTargetTime(
 void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
   FML_DCHECK(is_setup_);
 
-  auto discard_callback = [this](flutter::LayerTree& tree) {
+  auto discard_callback = [this](int64_t view_id, flutter::LayerTree& tree) {
     std::scoped_lock<std::mutex> lock(resize_mutex_);
-    return !expected_frame_size_.isEmpty() &&
-           tree.frame_size() != expected_frame_size_;
+    auto expected_frame_size = expected_frame_sizes_.find(view_id);
+    return expected_frame_size != expected_frame_sizes_.end() &&
+           !expected_frame_size->second.isEmpty() &&
+           tree.frame_size() != expected_frame_size->second;
   };
 
   task_runners_.GetRasterTaskRunner()->PostTask(fml::MakeCopyable(
@@ -1221,7 +1448,8 @@ void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
        &waiting_for_first_frame_condition = waiting_for_first_frame_condition_,
        rasterizer = rasterizer_->GetWeakPtr(),
        weak_pipeline = std::weak_ptr<LayerTreePipeline>(pipeline),
-       discard_callback = std::move(discard_callback)]() mutable {
+       discard_callback = std::move(discard_callback),
+       startup_timeline = startup_timeline_]() mutable {
         if (rasterizer) {
           std::shared_ptr<LayerTreePipeline> pipeline = weak_pipeline.lock();
           if (pipeline) {
@@ -1229,6 +1457,7 @@ void Shell::OnAnimatorDraw(std::shared_ptr<LayerTreePipeline> pipeline) {
           }
 
           if (waiting_for_first_frame.load()) {
+            startup_timeline->MarkFirstFrame();
             waiting_for_first_frame.store(false);
             waiting_for_first_frame_condition.notify_all();
           }
@@ -1499,6 +1728,10 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  if (frame_scheduler_) {
+    frame_scheduler_->AddFrameTiming(timing);
+  }
+
   if (!needs_report_timings_) {
     return;
   }
@@ -1575,6 +1808,20 @@ fml::TimePoint Shell::GetLatestFrameTargetTime() const {
   return latest_frame_target_time_.value();
 }
 
+// |Rasterizer::Delegate|
+void Shell::OnCriticalMemoryPressure() {
+  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
+  // Dart and the image cache of the framework hold memory the rasterizer can't
+  // free, so do what the platforms do when they report memory pressure.
+  ::Dart_NotifyLowMemory();
+  task_runners_.GetPlatformTaskRunner()->PostTask(
+      [shell = weak_factory_.GetWeakPtr()]() {
+        if (shell) {
+          shell->SendSystemNotification(kMemoryPressure);
+        }
+      });
+}
+
 // |ServiceProtocol::Handler|
 fml::RefPtr<fml::TaskRunner> Shell::GetServiceProtocolHandlerTaskRunner(
     std::string_view method) const {
@@ -1640,9 +1887,15 @@ static void ServiceProtocolFailureError(rapidjson::Document* response,
 bool Shell::OnServiceProtocolScreenshot(
     const ServiceProtocol::Handler::ServiceProtocolMap& params,
     rapidjson::Document* response) {
-  FML_DCHECK(task_runners_.GetRasterTaskRunner()->RunsTasksOnCurrentThread());
-  auto screenshot = rasterizer_->ScreenshotLastLayerTree(
-      Rasterizer::ScreenshotType::CompressedImage, true);
+  FML_DCHECK(task_runners_.GetIOTaskRunner()->RunsTasksOnCurrentThread());
+  fml::AutoResetWaitableEvent latch;
+  Rasterizer::Screenshot screenshot;
+  ScreenshotAsync({.encoding = ScreenshotEncoding::kPNG, .base64_encode = true},
+                  [&latch, &screenshot](Rasterizer::Screenshot result) {
+                    screenshot = std::move(result);
+                    latch.Signal();
+                  });
+  latch.Wait();
   if (screenshot.data) {
     response->SetObject();
     auto& allocator = response->GetAllocator();
@@ -1966,7 +2219,14 @@ bool Shell::OnServiceProtocolRenderFrameWithRasterStats(
 
     response->AddMember("snapshots", snapshots, allocator);
 
-    const auto& frame_size = expected_frame_size_;
+    SkISize frame_size = SkISize::MakeEmpty();
+    {
+      std::scoped_lock<std::mutex> lock(resize_mutex_);
+      auto found = expected_frame_sizes_.find(kFlutterImplicitViewId);
+      if (found != expected_frame_sizes_.end()) {
+        frame_size = found->second;
+      }
+    }
     response->AddMember("frame_width", frame_size.width(), allocator);
     response->AddMember("frame_height", frame_size.height(), allocator);
 
@@ -1986,22 +2246,26 @@ bool Shell::OnServiceProtocolRenderFrameWithRasterStats(
 void Shell::SendFontChangeNotification() {
   // After system fonts are reloaded, we send a system channel message
   // to notify flutter framework.
+  SendSystemNotification(kFontChange);
+}
+
+void Shell::SendSystemNotification(const char* type) {
   rapidjson::Document document;
   document.SetObject();
   auto& allocator = document.GetAllocator();
   rapidjson::Value message_value;
-  message_value.SetString(kFontChange, allocator);
+  message_value.SetString(type, allocator);
   document.AddMember(kTypeKey, message_value, allocator);
 
   rapidjson::StringBuffer buffer;
   rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
   document.Accept(writer);
   std::string message = buffer.GetString();
-  std::unique_ptr<PlatformMessage> fontsChangeMessage =
+  std::unique_ptr<PlatformMessage> system_message =
       std::make_unique<flutter::PlatformMessage>(
           kSystemChannel,
           fml::MallocMapping::Copy(message.c_str(), message.length()), nullptr);
-  OnPlatformViewDispatchPlatformMessage(std::move(fontsChangeMessage));
+  OnPlatformViewDispatchPlatformMessage(std::move(system_message));
 }
 
 bool Shell::OnServiceProtocolReloadAssetFonts(
@@ -2045,6 +2309,25 @@ Rasterizer::Screenshot Shell::Screenshot(
   return screenshot;
 }
 
+void Shell::ScreenshotAsync(const ScreenshotEncodingOptions& options,
+                            const Rasterizer::ScreenshotCallback& callback) {
+  TRACE_EVENT0("flutter", "Shell::ScreenshotAsync");
+  fml::TaskRunner::RunNowOrPostTask(
+      task_runners_.GetRasterTaskRunner(),
+      [rasterizer = GetRasterizer(),                          //
+       encode_task_runner = GetConcurrentWorkerTaskRunner(),  //
+       options,                                               //
+       callback                                               //
+  ]() {
+        if (!rasterizer || !encode_task_runner) {
+          callback({});
+          return;
+        }
+        rasterizer->ScreenshotLastLayerTreeAsync(options, encode_task_runner,
+                                                 callback);
+      });
+}
+
 fml::Status Shell::WaitForFirstFrame(fml::TimeDelta timeout) {
   FML_DCHECK(is_setup_);
   if (task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread() ||
@@ -2153,6 +2436,10 @@ const std::weak_ptr<VsyncWaiter> Shell::GetVsyncWaiter() const {
   return engine_->GetVsyncWaiter();
 }
 
+const StartupTimeline& Shell::GetStartupTimeline() const {
+  return *startup_timeline_;
+}
+
 const std::shared_ptr<fml::ConcurrentTaskRunner>
 Shell::GetConcurrentWorkerTaskRunner() const {
   FML_DCHECK(vm_);
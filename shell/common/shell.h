@@ -36,10 +36,12 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/frame_scheduler.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
 #include "flutter/shell/common/shell_io_manager.h"
+#include "flutter/shell/common/startup_timeline.h"
 
 namespace flutter {
 
@@ -267,6 +269,46 @@ class Shell final : public PlatformView::Delegate,
   ///
   fml::WeakPtr<PlatformView> GetPlatformView();
 
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to add a view that the framework can render
+  ///             into in addition to the implicit view. The rendering surface
+  ///             of the view is obtained from
+  ///             |PlatformView::CreateSurfaceForView|.
+  ///
+  /// @attention  This method must be called on the platform task runner.
+  ///
+  /// @param[in]  view_id  The ID of the new view. It must not be the ID of the
+  ///                      implicit view or of a view that was already added.
+  /// @param[in]  metrics  The initial metrics of the view.
+  ///
+  /// @return     Whether the view was added.
+  ///
+  bool AddView(int64_t view_id, const ViewportMetrics& metrics);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to remove a view added with |AddView|. The
+  ///             framework is notified first, and then the rendering surface
+  ///             of the view is released.
+  ///
+  /// @attention  This method must be called on the platform task runner.
+  ///
+  /// @param[in]  view_id  The ID of the view to remove.
+  ///
+  /// @return     Whether the view had been added.
+  ///
+  bool RemoveView(int64_t view_id);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Used by embedders to update the metrics of a view. Metrics of
+  ///             the implicit view are forwarded to the platform view
+  ///             delegate as before.
+  ///
+  /// @attention  This method must be called on the platform task runner.
+  ///
+  /// @return     Whether the view is the implicit view or was added.
+  ///
+  bool SetViewportMetrics(int64_t view_id, const ViewportMetrics& metrics);
+
   //----------------------------------------------------------------------------
   /// @brief      The IO Manager may only be accessed on the IO task runner.
   ///
@@ -312,6 +354,19 @@ class Shell final : public PlatformView::Delegate,
   Rasterizer::Screenshot Screenshot(Rasterizer::ScreenshotType type,
                                     bool base64_encode);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Captures a screenshot of the last layer tree rendered by the
+  ///             rasterizer in this shell without waiting for it. The raster
+  ///             thread only reads the pixels back, they are encoded on the
+  ///             concurrent worker task runner.
+  ///
+  /// @param[in]  options   How the screenshot is encoded.
+  /// @param[in]  callback  Invoked on a worker thread with the screenshot, or
+  ///                       with an empty screenshot if none could be captured.
+  ///
+  void ScreenshotAsync(const ScreenshotEncodingOptions& options,
+                       const Rasterizer::ScreenshotCallback& callback);
+
   //----------------------------------------------------------------------------
   /// @brief      Pauses the calling thread until the first frame is presented.
   ///
@@ -407,6 +462,12 @@ class Shell final : public PlatformView::Delegate,
   const std::shared_ptr<fml::ConcurrentTaskRunner>
   GetConcurrentWorkerTaskRunner() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief      How long each step of setting up this shell took, and how
+  ///             long it took for the first frame to reach the rasterizer.
+  ///
+  const StartupTimeline& GetStartupTimeline() const;
+
  private:
   using ServiceProtocolHandler =
       std::function<bool(const ServiceProtocol::Handler::ServiceProtocolMap&,
@@ -433,6 +494,10 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
+  const std::shared_ptr<StartupTimeline> startup_timeline_;
+  // Only set if predictive frame scheduling is enabled. Frame timings are
+  // added on the raster thread and used by the animator on the UI thread.
+  const std::shared_ptr<FrameScheduler> frame_scheduler_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
 
@@ -474,12 +539,13 @@ class Shell final : public PlatformView::Delegate,
   /// of the threads.
   std::unique_ptr<DisplayManager> display_manager_;
 
-  // protects expected_frame_size_ which is set on platform thread and read on
+  // protects expected_frame_sizes_ which is set on platform thread and read on
   // raster thread
   std::mutex resize_mutex_;
 
-  // used to discard wrong size layer tree produced during interactive resizing
-  SkISize expected_frame_size_ = SkISize::MakeEmpty();
+  // used to discard wrong size layer tree produced during interactive resizing,
+  // keyed by view ID
+  std::unordered_map<int64_t, SkISize> expected_frame_sizes_;
 
   // Used to communicate the right frame bounds via service protocol.
   double device_pixel_ratio_ = 0.0;
@@ -657,6 +723,9 @@ class Shell final : public PlatformView::Delegate,
   // |Rasterizer::Delegate|
   fml::TimePoint GetLatestFrameTargetTime() const override;
 
+  // |Rasterizer::Delegate|
+  void OnCriticalMemoryPressure() override;
+
   // |ServiceProtocol::Handler|
   fml::RefPtr<fml::TaskRunner> GetServiceProtocolHandlerTaskRunner(
       std::string_view method) const override;
@@ -733,6 +802,9 @@ class Shell final : public PlatformView::Delegate,
   // Send a system font change notification.
   void SendFontChangeNotification();
 
+  // Send a message of the given type over the system channel.
+  void SendSystemNotification(const char* type);
+
   // |ResourceCacheLimitItem|
   size_t GetResourceCacheLimit() override { return resource_cache_limit_; };
 
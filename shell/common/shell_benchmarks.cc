@@ -4,15 +4,79 @@
 
 #include "flutter/shell/common/shell.h"
 
+#include <map>
+#include <string>
+
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/run_configuration.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
 
 namespace flutter {
 
+static Settings CreateBenchmarkSettings(const fml::UniqueFD& assets_dir,
+                                       testing::ELFAOTSymbols& aot_symbols) {
+  Settings settings = {};
+  settings.task_observer_add = [](intptr_t, const fml::closure&) {};
+  settings.task_observer_remove = [](intptr_t) {};
+
+  if (DartVM::IsRunningPrecompiledCode()) {
+    aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
+        testing::kDefaultAOTAppELFFileName);
+    FML_CHECK(testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
+        << "Could not set up settings with AOT symbols.";
+  } else {
+    settings.application_kernels = [&assets_dir]() {
+      std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
+      kernel_mappings.emplace_back(
+          fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
+      return kernel_mappings;
+    };
+  }
+  return settings;
+}
+
+static std::unique_ptr<ThreadHost> CreateBenchmarkThreadHost() {
+  return std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
+      "io.flutter.bench.", ThreadHost::Type::Platform |
+                               ThreadHost::Type::RASTER |
+                               ThreadHost::Type::IO | ThreadHost::Type::UI));
+}
+
+static std::unique_ptr<Shell> CreateBenchmarkShell(
+    const Settings& settings,
+    const ThreadHost& thread_host) {
+  TaskRunners task_runners("test",
+                           thread_host.platform_thread->GetTaskRunner(),
+                           thread_host.raster_thread->GetTaskRunner(),
+                           thread_host.ui_thread->GetTaskRunner(),
+                           thread_host.io_thread->GetTaskRunner());
+
+  return Shell::Create(
+      flutter::PlatformData(), task_runners, settings,
+      [](Shell& shell) {
+        return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
+      },
+      [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+}
+
+static void DestroyBenchmarkShell(std::unique_ptr<Shell>& shell,
+                                  std::unique_ptr<ThreadHost>& thread_host) {
+  // Shutdown must occur synchronously on the platform thread.
+  fml::AutoResetWaitableEvent latch;
+  fml::TaskRunner::RunNowOrPostTask(
+      thread_host->platform_thread->GetTaskRunner(),
+      [&shell, &latch]() mutable {
+        shell.reset();
+        latch.Signal();
+      });
+  latch.Wait();
+  thread_host.reset();
+}
+
 static void StartupAndShutdownShell(benchmark::State& state,
                                     bool measure_startup,
                                     bool measure_shutdown) {
@@ -24,42 +88,9 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_startup);
-    Settings settings = {};
-    settings.task_observer_add = [](intptr_t, const fml::closure&) {};
-    settings.task_observer_remove = [](intptr_t) {};
-
-    if (DartVM::IsRunningPrecompiledCode()) {
-      aot_symbols = testing::LoadELFSymbolFromFixturesIfNeccessary(
-          testing::kDefaultAOTAppELFFileName);
-      FML_CHECK(
-          testing::PrepareSettingsForAOTWithSymbols(settings, aot_symbols))
-          << "Could not set up settings with AOT symbols.";
-    } else {
-      settings.application_kernels = [&]() {
-        std::vector<std::unique_ptr<const fml::Mapping>> kernel_mappings;
-        kernel_mappings.emplace_back(
-            fml::FileMapping::CreateReadOnly(assets_dir, "kernel_blob.bin"));
-        return kernel_mappings;
-      };
-    }
-
-    thread_host = std::make_unique<ThreadHost>(ThreadHost::ThreadHostConfig(
-        "io.flutter.bench.", ThreadHost::Type::Platform |
-                                 ThreadHost::Type::RASTER |
-                                 ThreadHost::Type::IO | ThreadHost::Type::UI));
-
-    TaskRunners task_runners("test",
-                             thread_host->platform_thread->GetTaskRunner(),
-                             thread_host->raster_thread->GetTaskRunner(),
-                             thread_host->ui_thread->GetTaskRunner(),
-                             thread_host->io_thread->GetTaskRunner());
-
-    shell = Shell::Create(
-        flutter::PlatformData(), task_runners, settings,
-        [](Shell& shell) {
-          return std::make_unique<PlatformView>(shell, shell.GetTaskRunners());
-        },
-        [](Shell& shell) { return std::make_unique<Rasterizer>(shell); });
+    Settings settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+    thread_host = CreateBenchmarkThreadHost();
+    shell = CreateBenchmarkShell(settings, *thread_host);
   }
 
   FML_CHECK(shell);
@@ -81,16 +112,7 @@ static void StartupAndShutdownShell(benchmark::State& state,
 
   {
     benchmarking::ScopedPauseTiming pause(state, !measure_shutdown);
-    // Shutdown must occur synchronously on the platform thread.
-    fml::AutoResetWaitableEvent latch;
-    fml::TaskRunner::RunNowOrPostTask(
-        thread_host->platform_thread->GetTaskRunner(),
-        [&shell, &latch]() mutable {
-          shell.reset();
-          latch.Signal();
-        });
-    latch.Wait();
-    thread_host.reset();
+    DestroyBenchmarkShell(shell, thread_host);
   }
 
   FML_CHECK(!shell);
@@ -120,4 +142,65 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+// Measures the time from creating a shell until its first frame reaches the
+// rasterizer. The platform view has no surface, so the frame isn't drawn.
+// Where in that time each setup step of the shell ended is reported in
+// milliseconds as a counter named after the step.
+static void BM_ShellTimeToFirstFrame(benchmark::State& state) {
+  auto assets_dir = fml::OpenDirectory(testing::GetFixturesPath(), false,
+                                       fml::FilePermission::kRead);
+  std::map<std::string, double> step_ends;
+  double time_to_first_frame = 0;
+
+  while (state.KeepRunning()) {
+    std::unique_ptr<Shell> shell;
+    std::unique_ptr<ThreadHost> thread_host;
+    testing::ELFAOTSymbols aot_symbols;
+    Settings settings;
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      settings = CreateBenchmarkSettings(assets_dir, aot_symbols);
+      thread_host = CreateBenchmarkThreadHost();
+    }
+
+    shell = CreateBenchmarkShell(settings, *thread_host);
+    FML_CHECK(shell);
+
+    fml::AutoResetWaitableEvent latch;
+    fml::TaskRunner::RunNowOrPostTask(
+        thread_host->platform_thread->GetTaskRunner(),
+        [&shell, &settings, &latch]() {
+          // Frames with an empty size are dropped by the engine.
+          shell->GetPlatformView()->SetViewportMetrics({1.0, 800, 600, 22, 0});
+          auto configuration = RunConfiguration::InferFromSettings(settings);
+          configuration.SetEntrypoint("renderFirstFrame");
+          shell->RunEngine(std::move(configuration));
+          latch.Signal();
+        });
+    latch.Wait();
+    FML_CHECK(shell->WaitForFirstFrame(fml::TimeDelta::FromSeconds(10)).ok())
+        << "The first frame didn't reach the rasterizer.";
+
+    {
+      benchmarking::ScopedPauseTiming pause(state);
+      const auto& timeline = shell->GetStartupTimeline();
+      for (const auto& step : timeline.GetSteps()) {
+        step_ends[step.name] += step.end.ToMillisecondsF();
+      }
+      time_to_first_frame +=
+          timeline.GetTimeToFirstFrame().value().ToMillisecondsF();
+      DestroyBenchmarkShell(shell, thread_host);
+    }
+  }
+
+  for (const auto& [name, end] : step_ends) {
+    state.counters[name] =
+        benchmark::Counter(end, benchmark::Counter::kAvgIterations);
+  }
+  state.counters["FirstFrame"] = benchmark::Counter(
+      time_to_first_frame, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_ShellTimeToFirstFrame)->Unit(benchmark::kMillisecond);
+
 }  // namespace flutter
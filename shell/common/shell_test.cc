@@ -6,6 +6,7 @@
 
 #include "flutter/shell/common/shell_test.h"
 
+#include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/transform_layer.h"
@@ -215,7 +216,8 @@ void ShellTest::PumpOneFrame(Shell* shell,
         if (builder) {
           builder(root_layer);
         }
-        runtime_delegate->Render(std::move(layer_tree), device_pixel_ratio);
+        runtime_delegate->Render(kFlutterImplicitViewId, std::move(layer_tree),
+                                 device_pixel_ratio);
         latch.Signal();
       });
   latch.Wait();
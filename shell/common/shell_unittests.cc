@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <ctime>
 #include <future>
 #include <memory>
@@ -1496,6 +1497,42 @@ TEST_F(ShellTest, WaitForFirstFrame) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, StartupTimelineRecordsSetupStepsAndFirstFrame) {
+  auto settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  ASSERT_TRUE(ValidateShell(shell.get()));
+
+  const StartupTimeline& timeline = shell->GetStartupTimeline();
+  std::vector<std::string> names;
+  fml::TimeDelta setup_end;
+  for (const auto& step : timeline.GetSteps()) {
+    ASSERT_LE(step.start, step.end);
+    names.push_back(step.name);
+    if (step.name == "Setup") {
+      setup_end = step.end;
+    }
+  }
+  for (const char* name : {"PlatformView", "Rasterizer", "IOManager",
+                           "VsyncWaiter", "Engine", "Setup"}) {
+    ASSERT_NE(std::find(names.begin(), names.end(), name), names.end())
+        << name;
+  }
+  ASSERT_FALSE(timeline.GetTimeToFirstFrame().has_value());
+
+  PlatformViewNotifyCreated(shell.get());
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  configuration.SetEntrypoint("emptyMain");
+  RunEngine(shell.get(), std::move(configuration));
+  PumpOneFrame(shell.get());
+  ASSERT_TRUE(shell->WaitForFirstFrame(fml::TimeDelta::Max()).ok());
+
+  auto time_to_first_frame = timeline.GetTimeToFirstFrame();
+  ASSERT_TRUE(time_to_first_frame.has_value());
+  ASSERT_GE(time_to_first_frame.value(), setup_end);
+
+  DestroyShell(std::move(shell));
+}
+
 TEST_F(ShellTest, WaitForFirstFrameZeroSizeFrame) {
   auto settings = CreateSettingsForFixture();
   std::unique_ptr<Shell> shell = CreateShell(settings);
@@ -2409,6 +2446,42 @@ TEST_F(ShellTest, RasterizerScreenshot) {
   DestroyShell(std::move(shell), task_runners);
 }
 
+TEST_F(ShellTest, ScreenshotAsyncEncodesOnWorkerThread) {
+  Settings settings = CreateSettingsForFixture();
+  auto configuration = RunConfiguration::InferFromSettings(settings);
+  auto task_runner = CreateNewThread();
+  TaskRunners task_runners("test", task_runner, task_runner, task_runner,
+                           task_runner);
+  std::unique_ptr<Shell> shell = CreateShell(settings, task_runners);
+
+  ASSERT_TRUE(ValidateShell(shell.get()));
+  PlatformViewNotifyCreated(shell.get());
+
+  RunEngine(shell.get(), std::move(configuration));
+
+  PumpOneFrame(shell.get());
+
+  fml::AutoResetWaitableEvent latch;
+  Rasterizer::Screenshot screenshot;
+  bool encoded_on_raster_thread = true;
+  shell->ScreenshotAsync(
+      {.encoding = ScreenshotEncoding::kQOI},
+      [&](Rasterizer::Screenshot result) {
+        encoded_on_raster_thread = task_runner->RunsTasksOnCurrentThread();
+        screenshot = std::move(result);
+        latch.Signal();
+      });
+  latch.Wait();
+
+  EXPECT_FALSE(encoded_on_raster_thread);
+  ASSERT_NE(screenshot.data, nullptr);
+  ASSERT_GT(screenshot.data->size(), 4u);
+  EXPECT_EQ(memcmp(screenshot.data->data(), "qoif", 4), 0);
+  EXPECT_FALSE(screenshot.frame_size.isEmpty());
+  EXPECT_EQ(screenshot.format, "ScreenshotEncoding::kQOI");
+  DestroyShell(std::move(shell), task_runners);
+}
+
 TEST_F(ShellTest, RasterizerMakeRasterSnapshot) {
   Settings settings = CreateSettingsForFixture();
   auto configuration = RunConfiguration::InferFromSettings(settings);
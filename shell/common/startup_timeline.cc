@@ -0,0 +1,49 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/startup_timeline.h"
+
+#include <utility>
+
+namespace flutter {
+
+StartupTimeline::ScopedStep::ScopedStep(StartupTimeline& timeline,
+                                        std::string name)
+    : timeline_(timeline),
+      name_(std::move(name)),
+      start_(fml::TimePoint::Now()) {}
+
+StartupTimeline::ScopedStep::~ScopedStep() {
+  timeline_.AddStep(std::move(name_), start_, fml::TimePoint::Now());
+}
+
+StartupTimeline::StartupTimeline(fml::TimePoint origin) : origin_(origin) {}
+
+StartupTimeline::~StartupTimeline() = default;
+
+void StartupTimeline::AddStep(std::string name,
+                              fml::TimePoint start,
+                              fml::TimePoint end) {
+  std::scoped_lock lock(mutex_);
+  steps_.push_back({std::move(name), start - origin_, end - origin_});
+}
+
+void StartupTimeline::MarkFirstFrame(fml::TimePoint time) {
+  std::scoped_lock lock(mutex_);
+  if (!time_to_first_frame_.has_value()) {
+    time_to_first_frame_ = time - origin_;
+  }
+}
+
+std::vector<StartupTimeline::Step> StartupTimeline::GetSteps() const {
+  std::scoped_lock lock(mutex_);
+  return steps_;
+}
+
+std::optional<fml::TimeDelta> StartupTimeline::GetTimeToFirstFrame() const {
+  std::scoped_lock lock(mutex_);
+  return time_to_first_frame_;
+}
+
+}  // namespace flutter
@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
+#define FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Records when each step of launching a shell started and ended,
+///             relative to when the launch started.
+///
+///             Independent steps run on different threads at the same time, so
+///             the steps may overlap. Steps can be added from any thread.
+///
+class StartupTimeline {
+ public:
+  struct Step {
+    std::string name;
+    fml::TimeDelta start;
+    fml::TimeDelta end;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the time between its construction and destruction to the
+  ///             timeline as a step.
+  ///
+  class ScopedStep {
+   public:
+    ScopedStep(StartupTimeline& timeline, std::string name);
+
+    ~ScopedStep();
+
+   private:
+    StartupTimeline& timeline_;
+    std::string name_;
+    const fml::TimePoint start_;
+
+    FML_DISALLOW_COPY_AND_ASSIGN(ScopedStep);
+  };
+
+  explicit StartupTimeline(fml::TimePoint origin = fml::TimePoint::Now());
+
+  ~StartupTimeline();
+
+  fml::TimePoint GetOrigin() const { return origin_; }
+
+  void AddStep(std::string name, fml::TimePoint start, fml::TimePoint end);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Record that the first frame reached the rasterizer. Only the
+  ///             first call has an effect.
+  ///
+  void MarkFirstFrame(fml::TimePoint time = fml::TimePoint::Now());
+
+  //----------------------------------------------------------------------------
+  /// @return     The steps in the order in which they ended.
+  ///
+  std::vector<Step> GetSteps() const;
+
+  //----------------------------------------------------------------------------
+  /// @return     The time from the start of the launch to the first frame, if
+  ///             there was one yet.
+  ///
+  std::optional<fml::TimeDelta> GetTimeToFirstFrame() const;
+
+ private:
+  const fml::TimePoint origin_;
+  mutable std::mutex mutex_;
+  std::vector<Step> steps_;
+  std::optional<fml::TimeDelta> time_to_first_frame_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(StartupTimeline);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_STARTUP_TIMELINE_H_
@@ -471,6 +471,28 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
+  settings.enable_predictive_frame_scheduling = command_line.HasOption(
+      FlagForSwitch(Switch::EnablePredictiveFrameScheduling));
+
+  settings.enable_latest_frame_wins = command_line.HasOption(
+      FlagForSwitch(Switch::EnableLatestFrameWins));
+
+  settings.enable_adaptive_resource_cache = command_line.HasOption(
+      FlagForSwitch(Switch::EnableAdaptiveResourceCache));
+
+  if (command_line.HasOption(FlagForSwitch(Switch::ResidentMemoryBudget))) {
+    std::string resident_memory_budget;
+    command_line.GetOptionValue(FlagForSwitch(Switch::ResidentMemoryBudget),
+                                &resident_memory_budget);
+    settings.resident_memory_budget_mb = std::stoi(resident_memory_budget);
+  }
+
+  settings.enable_pointer_resampling =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerResampling));
+  settings.enable_pointer_batching =
+      settings.enable_pointer_resampling ||
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerBatching));
+
   std::string all_dart_flags;
   if (command_line.GetOptionValue(FlagForSwitch(Switch::DartFlags),
                                   &all_dart_flags)) {
@@ -213,6 +213,34 @@ DEF_SWITCH(PrefetchedDefaultFontManager,
            "prefetched-default-font-manager",
            "Indicates whether the embedding started a prefetch of the "
            "default font manager before creating the engine.")
+DEF_SWITCH(EnablePredictiveFrameScheduling,
+           "enable-predictive-frame-scheduling",
+           "Start building frames as late as the recent build and raster "
+           "times allow, and only pipeline frames when they don't fit in a "
+           "frame interval.")
+DEF_SWITCH(EnableLatestFrameWins,
+           "enable-latest-frame-wins",
+           "When the rasterizer falls behind, replace the frame that is "
+           "waiting to be rasterized with the newer one instead of skipping "
+           "the newer one.")
+DEF_SWITCH(EnableAdaptiveResourceCache,
+           "enable-adaptive-resource-cache",
+           "Adjust the limits of the resource cache and of the raster cache to "
+           "how well they are used and to the memory pressure on the process.")
+DEF_SWITCH(ResidentMemoryBudget,
+           "resident-memory-budget-mb",
+           "The resident set size in megabytes above which the adaptive "
+           "resource cache shrinks the caches. Defaults to a share of the "
+           "physical memory of the device.")
+DEF_SWITCH(EnablePointerBatching,
+           "enable-pointer-batching",
+           "Hold pointer events until the next vsync and coalesce the moves of "
+           "each pointer in between, so that input devices that report faster "
+           "than the display refreshes don't flood the framework.")
+DEF_SWITCH(EnablePointerResampling,
+           "enable-pointer-resampling",
+           "Batch pointer events and resample the positions of pointer moves "
+           "to the vsync time.")
 DEF_SWITCH(VerboseLogging,
            "verbose-logging",
            "By default, only errors are logged. This flag enabled logging at "
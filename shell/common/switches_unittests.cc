@@ -115,6 +115,21 @@ TEST(SwitchesTest, NoEnableImpeller) {
   }
 }
 
+TEST(SwitchesTest, ResidentMemoryBudget) {
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--resident-memory-budget-mb=512"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.resident_memory_budget_mb, 512u);
+  }
+  {
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.resident_memory_budget_mb, 0u);
+  }
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -4,7 +4,11 @@
 
 #include "flutter/shell/common/vsync_waiter.h"
 
+#include <algorithm>
+#include <tuple>
+
 #include "flow/frame_timings.h"
+#include "flutter/fml/make_copyable.h"
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/trace_event.h"
 #include "fml/logging.h"
@@ -18,8 +22,12 @@ static constexpr const char* kVsyncFlowName = "VsyncFlow";
 
 static constexpr const char* kVsyncTraceName = "VsyncProcessCallback";
 
+static constexpr const char* kDefaultSecondaryCallbackName =
+    "VsyncWaiter::SecondaryCallback";
+
 VsyncWaiter::VsyncWaiter(const TaskRunners& task_runners)
-    : task_runners_(task_runners) {}
+    : task_runners_(task_runners),
+      secondary_callback_delays_(std::make_shared<SecondaryCallbackDelays>()) {}
 
 VsyncWaiter::~VsyncWaiter() = default;
 
@@ -52,6 +60,19 @@ void VsyncWaiter::AsyncWaitForVsync(const Callback& callback) {
 
 void VsyncWaiter::ScheduleSecondaryCallback(uintptr_t id,
                                             const fml::closure& callback) {
+  if (!callback) {
+    return;
+  }
+  ScheduleSecondaryCallback(
+      id, kDefaultSecondaryCallbackName, SecondaryCallbackPriority::kDefault,
+      [callback](fml::TimePoint, fml::TimePoint) { callback(); });
+}
+
+void VsyncWaiter::ScheduleSecondaryCallback(
+    uintptr_t id,
+    const char* name,
+    SecondaryCallbackPriority priority,
+    const SecondaryCallback& callback) {
   FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
 
   if (!callback) {
@@ -63,7 +84,13 @@ void VsyncWaiter::ScheduleSecondaryCallback(uintptr_t id,
   {
     std::scoped_lock lock(callback_mutex_);
     bool secondary_callbacks_originally_empty = secondary_callbacks_.empty();
-    auto [_, inserted] = secondary_callbacks_.emplace(id, callback);
+    auto [_, inserted] = secondary_callbacks_.emplace(
+        id, PendingSecondaryCallback{
+                .name = name,
+                .priority = priority,
+                .sequence = secondary_callback_sequence_++,
+                .callback = callback,
+            });
     if (!inserted) {
       // Multiple schedules must result in a single callback per frame interval.
       TRACE_EVENT_INSTANT0("flutter",
@@ -90,11 +117,12 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
   FML_DCHECK(fml::TimePoint::Now() >= frame_start_time);
 
   Callback callback;
-  std::vector<fml::closure> secondary_callbacks;
+  std::vector<PendingSecondaryCallback> secondary_callbacks;
 
   {
     std::scoped_lock lock(callback_mutex_);
     callback = std::move(callback_);
+    secondary_callbacks.reserve(secondary_callbacks_.size());
     for (auto& pair : secondary_callbacks_) {
       secondary_callbacks.push_back(std::move(pair.second));
     }
@@ -143,11 +171,57 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
         });
   }
 
-  for (auto& secondary_callback : secondary_callbacks) {
-    task_runners_.GetUITaskRunner()->PostTask(secondary_callback);
+  if (!secondary_callbacks.empty()) {
+    std::sort(secondary_callbacks.begin(), secondary_callbacks.end(),
+              [](const PendingSecondaryCallback& a,
+                 const PendingSecondaryCallback& b) {
+                return std::tie(a.priority, a.sequence) <
+                       std::tie(b.priority, b.sequence);
+              });
+    task_runners_.GetUITaskRunner()->PostTask(fml::MakeCopyable(
+        [secondary_callbacks = std::move(secondary_callbacks),
+         delays = secondary_callback_delays_, frame_start_time,
+         frame_target_time]() mutable {
+          InvokeSecondaryCallbacks(std::move(secondary_callbacks),
+                                   frame_start_time, frame_target_time,
+                                   *delays);
+        }));
   }
 }
 
+void VsyncWaiter::InvokeSecondaryCallbacks(
+    std::vector<PendingSecondaryCallback> callbacks,
+    fml::TimePoint frame_start_time,
+    fml::TimePoint frame_target_time,
+    SecondaryCallbackDelays& delays) {
+  TRACE_EVENT0("flutter", "VsyncWaiter::InvokeSecondaryCallbacks");
+  for (auto& pending : callbacks) {
+    const fml::TimeDelta delay = fml::TimePoint::Now() - frame_start_time;
+    {
+      std::scoped_lock lock(delays.mutex);
+      auto& subscriber_delay = delays.delays[pending.name];
+      subscriber_delay.count++;
+      subscriber_delay.last = delay;
+      subscriber_delay.max = std::max(subscriber_delay.max, delay);
+      subscriber_delay.total = subscriber_delay.total + delay;
+    }
+#if !FLUTTER_RELEASE
+    FML_TRACE_COUNTER("flutter", "SecondaryVsyncCallbackDelay",
+                      reinterpret_cast<int64_t>(&delays), pending.name,
+                      delay.ToMicroseconds());
+#endif  // !FLUTTER_RELEASE
+    TRACE_EVENT1("flutter", "VsyncWaiter::SecondaryCallback", "subscriber",
+                 pending.name);
+    pending.callback(frame_start_time, frame_target_time);
+  }
+}
+
+std::unordered_map<std::string, VsyncWaiter::SecondaryCallbackDelay>
+VsyncWaiter::GetSecondaryCallbackDelays() const {
+  std::scoped_lock lock(secondary_callback_delays_->mutex);
+  return secondary_callback_delays_->delays;
+}
+
 void VsyncWaiter::PauseDartMicroTasks() {
   auto ui_task_queue_id = task_runners_.GetUITaskRunner()->GetTaskQueueId();
   auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
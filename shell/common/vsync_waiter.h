@@ -8,10 +8,13 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "flutter/common/task_runners.h"
 #include "flutter/flow/frame_timings.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace flutter {
@@ -22,6 +25,31 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
  public:
   using Callback = std::function<void(std::unique_ptr<FrameTimingsRecorder>)>;
 
+  using SecondaryCallback =
+      std::function<void(fml::TimePoint frame_start_time,
+                         fml::TimePoint frame_target_time)>;
+
+  /// The order in which the secondary callbacks of a vsync are invoked.
+  /// Callbacks with the same priority are invoked in the order they were
+  /// scheduled.
+  enum class SecondaryCallbackPriority {
+    /// Consumers of input that everything else reacting to the vsync should
+    /// see the result of, such as pointer data dispatch.
+    kInput,
+    /// Animations and physics that depend on the latest input.
+    kAnimation,
+    kDefault,
+  };
+
+  /// The delay between vsyncs and the invocation of the secondary callbacks
+  /// of one subscriber.
+  struct SecondaryCallbackDelay {
+    size_t count = 0;
+    fml::TimeDelta last;
+    fml::TimeDelta max;
+    fml::TimeDelta total;
+  };
+
   virtual ~VsyncWaiter();
 
   void AsyncWaitForVsync(const Callback& callback);
@@ -32,6 +60,21 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
   /// |Animator::ScheduleMaybeClearTraceFlowIds|.
   void ScheduleSecondaryCallback(uintptr_t id, const fml::closure& callback);
 
+  /// Add a secondary callback for key |id| for the next vsync.
+  ///
+  /// All the secondary callbacks of a vsync are invoked from a single task on
+  /// the UI task runner, in the order of their |priority|, with the timing of
+  /// the vsync. The delay between the vsync and the invocation is recorded for
+  /// the subscriber |name|, which must outlive the waiter.
+  void ScheduleSecondaryCallback(uintptr_t id,
+                                 const char* name,
+                                 SecondaryCallbackPriority priority,
+                                 const SecondaryCallback& callback);
+
+  /// The delays of the secondary callbacks invoked so far, by subscriber name.
+  std::unordered_map<std::string, SecondaryCallbackDelay>
+  GetSecondaryCallbackDelays() const;
+
  protected:
   // On some backends, the |FireCallback| needs to be made from a static C
   // method.
@@ -72,13 +115,35 @@ class VsyncWaiter : public std::enable_shared_from_this<VsyncWaiter> {
                     bool pause_secondary_tasks = true);
 
  private:
+  struct PendingSecondaryCallback {
+    const char* name;
+    SecondaryCallbackPriority priority;
+    size_t sequence;
+    SecondaryCallback callback;
+  };
+
+  // Shared with the tasks that invoke secondary callbacks, which may outlive
+  // the waiter.
+  struct SecondaryCallbackDelays {
+    std::mutex mutex;
+    std::unordered_map<std::string, SecondaryCallbackDelay> delays;
+  };
+
   std::mutex callback_mutex_;
   Callback callback_;
-  std::unordered_map<uintptr_t, fml::closure> secondary_callbacks_;
+  std::unordered_map<uintptr_t, PendingSecondaryCallback> secondary_callbacks_;
+  size_t secondary_callback_sequence_ = 0;
+  const std::shared_ptr<SecondaryCallbackDelays> secondary_callback_delays_;
 
   void PauseDartMicroTasks();
   static void ResumeDartMicroTasks(fml::TaskQueueId ui_task_queue_id);
 
+  static void InvokeSecondaryCallbacks(
+      std::vector<PendingSecondaryCallback> callbacks,
+      fml::TimePoint frame_start_time,
+      fml::TimePoint frame_target_time,
+      SecondaryCallbackDelays& delays);
+
   FML_DISALLOW_COPY_AND_ASSIGN(VsyncWaiter);
 };
 
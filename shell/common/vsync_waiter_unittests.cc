@@ -1,9 +1,12 @@
 #define FML_USED_ON_EMBEDDER
 
 #include <initializer_list>
+#include <string>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/fml/message_loop.h"
 #include "flutter/shell/common/switches.h"
 
 #include "gtest/gtest.h"
@@ -20,6 +23,11 @@ class TestVsyncWaiter : public VsyncWaiter {
 
   int await_vsync_call_count_ = 0;
 
+  void FireVsync(fml::TimePoint frame_start_time,
+                 fml::TimePoint frame_target_time) {
+    FireCallback(frame_start_time, frame_target_time);
+  }
+
  protected:
   void AwaitVSync() override { await_vsync_call_count_++; }
 };
@@ -43,5 +51,75 @@ TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
 }
 
+TEST(VsyncWaiterTest, SecondaryCallbacksAreInvokedInPriorityOrder) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+  const flutter::TaskRunners task_runners("vsync_waiter_test", task_runner,
+                                          task_runner, task_runner,
+                                          task_runner);
+  TestVsyncWaiter vsync_waiter(task_runners);
+
+  using Priority = VsyncWaiter::SecondaryCallbackPriority;
+  std::vector<std::string> invoked;
+  const auto record = [&invoked](const char* name) {
+    return [&invoked, name](fml::TimePoint, fml::TimePoint) {
+      invoked.push_back(name);
+    };
+  };
+  vsync_waiter.ScheduleSecondaryCallback(1, "default", Priority::kDefault,
+                                         record("default"));
+  vsync_waiter.ScheduleSecondaryCallback(2, "animation", Priority::kAnimation,
+                                         record("animation"));
+  vsync_waiter.ScheduleSecondaryCallback(3, "input", Priority::kInput,
+                                         record("input"));
+  vsync_waiter.ScheduleSecondaryCallback(4, [&invoked] {
+    invoked.push_back("closure");
+  });
+  EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
+
+  const auto now = fml::TimePoint::Now();
+  vsync_waiter.FireVsync(now, now + fml::TimeDelta::FromMilliseconds(16));
+  fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+
+  EXPECT_EQ(invoked, (std::vector<std::string>{"input", "animation",
+                                               "default", "closure"}));
+}
+
+TEST(VsyncWaiterTest, SecondaryCallbacksGetVsyncTimingAndRecordDelays) {
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto task_runner = fml::MessageLoop::GetCurrent().GetTaskRunner();
+  const flutter::TaskRunners task_runners("vsync_waiter_test", task_runner,
+                                          task_runner, task_runner,
+                                          task_runner);
+  TestVsyncWaiter vsync_waiter(task_runners);
+
+  const auto frame_start_time =
+      fml::TimePoint::Now() - fml::TimeDelta::FromMilliseconds(4);
+  const auto frame_target_time =
+      frame_start_time + fml::TimeDelta::FromMilliseconds(16);
+  for (int i = 0; i < 2; i++) {
+    fml::TimePoint start_time;
+    fml::TimePoint target_time;
+    vsync_waiter.ScheduleSecondaryCallback(
+        1, "subscriber", VsyncWaiter::SecondaryCallbackPriority::kDefault,
+        [&](fml::TimePoint start, fml::TimePoint target) {
+          start_time = start;
+          target_time = target;
+        });
+    vsync_waiter.FireVsync(frame_start_time, frame_target_time);
+    fml::MessageLoop::GetCurrent().RunExpiredTasksNow();
+    EXPECT_EQ(start_time, frame_start_time);
+    EXPECT_EQ(target_time, frame_target_time);
+  }
+
+  auto delays = vsync_waiter.GetSecondaryCallbackDelays();
+  ASSERT_EQ(delays.count("subscriber"), 1u);
+  const auto& delay = delays["subscriber"];
+  EXPECT_EQ(delay.count, 2u);
+  EXPECT_GE(delay.last, fml::TimeDelta::FromMilliseconds(4));
+  EXPECT_GE(delay.max, delay.last);
+  EXPECT_GE(delay.total, delay.max + fml::TimeDelta::FromMilliseconds(4));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -10,7 +10,9 @@
 #include "flutter/common/settings.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/paths.h"
 #include "flutter/fml/trace_event.h"
+#include "flutter/impeller/display_list/dl_backdrop_key_collector.h"
 #include "flutter/impeller/display_list/dl_dispatcher.h"
 #include "flutter/impeller/renderer/backend/metal/surface_mtl.h"
 
@@ -37,6 +39,7 @@ GPUSurfaceMetalImpeller::GPUSurfaceMetalImpeller(GPUSurfaceMetalDelegate* delega
       aiks_context_(
           std::make_shared<impeller::AiksContext>(impeller_renderer_ ? context : nullptr)),
       render_to_surface_(render_to_surface) {
+  aiks_context_->EnablePipelineUsageProfile(fml::paths::GetCachesDirectory());
   // If this preference is explicitly set, we allow for disabling partial repaint.
   NSNumber* disablePartialRepaint =
       [[NSBundle mainBundle] objectForInfoDictionaryKey:@"FLTDisablePartialRepaint"];
@@ -151,6 +154,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromCAMetalLa
         impeller::IRect cull_rect = surface->coverage();
         SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.size.width, cull_rect.size.height);
         impeller::DlDispatcher impeller_dispatcher(cull_rect);
+        impeller_dispatcher.SetBackdropContentKeys(
+            impeller::DlBackdropKeyCollector::Collect(*display_list, SkRect::Make(sk_cull_rect)));
         display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
@@ -249,6 +254,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceMetalImpeller::AcquireFrameFromMTLTextur
         impeller::IRect cull_rect = surface->coverage();
         SkIRect sk_cull_rect = SkIRect::MakeWH(cull_rect.size.width, cull_rect.size.height);
         impeller::DlDispatcher impeller_dispatcher(cull_rect);
+        impeller_dispatcher.SetBackdropContentKeys(
+            impeller::DlBackdropKeyCollector::Collect(*display_list, SkRect::Make(sk_cull_rect)));
         display_list->Dispatch(impeller_dispatcher, sk_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
@@ -5,6 +5,8 @@
 #include "flutter/shell/gpu/gpu_surface_vulkan_impeller.h"
 
 #include "flutter/fml/make_copyable.h"
+#include "flutter/fml/paths.h"
+#include "flutter/impeller/display_list/dl_backdrop_key_collector.h"
 #include "flutter/impeller/display_list/dl_dispatcher.h"
 #include "flutter/impeller/renderer/renderer.h"
 #include "impeller/renderer/backend/vulkan/context_vk.h"
@@ -26,6 +28,7 @@ GPUSurfaceVulkanImpeller::GPUSurfaceVulkanImpeller(
   if (!aiks_context->IsValid()) {
     return;
   }
+  aiks_context->EnablePipelineUsageProfile(fml::paths::GetCachesDirectory());
 
   impeller_context_ = std::move(context);
   impeller_renderer_ = std::move(renderer);
@@ -75,10 +78,14 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceVulkanImpeller::AcquireFrame(
         auto cull_rect =
             surface->GetTargetRenderPassDescriptor().GetRenderTargetSize();
 
+        auto dispatch_cull_rect =
+            SkRect::MakeIWH(cull_rect.width, cull_rect.height);
+
         impeller::DlDispatcher impeller_dispatcher;
-        display_list->Dispatch(
-            impeller_dispatcher,
-            SkIRect::MakeWH(cull_rect.width, cull_rect.height));
+        impeller_dispatcher.SetBackdropContentKeys(
+            impeller::DlBackdropKeyCollector::Collect(*display_list,
+                                                      dispatch_cull_rect));
+        display_list->Dispatch(impeller_dispatcher, dispatch_cull_rect);
         auto picture = impeller_dispatcher.EndRecordingAsPicture();
 
         return renderer->Render(
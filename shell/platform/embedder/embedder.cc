@@ -10,6 +10,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <variant>
 #include <vector>
 
 #include "flutter/fml/build_config.h"
@@ -40,6 +41,7 @@ extern const intptr_t kPlatformStrongDillSize;
 }
 
 #include "flutter/assets/directory_asset_bundle.h"
+#include "flutter/common/constants.h"
 #include "flutter/common/graphics/persistent_cache.h"
 #include "flutter/common/task_runners.h"
 #include "flutter/fml/command_line.h"
@@ -648,9 +650,23 @@ InferSoftwarePlatformViewCreationCallback(
     return ptr(user_data, allocation, row_bytes, height);
   };
 
+  std::function<bool(int64_t view_id, const void* allocation, size_t row_bytes,
+                     size_t height)>
+      software_present_view_backing_store;
+  const FlutterSoftwareRendererConfig* software_config = &config->software;
+  if (auto ptr = SAFE_ACCESS(software_config, surface_present_view_callback,
+                             nullptr)) {
+    software_present_view_backing_store =
+        [ptr, user_data](int64_t view_id, const void* allocation,
+                         size_t row_bytes, size_t height) -> bool {
+      return ptr(user_data, view_id, allocation, row_bytes, height);
+    };
+  }
+
   flutter::EmbedderSurfaceSoftware::SoftwareDispatchTable
       software_dispatch_table = {
-          software_present_backing_store,  // required
+          software_present_backing_store,       // required
+          software_present_view_backing_store,  // optional
       };
 
   return fml::MakeCopyable(
@@ -2180,13 +2196,11 @@ FlutterEngineResult FlutterEngineShutdown(FLUTTER_API_SYMBOL(FlutterEngine)
   return kSuccess;
 }
 
-FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
-    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+// Validates the metrics of a view sent by the embedder, returning an error
+// message if they are invalid.
+static std::variant<flutter::ViewportMetrics, std::string>
+MakeViewportMetricsFromWindowMetrics(
     const FlutterWindowMetricsEvent* flutter_metrics) {
-  if (engine == nullptr || flutter_metrics == nullptr) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
-  }
-
   flutter::ViewportMetrics metrics;
 
   metrics.physical_width = SAFE_ACCESS(flutter_metrics, width, 0.0);
@@ -2203,36 +2217,102 @@ FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
   metrics.display_id = SAFE_ACCESS(flutter_metrics, display_id, 0);
 
   if (metrics.device_pixel_ratio <= 0.0) {
-    return LOG_EMBEDDER_ERROR(
-        kInvalidArguments,
-        "Device pixel ratio was invalid. It must be greater than zero.");
+    return "Device pixel ratio was invalid. It must be greater than zero.";
   }
 
   if (metrics.physical_view_inset_top < 0 ||
       metrics.physical_view_inset_right < 0 ||
       metrics.physical_view_inset_bottom < 0 ||
       metrics.physical_view_inset_left < 0) {
-    return LOG_EMBEDDER_ERROR(
-        kInvalidArguments,
-        "Physical view insets are invalid. They must be non-negative.");
+    return "Physical view insets are invalid. They must be non-negative.";
   }
 
   if (metrics.physical_view_inset_top > metrics.physical_height ||
       metrics.physical_view_inset_right > metrics.physical_width ||
       metrics.physical_view_inset_bottom > metrics.physical_height ||
       metrics.physical_view_inset_left > metrics.physical_width) {
-    return LOG_EMBEDDER_ERROR(kInvalidArguments,
-                              "Physical view insets are invalid. They cannot "
-                              "be greater than physical height or width.");
+    return "Physical view insets are invalid. They cannot be greater than "
+           "physical height or width.";
+  }
+
+  return metrics;
+}
+
+FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterWindowMetricsEvent* flutter_metrics) {
+  if (engine == nullptr || flutter_metrics == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+
+  std::variant<flutter::ViewportMetrics, std::string> metrics_or_error =
+      MakeViewportMetricsFromWindowMetrics(flutter_metrics);
+  if (const std::string* error = std::get_if<std::string>(&metrics_or_error)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, error->c_str());
   }
 
+  const FlutterViewId view_id =
+      SAFE_ACCESS(flutter_metrics, view_id, kFlutterImplicitViewId);
   return reinterpret_cast<flutter::EmbedderEngine*>(engine)->SetViewportMetrics(
-             metrics)
+             view_id, std::get<flutter::ViewportMetrics>(metrics_or_error))
              ? kSuccess
              : LOG_EMBEDDER_ERROR(kInvalidArguments,
                                   "Viewport metrics were invalid.");
 }
 
+FlutterEngineResult FlutterEngineAddView(FLUTTER_API_SYMBOL(FlutterEngine)
+                                             engine,
+                                         const FlutterAddViewInfo* info) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+  if (info == nullptr || SAFE_ACCESS(info, view_metrics, nullptr) == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "Add view info was invalid. The view metrics "
+                              "must be specified.");
+  }
+
+  const FlutterViewId view_id =
+      SAFE_ACCESS(info, view_id, kFlutterImplicitViewId);
+  if (view_id == kFlutterImplicitViewId) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The implicit view always exists and can't be "
+                              "added.");
+  }
+
+  std::variant<flutter::ViewportMetrics, std::string> metrics_or_error =
+      MakeViewportMetricsFromWindowMetrics(info->view_metrics);
+  if (const std::string* error = std::get_if<std::string>(&metrics_or_error)) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, error->c_str());
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)->AddView(
+             view_id, std::get<flutter::ViewportMetrics>(metrics_or_error))
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                  "The view could not be added. It may "
+                                  "already exist or the renderer may not "
+                                  "support more than one view.");
+}
+
+FlutterEngineResult FlutterEngineRemoveView(FLUTTER_API_SYMBOL(FlutterEngine)
+                                                engine,
+                                            FlutterViewId view_id) {
+  if (engine == nullptr) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments, "Engine handle was invalid.");
+  }
+  if (view_id == kFlutterImplicitViewId) {
+    return LOG_EMBEDDER_ERROR(kInvalidArguments,
+                              "The implicit view can't be removed.");
+  }
+
+  return reinterpret_cast<flutter::EmbedderEngine*>(engine)->RemoveView(
+             view_id)
+             ? kSuccess
+             : LOG_EMBEDDER_ERROR(kInvalidArguments,
+                                  "The view could not be removed.");
+}
+
 // Returns the flutter::PointerData::Change for the given FlutterPointerPhase.
 inline flutter::PointerData::Change ToPointerDataChange(
     FlutterPointerPhase phase) {
@@ -3251,6 +3331,8 @@ FlutterEngineResult FlutterEngineGetProcAddresses(
   SET_PROC(NotifyDisplayUpdate, FlutterEngineNotifyDisplayUpdate);
   SET_PROC(ScheduleFrame, FlutterEngineScheduleFrame);
   SET_PROC(SetNextFrameCallback, FlutterEngineSetNextFrameCallback);
+  SET_PROC(AddView, FlutterEngineAddView);
+  SET_PROC(RemoveView, FlutterEngineRemoveView);
 #undef SET_PROC
 
   return kSuccess;
@@ -397,6 +397,12 @@ typedef bool (*SoftwareSurfacePresentCallback)(void* /* user data */,
                                                const void* /* allocation */,
                                                size_t /* row bytes */,
                                                size_t /* height */);
+typedef bool (*SoftwareSurfacePresentViewCallback)(
+    void* /* user data */,
+    int64_t /* view id */,
+    const void* /* allocation */,
+    size_t /* row bytes */,
+    size_t /* height */);
 typedef void* (*ProcResolver)(void* /* user data */, const char* /* name */);
 typedef bool (*TextureFrameCallback)(void* /* user data */,
                                      int64_t /* texture identifier */,
@@ -797,6 +803,11 @@ typedef struct {
   /// format. The buffer is owned by the Flutter engine and must be copied in
   /// this callback if needed.
   SoftwareSurfacePresentCallback surface_present_callback;
+  /// The callback presented to the embedder to present a fully populated buffer
+  /// of a view added with `FlutterEngineAddView`. The buffer has the same
+  /// format and ownership as the one passed to `surface_present_callback`.
+  /// This callback is optional. Views can't be added if it isn't supplied.
+  SoftwareSurfacePresentViewCallback surface_present_view_callback;
 } FlutterSoftwareRendererConfig;
 
 typedef struct {
@@ -814,6 +825,11 @@ typedef struct {
 /// stable until the Flutter application restarts.
 typedef uint64_t FlutterEngineDisplayId;
 
+/// The identifier of a view the engine renders into. The view that exists for
+/// the whole lifetime of the engine, and that all views were before views could
+/// be added, has the identifier 0.
+typedef int64_t FlutterViewId;
+
 typedef struct {
   /// The size of this struct. Must be sizeof(FlutterWindowMetricsEvent).
   size_t struct_size;
@@ -837,8 +853,21 @@ typedef struct {
   double physical_view_inset_left;
   /// The identifier of the display the view is rendering on.
   FlutterEngineDisplayId display_id;
+  /// The view that this event describes. It must be 0 or the identifier of a
+  /// view added with `FlutterEngineAddView`.
+  FlutterViewId view_id;
 } FlutterWindowMetricsEvent;
 
+typedef struct {
+  /// The size of this struct. Must be sizeof(FlutterAddViewInfo).
+  size_t struct_size;
+  /// The identifier of the view to add. It must not be 0 or the identifier of
+  /// a view that was already added.
+  FlutterViewId view_id;
+  /// The initial metrics of the view. The `view_id` of the event is ignored.
+  const FlutterWindowMetricsEvent* view_metrics;
+} FlutterAddViewInfo;
+
 /// The phase of the pointer event.
 typedef enum {
   kCancel,
@@ -2263,6 +2292,45 @@ FlutterEngineResult FlutterEngineSendWindowMetricsEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     const FlutterWindowMetricsEvent* event);
 
+//------------------------------------------------------------------------------
+/// @brief      Adds a view that the engine renders into in addition to the
+///             view with the identifier 0. The framework can render into the
+///             view once this call returns. Frames of the view are presented
+///             with the `surface_present_view_callback` of the software
+///             renderer config.
+///
+/// @attention  Views can currently only be added to engines that use the
+///             software renderer without a `FlutterCompositor`. This must be
+///             called on the platform thread.
+///
+/// @param[in]  engine  A running engine instance.
+/// @param[in]  info    The identifier and initial metrics of the view.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineAddView(FLUTTER_API_SYMBOL(FlutterEngine)
+                                             engine,
+                                         const FlutterAddViewInfo* info);
+
+//------------------------------------------------------------------------------
+/// @brief      Removes a view added with `FlutterEngineAddView`. The
+///             framework is notified that the view is gone before the engine
+///             stops presenting frames of the view, so a frame that was
+///             already in flight may still be presented.
+///
+/// @attention  This must be called on the platform thread.
+///
+/// @param[in]  engine   A running engine instance.
+/// @param[in]  view_id  The identifier of the view to remove.
+///
+/// @return     The result of the call.
+///
+FLUTTER_EXPORT
+FlutterEngineResult FlutterEngineRemoveView(FLUTTER_API_SYMBOL(FlutterEngine)
+                                                engine,
+                                            FlutterViewId view_id);
+
 FLUTTER_EXPORT
 FlutterEngineResult FlutterEngineSendPointerEvent(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
@@ -2928,6 +2996,12 @@ typedef FlutterEngineResult (*FlutterEngineSetNextFrameCallbackFnPtr)(
     FLUTTER_API_SYMBOL(FlutterEngine) engine,
     VoidCallback callback,
     void* user_data);
+typedef FlutterEngineResult (*FlutterEngineAddViewFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    const FlutterAddViewInfo* info);
+typedef FlutterEngineResult (*FlutterEngineRemoveViewFnPtr)(
+    FLUTTER_API_SYMBOL(FlutterEngine) engine,
+    FlutterViewId view_id);
 
 /// Function-pointer-based versions of the APIs above.
 typedef struct {
@@ -2974,6 +3048,8 @@ typedef struct {
   FlutterEngineNotifyDisplayUpdateFnPtr NotifyDisplayUpdate;
   FlutterEngineScheduleFrameFnPtr ScheduleFrame;
   FlutterEngineSetNextFrameCallbackFnPtr SetNextFrameCallback;
+  FlutterEngineAddViewFnPtr AddView;
+  FlutterEngineRemoveViewFnPtr RemoveView;
 } FlutterEngineProcTable;
 
 //------------------------------------------------------------------------------
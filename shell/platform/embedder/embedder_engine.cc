@@ -4,6 +4,7 @@
 
 #include "flutter/shell/platform/embedder/embedder_engine.h"
 
+#include "flutter/common/constants.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/shell/platform/embedder/vsync_waiter_embedder.h"
 
@@ -113,6 +114,33 @@ bool EmbedderEngine::SetViewportMetrics(
   return true;
 }
 
+bool EmbedderEngine::SetViewportMetrics(
+    int64_t view_id,
+    const flutter::ViewportMetrics& metrics) {
+  if (view_id == kFlutterImplicitViewId) {
+    return SetViewportMetrics(metrics);
+  }
+  if (!IsValid()) {
+    return false;
+  }
+  return shell_->SetViewportMetrics(view_id, metrics);
+}
+
+bool EmbedderEngine::AddView(int64_t view_id,
+                             const flutter::ViewportMetrics& metrics) {
+  if (!IsValid()) {
+    return false;
+  }
+  return shell_->AddView(view_id, metrics);
+}
+
+bool EmbedderEngine::RemoveView(int64_t view_id) {
+  if (!IsValid()) {
+    return false;
+  }
+  return shell_->RemoveView(view_id);
+}
+
 bool EmbedderEngine::DispatchPointerDataPacket(
     std::unique_ptr<flutter::PointerDataPacket> packet) {
   if (!IsValid() || !packet) {
@@ -50,6 +50,13 @@ class EmbedderEngine {
 
   bool SetViewportMetrics(const flutter::ViewportMetrics& metrics);
 
+  bool SetViewportMetrics(int64_t view_id,
+                          const flutter::ViewportMetrics& metrics);
+
+  bool AddView(int64_t view_id, const flutter::ViewportMetrics& metrics);
+
+  bool RemoveView(int64_t view_id);
+
   bool DispatchPointerDataPacket(
       std::unique_ptr<flutter::PointerDataPacket> packet);
 
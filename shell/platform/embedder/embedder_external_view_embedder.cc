@@ -11,6 +11,11 @@
 #include "flutter/shell/platform/embedder/embedder_render_target.h"
 #include "third_party/skia/include/gpu/GrDirectContext.h"
 
+#ifdef IMPELLER_SUPPORTS_RENDERING
+#include "flutter/fml/closure.h"
+#include "impeller/aiks/aiks_context.h"
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
 namespace flutter {
 
 EmbedderExternalViewEmbedder::EmbedderExternalViewEmbedder(
@@ -192,12 +197,36 @@ void EmbedderExternalViewEmbedder::SubmitFrame(
 
   // Scribble embedder provide render targets. The order in which we scribble
   // into the buffers is irrelevant to the presentation order.
-  for (const auto& render_target : matched_render_targets) {
-    if (!pending_views_.at(render_target.first)
-             ->Render(*render_target.second)) {
-      FML_LOG(ERROR)
-          << "Could not render into the embedder supplied render target.";
-      return;
+  {
+#ifdef IMPELLER_SUPPORTS_RENDERING
+    // Every layer is rendered with the same context. Bracket all of them as a
+    // single frame so that rendering one layer doesn't evict the cached
+    // results and render targets used by the others.
+    std::shared_ptr<impeller::FilterResultCache> filter_result_cache;
+    std::shared_ptr<impeller::RenderTargetCache> render_target_cache;
+    if (aiks_context) {
+      filter_result_cache =
+          aiks_context->GetContentContext().GetFilterResultCache();
+      render_target_cache =
+          aiks_context->GetContentContext().GetRenderTargetCache();
+      filter_result_cache->Start();
+      render_target_cache->Start();
+    }
+    fml::ScopedCleanupClosure end_frame([&]() {
+      if (filter_result_cache) {
+        filter_result_cache->End();
+        render_target_cache->End();
+      }
+    });
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+    for (const auto& render_target : matched_render_targets) {
+      if (!pending_views_.at(render_target.first)
+               ->Render(*render_target.second)) {
+        FML_LOG(ERROR)
+            << "Could not render into the embedder supplied render target.";
+        return;
+      }
     }
   }
 
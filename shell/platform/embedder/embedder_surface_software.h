@@ -20,6 +20,11 @@ class EmbedderSurfaceSoftware final : public EmbedderSurface,
   struct SoftwareDispatchTable {
     std::function<bool(const void* allocation, size_t row_bytes, size_t height)>
         software_present_backing_store;  // required
+    std::function<bool(int64_t view_id,
+                       const void* allocation,
+                       size_t row_bytes,
+                       size_t height)>
+        software_present_view_backing_store;  // optional
   };
 
   EmbedderSurfaceSoftware(
@@ -1200,6 +1200,23 @@ void draw_solid_blue() {
   drawSolidColor(const Color.fromARGB(255, 0, 0, 255));
 }
 
+@pragma('vm:entry-point')
+void draw_solid_red_into_all_views() {
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    for (final FlutterView view in PlatformDispatcher.instance.views) {
+      final SceneBuilder builder = SceneBuilder();
+      builder.pushOffset(0.0, 0.0);
+      builder.addPicture(
+          Offset.zero,
+          CreateColoredBox(
+              const Color.fromARGB(255, 255, 0, 0), view.physicalSize));
+      builder.pop();
+      view.render(builder.build());
+    }
+  };
+  signalNativeTest();
+}
+
 @pragma('vm:entry-point')
 void pointer_data_packet() {
   PlatformDispatcher.instance.onPointerDataPacket =
@@ -10,6 +10,61 @@
 
 namespace flutter {
 
+namespace {
+
+// The rendering surface of a view added in addition to the implicit view. It
+// keeps the embedder surface that presents its frames alive.
+class ViewSurface final : public Surface {
+ public:
+  ViewSurface(std::unique_ptr<EmbedderSurface> embedder_surface,
+              std::unique_ptr<Surface> surface)
+      : embedder_surface_(std::move(embedder_surface)),
+        surface_(std::move(surface)) {}
+
+  ~ViewSurface() override {
+    // The surface refers to the embedder surface.
+    surface_.reset();
+  }
+
+  bool IsValid() override { return surface_->IsValid(); }
+
+  std::unique_ptr<SurfaceFrame> AcquireFrame(const SkISize& size) override {
+    return surface_->AcquireFrame(size);
+  }
+
+  SkMatrix GetRootTransformation() const override {
+    return surface_->GetRootTransformation();
+  }
+
+  GrDirectContext* GetContext() override { return surface_->GetContext(); }
+
+  std::unique_ptr<GLContextResult> MakeRenderContextCurrent() override {
+    return surface_->MakeRenderContextCurrent();
+  }
+
+  bool ClearRenderContext() override { return surface_->ClearRenderContext(); }
+
+  bool AllowsDrawingWhenGpuDisabled() const override {
+    return surface_->AllowsDrawingWhenGpuDisabled();
+  }
+
+  bool EnableRasterCache() const override {
+    return surface_->EnableRasterCache();
+  }
+
+  std::shared_ptr<impeller::AiksContext> GetAiksContext() const override {
+    return surface_->GetAiksContext();
+  }
+
+ private:
+  std::unique_ptr<EmbedderSurface> embedder_surface_;
+  std::unique_ptr<Surface> surface_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(ViewSurface);
+};
+
+}  // namespace
+
 class PlatformViewEmbedder::EmbedderPlatformMessageHandler
     : public PlatformMessageHandler {
  public:
@@ -57,6 +112,8 @@ PlatformViewEmbedder::PlatformViewEmbedder(
       embedder_surface_(
           std::make_unique<EmbedderSurfaceSoftware>(software_dispatch_table,
                                                     external_view_embedder_)),
+      software_present_view_backing_store_(
+          software_dispatch_table.software_present_view_backing_store),
       platform_message_handler_(new EmbedderPlatformMessageHandler(
           GetWeakPtr(),
           task_runners.GetPlatformTaskRunner())),
@@ -151,6 +208,40 @@ std::unique_ptr<Surface> PlatformViewEmbedder::CreateRenderingSurface() {
   return embedder_surface_->CreateGPUSurface();
 }
 
+// |PlatformView|
+std::unique_ptr<Surface> PlatformViewEmbedder::CreateSurfaceForView(
+    int64_t view_id) {
+  if (!software_present_view_backing_store_) {
+    FML_LOG(ERROR) << "Views can only be added to engines that use the "
+                      "software renderer with a view present callback.";
+    return nullptr;
+  }
+  if (external_view_embedder_) {
+    FML_LOG(ERROR) << "Views can't be added to engines with a compositor.";
+    return nullptr;
+  }
+
+  EmbedderSurfaceSoftware::SoftwareDispatchTable software_dispatch_table = {
+      .software_present_backing_store =
+          [present = software_present_view_backing_store_, view_id](
+              const void* allocation, size_t row_bytes, size_t height) {
+            return present(view_id, allocation, row_bytes, height);
+          },
+  };
+  std::unique_ptr<EmbedderSurface> embedder_surface =
+      std::make_unique<EmbedderSurfaceSoftware>(software_dispatch_table,
+                                                nullptr);
+  if (!embedder_surface->IsValid()) {
+    return nullptr;
+  }
+  std::unique_ptr<Surface> surface = embedder_surface->CreateGPUSurface();
+  if (!surface) {
+    return nullptr;
+  }
+  return std::make_unique<ViewSurface>(std::move(embedder_surface),
+                                       std::move(surface));
+}
+
 // |PlatformView|
 std::shared_ptr<ExternalViewEmbedder>
 PlatformViewEmbedder::CreateExternalViewEmbedder() {
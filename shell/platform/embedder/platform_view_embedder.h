@@ -109,12 +109,22 @@ class PlatformViewEmbedder final : public PlatformView {
   class EmbedderPlatformMessageHandler;
   std::shared_ptr<EmbedderExternalViewEmbedder> external_view_embedder_;
   std::unique_ptr<EmbedderSurface> embedder_surface_;
+  // Presents the views added in addition to the implicit view. Only set up
+  // for the software rasterizer.
+  std::function<bool(int64_t view_id,
+                     const void* allocation,
+                     size_t row_bytes,
+                     size_t height)>
+      software_present_view_backing_store_;
   std::shared_ptr<EmbedderPlatformMessageHandler> platform_message_handler_;
   PlatformDispatchTable platform_dispatch_table_;
 
   // |PlatformView|
   std::unique_ptr<Surface> CreateRenderingSurface() override;
 
+  // |PlatformView|
+  std::unique_ptr<Surface> CreateSurfaceForView(int64_t view_id) override;
+
   // |PlatformView|
   std::shared_ptr<ExternalViewEmbedder> CreateExternalViewEmbedder() override;
 
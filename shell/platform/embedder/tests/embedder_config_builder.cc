@@ -28,6 +28,27 @@
 namespace flutter {
 namespace testing {
 
+namespace {
+
+// Wraps a buffer presented by the software renderer in an image.
+sk_sp<SkImage> MakeImageFromSoftwareAllocation(const void* allocation,
+                                               size_t row_bytes,
+                                               size_t height) {
+  auto image_info =
+      SkImageInfo::MakeN32Premul(SkISize::Make(row_bytes / 4, height));
+  SkBitmap bitmap;
+  if (!bitmap.installPixels(image_info, const_cast<void*>(allocation),
+                            row_bytes)) {
+    FML_LOG(ERROR) << "Could not copy pixels for the software "
+                      "composition from the engine.";
+    return nullptr;
+  }
+  bitmap.setImmutable();
+  return SkImages::RasterFromBitmap(bitmap);
+}
+
+}  // namespace
+
 EmbedderConfigBuilder::EmbedderConfigBuilder(
     EmbedderTestContext& context,
     InitializationPreference preference)
@@ -90,18 +111,24 @@ EmbedderConfigBuilder::EmbedderConfigBuilder(
   software_renderer_config_.surface_present_callback =
       [](void* context, const void* allocation, size_t row_bytes,
          size_t height) {
-        auto image_info =
-            SkImageInfo::MakeN32Premul(SkISize::Make(row_bytes / 4, height));
-        SkBitmap bitmap;
-        if (!bitmap.installPixels(image_info, const_cast<void*>(allocation),
-                                  row_bytes)) {
-          FML_LOG(ERROR) << "Could not copy pixels for the software "
-                            "composition from the engine.";
+        auto image =
+            MakeImageFromSoftwareAllocation(allocation, row_bytes, height);
+        if (!image) {
           return false;
         }
-        bitmap.setImmutable();
         return reinterpret_cast<EmbedderTestContextSoftware*>(context)->Present(
-            SkImages::RasterFromBitmap(bitmap));
+            image);
+      };
+  software_renderer_config_.surface_present_view_callback =
+      [](void* context, int64_t view_id, const void* allocation,
+         size_t row_bytes, size_t height) {
+        auto image =
+            MakeImageFromSoftwareAllocation(allocation, row_bytes, height);
+        if (!image) {
+          return false;
+        }
+        return reinterpret_cast<EmbedderTestContextSoftware*>(context)
+            ->PresentView(view_id, image);
       };
 
   // The first argument is always the executable name. Don't make tests have to
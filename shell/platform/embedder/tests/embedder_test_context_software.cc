@@ -32,6 +32,21 @@ bool EmbedderTestContextSoftware::Present(const sk_sp<SkImage>& image) {
   return true;
 }
 
+void EmbedderTestContextSoftware::SetViewPresentCallback(
+    const ViewPresentCallback& view_present_callback) {
+  std::scoped_lock lock(view_present_callback_mutex_);
+  view_present_callback_ = view_present_callback;
+}
+
+bool EmbedderTestContextSoftware::PresentView(int64_t view_id,
+                                              const sk_sp<SkImage>& image) {
+  std::scoped_lock lock(view_present_callback_mutex_);
+  if (view_present_callback_) {
+    view_present_callback_(view_id, image);
+  }
+  return true;
+}
+
 size_t EmbedderTestContextSoftware::GetSurfacePresentCount() const {
   return software_surface_present_count_;
 }
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_CONTEXT_SOFTWARE_H_
 #define FLUTTER_SHELL_PLATFORM_EMBEDDER_TESTS_EMBEDDER_CONTEXT_SOFTWARE_H_
 
+#include <functional>
+#include <mutex>
+
 #include "flutter/shell/platform/embedder/tests/embedder_test_context.h"
 
 #include "third_party/skia/include/core/SkSurface.h"
@@ -25,6 +28,15 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
 
   bool Present(const sk_sp<SkImage>& image);
 
+  using ViewPresentCallback =
+      std::function<void(int64_t view_id, sk_sp<SkImage> image)>;
+
+  // Invoked with every frame presented for a view that was added in addition
+  // to the implicit view.
+  void SetViewPresentCallback(const ViewPresentCallback& view_present_callback);
+
+  bool PresentView(int64_t view_id, const sk_sp<SkImage>& image);
+
  protected:
   virtual void SetupCompositor() override;
 
@@ -32,6 +44,8 @@ class EmbedderTestContextSoftware : public EmbedderTestContext {
   sk_sp<SkSurface> surface_;
   SkISize surface_size_;
   size_t software_surface_present_count_ = 0;
+  std::mutex view_present_callback_mutex_;
+  ViewPresentCallback view_present_callback_;
   void SetupSurface(SkISize surface_size) override;
 
   FML_DISALLOW_COPY_AND_ASSIGN(EmbedderTestContextSoftware);
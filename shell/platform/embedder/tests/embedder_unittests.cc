@@ -4,6 +4,7 @@
 
 #define FML_USED_ON_EMBEDDER
 
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,6 +27,7 @@
 #include "flutter/shell/platform/embedder/tests/embedder_assertions.h"
 #include "flutter/shell/platform/embedder/tests/embedder_config_builder.h"
 #include "flutter/shell/platform/embedder/tests/embedder_test.h"
+#include "flutter/shell/platform/embedder/tests/embedder_test_context_software.h"
 #include "flutter/shell/platform/embedder/tests/embedder_unittests_util.h"
 #include "flutter/testing/assertions_skia.h"
 #include "flutter/testing/testing.h"
@@ -2470,6 +2472,75 @@ TEST_F(EmbedderTest, CanSetNextFrameCallback) {
   callback_latch.Wait();
 }
 
+TEST_F(EmbedderTest, CanRenderIntoAddedViews) {
+  auto& context = GetEmbedderContext(EmbedderTestContextType::kSoftwareContext);
+  EmbedderConfigBuilder builder(context);
+  builder.SetSoftwareRendererConfig(SkISize::Make(800, 600));
+  builder.SetDartEntrypoint("draw_solid_red_into_all_views");
+
+  fml::AutoResetWaitableEvent ready_latch;
+  context.AddNativeCallback(
+      "SignalNativeTest",
+      CREATE_NATIVE_ENTRY(
+          [&ready_latch](Dart_NativeArguments args) { ready_latch.Signal(); }));
+
+  fml::AutoResetWaitableEvent implicit_view_latch;
+  context.SetNextSceneCallback([&](sk_sp<SkImage> image) {
+    ASSERT_TRUE(image);
+    EXPECT_EQ(image->dimensions(), SkISize::Make(800, 600));
+    implicit_view_latch.Signal();
+  });
+
+  fml::AutoResetWaitableEvent added_view_latch;
+  std::atomic_bool added_view_presented = false;
+  static_cast<EmbedderTestContextSoftware&>(context).SetViewPresentCallback(
+      [&](int64_t view_id, sk_sp<SkImage> image) {
+        EXPECT_EQ(view_id, 1);
+        ASSERT_TRUE(image);
+        EXPECT_EQ(image->dimensions(), SkISize::Make(300, 200));
+        if (!added_view_presented.exchange(true)) {
+          added_view_latch.Signal();
+        }
+      });
+
+  auto engine = builder.LaunchEngine();
+  ASSERT_TRUE(engine.is_valid());
+
+  // Wait for the application to attach the frame callback.
+  ready_latch.Wait();
+
+  FlutterWindowMetricsEvent event = {};
+  event.struct_size = sizeof(event);
+  event.width = 800;
+  event.height = 600;
+  event.pixel_ratio = 1.0;
+  ASSERT_EQ(FlutterEngineSendWindowMetricsEvent(engine.get(), &event),
+            kSuccess);
+
+  FlutterWindowMetricsEvent view_metrics = {};
+  view_metrics.struct_size = sizeof(view_metrics);
+  view_metrics.width = 300;
+  view_metrics.height = 200;
+  view_metrics.pixel_ratio = 1.0;
+  FlutterAddViewInfo info = {};
+  info.struct_size = sizeof(info);
+  info.view_id = 1;
+  info.view_metrics = &view_metrics;
+  ASSERT_EQ(FlutterEngineAddView(engine.get(), &info), kSuccess);
+
+  // A view can only be added once, and the implicit view is always there.
+  ASSERT_EQ(FlutterEngineAddView(engine.get(), &info), kInvalidArguments);
+  info.view_id = 0;
+  ASSERT_EQ(FlutterEngineAddView(engine.get(), &info), kInvalidArguments);
+
+  implicit_view_latch.Wait();
+  added_view_latch.Wait();
+
+  ASSERT_EQ(FlutterEngineRemoveView(engine.get(), 1), kSuccess);
+  ASSERT_EQ(FlutterEngineRemoveView(engine.get(), 1), kInvalidArguments);
+  ASSERT_EQ(FlutterEngineRemoveView(engine.get(), 0), kInvalidArguments);
+}
+
 #if defined(FML_OS_MACOSX)
 
 static void MockThreadConfigSetter(const fml::Thread::ThreadConfig& config) {